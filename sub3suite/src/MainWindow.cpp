@@ -15,11 +15,15 @@
 #include "src/dialogs/AboutDialog.h"
 #include "src/dialogs/ApiKeysDialog.h"
 #include "src/dialogs/LogViewerDialog.h"
+#include "src/dialogs/MetricsDialog.h"
+#include "src/dialogs/CtLogDialog.h"
+#include "src/utils/ReverseIndex.h"
 #include "src/dialogs/DocumentationDialog.h"
 #include "src/dialogs/ProjectConfigDialog.h"
 #include "src/dialogs/SaveProjectDialog.h"
 
 #include "src/utils/Config.h"
+#include "src/utils/IpDatabase.h"
 
 
 MainWindow::MainWindow(QWidget *parent) :
@@ -31,6 +35,8 @@ MainWindow::MainWindow(QWidget *parent) :
     this->initActions();
     this->setRecentProjects();
 
+    connect(&m_enrichExecutor, &ScanExecutor::finished, this, &MainWindow::onEnrichEnded);
+
     /* check for updates */
     m_updateChecker = new UpdateChecker(this);
     m_updateChecker->checkForUpdates_onStart();
@@ -95,6 +101,9 @@ void MainWindow::initUI(){
 }
 
 void MainWindow::closeEvent(QCloseEvent *event){
+    /* the scans are stopped first, their workers end while the project is saved */
+    ScanExecutor::stopAll();
+
     /* check if project is configured, if not prompt to save project */
     if(projectModel->info.isNew ||  projectModel->info.isTemporary){
         if(!projectModel->info.isConfigured)
@@ -111,6 +120,9 @@ void MainWindow::closeEvent(QCloseEvent *event){
         /* save project */
         projectModel->closeProject();
     }
+
+    /* the results indexed since the last project save */
+    s3s_ReverseIndex::instance().saveConfigured();
 }
 
 void MainWindow::initActions(){
@@ -123,6 +135,7 @@ void MainWindow::initActions(){
     ui->actionApiKeys->setIcon(QIcon(":/img/res/icons/key.png"));
     ui->actionTwitter->setIcon(QIcon(":/img/res/icons/twitter.png"));
     ui->actionlogViewer->setIcon(QIcon(":/img/res/icons/log.png"));
+    ui->actionMetrics->setIcon(QIcon(":/img/res/icons/active.png"));
     ui->actionSourceCode->setIcon(QIcon(":/img/res/icons/source.png"));
     ui->actionOpenProject->setIcon(QIcon(":/img/res/icons/open.png"));
     ui->actionDocumentation->setIcon(QIcon(":/img/res/icons/doc.png"));
@@ -530,6 +543,12 @@ void MainWindow::on_actionlogViewer_triggered(){
     logViewerDialog->show();
 }
 
+void MainWindow::on_actionMetrics_triggered(){
+    MetricsDialog *metricsDialog = new MetricsDialog(this);
+    metricsDialog->setAttribute(Qt::WA_DeleteOnClose, true);
+    metricsDialog->show();
+}
+
 void MainWindow::on_actionDocumentation_triggered(){
     DocumentationDialog *documentationDialog = nullptr;
     documentationDialog = new DocumentationDialog(this);
@@ -577,3 +596,60 @@ void MainWindow::on_actionSaveCopy_triggered(){
     saveProjectDialog->setAttribute(Qt::WA_DeleteOnClose, true);
     saveProjectDialog->show();
 }
+
+void MainWindow::on_actionEnrichIPs_triggered(){
+    if(m_enrichExecutor.isRunning())
+        return;
+
+    /* ask for the routing table if no database is configured yet */
+    if(CONFIG.value(CFG_VAL_IPDB_ROUTES).toString().isEmpty() && CONFIG.value(CFG_VAL_IPDB_GEO).toString().isEmpty()){
+        QString filename = QFileDialog::getOpenFileName(this, "Routing Table", "./");
+        if(filename.isEmpty())
+            return;
+        CONFIG.setValue(CFG_VAL_IPDB_ROUTES, filename);
+    }
+
+    /* the database is loaded & the ips are looked up on a worker, the results are added here */
+    m_enrichArgs.targets = projectModel->getIPs();
+    m_enrichArgs.progress = 0;
+    s3s_IpDatabase::configuredPaths(m_enrichArgs.routes, m_enrichArgs.names, m_enrichArgs.geo);
+    m_enrichError.clear();
+    m_enriched = 0;
+
+    m_enrichProgress = new QProgressDialog("Enriching IP-Addresses...", "Stop", 0, m_enrichArgs.targets.size(), this);
+    m_enrichProgress->setAttribute(Qt::WA_DeleteOnClose, true);
+    m_enrichProgress->setWindowModality(Qt::WindowModal);
+    m_enrichProgress->setMinimumDuration(0);
+    m_enrichProgress->setAutoClose(false);
+    m_enrichProgress->setAutoReset(false);
+    connect(m_enrichProgress, &QProgressDialog::canceled, &m_enrichExecutor, &ScanExecutor::stop);
+
+    ipdb::Scanner *scanner = new ipdb::Scanner(&m_enrichArgs);
+    connect(scanner, &ipdb::Scanner::scanResult, this, [=](s3s_struct::IP ip){
+        projectModel->addEnumIP(ip);
+        m_enriched++;
+    });
+    connect(scanner, &ipdb::Scanner::scanStatus, this, [=](const QString &error){
+        m_enrichError = error;
+    });
+    connect(scanner, &ipdb::Scanner::scanProgress, m_enrichProgress.data(), &QProgressDialog::setValue);
+    m_enrichExecutor.start(scanner);
+}
+
+void MainWindow::onEnrichEnded(){
+    if(m_enrichProgress)
+        m_enrichProgress->close();
+
+    if(!m_enriched && !m_enrichError.isEmpty()){
+        QMessageBox::warning(this, "Error!", m_enrichError);
+        return;
+    }
+    QMessageBox::information(this, "Enrich IPs", QString::number(m_enriched)+" IP-Addresses enriched from "+
+                             QString::number(s3s_IpDatabase::instance().routes())+" routes");
+}
+
+void MainWindow::on_actionCtLogs_triggered(){
+    CtLogDialog *ctLogDialog = new CtLogDialog(projectModel, this);
+    ctLogDialog->setAttribute(Qt::WA_DeleteOnClose, true);
+    ctLogDialog->show();
+}
@@ -12,11 +12,15 @@
 #include <QMainWindow>
 #include <QSettings>
 #include <QLabel>
+#include <QPointer>
+#include <QProgressDialog>
 
 #include "src/utils/s3s.h"
 #include "src/utils/utils.h"
 #include "src/project/Project.h"
 #include "src/utils/UpdateChecker.h"
+#include "src/modules/active/ScanExecutor.h"
+#include "src/modules/active/IPDBScanner.h"
 
 /* engines */
 #include "src/engines/dns/Dns.h"
@@ -87,6 +91,7 @@ class MainWindow : public QMainWindow{
         void on_actionAbout_triggered();
         void on_actionAboutQt_triggered();
         void on_actionlogViewer_triggered();
+        void on_actionMetrics_triggered();
         void on_actionTwitter_triggered();
         void on_actionDocumentation_triggered();
         void on_actionConfig_triggered();
@@ -95,6 +100,9 @@ class MainWindow : public QMainWindow{
         void on_actionDonate_triggered();
         void on_actionCheckUpdates_triggered();
         void on_actionSaveCopy_triggered();
+        void on_actionEnrichIPs_triggered();
+        void on_actionCtLogs_triggered();
+        void onEnrichEnded();
 
     protected:
         void closeEvent(QCloseEvent *event) override;
@@ -125,6 +133,13 @@ class MainWindow : public QMainWindow{
         UpdateChecker *m_updateChecker = nullptr;
         QMenu *m_menuRecents = nullptr;
 
+        /* the offline enrichment of the project's ips */
+        ipdb::ScanArgs m_enrichArgs;
+        ScanExecutor m_enrichExecutor; // after the args, its workers end before the args are destroyed
+        QPointer<QProgressDialog> m_enrichProgress;
+        QString m_enrichError;
+        int m_enriched = 0;
+
         void initUI();
         void initActions();
         void initEngines();
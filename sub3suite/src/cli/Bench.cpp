@@ -0,0 +1,322 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : benchmarks of the active scanners against the local stub servers, each scanner is run at
+          a fixed concurrency & the measurements are written as a json baseline.
+*/
+
+#include "Bench.h"
+#include "ScanRunner.h"
+
+#include <algorithm>
+#include <QUrl>
+#include <QFile>
+#include <QThread>
+#include <QDateTime>
+#include <QEventLoop>
+#include <QJsonArray>
+#include <QTextStream>
+#include <QJsonDocument>
+#include <QSslConfiguration>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+
+#if defined(Q_OS_UNIX)
+#include <unistd.h>
+#include <sys/resource.h>
+#endif
+
+/* every nth brute word is a live label of the stub zone */
+#define LIVE_EVERY 10
+
+
+void bench::resourceUsage(qint64 &user, qint64 &system, qint64 &peakRss){
+#if defined(Q_OS_UNIX)
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) == 0){
+        user = static_cast<qint64>(usage.ru_utime.tv_sec)*1000000+usage.ru_utime.tv_usec;
+        system = static_cast<qint64>(usage.ru_stime.tv_sec)*1000000+usage.ru_stime.tv_usec;
+#if defined(Q_OS_MACOS)
+        peakRss = usage.ru_maxrss/1024; // bytes on macos
+#else
+        peakRss = usage.ru_maxrss;
+#endif
+        return;
+    }
+#endif
+    user = -1;
+    system = -1;
+    peakRss = -1;
+}
+
+qint64 bench::currentRss(){
+#if defined(Q_OS_LINUX)
+    /* the second field of statm is the resident set in pages */
+    QFile statm("/proc/self/statm");
+    if(statm.open(QIODevice::ReadOnly)){
+        QList<QByteArray> fields = statm.readAll().split(' ');
+        if(fields.size() > 1)
+            return fields.at(1).toLongLong()*(sysconf(_SC_PAGESIZE)/1024);
+    }
+#endif
+    return -1;
+}
+
+static double percentile(QList<qint64> sorted, double p){
+    if(sorted.isEmpty())
+        return -1;
+    int index = qMin(sorted.size()-1, static_cast<int>(p*sorted.size()));
+    return sorted.at(index)/1000000.0;
+}
+
+QJsonObject bench::Measurement::toJson() const {
+    QList<qint64> sorted = latencies;
+    std::sort(sorted.begin(), sorted.end());
+
+    QJsonObject object;
+    object.insert("scanner", scanner);
+    object.insert("queries", queries);
+    object.insert("results", results);
+    object.insert("elapsed_ms", elapsed/1000000.0);
+    object.insert("queries_per_sec", elapsed? queries/(elapsed/1000000000.0) : 0);
+
+    /* latencies are only known for the scanners whose requests name their targets */
+    if(sorted.isEmpty()){
+        object.insert("latency_p50_ms", QJsonValue::Null);
+        object.insert("latency_p99_ms", QJsonValue::Null);
+    }
+    else {
+        object.insert("latency_p50_ms", percentile(sorted, 0.50));
+        object.insert("latency_p99_ms", percentile(sorted, 0.99));
+    }
+    object.insert("cpu_user_ms", cpuUser < 0? QJsonValue(QJsonValue::Null) : QJsonValue(cpuUser/1000.0));
+    object.insert("cpu_system_ms", cpuSystem < 0? QJsonValue(QJsonValue::Null) : QJsonValue(cpuSystem/1000.0));
+    object.insert("peak_rss_kb", peakRss < 0? QJsonValue(QJsonValue::Null) : QJsonValue(peakRss));
+    return object;
+}
+
+///
+/// a benchmark run...
+///
+
+/* the scan options of the scanner's workload on the stubs */
+static bool workload(const QString &scanner, const bench::Options &options, bench::Stubs *stubs,
+                     cli::Options &scan, int &queries)
+{
+    scan.print = false;
+    scan.threads = options.threads;
+    scan.timeout = options.timeout;
+    scan.nameservers = QStringList{"127.0.0.1"};
+
+    if(scanner == "brute"){
+        if(!stubs->dns)
+            return false;
+        scan.engine = cli::ENGINE::BRUTE;
+        scan.targets.append(STUB_ZONE);
+        scan.targets.append(options.stub.wildcardZones);
+        scan.wildcard = !options.stub.wildcardZones.isEmpty();
+        int words = qMax(1, options.queries/scan.targets.size());
+        for(int i = 0; i < words; i++)
+            scan.wordlist.append(i%LIVE_EVERY? QString("w%1").arg(i) : QString(STUB_LIVE_PREFIX "%1").arg(i));
+        queries = words*scan.targets.size();
+        return true;
+    }
+    if(scanner == "dns"){
+        if(!stubs->dns)
+            return false;
+        scan.engine = cli::ENGINE::DNS;
+        scan.records = QStringList{"a", "aaaa"};
+        for(int i = 0; i < options.queries; i++)
+            scan.targets.append(QString(STUB_LIVE_PREFIX "%1." STUB_ZONE).arg(i));
+        queries = options.queries;
+        return true;
+    }
+    if(scanner == "url"){
+        if(!stubs->http)
+            return false;
+        scan.engine = cli::ENGINE::URL;
+        for(int i = 0; i < options.queries; i++)
+            scan.targets.append(QString("http://127.0.0.1:%1/u%2").arg(stubs->http->serverPort()).arg(i));
+        queries = options.queries;
+        return true;
+    }
+    if(scanner == "ssl"){
+        if(!stubs->tls)
+            return false;
+        scan.engine = cli::ENGINE::SSL;
+        scan.port = "https";
+        scan.output = "sha256";
+        for(int i = 0; i < options.queries; i++)
+            scan.targets.append("localhost");
+        queries = options.queries;
+        return true;
+    }
+    if(scanner == "port"){
+        if(!stubs->tcp)
+            return false;
+        scan.engine = cli::ENGINE::PORT;
+        scan.ports = stubs->tcp->ports();
+        int targets = qMax(1, options.queries/scan.ports.size());
+        for(int i = 0; i < targets; i++)
+            scan.targets.append("127.0.0.1");
+        queries = targets*scan.ports.size();
+        return true;
+    }
+    return false;
+}
+
+/* the key of the result's request in the stubs' arrival log */
+static QString arrivalKey(const QString &scanner, const QJsonObject &result){
+    if(scanner == "brute" || scanner == "dns")
+        return result.value("host").toString().toLower();
+    if(scanner == "url")
+        return QUrl(result.value("url").toString()).path();
+    return QString();
+}
+
+static bool benchmark(const QString &scanner, const bench::Options &options, bench::Stubs *stubs,
+                      bench::Measurement &measurement)
+{
+    cli::Options scan;
+    int queries = 0;
+    if(!workload(scanner, options, stubs, scan, queries))
+        return false;
+
+    stubs->arrivals.clear();
+    measurement.scanner = scanner;
+    measurement.queries = queries;
+
+    cli::ScanRunner runner(scan);
+    QEventLoop loop;
+    QObject::connect(&runner, &cli::ScanRunner::finished, &loop, &QEventLoop::quit, Qt::QueuedConnection);
+    QObject::connect(&runner, &cli::ScanRunner::result, &loop, [&](const QJsonObject &result){
+        qint64 time = bench::now();
+        measurement.results++;
+
+        QString key = arrivalKey(scanner, result);
+        if(key.isEmpty())
+            return;
+        qint64 arrival = stubs->arrivals.value(key);
+        if(arrival >= 0)
+            measurement.latencies.append(time-arrival);
+    });
+
+    qint64 user, system, peakRss;
+    bench::resourceUsage(user, system, peakRss);
+    qint64 start = bench::now();
+
+    if(!runner.start())
+        return false;
+    loop.exec();
+
+    measurement.elapsed = bench::now()-start;
+    bench::resourceUsage(measurement.cpuUser, measurement.cpuSystem, measurement.peakRss);
+    if(measurement.cpuUser >= 0){
+        measurement.cpuUser -= user;
+        measurement.cpuSystem -= system;
+    }
+    return true;
+}
+
+int bench::run(int argc, char *argv[]){
+    if(argc > 2 && qstrcmp(argv[2], "model") == 0)
+        return bench::runModel(argc, argv);
+
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmarks the active scanners against local stub servers & writes the "
+                                     "measurements as a json baseline. the dns & tls stubs listen on the "
+                                     "privileged ports 53 & 443 of the loopback interface.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("bench", "runs the benchmarks.");
+    parser.addOptions({
+        {"scanner", "scanners to benchmark, comma separated, brute, dns, port, ssl & url.", "scanners", "brute,dns,port,ssl,url"},
+        {"queries", "number of queries for each scanner.", "number", "10000"},
+        {"threads", "number of scanner threads.", "number", "50"},
+        {"timeout", "scanner timeout in milliseconds.", "ms", "1000"},
+        {"latency", "stub reply latency in milliseconds.", "ms", "0"},
+        {"loss", "percentage of dns queries dropped by the stub.", "percent", "0"},
+        {"wildcard", "adds a wildcard zone to the brute workload."},
+        {"listeners", "number of tcp listeners for the port scanner.", "number", "16"},
+        {"output", "baseline file, stdout by default.", "file"}
+    });
+    parser.process(app);
+
+    bench::Options options;
+    options.scanners = parser.value("scanner").toLower().split(',', QString::SkipEmptyParts);
+    options.queries = qMax(1, parser.value("queries").toInt());
+    options.threads = qMax(1, parser.value("threads").toInt());
+    options.timeout = qMax(1, parser.value("timeout").toInt());
+    options.stub.latency = qMax(0, parser.value("latency").toInt());
+    options.stub.loss = qBound(0.0, parser.value("loss").toDouble(), 100.0);
+    options.stub.tcpListeners = qMax(1, parser.value("listeners").toInt());
+    options.output = parser.value("output");
+    if(parser.isSet("wildcard"))
+        options.stub.wildcardZones.append("wild." STUB_ZONE);
+
+    /* the stubs run on their own thread, away from the results' event loop */
+    QThread stubThread;
+    bench::Stubs stubs(options.stub);
+    stubs.moveToThread(&stubThread);
+    stubThread.start();
+    QMetaObject::invokeMethod(&stubs, "start", Qt::BlockingQueuedConnection);
+    if(!stubs.error.isEmpty())
+        QTextStream(stderr) << stubs.error << endl;
+
+    /* the ssl scanner verifies its peers, the stub's self-signed certificate is trusted for the benchmark */
+    if(stubs.tls){
+        QSslConfiguration configuration = QSslConfiguration::defaultConfiguration();
+        QList<QSslCertificate> certificates = configuration.caCertificates();
+        certificates.append(stubs.tls->certificate());
+        configuration.setCaCertificates(certificates);
+        QSslConfiguration::setDefaultConfiguration(configuration);
+    }
+
+    QJsonArray measurements;
+    foreach(const QString &scanner, options.scanners){
+        bench::Measurement measurement;
+        if(!benchmark(scanner, options, &stubs, measurement)){
+            QTextStream(stderr) << "skipped " << scanner << ", unknown scanner or its stub is not running" << endl;
+            continue;
+        }
+        measurements.append(measurement.toJson());
+    }
+
+    QMetaObject::invokeMethod(&stubs, "stop", Qt::BlockingQueuedConnection);
+    stubThread.quit();
+    stubThread.wait();
+
+    ///
+    /// the baseline...
+    ///
+    QJsonObject config;
+    config.insert("queries", options.queries);
+    config.insert("threads", options.threads);
+    config.insert("timeout_ms", options.timeout);
+    config.insert("latency_ms", options.stub.latency);
+    config.insert("loss_percent", options.stub.loss);
+    config.insert("wildcard", !options.stub.wildcardZones.isEmpty());
+    config.insert("listeners", options.stub.tcpListeners);
+
+    QJsonObject baseline;
+    baseline.insert("date", QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    baseline.insert("qt", QString(qVersion()));
+    baseline.insert("config", config);
+    baseline.insert("measurements", measurements);
+
+    QByteArray json = QJsonDocument(baseline).toJson(QJsonDocument::Indented);
+    if(options.output.isEmpty()){
+        QTextStream(stdout) << json;
+        return 0;
+    }
+
+    QFile file(options.output);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)){
+        QTextStream(stderr) << "cannot write " << options.output << endl;
+        return 1;
+    }
+    file.write(json);
+    return 0;
+}
@@ -0,0 +1,59 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : benchmarks of the active scanners against the local stub servers, each scanner is run at
+          a fixed concurrency & the measurements are written as a json baseline.
+
+          usage: sudo sub3suite bench --scanner brute,dns --queries 10000 --threads 50 --output baseline.json
+                 sub3suite bench model --records 10000,1000000 --output model.json
+*/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <QJsonObject>
+#include <QStringList>
+
+#include "StubServers.h"
+
+
+namespace bench {
+
+struct Options { // benchmark options from the command line
+    QStringList scanners;
+    int queries = 10000;
+    int threads = 50;
+    int timeout = 1000;
+    bench::StubConfig stub;
+    QString output; // baseline file, stdout if empty
+};
+
+struct Measurement { // a benchmark run of a scanner
+    QString scanner;
+    int queries = 0;
+    int results = 0;
+    qint64 elapsed = 0;         // nanoseconds
+    QList<qint64> latencies;    // nanoseconds, from a request's arrival at the stub to its result
+    qint64 cpuUser = -1;        // microseconds, -1 if not known on the platform
+    qint64 cpuSystem = -1;
+    qint64 peakRss = -1;        // kilobytes, the process' peak so far
+
+    QJsonObject toJson() const;
+};
+
+/* parses the command line & runs the benchmarks on a QCoreApplication, returns the exit code */
+int run(int argc, char *argv[]);
+
+/* the project model benchmarks, on synthetic projects */
+int runModel(int argc, char *argv[]);
+
+/* the process' cpu times in microseconds & its peak resident set in kilobytes, -1 if not known */
+void resourceUsage(qint64 &user, qint64 &system, qint64 &peakRss);
+
+/* the process' current resident set in kilobytes, -1 if not known */
+qint64 currentRss();
+
+}
+
+#endif // BENCH_H
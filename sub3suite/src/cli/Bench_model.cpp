@@ -0,0 +1,256 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : benchmarks of the project model on synthetic projects, the results ingestion, the project's
+          serialization, the memory per record & the filtering of the results.
+*/
+
+#include "Bench.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QJsonArray>
+#include <QTextStream>
+#include <QTemporaryDir>
+#include <QJsonDocument>
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QRandomGenerator>
+#include <QCommandLineParser>
+#include <QSortFilterProxyModel>
+
+#include "src/models/ProjectModel.h"
+
+/* the raw items are parsed json documents, fewer of them are benchmarked */
+#define RAW_RECORDS_MAX 100000
+
+/* zones the synthetic names are spread on */
+#define SYNTHETIC_ZONES 64
+
+
+static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz0123456789";
+
+/* the ith synthetic name, the same for a seed on every run */
+static QString syntheticName(quint32 seed, int i){
+    QRandomGenerator generator(seed+static_cast<quint32>(i)*2654435761u);
+    QString label;
+    int length = generator.bounded(3, 13);
+    for(int j = 0; j < length; j++)
+        label.append(QChar::fromLatin1(alphabet[generator.bounded(36)]));
+    return QString("%1-%2.zone%3.test").arg(label).arg(i, 0, 36).arg(i%SYNTHETIC_ZONES);
+}
+
+static QString syntheticIp(int i){
+    quint32 address = (10u << 24) | (static_cast<quint32>(i) & 0x00ffffff);
+    return QString("%1.%2.%3.%4").arg(address >> 24).arg((address >> 16) & 0xff).arg((address >> 8) & 0xff).arg(address & 0xff);
+}
+
+static QByteArray syntheticRaw(int i){
+    QJsonObject object;
+    object.insert("domain", syntheticName(0, i));
+    object.insert("ip", syntheticIp(i));
+    object.insert("count", i);
+    object.insert("verified", i%2 == 0);
+    QJsonArray subdomains;
+    for(int j = 0; j < 8; j++)
+        subdomains.append(syntheticName(1, i*8+j));
+    object.insert("subdomains", subdomains);
+    QJsonObject whois;
+    whois.insert("registrar", "stub registrar");
+    whois.insert("created", "2020-01-01");
+    whois.insert("country", "TZ");
+    object.insert("whois", whois);
+    return QJsonDocument(object).toJson(QJsonDocument::Compact);
+}
+
+static double perSecond(int count, qint64 nsecs){
+    return nsecs? count/(nsecs/1000000000.0) : 0;
+}
+
+///
+/// a benchmark run...
+///
+
+static QJsonObject benchmarkModel(int records, quint32 seed, int duplicates, const QString &directory){
+    QJsonObject measurement;
+    measurement.insert("records", records);
+    QElapsedTimer timer;
+
+    ProjectModel *model = new ProjectModel;
+    qint64 rssBefore = bench::currentRss();
+
+    /* insert throughput */
+    timer.start();
+    for(int i = 0; i < records; i++){
+        s3s_struct::HOST host;
+        host.host = syntheticName(seed, i);
+        host.ipv4 = syntheticIp(i);
+        model->addActiveHost(host);
+    }
+    measurement.insert("active_host_per_sec", perSecond(records, timer.nsecsElapsed()));
+
+    /* a percentage of the passive subdomains repeat earlier ones, for the duplicates removal */
+    QRandomGenerator generator(seed);
+    int repeated = 0;
+    timer.start();
+    for(int i = 0; i < records; i++){
+        if(i && generator.bounded(100) < duplicates){
+            model->addPassiveSubdomain(syntheticName(seed, generator.bounded(i)));
+            repeated++;
+        }
+        else
+            model->addPassiveSubdomain(syntheticName(seed, i));
+    }
+    measurement.insert("passive_subdomain_per_sec", perSecond(records, timer.nsecsElapsed()));
+
+    timer.start();
+    for(int i = 0; i < records; i++){
+        s3s_struct::IP ip;
+        ip.ip = syntheticIp(i);
+        ip.info_city = "Dar es Salaam";
+        ip.info_countryCode = "TZ";
+        ip.info_organization = "stub";
+        model->addEnumIP(ip);
+    }
+    measurement.insert("enum_ip_per_sec", perSecond(records, timer.nsecsElapsed()));
+
+    /* memory per record, of the three models */
+    qint64 rssAfter = bench::currentRss();
+    if(rssBefore < 0 || rssAfter < 0)
+        measurement.insert("memory_per_record_bytes", QJsonValue::Null);
+    else
+        measurement.insert("memory_per_record_bytes", (rssAfter-rssBefore)*1024.0/(3.0*records));
+
+    /* raw items parse their json into child items */
+    int raws = qMin(records, RAW_RECORDS_MAX);
+    timer.start();
+    for(int i = 0; i < raws; i++){
+        s3s_struct::RAW raw;
+        raw.module = "Stub";
+        raw.query_option = "domain";
+        raw.target = syntheticName(seed, i);
+        raw.results = syntheticRaw(i);
+
+        s3s_item::RAW *item = new s3s_item::RAW;
+        item->setValues(raw);
+        delete item;
+    }
+    measurement.insert("raw_records", raws);
+    measurement.insert("raw_set_values_per_sec", perSecond(raws, timer.nsecsElapsed()));
+
+    /* filter latency, as in the project's results view */
+    QSortFilterProxyModel proxy;
+    proxy.setFilterCaseSensitivity(Qt::CaseInsensitive);
+    proxy.setFilterKeyColumn(0);
+    proxy.setSourceModel(model->passiveSubdomain);
+    timer.start();
+    proxy.setFilterFixedString(".zone7.");
+    int matches = proxy.rowCount();
+    measurement.insert("filter_ms", timer.nsecsElapsed()/1000000.0);
+    measurement.insert("filter_matches", matches);
+    proxy.setSourceModel(nullptr);
+
+    /* save & load */
+    QString path = directory+QString("/bench_%1.s3s").arg(records);
+    timer.start();
+    bool saved = model->saveProjectFile(path);
+    measurement.insert("save_ms", timer.nsecsElapsed()/1000000.0);
+    measurement.insert("saved", saved);
+    measurement.insert("file_bytes", QFileInfo(path).size());
+
+    ProjectModel *loaded = new ProjectModel;
+    ProjectStruct project;
+    project.name = "bench";
+    project.path = path;
+    project.isExisting = true;
+    timer.start();
+    loaded->openProject(project);
+    measurement.insert("load_ms", timer.nsecsElapsed()/1000000.0);
+    /* the records that made it through a save & load, the serialization has a size limit */
+    measurement.insert("loaded_records", loaded->getItemsCount());
+    measurement.insert("expected_records", model->getItemsCount());
+    delete loaded;
+    QFile::remove(path);
+
+    /* duplicates removal */
+    timer.start();
+    int removed = ProjectModel::removeDuplicates(model->passiveSubdomain);
+    measurement.insert("remove_duplicates_ms", timer.nsecsElapsed()/1000000.0);
+    measurement.insert("duplicates_removed", removed);
+    measurement.insert("duplicates_inserted", repeated);
+
+    delete model;
+    return measurement;
+}
+
+int bench::runModel(int argc, char *argv[]){
+    /* the items have icons & fonts, a gui application without a display */
+    if(qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QGuiApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmarks the project model on synthetic projects & writes the "
+                                     "measurements as a json baseline.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("bench", "runs the benchmarks.");
+    parser.addPositionalArgument("model", "the project model benchmarks.");
+    parser.addOptions({
+        {"records", "records of each synthetic project, comma separated.", "numbers", "10000,1000000,10000000"},
+        {"seed", "seed of the synthetic records.", "number", "1"},
+        {"duplicates", "percentage of repeated passive subdomains.", "percent", "5"},
+        {"output", "baseline file, stdout by default.", "file"}
+    });
+    parser.process(app);
+
+    QList<int> sizes;
+    foreach(const QString &size, parser.value("records").split(',', QString::SkipEmptyParts)){
+        int records = size.trimmed().toInt();
+        if(records < 1){
+            QTextStream(stderr) << "invalid records " << size << endl;
+            return 1;
+        }
+        sizes.append(records);
+    }
+    quint32 seed = parser.value("seed").toUInt();
+    int duplicates = qBound(0, parser.value("duplicates").toInt(), 100);
+
+    QTemporaryDir directory;
+    if(!directory.isValid()){
+        QTextStream(stderr) << "cannot create a temporary directory" << endl;
+        return 1;
+    }
+
+    QJsonArray measurements;
+    foreach(int records, sizes){
+        QTextStream(stderr) << "project model, " << records << " records..." << endl;
+        measurements.append(benchmarkModel(records, seed, duplicates, directory.path()));
+    }
+
+    QJsonObject config;
+    config.insert("seed", static_cast<qint64>(seed));
+    config.insert("duplicates_percent", duplicates);
+
+    QJsonObject baseline;
+    baseline.insert("date", QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    baseline.insert("qt", QString(qVersion()));
+    baseline.insert("config", config);
+    baseline.insert("measurements", measurements);
+
+    QByteArray json = QJsonDocument(baseline).toJson(QJsonDocument::Indented);
+    QString output = parser.value("output");
+    if(output.isEmpty()){
+        QTextStream(stdout) << json;
+        return 0;
+    }
+
+    QFile file(output);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)){
+        QTextStream(stderr) << "cannot write " << output << endl;
+        return 1;
+    }
+    file.write(json);
+    return 0;
+}
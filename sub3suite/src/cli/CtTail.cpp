@@ -0,0 +1,164 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : certificate transparency tail without the gui.
+*/
+
+#include "CtTail.h"
+#include "ScanRunner.h"
+#include "StubServers.h"
+
+#include <QThread>
+#include <QTextStream>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+
+/* milliseconds between flushes of the results to stdout */
+#define FLUSH_INTERVAL 250
+
+
+int cli::runCt(int argc, char *argv[]){
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Tails certificate transparency logs without the gui. the entries are downloaded "
+                                     "from the logs' get-entries endpoints in parallel ranges & their certificates are "
+                                     "parsed on a pool of threads, the names under the monitored domains are written "
+                                     "to stdout as newline delimited json.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("ct", "runs a ct tail.");
+    parser.addOptions({
+        {"log", "a log's base url, can be repeated.", "url"},
+        {"logs", "file with the logs' base urls.", "file"},
+        {"domain", "a monitored apex domain, can be repeated, all the names if none.", "domain"},
+        {"domains", "file with the monitored apex domains.", "file"},
+        {"start", "first entry, the tree head minus the backlog by default.", "index"},
+        {"end", "entry after the last, the tree size by default.", "index"},
+        {"backlog", "entries before the tree head to start from.", "number", QString::number(CT_BACKLOG)},
+        {"follow", "keeps polling the tree heads & tails the new entries."},
+        {"interval", "milliseconds between the polls of the tree heads.", "ms", QString::number(CT_INTERVAL)},
+        {"batch", "entries of each get-entries request.", "number", QString::number(CT_BATCH)},
+        {"parallel", "get-entries requests in flight for each log.", "number", QString::number(CT_PARALLEL)},
+        {"workers", "certificate parsing threads, the number of cores by default.", "number", "0"},
+        {"timeout", "request timeout in milliseconds.", "ms", "30000"},
+        {"mock", "tails a local log of the given number of synthetic certificates of " STUB_ZONE ".", "size"}
+    });
+    parser.process(app);
+
+    ct::Config config;
+    QStringList logs;
+    if(!cli::readList(parser, "log", "logs", logs) || !cli::readList(parser, "domain", "domains", config.domains))
+        return 1;
+
+    foreach(const QString &log, logs){
+        QUrl url(log.trimmed());
+        if(!url.isValid() || (url.scheme() != "https" && url.scheme() != "http")){
+            QTextStream(stderr) << "invalid log url " << log << endl;
+            return 1;
+        }
+        config.logs.append(url);
+    }
+
+    config.start = parser.isSet("start")? parser.value("start").toLongLong() : -1;
+    config.end = parser.isSet("end")? parser.value("end").toLongLong() : -1;
+    config.backlog = parser.value("backlog").toLongLong();
+    config.follow = parser.isSet("follow");
+    config.interval = parser.value("interval").toInt();
+    config.batch = parser.value("batch").toInt();
+    config.parallel = parser.value("parallel").toInt();
+    config.workers = parser.value("workers").toInt();
+    config.timeout = parser.value("timeout").toInt();
+    if(config.batch < 1 || config.parallel < 1 || config.interval < 1 || config.backlog < 0){
+        QTextStream(stderr) << "invalid batch, parallel, interval or backlog" << endl;
+        return 1;
+    }
+
+    /* the mock log is served on its own thread, all its entries are tailed */
+    QThread mockThread;
+    bench::CtLogStub mock(parser.value("mock").toLongLong());
+    if(parser.isSet("mock")){
+        mock.moveToThread(&mockThread);
+        mockThread.start();
+        QMetaObject::invokeMethod(&mock, "start", Qt::BlockingQueuedConnection);
+        if(!mock.error.isEmpty()){
+            QTextStream(stderr) << mock.error << endl;
+            mockThread.quit();
+            mockThread.wait();
+            return 1;
+        }
+        config.logs.append(mock.url());
+        if(!parser.isSet("start"))
+            config.start = 0;
+    }
+    if(config.logs.isEmpty()){
+        QTextStream(stderr) << "no logs, use --log, --logs or --mock" << endl;
+        return 1;
+    }
+
+    int code;
+    {
+        cli::CtTail tail(config);
+        QObject::connect(&tail, &cli::CtTail::finished, &app, &QCoreApplication::quit, Qt::QueuedConnection);
+        tail.start();
+        code = app.exec();
+    }
+
+    if(parser.isSet("mock")){
+        QMetaObject::invokeMethod(&mock, "stop", Qt::BlockingQueuedConnection);
+        mockThread.quit();
+        mockThread.wait();
+    }
+    return code;
+}
+
+///
+/// the tail...
+///
+
+cli::CtTail::CtTail(const ct::Config &config, QObject *parent): QObject(parent),
+    m_tailer(config)
+{
+    m_stdout.open(stdout, QIODevice::WriteOnly);
+
+    connect(&m_tailer, &ct::Tailer::result, this, &cli::CtTail::onResult);
+    connect(&m_tailer, &ct::Tailer::error, this, &cli::CtTail::onError);
+    connect(&m_tailer, &ct::Tailer::finished, this, &cli::CtTail::onFinished);
+    connect(&m_flushTimer, &QTimer::timeout, this, &cli::CtTail::flush);
+    m_flushTimer.start(FLUSH_INTERVAL);
+}
+cli::CtTail::~CtTail(){
+    this->flush();
+}
+
+void cli::CtTail::start(){
+    m_timer.start();
+    m_tailer.start();
+}
+
+void cli::CtTail::onResult(const QString &name, const QString &log, qint64 index){
+    QJsonObject result{{"name", name}, {"log", log}, {"index", static_cast<double>(index)}};
+    m_stdout.write(QJsonDocument(result).toJson(QJsonDocument::Compact));
+    m_stdout.write("\n");
+    m_results++;
+}
+
+void cli::CtTail::onError(const QString &log, const QString &message){
+    QTextStream(stderr) << log << ": " << message << endl;
+}
+
+void cli::CtTail::onFinished(){
+    this->flush();
+
+    /* the throughput, for the runs against the mock log */
+    qint64 elapsed = qMax<qint64>(1, m_timer.elapsed());
+    QTextStream(stderr) << m_tailer.parsed() << " entries, " << m_results << " names in " << elapsed << " ms, "
+                        << (m_tailer.parsed()*1000/elapsed) << " entries/s" << endl;
+    emit finished();
+}
+
+void cli::CtTail::flush(){
+    m_stdout.flush();
+}
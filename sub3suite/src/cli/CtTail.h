@@ -0,0 +1,57 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : certificate transparency tail without the gui, the names under the monitored domains are
+          written to stdout as newline delimited json as the logs' entries are parsed. with --mock
+          the tail runs against a local log of synthetic certificates & prints its throughput.
+
+          usage: sub3suite ct --log https://ct.googleapis.com/logs/us1/argon2026h2/ --domain example.com --follow
+                 sub3suite ct --mock 100000 --workers 4
+*/
+
+#ifndef CTTAIL_H
+#define CTTAIL_H
+
+#include <QFile>
+#include <QTimer>
+#include <QObject>
+#include <QElapsedTimer>
+
+#include "src/modules/ct/CtTailer.h"
+
+
+namespace cli {
+
+/* parses the command line & runs the tail on a QCoreApplication, returns the exit code */
+int runCt(int argc, char *argv[]);
+
+class CtTail : public QObject {
+    Q_OBJECT
+
+    public:
+        CtTail(const ct::Config &config, QObject *parent = nullptr);
+        ~CtTail() override;
+
+        void start();
+
+    signals:
+        void finished();
+
+    private slots:
+        void onResult(const QString &name, const QString &log, qint64 index);
+        void onError(const QString &log, const QString &message);
+        void onFinished();
+        void flush();
+
+    private:
+        ct::Tailer m_tailer;
+        QFile m_stdout;
+        QTimer m_flushTimer;
+        QElapsedTimer m_timer;
+        qint64 m_results = 0;
+};
+
+}
+
+#endif // CTTAIL_H
@@ -0,0 +1,289 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : email verification without the gui.
+*/
+
+#include "EmailVerify.h"
+#include "ScanRunner.h"
+#include "StubServers.h"
+#include "src/utils/Config.h"
+#include "src/utils/Hostname.h"
+
+#include <QThread>
+#include <QTextStream>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+
+/* milliseconds between flushes of the results to stdout */
+#define FLUSH_INTERVAL 250
+
+/* people of each domain of the mock */
+#define MOCK_PEOPLE 100
+
+
+int cli::runEmail(int argc, char *argv[]){
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Verifies email addresses without the gui. the candidate addresses of the names "
+                                     "are generated from the patterns on each domain, the domains' mx records are "
+                                     "resolved & the addresses are checked with pipelined RCPT TO commands, the "
+                                     "results are written to stdout as newline delimited json.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("email", "runs an email verification.");
+    parser.addOptions({
+        {"name", "a person's name eg. \"Jane Doe\", can be repeated.", "name"},
+        {"names", "file with the names.", "file"},
+        {"domain", "a domain of the names, can be repeated.", "domain"},
+        {"domains", "file with the domains of the names.", "file"},
+        {"pattern", "a pattern of the domains eg. \"{first}.{last}\", the common patterns if none.", "pattern"},
+        {"patterns", "file with the patterns.", "file"},
+        {"email", "an address to verify, can be repeated.", "address"},
+        {"emails", "file with the addresses to verify.", "file"},
+        {"generate", "writes the candidate addresses to stdout without verifying them."},
+        {"discover", "finds the patterns & the people of the domains with the EmailFormat & Hunter modules that "
+                     "have api keys, then verifies the candidates of the people & the given names."},
+        {"nameserver", "a nameserver of the mx lookups, can be repeated.", "address"},
+        {"nameservers", "file with the nameservers.", "file"},
+        {"threads", "number of worker threads, the configured value by default.", "number", "0"},
+        {"timeout", "connection & reply timeout in milliseconds, the configured value by default.", "ms", "0"},
+        {"connections", "connections to each mail exchanger, the configured value by default.", "number", "0"},
+        {"pipeline", "RCPT TO commands written at once, the configured value by default.", "number", "0"},
+        {"helo", "the name of the EHLO command.", "name"},
+        {"sender", "the address of the MAIL FROM command, the null sender by default.", "address"},
+        {"mx", "a mail exchanger of every domain instead of their mx records.", "host"},
+        {"port", "the port of the mail exchangers.", "port", QString::number(SMTP_PORT)},
+        {"mock", "verifies the addresses of the given number of synthetic people on a local smtp server.", "size"}
+    });
+    parser.process(app);
+
+    QStringList names, domains, patterns, addresses, nameservers;
+    if(!cli::readList(parser, "name", "names", names) || !cli::readList(parser, "domain", "domains", domains) ||
+       !cli::readList(parser, "pattern", "patterns", patterns) || !cli::readList(parser, "email", "emails", addresses) ||
+       !cli::readList(parser, "nameserver", "nameservers", nameservers))
+        return 1;
+
+    email::ScanConfig config;
+    CONFIG.beginGroup(CFG_SMTP);
+    config.threads = CONFIG.value(CFG_VAL_THREADS, config.threads).toInt();
+    config.timeout = CONFIG.value(CFG_VAL_TIMEOUT, config.timeout).toInt();
+    config.connections = CONFIG.value(CFG_VAL_MX_CONNECTIONS, config.connections).toInt();
+    config.pipeline = CONFIG.value(CFG_VAL_PIPELINE, config.pipeline).toInt();
+    config.helo = CONFIG.value(CFG_VAL_HELO, config.helo).toString();
+    config.sender = CONFIG.value(CFG_VAL_SENDER).toString();
+    CONFIG.endGroup();
+
+    if(parser.value("threads").toInt() > 0)
+        config.threads = parser.value("threads").toInt();
+    if(parser.value("timeout").toInt() > 0)
+        config.timeout = parser.value("timeout").toInt();
+    if(parser.value("connections").toInt() > 0)
+        config.connections = parser.value("connections").toInt();
+    if(parser.value("pipeline").toInt() > 0)
+        config.pipeline = parser.value("pipeline").toInt();
+    if(parser.isSet("helo"))
+        config.helo = parser.value("helo");
+    if(parser.isSet("sender"))
+        config.sender = parser.value("sender");
+    config.mailExchanger = parser.value("mx");
+    config.port = static_cast<quint16>(parser.value("port").toUInt());
+    if(config.port == 0){
+        QTextStream(stderr) << "invalid port " << parser.value("port") << endl;
+        return 1;
+    }
+
+    /* the mock's people, a mailbox for the first pattern of each & a catch-all domain */
+    QSet<QString> mailboxes, catchAllDomains;
+    int mockPeople = parser.value("mock").toInt();
+    if(parser.isSet("mock")){
+        if(mockPeople < 1){
+            QTextStream(stderr) << "invalid mock size" << endl;
+            return 1;
+        }
+        int mockDomains = qMax(1, mockPeople/MOCK_PEOPLE);
+        for(int i = 0; i < mockPeople; i++){
+            QString domain = QString("mail%1.bench.test").arg(i%mockDomains);
+            addresses.append(email::permutations(QString("first%1 last%1").arg(i), patterns.isEmpty()? email::commonPatterns() : patterns, domain));
+            mailboxes.insert(QString("first%1.last%1@%2").arg(i).arg(domain));
+        }
+        if(mockDomains > 1)
+            catchAllDomains.insert("mail0.bench.test");
+    }
+
+    /* the names of each domain, their candidates are of the domain's patterns */
+    email::Discovery discovery;
+    foreach(const QString &domain, domains){
+        QString normalized = s3s_Hostname::normalize(domain);
+        if(normalized.isNull()){
+            QTextStream(stderr) << "invalid domain " << domain << endl;
+            return 1;
+        }
+        discovery.names[normalized].append(names);
+    }
+
+    if(parser.isSet("discover")){
+        if(parser.isSet("generate") || parser.isSet("mock")){
+            QTextStream(stderr) << "--discover can not be used with --generate or --mock" << endl;
+            return 1;
+        }
+        if(discovery.names.isEmpty()){
+            QTextStream(stderr) << "no domains to discover, use --domain" << endl;
+            return 1;
+        }
+    }else{
+        addresses.append(email::candidates(discovery, patterns));
+        discovery = email::Discovery();
+    }
+    if(addresses.isEmpty() && discovery.names.isEmpty()){
+        QTextStream(stderr) << "no addresses, use --name & --domain, --email or --mock" << endl;
+        return 1;
+    }
+
+    if(parser.isSet("generate")){
+        QTextStream out(stdout);
+        foreach(const QString &address, addresses)
+            out << address << "\n";
+        return 0;
+    }
+
+    /* the nameservers of the dns engine, like the scan's mx lookups */
+    foreach(const QString &nameserver, nameservers)
+        config.nameservers.enqueue(nameserver);
+    if(config.nameservers.isEmpty())
+        config.nameservers = Config::nameservers("nameservers_dns");
+    if(config.nameservers.isEmpty())
+        config.nameservers.enqueue("8.8.8.8");
+
+    /* the mock smtp server is served on its own thread */
+    QThread mockThread;
+    bench::SmtpStub mock(mailboxes, catchAllDomains);
+    if(parser.isSet("mock")){
+        mock.moveToThread(&mockThread);
+        mockThread.start();
+        QMetaObject::invokeMethod(&mock, "start", Qt::BlockingQueuedConnection);
+        if(!mock.error.isEmpty()){
+            QTextStream(stderr) << mock.error << endl;
+            mockThread.quit();
+            mockThread.wait();
+            return 1;
+        }
+        config.mailExchanger = "127.0.0.1";
+        config.port = mock.serverPort();
+    }
+
+    int code;
+    {
+        cli::EmailVerify verify(config, addresses);
+        verify.setDiscovery(discovery, patterns);
+        QObject::connect(&verify, &cli::EmailVerify::finished, &app, &QCoreApplication::quit, Qt::QueuedConnection);
+        verify.start();
+        code = app.exec();
+    }
+
+    if(parser.isSet("mock")){
+        QMetaObject::invokeMethod(&mock, "stop", Qt::BlockingQueuedConnection);
+        mockThread.quit();
+        mockThread.wait();
+    }
+    return code;
+}
+
+///
+/// the verification...
+///
+
+cli::EmailVerify::EmailVerify(const email::ScanConfig &config, const QStringList &addresses, QObject *parent): QObject(parent),
+    m_config(config)
+{
+    m_args.config = &m_config;
+    email::group(&m_args, addresses);
+
+    /* the discovery's modules are of the osint engine's configurations */
+    osint::loadConfig(&m_osintConfig, CFG_OSINT);
+
+    m_stdout.open(stdout, QIODevice::WriteOnly);
+
+    connect(&m_executor, &ScanExecutor::finished, this, &cli::EmailVerify::onFinished);
+    connect(&m_flushTimer, &QTimer::timeout, this, &cli::EmailVerify::flush);
+    m_flushTimer.start(FLUSH_INTERVAL);
+}
+cli::EmailVerify::~EmailVerify(){
+    this->flush();
+}
+
+void cli::EmailVerify::setDiscovery(const email::Discovery &discovery, const QStringList &patterns){
+    m_discovery = discovery;
+    m_patterns = patterns;
+}
+
+void cli::EmailVerify::start(){
+    m_timer.start();
+
+    /* the domains' patterns & people are found first, then the candidates of their names are verified */
+    if(!m_discovery.names.isEmpty()){
+        ScanArgs args;
+        args.config = &m_osintConfig;
+        m_discovering = email::discover(&m_executor, args, &m_discovery, this) > 0;
+        if(m_discovering)
+            return;
+        QTextStream(stderr) << "no EmailFormat or Hunter api key, the candidates are of the given patterns" << endl;
+    }
+    this->verify();
+}
+
+void cli::EmailVerify::verify(){
+    email::group(&m_args, email::candidates(m_discovery, m_patterns));
+
+    int threads = ScanExecutor::workers(m_config.threads, m_args.domains.size());
+    for(int i = 0; i < threads; i++)
+    {
+        email::Scanner *scanner = new email::Scanner(&m_args);
+        connect(scanner, &email::Scanner::scanResult, this, &cli::EmailVerify::onResult);
+        connect(scanner, &email::Scanner::scanStatus, this, &cli::EmailVerify::onStatus);
+        connect(scanner, &email::Scanner::scanLog, this, &cli::EmailVerify::onLog);
+        m_executor.start(scanner);
+    }
+}
+
+void cli::EmailVerify::onResult(s3s_struct::Email result){
+    QJsonObject object{{"email", result.email},
+                       {"domain", result.domain},
+                       {"deliverable", result.deliverable},
+                       {"catch_all", result.catchAll},
+                       {"host_exists", result.hostExists}};
+    m_stdout.write(QJsonDocument(object).toJson(QJsonDocument::Compact));
+    m_stdout.write("\n");
+    m_results++;
+}
+
+void cli::EmailVerify::onStatus(const QString &status){
+    QTextStream(stderr) << status << endl;
+}
+
+void cli::EmailVerify::onLog(const scan::Log &log){
+    QTextStream(stderr) << log.target << ": " << log.nameserver << ": " << log.message << endl;
+    m_errors++;
+}
+
+void cli::EmailVerify::onFinished(){
+    if(m_discovering){
+        m_discovering = false;
+        this->verify();
+        return;
+    }
+    this->flush();
+
+    /* the throughput, for the runs against the mock server */
+    qint64 elapsed = qMax<qint64>(1, m_timer.elapsed());
+    QTextStream(stderr) << m_results << " addresses, " << m_errors << " failed in " << elapsed << " ms, "
+                        << (m_results*1000/elapsed) << " addresses/s" << endl;
+    emit finished();
+}
+
+void cli::EmailVerify::flush(){
+    m_stdout.flush();
+}
@@ -0,0 +1,75 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : email verification without the gui, the candidate addresses of people's names are generated
+          from the patterns of their domains & verified on the domains' mail exchangers, the results
+          are written to stdout as newline delimited json. with --mock the addresses are verified
+          on a local smtp server & the throughput is printed.
+
+          usage: sub3suite email --name "Jane Doe" --domain example.com --pattern "{first}.{last}"
+                 sub3suite email --email jane@example.com --email john@example.org
+                 sub3suite email --name "Jane Doe" --domain example.com --discover
+                 sub3suite email --mock 10000 --threads 8
+*/
+
+#ifndef EMAILVERIFY_H
+#define EMAILVERIFY_H
+
+#include <QFile>
+#include <QTimer>
+#include <QObject>
+#include <QElapsedTimer>
+
+#include "src/modules/active/ScanExecutor.h"
+#include "src/modules/active/EmailScanner.h"
+#include "src/modules/passive/AbstractOsintModule.h"
+
+
+namespace cli {
+
+/* parses the command line & runs the verification on a QCoreApplication, returns the exit code */
+int runEmail(int argc, char *argv[]);
+
+class EmailVerify : public QObject {
+    Q_OBJECT
+
+    public:
+        EmailVerify(const email::ScanConfig &config, const QStringList &addresses, QObject *parent = nullptr);
+        ~EmailVerify() override;
+
+        /* the names of each domain, verified with the domains' patterns found by the modules */
+        void setDiscovery(const email::Discovery &discovery, const QStringList &patterns);
+
+        void start();
+
+    signals:
+        void finished();
+
+    private slots:
+        void onResult(s3s_struct::Email result);
+        void onStatus(const QString &status);
+        void onLog(const scan::Log &log);
+        void onFinished();
+        void flush();
+
+    private:
+        email::ScanConfig m_config;
+        email::ScanArgs m_args;
+        email::Discovery m_discovery;
+        QStringList m_patterns;
+        ScanConfig m_osintConfig;
+        bool m_discovering = false;
+        ScanExecutor m_executor; // after the args, its workers end before the args are destroyed
+        QFile m_stdout;
+        QTimer m_flushTimer;
+        QElapsedTimer m_timer;
+        qint64 m_results = 0;
+        qint64 m_errors = 0;
+
+        void verify();
+};
+
+}
+
+#endif // EMAILVERIFY_H
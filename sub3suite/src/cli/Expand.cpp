@@ -0,0 +1,208 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : asn expansion, the announced prefixes of asns are aggregated into the smallest set of
+          cidr ranges & their addresses are swept lazily by a ptr, port or ssl scan.
+*/
+
+#include "Expand.h"
+#include "src/utils/CidrIterator.h"
+
+#include <QMap>
+#include <QTextStream>
+#include <QJsonDocument>
+#include <QCoreApplication>
+
+/* milliseconds between flushes of the results to stdout */
+#define FLUSH_INTERVAL 250
+
+/* lookups or connections of the sweep at once, by default */
+#define EXPAND_CONCURRENCY 256
+
+
+static const QMap<QString, cli::ENGINE> sweeps = {
+    {"ptr", cli::ENGINE::PTR}, {"port", cli::ENGINE::PORT}, {"ssl", cli::ENGINE::SSL}
+};
+
+int cli::runExpand(int argc, char *argv[]){
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Expands asns to their announced prefixes & sweeps the prefixes' addresses without "
+                                     "the gui. the prefixes are aggregated first, overlapping & adjacent prefixes are "
+                                     "swept once. the results are written to stdout as newline delimited json with "
+                                     "their stage.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("expand", "runs an asn expansion.");
+    parser.addOptions({
+        {"target", "an asn eg. AS13335 or 13335, can be repeated.", "asn"},
+        {"targets", "file with the asns.", "file"},
+        {"module", "osint modules for the asns' prefixes, comma separated or repeated.", "modules", "bgpview"},
+        {"sweep", "sweep of the prefixes' addresses, ptr, port or ssl.", "sweep", "ptr"},
+        {"ports", "port sweep, ports to scan, comma separated & ranges eg. 80,443,8000-8080.", "ports", "80,443"},
+        {"port", "ssl sweep, ssl port, https, ftp, ftps, ssh, smtp, imap or pop.", "port", "https"},
+        {"sample-rate", "the fraction of each prefix's addresses swept eg. 0.1 for every tenth address.", "rate", "1"},
+        {"concurrency", "lookups or connections of the sweep at once.", "number", QString::number(EXPAND_CONCURRENCY)},
+        {"nameserver", "a nameserver, can be repeated.", "ip"},
+        {"nameservers", "file with the nameservers.", "file"},
+        {"timeout", "timeout in milliseconds, the configured timeout by default.", "ms"}
+    });
+    parser.process(app);
+
+    cli::Options options;
+    QStringList asns;
+    if(!cli::readList(parser, "target", "targets", asns) ||
+       !cli::readList(parser, "nameserver", "nameservers", options.nameservers) ||
+       !cli::readList(parser, "module", QString(), options.modules))
+        return 1;
+
+    /* the modules take the asn's number */
+    foreach(QString asn, asns){
+        asn = asn.trimmed();
+        if(asn.startsWith("as", Qt::CaseInsensitive))
+            asn.remove(0, 2);
+        if(!asn.isEmpty())
+            options.targets.append(asn);
+    }
+    if(options.targets.isEmpty()){
+        QTextStream(stderr) << "no asns, use --target or --targets" << endl;
+        return 1;
+    }
+
+    QString sweep = parser.value("sweep").toLower();
+    if(!sweeps.contains(sweep)){
+        QTextStream(stderr) << "unknown sweep " << sweep << endl;
+        return 1;
+    }
+    options.engine = sweeps.value(sweep);
+
+    if(!cli::readPorts(parser.value("ports"), options.ports)){
+        QTextStream(stderr) << "invalid ports " << parser.value("ports") << endl;
+        return 1;
+    }
+    if(!cli::readSampleRate(parser.value("sample-rate"), options.stride)){
+        QTextStream(stderr) << "invalid sample rate " << parser.value("sample-rate") << ", a fraction between 0 & 1" << endl;
+        return 1;
+    }
+    int concurrency = parser.value("concurrency").toInt();
+    if(concurrency < 1){
+        QTextStream(stderr) << "invalid concurrency " << parser.value("concurrency") << endl;
+        return 1;
+    }
+    options.port = parser.value("port").toLower();
+    options.timeout = parser.value("timeout").toInt();
+
+    cli::Expand expand(options, concurrency);
+    QObject::connect(&expand, &cli::Expand::finished, &app, &QCoreApplication::quit, Qt::QueuedConnection);
+    if(!expand.start())
+        return 1;
+
+    return app.exec();
+}
+
+///
+/// the expansion...
+///
+
+cli::Expand::Expand(const cli::Options &options, int concurrency, QObject *parent): QObject(parent),
+    m_options(options),
+    m_concurrency(concurrency)
+{
+    m_stdout.open(stdout, QIODevice::WriteOnly);
+    connect(&m_flushTimer, &QTimer::timeout, this, &cli::Expand::flush);
+    m_flushTimer.start(FLUSH_INTERVAL);
+}
+cli::Expand::~Expand(){
+    this->flush();
+}
+
+bool cli::Expand::start(){
+    /* the asns' announced prefixes */
+    cli::Options options = m_options;
+    options.engine = cli::ENGINE::OSINT;
+    options.input = "asn";
+    options.output = "cidr";
+    options.print = false;
+
+    m_prefixes = new cli::ScanRunner(options, this);
+    connect(m_prefixes, &cli::ScanRunner::result, this, [=](const QJsonObject &object){
+        m_cidrs.append(object.value("cidr").toString());
+    });
+    connect(m_prefixes, &cli::ScanRunner::finished, this, &cli::Expand::onPrefixesEnded, Qt::QueuedConnection);
+
+    return m_prefixes->start();
+}
+
+void cli::Expand::onPrefixesEnded(){
+    /*
+     * the sweep starts once all the prefixes are in, overlapping prefixes of the asns & the
+     * more specific prefixes announced next to their covering prefix are then swept once.
+     */
+    QStringList targets;
+    foreach(const QString &cidr, s3s_CidrIterator::aggregate(m_cidrs))
+    {
+        int length = cidr.section('/', 1).toInt();
+        int hostBits = (cidr.contains(':')? 128 : 32) - length;
+        if(hostBits > CIDR_MAX_HOST_BITS){
+            QTextStream(stderr) << "skipped " << cidr << ", larger than 2^" << CIDR_MAX_HOST_BITS << " addresses" << endl;
+            continue;
+        }
+        targets.append(cidr);
+        this->write("prefix", QJsonObject{{"cidr", cidr}});
+    }
+    this->flush();
+
+    if(targets.isEmpty()){
+        QTextStream(stderr) << "no prefixes to sweep" << endl;
+        emit finished();
+        return;
+    }
+
+    cli::Options options = m_options;
+    options.targets = targets;
+    options.print = false;
+
+    /*
+     * the concurrency budget, a ptr thread keeps a number of lookups in flight while a port or
+     * an ssl thread connects to one address at a time.
+     */
+    if(options.engine == cli::ENGINE::PTR){
+        active::ScanConfig config;
+        active::loadConfig(&config);
+
+        options.inflight = qBound(1, config.inflight, m_concurrency);
+        options.threads = m_concurrency / options.inflight;
+    }
+    else
+        options.threads = m_concurrency;
+
+    QString stage = sweeps.key(options.engine);
+    m_sweep = new cli::ScanRunner(options, this);
+    connect(m_sweep, &cli::ScanRunner::result, this, [=](const QJsonObject &object){
+        this->write(stage, object);
+    });
+    connect(m_sweep, &cli::ScanRunner::finished, this, &cli::Expand::onSweepEnded, Qt::QueuedConnection);
+
+    if(!m_sweep->start())
+        emit finished();
+}
+
+void cli::Expand::onSweepEnded(){
+    this->flush();
+    emit finished();
+}
+
+///
+/// output...
+///
+
+void cli::Expand::write(const QString &stage, QJsonObject object){
+    object.insert("stage", stage);
+    m_stdout.write(QJsonDocument(object).toJson(QJsonDocument::Compact));
+    m_stdout.write("\n");
+}
+
+void cli::Expand::flush(){
+    m_stdout.flush();
+}
@@ -0,0 +1,59 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : asn expansion, the announced prefixes of asns are aggregated into the smallest set of
+          cidr ranges & their addresses are swept lazily by a ptr, port or ssl scan. the sweep is
+          bounded by a budget of concurrent lookups or connections & a sampling rate of each range.
+
+          usage: sub3suite expand --target AS13335 --sweep ptr --sample-rate 0.1 --concurrency 256
+*/
+
+#ifndef EXPAND_H
+#define EXPAND_H
+
+#include <QFile>
+#include <QTimer>
+#include <QObject>
+
+#include "ScanRunner.h"
+
+
+namespace cli {
+
+/* parses the command line & runs the expansion on a QCoreApplication, returns the exit code */
+int runExpand(int argc, char *argv[]);
+
+class Expand : public QObject {
+    Q_OBJECT
+
+    public:
+        Expand(const cli::Options &options, int concurrency, QObject *parent = nullptr);
+        ~Expand() override;
+
+        /* starts the prefixes' lookup, returns false with an error on stderr if it could not */
+        bool start();
+
+    signals:
+        void finished();
+
+    private slots:
+        void onPrefixesEnded();
+        void onSweepEnded();
+        void flush();
+
+    private:
+        cli::Options m_options; // the sweep's options
+        cli::ScanRunner *m_prefixes = nullptr;
+        cli::ScanRunner *m_sweep = nullptr;
+        QStringList m_cidrs; // the announced prefixes
+        QFile m_stdout;
+        QTimer m_flushTimer;
+        int m_concurrency;
+
+        void write(const QString &stage, QJsonObject object);
+};
+
+}
+
+#endif // EXPAND_H
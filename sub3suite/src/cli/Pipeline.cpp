@@ -0,0 +1,339 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : scan pipelines, the engines' scans run together as one flow connected by bounded streaming
+          queues. passive & bruteforced subdomains are resolved, the resolved hosts are sent to the
+          dns, ssl & url stages as they arrive & the certificates' names are fed back to the resolve stage.
+*/
+
+#include "Pipeline.h"
+
+#include <QTextStream>
+#include <QJsonDocument>
+#include <QCoreApplication>
+
+/* milliseconds between flushes of the results to stdout */
+#define FLUSH_INTERVAL 250
+
+
+static const QMap<QString, cli::STAGE> stageNames = {
+    {"osint", cli::STAGE::OSINT}, {"brute", cli::STAGE::BRUTE}, {"resolve", cli::STAGE::RESOLVE},
+    {"dns", cli::STAGE::DNS}, {"ssl", cli::STAGE::SSL}, {"url", cli::STAGE::URL}
+};
+
+int cli::runPipeline(int argc, char *argv[]){
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Runs the engines' scans as one pipeline without the gui, each stage starts on "
+                                     "the previous stages' results as they arrive. the results are written to stdout "
+                                     "as newline delimited json with their stage.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("pipeline", "runs a pipeline.");
+    parser.addOptions({
+        {"target", "a target domain, can be repeated.", "target"},
+        {"targets", "file with the target domains.", "file"},
+        {"stages", "stages, comma separated, osint, brute, resolve, dns, ssl & url. by default all the stages, "
+                   "osint with --module & brute with --wordlist.", "stages"},
+        {"module", "osint modules, comma separated or repeated.", "modules"},
+        {"wordlist", "file with the brute wordlist.", "file"},
+        {"nameserver", "a nameserver, can be repeated.", "ip"},
+        {"nameservers", "file with the nameservers.", "file"},
+        {"records", "dns record types, comma separated eg. a,aaaa,mx,ns,txt,cname.", "types", "a,aaaa"},
+        {"capacity", "targets a stage's queue holds before the stages feeding it wait.", "number", QString::number(STREAM_CAPACITY)},
+        {"threads", "number of threads of each stage, the configured number by default.", "number"},
+        {"timeout", "timeout in milliseconds, the configured timeout by default.", "ms"},
+        {"wildcard", "filter out the wildcard answers, brute."}
+    });
+    parser.process(app);
+
+    cli::Options options;
+    if(!cli::readList(parser, "target", "targets", options.targets) ||
+       !cli::readList(parser, QString(), "wordlist", options.wordlist) ||
+       !cli::readList(parser, "nameserver", "nameservers", options.nameservers) ||
+       !cli::readList(parser, "module", QString(), options.modules))
+        return 1;
+
+    if(options.targets.isEmpty()){
+        QTextStream(stderr) << "no targets, use --target or --targets" << endl;
+        return 1;
+    }
+
+    options.records = parser.value("records").toLower().split(',', QString::SkipEmptyParts);
+    options.threads = parser.value("threads").toInt();
+    options.timeout = parser.value("timeout").toInt();
+    options.wildcard = parser.isSet("wildcard");
+
+    /* the dns scanner counts an "any" lookup & the other record types' lookups as separate targets */
+    if(options.records.contains("any") && options.records.size() > 1){
+        QTextStream(stderr) << "the any record type can not be combined with other record types" << endl;
+        return 1;
+    }
+    if(options.records.contains("srv")){
+        QTextStream(stderr) << "the srv record type is not supported in a pipeline" << endl;
+        return 1;
+    }
+
+    /* stages */
+    QList<cli::STAGE> stages;
+    if(parser.isSet("stages")){
+        foreach(const QString &name, parser.value("stages").toLower().split(',', QString::SkipEmptyParts)){
+            if(!stageNames.contains(name.trimmed())){
+                QTextStream(stderr) << "unknown stage " << name << endl;
+                return 1;
+            }
+            stages.append(stageNames.value(name.trimmed()));
+        }
+    }
+    else {
+        if(!options.modules.isEmpty())
+            stages.append(cli::STAGE::OSINT);
+        if(!options.wordlist.isEmpty())
+            stages.append(cli::STAGE::BRUTE);
+        stages << cli::STAGE::RESOLVE << cli::STAGE::DNS << cli::STAGE::SSL << cli::STAGE::URL;
+    }
+
+    cli::Pipeline pipeline(options, stages, parser.value("capacity").toInt());
+    QObject::connect(&pipeline, &cli::Pipeline::finished, &app, &QCoreApplication::quit, Qt::QueuedConnection);
+    if(!pipeline.start())
+        return 1;
+
+    return app.exec();
+}
+
+///
+/// the pipeline...
+///
+
+cli::Pipeline::Pipeline(const cli::Options &options, const QList<cli::STAGE> &stages, int capacity, QObject *parent):
+    QObject(parent),
+    m_options(options)
+{
+    m_stdout.open(stdout, QIODevice::WriteOnly);
+    connect(&m_flushTimer, &QTimer::timeout, this, &cli::Pipeline::flush);
+    m_flushTimer.start(FLUSH_INTERVAL);
+
+    foreach(const cli::STAGE &stage, stages)
+    {
+        if(m_stages.contains(stage))
+            continue;
+
+        cli::Options stageOptions = m_options;
+        stageOptions.print = false;
+
+        Stage s;
+        switch(stage){
+        case cli::STAGE::OSINT:
+            stageOptions.engine = cli::ENGINE::OSINT;
+            stageOptions.input = "domain";
+            stageOptions.output = "subdomain";
+            break;
+        case cli::STAGE::BRUTE:
+            stageOptions.engine = cli::ENGINE::BRUTE;
+            stageOptions.output = "subdomain";
+            break;
+        case cli::STAGE::RESOLVE:
+            stageOptions.engine = cli::ENGINE::ACTIVE;
+            break;
+        case cli::STAGE::DNS:
+            stageOptions.engine = cli::ENGINE::DNS;
+            break;
+        case cli::STAGE::SSL:
+            stageOptions.engine = cli::ENGINE::SSL;
+            stageOptions.port = "https";
+            stageOptions.output = "subdomain";
+            break;
+        case cli::STAGE::URL:
+            stageOptions.engine = cli::ENGINE::URL;
+            break;
+        }
+
+        /* the stages after the sources take their targets from their queues only */
+        if(stage != cli::STAGE::OSINT && stage != cli::STAGE::BRUTE){
+            s.queue = new s3s_StreamQueue(capacity);
+            stageOptions.targets.clear();
+            stageOptions.stream = s.queue;
+        }
+        s.runner = new cli::ScanRunner(stageOptions, this);
+        m_stages.insert(stage, s);
+
+        connect(s.runner, &cli::ScanRunner::result, this, [=](const QJsonObject &object){
+            this->write(stage, object);
+
+            switch(stage){
+            case cli::STAGE::OSINT:
+                this->onName(object.value("subdomain").toString());
+                break;
+            case cli::STAGE::BRUTE:
+            case cli::STAGE::RESOLVE:
+                this->onHost(object.value("host").toString());
+                break;
+            case cli::STAGE::SSL:
+                /* the certificates' names are resolved in turn, if they are names of the targets */
+                if(this->inScope(object.value("subdomain").toString()))
+                    this->onName(object.value("subdomain").toString());
+                break;
+            default:
+                break;
+            }
+        });
+        connect(s.runner, &cli::ScanRunner::targetDone, this, &cli::Pipeline::onTargetDone);
+        connect(s.runner, &cli::ScanRunner::finished, this, [=](){
+            if(!s.queue)
+                m_sources--;
+            this->onStageFinished();
+        });
+    }
+
+    /*
+     * backpressure, the resolve stage waits while a stage it feeds is full. the certificates' names
+     * fed back to the resolve stage do not throttle the ssl stage, the two would wait on each other.
+     */
+    QList<s3s_StreamQueue*> hosts;
+    foreach(const cli::STAGE &stage, QList<cli::STAGE>{cli::STAGE::DNS, cli::STAGE::SSL, cli::STAGE::URL}){
+        if(m_stages.contains(stage))
+            hosts.append(m_stages.value(stage).queue);
+    }
+    if(m_stages.contains(cli::STAGE::RESOLVE)){
+        s3s_StreamQueue *resolve = m_stages.value(cli::STAGE::RESOLVE).queue;
+        foreach(s3s_StreamQueue *queue, hosts)
+            resolve->addDownstream(queue);
+    }
+
+    /*
+     * the brute source waits while a queue its resolved hosts go to is full, they skip the resolve stage
+     * for the dns, ssl & url stages. the osint modules' results come in the apis' replies & can not be
+     * held back, their pushes can go over a queue's capacity.
+     */
+    if(m_stages.contains(cli::STAGE::BRUTE))
+        m_stages.value(cli::STAGE::BRUTE).runner->setDownstream(hosts);
+}
+cli::Pipeline::~Pipeline(){
+    this->flush();
+
+    foreach(const Stage &stage, m_stages){
+        delete stage.runner;
+        delete stage.queue;
+    }
+}
+
+bool cli::Pipeline::start(){
+    if(m_stages.isEmpty()){
+        QTextStream(stderr) << "no stages" << endl;
+        return false;
+    }
+
+    /* the targets are the first names */
+    foreach(const QString &target, m_options.targets)
+        this->onName(target);
+
+    /* the streamed stages first, so they are waiting when the sources' results arrive */
+    QList<cli::STAGE> order{cli::STAGE::RESOLVE, cli::STAGE::DNS, cli::STAGE::SSL, cli::STAGE::URL,
+                            cli::STAGE::BRUTE, cli::STAGE::OSINT};
+    foreach(const cli::STAGE &stage, order)
+    {
+        if(!m_stages.contains(stage))
+            continue;
+        if(!m_stages.value(stage).runner->start())
+            return false;
+
+        m_running++;
+        if(!m_stages.value(stage).queue)
+            m_sources++;
+    }
+
+    this->closeIfDone();
+    return true;
+}
+
+///
+/// routing...
+///
+
+void cli::Pipeline::onName(const QString &name){
+    QString subdomain = s3s_Hostname::normalize(name);
+    if(subdomain.isNull() || !m_names.insert(subdomain))
+        return;
+
+    if(m_stages.contains(cli::STAGE::RESOLVE))
+        this->push(cli::STAGE::RESOLVE, subdomain);
+    else
+        this->onHost(subdomain);
+}
+
+void cli::Pipeline::onHost(const QString &host){
+    QString hostname = host.trimmed().toLower();
+    if(hostname.isEmpty() || !m_hosts.insert(hostname))
+        return;
+
+    this->push(cli::STAGE::DNS, hostname);
+    this->push(cli::STAGE::SSL, hostname);
+    this->push(cli::STAGE::URL, "https://"+hostname);
+}
+
+void cli::Pipeline::push(cli::STAGE stage, const QString &target){
+    if(m_closed || !m_stages.contains(stage))
+        return;
+
+    m_inFlight++;
+    m_stages.value(stage).queue->push(target);
+}
+
+bool cli::Pipeline::inScope(const QString &name) const {
+    QString subdomain = name.trimmed().toLower();
+    if(subdomain.startsWith("*."))
+        subdomain.remove(0, 2);
+
+    foreach(const QString &target, m_options.targets){
+        QString domain = target.trimmed().toLower();
+        if(subdomain == domain || subdomain.endsWith("."+domain))
+            return true;
+    }
+    return false;
+}
+
+///
+/// completion...
+///
+
+void cli::Pipeline::onTargetDone(){
+    m_inFlight--;
+    this->closeIfDone();
+}
+
+void cli::Pipeline::closeIfDone(){
+    /* nothing more can come once the sources have ended & every pushed target was scanned */
+    if(m_closed || m_sources || m_inFlight > 0)
+        return;
+
+    m_closed = true;
+    foreach(const Stage &stage, m_stages){
+        if(stage.queue)
+            stage.queue->close();
+    }
+}
+
+void cli::Pipeline::onStageFinished(){
+    m_running--;
+    this->closeIfDone();
+    if(m_running)
+        return;
+
+    this->flush();
+    emit finished();
+}
+
+///
+/// output...
+///
+
+void cli::Pipeline::write(cli::STAGE stage, QJsonObject object){
+    object.insert("stage", stageNames.key(stage));
+    m_stdout.write(QJsonDocument(object).toJson(QJsonDocument::Compact));
+    m_stdout.write("\n");
+}
+
+void cli::Pipeline::flush(){
+    m_stdout.flush();
+}
@@ -0,0 +1,84 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : scan pipelines, the engines' scans run together as one flow connected by bounded streaming
+          queues. passive & bruteforced subdomains are resolved, the resolved hosts are sent to the
+          dns, ssl & url stages as they arrive & the certificates' names are fed back to the resolve stage.
+
+          usage: sub3suite pipeline --target example.com --module crtsh,certspotter --wordlist words.txt
+*/
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <QMap>
+#include <QFile>
+#include <QTimer>
+#include <QObject>
+
+#include "ScanRunner.h"
+#include "src/utils/StreamQueue.h"
+
+
+namespace cli {
+
+enum class STAGE {
+    OSINT,   // source, passive subdomains of the targets
+    BRUTE,   // source, bruteforced subdomains of the targets
+    RESOLVE, // subdomains to resolved hosts
+    DNS,     // dns records of the resolved hosts
+    SSL,     // certificates' names of the resolved hosts, fed back to the resolve stage
+    URL      // the resolved hosts' https urls
+};
+
+/* parses the command line & runs the pipeline on a QCoreApplication, returns the exit code */
+int runPipeline(int argc, char *argv[]);
+
+class Pipeline : public QObject {
+    Q_OBJECT
+
+    public:
+        Pipeline(const cli::Options &options, const QList<cli::STAGE> &stages, int capacity, QObject *parent = nullptr);
+        ~Pipeline() override;
+
+        /* starts the stages, returns false with an error on stderr if one could not */
+        bool start();
+
+    signals:
+        void finished();
+
+    private slots:
+        void onStageFinished();
+        void flush();
+
+    private:
+        struct Stage {
+            cli::ScanRunner *runner = nullptr;
+            s3s_StreamQueue *queue = nullptr; // nullptr for the sources
+        };
+        QMap<cli::STAGE, Stage> m_stages;
+        cli::Options m_options;
+        s3s_ResultFilter m_names; // names sent to the resolve stage
+        s3s_ResultFilter m_hosts; // hosts sent to the dns, ssl & url stages
+        QFile m_stdout;
+        QTimer m_flushTimer;
+
+        int m_inFlight = 0; // targets pushed to the stages & not yet scanned
+        int m_sources = 0;  // source stages still running
+        int m_running = 0;  // stages still running
+        bool m_closed = false;
+
+        void onName(const QString &name);
+        void onHost(const QString &host);
+        void push(cli::STAGE stage, const QString &target);
+        void onTargetDone();
+        void closeIfDone();
+
+        bool inScope(const QString &name) const;
+        void write(cli::STAGE stage, QJsonObject object);
+};
+
+}
+
+#endif // PIPELINE_H
@@ -0,0 +1,311 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : headless scan runner, runs the engines' scanners & osint modules without the gui
+          and streams the results to stdout as newline delimited json.
+*/
+
+#include "ScanRunner.h"
+
+#include <cstdio>
+#include <QMap>
+#include <QTextStream>
+#include <QJsonDocument>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+
+/* milliseconds between flushes of the results to stdout */
+#define FLUSH_INTERVAL 250
+
+
+///
+/// reading the list options...
+///
+
+/* reads the non-empty lines of a file, or of stdin for "-" */
+static bool readLines(const QString &path, QStringList &lines){
+    QFile file;
+    bool opened;
+    if(path == "-")
+        opened = file.open(stdin, QIODevice::ReadOnly | QIODevice::Text);
+    else{
+        file.setFileName(path);
+        opened = file.open(QIODevice::ReadOnly | QIODevice::Text);
+    }
+    if(!opened)
+        return false;
+
+    QTextStream in(&file);
+    while(!in.atEnd()){
+        QString line = in.readLine().trimmed();
+        if(!line.isEmpty() && !line.startsWith('#'))
+            lines.append(line);
+    }
+    return true;
+}
+
+bool cli::readList(const QCommandLineParser &parser, const QString &valueOption, const QString &fileOption,
+                     QStringList &list)
+{
+    if(!valueOption.isEmpty()){
+        foreach(const QString &value, parser.values(valueOption))
+            list.append(value.split(',', QString::SkipEmptyParts));
+    }
+
+    if(parser.isSet(fileOption) && !readLines(parser.value(fileOption), list)){
+        QTextStream(stderr) << "cannot read " << parser.value(fileOption) << endl;
+        return false;
+    }
+    return true;
+}
+
+bool cli::readPorts(const QString &value, QList<quint16> &ports){
+    foreach(const QString &part, value.split(',', QString::SkipEmptyParts)){
+        QStringList range = part.split('-');
+        bool okFrom, okTo;
+        uint from = range.first().trimmed().toUInt(&okFrom);
+        uint to = range.last().trimmed().toUInt(&okTo);
+        if(!okFrom || !okTo || range.size() > 2 || from == 0 || to > 65535 || from > to)
+            return false;
+        for(uint port = from; port <= to; port++)
+            ports.append(static_cast<quint16>(port));
+    }
+    return true;
+}
+
+bool cli::readSampleRate(const QString &value, int &stride){
+    bool ok;
+    double rate = value.toDouble(&ok);
+    if(!ok || rate <= 0 || rate > 1)
+        return false;
+
+    stride = qMax(1, qRound(1/rate));
+    return true;
+}
+
+int cli::run(int argc, char *argv[]){
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Runs a sub3suite scan without the gui, the results are written to stdout "
+                                     "as newline delimited json. list files are read from stdin with \"-\".");
+    parser.addHelpOption();
+    parser.addPositionalArgument("scan", "runs a scan.");
+    parser.addOptions({
+        {"engine", "brute, active, port, ptr, dns, ssl, url or osint.", "engine", "brute"},
+        {"target", "a target, can be repeated. ptr: an address or a cidr range. port & ssl: also cidr ranges.", "target"},
+        {"targets", "file with the targets.", "file"},
+        {"wordlist", "file with the wordlist, for brute & the dns srv records.", "file"},
+        {"nameserver", "a nameserver, can be repeated.", "ip"},
+        {"nameservers", "file with the nameservers.", "file"},
+        {"module", "osint modules, comma separated or repeated.", "modules"},
+        {"records", "dns record types, comma separated eg. a,aaaa,mx,ns,txt,cname,srv,any.", "types", "a,aaaa"},
+        {"scope", "osint: a scope pattern, example.com for the apex & its subdomains or *.example.com for the "
+                  "subdomains only, can be repeated. the domain targets by default.", "pattern"},
+        {"scopes", "file with the scope patterns.", "file"},
+        {"input", "osint input type, domain, ip, email, url, asn, cert, cidr or query.", "type", "domain"},
+        {"output", "brute: subdomain or tld. osint: subdomain, subdomainip, ip, email, url, asn, cert or cidr. "
+                   "ssl: subdomain, sha1, sha256.", "type"},
+        {"port", "ssl port, https, ftp, ftps, ssh, smtp, imap or pop.", "port", "https"},
+        {"ports", "ports to scan, comma separated & ranges eg. 80,443,8000-8080.", "ports", "80,443,21,990,22,25,465,587,2525"},
+        {"threads", "number of threads, the configured number by default.", "number"},
+        {"timeout", "timeout in milliseconds, the configured timeout by default.", "ms"},
+        {"sample-rate", "ptr, port & ssl: the fraction of each cidr range's addresses scanned eg. 0.1 for every "
+                        "tenth address.", "rate", "1"},
+        {"wildcard", "filter out the wildcard answers, brute."},
+        {"recursive", "scan the resolved subdomains as new targets, brute."},
+        {"list-modules", "lists the osint modules."}
+    });
+    parser.process(app);
+
+    if(parser.isSet("list-modules")){
+        QTextStream out(stdout);
+        foreach(const QString &module, cli::osintModules())
+            out << module << endl;
+        return 0;
+    }
+
+    cli::Options options;
+
+    static const QMap<QString, cli::ENGINE> engines = {
+        {"brute", cli::ENGINE::BRUTE}, {"active", cli::ENGINE::ACTIVE}, {"port", cli::ENGINE::PORT}, {"ptr", cli::ENGINE::PTR},
+        {"dns", cli::ENGINE::DNS},
+        {"ssl", cli::ENGINE::SSL}, {"url", cli::ENGINE::URL}, {"osint", cli::ENGINE::OSINT}
+    };
+    QString engine = parser.value("engine").toLower();
+    if(!engines.contains(engine)){
+        QTextStream(stderr) << "unknown engine " << engine << endl;
+        return 1;
+    }
+    options.engine = engines.value(engine);
+
+    if(!cli::readList(parser, "target", "targets", options.targets) ||
+       !cli::readList(parser, QString(), "wordlist", options.wordlist) ||
+       !cli::readList(parser, "nameserver", "nameservers", options.nameservers) ||
+       !cli::readList(parser, "module", QString(), options.modules) ||
+       !cli::readList(parser, "scope", "scopes", options.scope))
+        return 1;
+
+    options.records = parser.value("records").toLower().split(',', QString::SkipEmptyParts);
+    options.input = parser.value("input").toLower();
+    options.output = parser.value("output").toLower();
+    options.port = parser.value("port").toLower();
+    if(!cli::readPorts(parser.value("ports"), options.ports)){
+        QTextStream(stderr) << "invalid ports " << parser.value("ports") << endl;
+        return 1;
+    }
+    if(!cli::readSampleRate(parser.value("sample-rate"), options.stride)){
+        QTextStream(stderr) << "invalid sample rate " << parser.value("sample-rate") << ", a fraction between 0 & 1" << endl;
+        return 1;
+    }
+    options.threads = parser.value("threads").toInt();
+    options.timeout = parser.value("timeout").toInt();
+    options.wildcard = parser.isSet("wildcard");
+    options.recursive = parser.isSet("recursive");
+
+    if(options.targets.isEmpty()){
+        QTextStream(stderr) << "no targets, use --target or --targets" << endl;
+        return 1;
+    }
+
+    cli::ScanRunner runner(options);
+    QObject::connect(&runner, &cli::ScanRunner::finished, &app, &QCoreApplication::quit, Qt::QueuedConnection);
+    if(!runner.start())
+        return 1;
+
+    return app.exec();
+}
+
+///
+/// the scan runner...
+///
+
+cli::ScanRunner::ScanRunner(const cli::Options &options, QObject *parent): QObject(parent),
+    m_options(options),
+    m_executor(new ScanExecutor)
+{
+    m_stdout.open(stdout, QIODevice::WriteOnly);
+    m_stderr.open(stderr, QIODevice::WriteOnly);
+
+    connect(m_executor, &ScanExecutor::finished, this, &cli::ScanRunner::onScanEnded);
+
+    /* results are buffered & flushed periodically, not on every line */
+    connect(&m_flushTimer, &QTimer::timeout, this, &cli::ScanRunner::flush);
+    m_flushTimer.start(FLUSH_INTERVAL);
+}
+cli::ScanRunner::~ScanRunner(){
+    this->flush();
+    delete m_executor;
+
+    if(m_bruteArgs){
+        delete m_bruteArgs->config;
+        delete m_bruteArgs->filter;
+        delete m_bruteArgs;
+    }
+    if(m_activeArgs){
+        delete m_activeArgs->config;
+        delete m_activeArgs;
+    }
+    if(m_dnsArgs){
+        delete m_dnsArgs->config;
+        delete m_dnsArgs;
+    }
+    if(m_sslArgs){
+        delete m_sslArgs->config;
+        delete m_sslArgs;
+    }
+    if(m_urlArgs){
+        delete m_urlArgs->config;
+        delete m_urlArgs;
+    }
+    if(m_osintArgs){
+        delete m_osintArgs->config;
+        delete m_osintArgs;
+    }
+}
+
+bool cli::ScanRunner::start(){
+    switch(m_options.engine){
+    case cli::ENGINE::BRUTE:
+        return this->startBrute();
+    case cli::ENGINE::ACTIVE:
+        return this->startActive();
+    case cli::ENGINE::PORT:
+        return this->startPort();
+    case cli::ENGINE::PTR:
+        return this->startPtr();
+    case cli::ENGINE::DNS:
+        return this->startDns();
+    case cli::ENGINE::SSL:
+        return this->startSsl();
+    case cli::ENGINE::URL:
+        return this->startUrl();
+    case cli::ENGINE::OSINT:
+        return this->startOsint();
+    }
+    return false;
+}
+
+void cli::ScanRunner::onScanEnded(){
+    this->flush();
+    emit finished();
+}
+
+void cli::ScanRunner::overrideNameservers(QQueue<QString> &nameservers) const {
+    if(!m_options.nameservers.isEmpty()){
+        nameservers.clear();
+        foreach(const QString &nameserver, m_options.nameservers)
+            nameservers.enqueue(nameserver);
+    }
+    if(nameservers.isEmpty())
+        nameservers.enqueue("8.8.8.8");
+}
+
+///
+/// output...
+///
+
+void cli::ScanRunner::write(const QJsonObject &object){
+    emit result(object);
+    if(!m_options.print)
+        return;
+
+    m_stdout.write(QJsonDocument(object).toJson(QJsonDocument::Compact));
+    m_stdout.write("\n");
+}
+
+void cli::ScanRunner::error(const QString &message){
+    m_stderr.write(message.toUtf8());
+    m_stderr.write("\n");
+    m_stderr.flush();
+}
+
+void cli::ScanRunner::flush(){
+    m_stdout.flush();
+}
+
+void cli::ScanRunner::onScanLog(scan::Log log){
+    QJsonObject object;
+    object.insert("error", log.message);
+    object.insert("target", log.target);
+    if(!log.nameserver.isEmpty())
+        object.insert("nameserver", log.nameserver);
+
+    m_stderr.write(QJsonDocument(object).toJson(QJsonDocument::Compact));
+    m_stderr.write("\n");
+}
+
+void cli::ScanRunner::onOsintLog(ScanLog log){
+    if(!log.error)
+        return;
+
+    QJsonObject object;
+    object.insert("error", log.message);
+    object.insert("target", log.target);
+    object.insert("module", log.moduleName);
+    object.insert("status_code", log.statusCode);
+
+    m_stderr.write(QJsonDocument(object).toJson(QJsonDocument::Compact));
+    m_stderr.write("\n");
+}
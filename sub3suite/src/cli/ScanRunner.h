@@ -0,0 +1,159 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : headless scan runner, runs the engines' scanners & osint modules without the gui
+          and streams the results to stdout as newline delimited json.
+
+          usage: sub3suite scan --engine brute --targets targets.txt --wordlist words.txt
+*/
+
+#ifndef SCANRUNNER_H
+#define SCANRUNNER_H
+
+#include <QFile>
+#include <QTimer>
+#include <QObject>
+#include <QJsonObject>
+#include <QStringList>
+#include <QCommandLineParser>
+
+#include "src/utils/ResultFilter.h"
+#include "src/utils/Hostname.h"
+#include "src/modules/active/BruteScanner.h"
+#include "src/modules/active/ActiveScanner.h"
+#include "src/modules/active/DNSScanner.h"
+#include "src/modules/active/SSLScanner.h"
+#include "src/modules/active/URLScanner.h"
+#include "src/modules/active/ScanExecutor.h"
+#include "src/modules/passive/AbstractOsintModule.h"
+
+
+namespace cli {
+
+enum class ENGINE {
+    BRUTE,
+    ACTIVE,
+    PORT,
+    PTR,
+    DNS,
+    SSL,
+    URL,
+    OSINT
+};
+
+struct Options { // scan options from the command line
+    cli::ENGINE engine = cli::ENGINE::BRUTE;
+    QStringList targets;
+    QStringList wordlist;
+    QStringList nameservers;
+    QStringList modules;    // osint modules
+    QStringList records;    // dns record types
+    QStringList scope;      // osint scope patterns, the domain targets if none
+    QString input;          // osint input type
+    QString output;         // brute & osint output type
+    QString port;           // ssl port
+    QList<quint16> ports;   // port scan ports
+    int threads = 0;        // 0 for the configured value
+    int timeout = 0;        // 0 for the configured value
+    int inflight = 0;       // ptr lookups in flight on each thread, 0 for the configured value
+    int stride = 1;         // every stride-th address of the swept ranges, ptr, port & ssl
+    bool wildcard = false;
+    bool recursive = false;
+    bool print = true;      // write the results to stdout
+    s3s_StreamQueue *stream = nullptr; // targets streamed from a pipeline's stage, active, dns, ssl & url
+    QList<s3s_StreamQueue*> downstream; // a pipeline's queues fed by the results, brute waits while one is full
+};
+
+/* parses the command line & runs the scan on a QCoreApplication, returns the exit code */
+int run(int argc, char *argv[]);
+
+/* a list from a repeatable value option & a file option, "-" reads the file from stdin */
+bool readList(const QCommandLineParser &parser, const QString &valueOption, const QString &fileOption,
+              QStringList &list);
+
+/* ports from a list of ports & port ranges eg. 80,443,8000-8080 */
+bool readPorts(const QString &value, QList<quint16> &ports);
+
+/* the stride of a sampling rate between 0 & 1, a rate of 0.1 takes every tenth address */
+bool readSampleRate(const QString &value, int &stride);
+
+/* names of the osint modules available to the cli */
+QStringList osintModules();
+AbstractOsintModule *osintModule(const QString &name, const ScanArgs &args);
+
+class ScanRunner : public QObject {
+    Q_OBJECT
+
+    public:
+        explicit ScanRunner(const cli::Options &options, QObject *parent = nullptr);
+        ~ScanRunner() override;
+
+        /* starts the scan, returns false with an error on stderr if it could not */
+        bool start();
+
+        /* the queues fed by the results, set before the scan starts */
+        void setDownstream(const QList<s3s_StreamQueue*> &queues){ m_options.downstream = queues; }
+
+    signals:
+        void finished();
+        void result(const QJsonObject &object); // each result as written to stdout
+        void targetDone(); // a target was scanned, for the pipelines
+
+    private slots:
+        void onScanEnded();
+        void onScanLog(scan::Log log);
+        void onOsintLog(ScanLog log);
+        void flush();
+
+    private:
+        cli::Options m_options;
+        ScanExecutor *m_executor; // deleted before the args, its workers end before them
+        QFile m_stdout;
+        QFile m_stderr;
+        QTimer m_flushTimer;
+        s3s_ResultFilter m_filter;
+        s3s_Scope m_scope;
+
+        brute::ScanArgs *m_bruteArgs = nullptr;
+        active::ScanArgs *m_activeArgs = nullptr;
+        dns::ScanArgs *m_dnsArgs = nullptr;
+        ssl::ScanArgs *m_sslArgs = nullptr;
+        url::ScanArgs *m_urlArgs = nullptr;
+        ScanArgs *m_osintArgs = nullptr;
+
+        bool startBrute();
+        bool startActive();
+        bool startPort();
+        bool startPtr();
+        bool startDns();
+        bool startSsl();
+        bool startUrl();
+        bool startOsint();
+
+        void initActiveArgs(); // shared by the active & the port scans
+
+        /* the command line's timeout & threads over the engine's configurations */
+        template<typename EngineConfig>
+        void overrideConfig(EngineConfig *config){
+            if(m_options.timeout){
+                config->timeout = m_options.timeout;
+                config->setTimeout = true;
+            }
+            if(m_options.threads)
+                config->threads = m_options.threads;
+        }
+
+        /* the command line's nameservers over the engine's, 8.8.8.8 if none */
+        void overrideNameservers(QQueue<QString> &nameservers) const;
+
+        /* the amount of streamed work is not known */
+        qint64 workFor(qint64 work) const { return m_options.stream? INT_MAX : work; }
+
+        void write(const QJsonObject &object);
+        void error(const QString &message);
+};
+
+}
+
+#endif // SCANRUNNER_H
@@ -0,0 +1,107 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : the osint modules available to the headless scan runner, by their lowercase class names.
+*/
+
+#include "ScanRunner.h"
+
+#include <QMap>
+#include "src/modules/passive/OsintHeaders.h"
+
+
+typedef AbstractOsintModule *(*ModuleFactory)(const ScanArgs &args);
+
+static const QMap<QString, ModuleFactory> &moduleFactories(){
+    static const QMap<QString, ModuleFactory> factories = {
+        {"anubis", [](const ScanArgs &args)->AbstractOsintModule*{return new Anubis(args);}},
+        {"asrank", [](const ScanArgs &args)->AbstractOsintModule*{return new ASRank(args);}},
+        {"bgpview", [](const ScanArgs &args)->AbstractOsintModule*{return new Bgpview(args);}},
+        {"binaryedge", [](const ScanArgs &args)->AbstractOsintModule*{return new BinaryEdge(args);}},
+        {"c99", [](const ScanArgs &args)->AbstractOsintModule*{return new C99(args);}},
+        {"circl", [](const ScanArgs &args)->AbstractOsintModule*{return new Circl(args);}},
+        {"circlpublic", [](const ScanArgs &args)->AbstractOsintModule*{return new CirclPublic(args);}},
+        {"dnsbufferoverun", [](const ScanArgs &args)->AbstractOsintModule*{return new Dnsbufferoverun(args);}},
+        {"github", [](const ScanArgs &args)->AbstractOsintModule*{return new Github(args);}},
+        {"hackertargetfree", [](const ScanArgs &args)->AbstractOsintModule*{return new HackerTargetFree(args);}},
+        {"hackertarget", [](const ScanArgs &args)->AbstractOsintModule*{return new HackerTarget(args);}},
+        {"mnemonicfree", [](const ScanArgs &args)->AbstractOsintModule*{return new MnemonicFree(args);}},
+        {"mnemonic", [](const ScanArgs &args)->AbstractOsintModule*{return new Mnemonic(args);}},
+        {"omnisint", [](const ScanArgs &args)->AbstractOsintModule*{return new Omnisint(args);}},
+        {"otxfree", [](const ScanArgs &args)->AbstractOsintModule*{return new OtxFree(args);}},
+        {"otx", [](const ScanArgs &args)->AbstractOsintModule*{return new Otx(args);}},
+        {"projectdiscovery", [](const ScanArgs &args)->AbstractOsintModule*{return new Projectdiscovery(args);}},
+        {"riskiq", [](const ScanArgs &args)->AbstractOsintModule*{return new RiskIq(args);}},
+        {"robtexfree", [](const ScanArgs &args)->AbstractOsintModule*{return new RobtexFree(args);}},
+        {"robtex", [](const ScanArgs &args)->AbstractOsintModule*{return new Robtex(args);}},
+        {"securitytrails", [](const ScanArgs &args)->AbstractOsintModule*{return new SecurityTrails(args);}},
+        {"shodan", [](const ScanArgs &args)->AbstractOsintModule*{return new Shodan(args);}},
+        {"spyse", [](const ScanArgs &args)->AbstractOsintModule*{return new Spyse(args);}},
+        {"sublist3r", [](const ScanArgs &args)->AbstractOsintModule*{return new Sublist3r(args);}},
+        {"threatbook", [](const ScanArgs &args)->AbstractOsintModule*{return new ThreatBook(args);}},
+        {"threatcrowd", [](const ScanArgs &args)->AbstractOsintModule*{return new Threatcrowd(args);}},
+        {"threatminer", [](const ScanArgs &args)->AbstractOsintModule*{return new Threatminer(args);}},
+        {"urlscan", [](const ScanArgs &args)->AbstractOsintModule*{return new Urlscan(args);}},
+        {"viewdns", [](const ScanArgs &args)->AbstractOsintModule*{return new ViewDns(args);}},
+        {"virustotal", [](const ScanArgs &args)->AbstractOsintModule*{return new VirusTotal(args);}},
+        {"webresolver", [](const ScanArgs &args)->AbstractOsintModule*{return new WebResolver(args);}},
+        {"whoisxmlapi", [](const ScanArgs &args)->AbstractOsintModule*{return new WhoisXmlApi(args);}},
+        {"zetalytics", [](const ScanArgs &args)->AbstractOsintModule*{return new ZETAlytics(args);}},
+        {"zoomeye", [](const ScanArgs &args)->AbstractOsintModule*{return new ZoomEye(args);}},
+        {"ipinfo", [](const ScanArgs &args)->AbstractOsintModule*{return new IpInfo(args);}},
+        {"dnslytics", [](const ScanArgs &args)->AbstractOsintModule*{return new Dnslytics(args);}},
+        {"domaintools", [](const ScanArgs &args)->AbstractOsintModule*{return new DomainTools(args);}},
+        {"maltiverse", [](const ScanArgs &args)->AbstractOsintModule*{return new Maltiverse(args);}},
+        {"n45ht", [](const ScanArgs &args)->AbstractOsintModule*{return new N45HT(args);}},
+        {"onyphe", [](const ScanArgs &args)->AbstractOsintModule*{return new Onyphe(args);}},
+        {"ripe", [](const ScanArgs &args)->AbstractOsintModule*{return new Ripe(args);}},
+        {"rdap", [](const ScanArgs &args)->AbstractOsintModule*{return new Rdap(args);}},
+        {"fullhunt", [](const ScanArgs &args)->AbstractOsintModule*{return new FullHunt(args);}},
+        {"networksdb", [](const ScanArgs &args)->AbstractOsintModule*{return new NetworksDB(args);}},
+        {"spyonweb", [](const ScanArgs &args)->AbstractOsintModule*{return new SpyOnWeb(args);}},
+        {"leakix", [](const ScanArgs &args)->AbstractOsintModule*{return new LeakIX(args);}},
+        {"passivetotal", [](const ScanArgs &args)->AbstractOsintModule*{return new PassiveTotal(args);}},
+        {"archiveit", [](const ScanArgs &args)->AbstractOsintModule*{return new ArchiveIt(args);}},
+        {"archivetoday", [](const ScanArgs &args)->AbstractOsintModule*{return new ArchiveToday(args);}},
+        {"arquivo", [](const ScanArgs &args)->AbstractOsintModule*{return new Arquivo(args);}},
+        {"commoncrawl", [](const ScanArgs &args)->AbstractOsintModule*{return new CommonCrawl(args);}},
+        {"ukwebarchive", [](const ScanArgs &args)->AbstractOsintModule*{return new UKWebArchive(args);}},
+        {"waybackmachine", [](const ScanArgs &args)->AbstractOsintModule*{return new Waybackmachine(args);}},
+        {"censys", [](const ScanArgs &args)->AbstractOsintModule*{return new Censys(args);}},
+        {"censysfree", [](const ScanArgs &args)->AbstractOsintModule*{return new CensysFree(args);}},
+        {"certspotter", [](const ScanArgs &args)->AbstractOsintModule*{return new Certspotter(args);}},
+        {"certspotterfree", [](const ScanArgs &args)->AbstractOsintModule*{return new CertspotterFree(args);}},
+        {"crtsh", [](const ScanArgs &args)->AbstractOsintModule*{return new Crtsh(args);}},
+        {"googlecert", [](const ScanArgs &args)->AbstractOsintModule*{return new GoogleCert(args);}},
+        {"hunter", [](const ScanArgs &args)->AbstractOsintModule*{return new Hunter(args);}},
+        {"emailcrawlr", [](const ScanArgs &args)->AbstractOsintModule*{return new EmailCrawlr(args);}},
+        {"dnsdumpster", [](const ScanArgs &args)->AbstractOsintModule*{return new Dnsdumpster(args);}},
+        {"netcraft", [](const ScanArgs &args)->AbstractOsintModule*{return new Netcraft(args);}},
+        {"pagesinventory", [](const ScanArgs &args)->AbstractOsintModule*{return new PagesInventory(args);}},
+        {"pkey", [](const ScanArgs &args)->AbstractOsintModule*{return new Pkey(args);}},
+        {"rapiddns", [](const ScanArgs &args)->AbstractOsintModule*{return new Rapiddns(args);}},
+        {"sitedossier", [](const ScanArgs &args)->AbstractOsintModule*{return new SiteDossier(args);}},
+        {"ask", [](const ScanArgs &args)->AbstractOsintModule*{return new Ask(args);}},
+        {"baidu", [](const ScanArgs &args)->AbstractOsintModule*{return new Baidu(args);}},
+        {"dogpile", [](const ScanArgs &args)->AbstractOsintModule*{return new DogPile(args);}},
+        {"duckduckgo", [](const ScanArgs &args)->AbstractOsintModule*{return new DuckDuckGo(args);}},
+        {"exalead", [](const ScanArgs &args)->AbstractOsintModule*{return new Exalead(args);}},
+        {"yahoosearch", [](const ScanArgs &args)->AbstractOsintModule*{return new YahooSearch(args);}},
+        {"bingsearch", [](const ScanArgs &args)->AbstractOsintModule*{return new BingSearch(args);}},
+        {"googlesearch", [](const ScanArgs &args)->AbstractOsintModule*{return new GoogleSearch(args);}},
+        {"ipfy", [](const ScanArgs &args)->AbstractOsintModule*{return new Ipfy(args);}}
+    };
+    return factories;
+}
+
+QStringList cli::osintModules(){
+    return moduleFactories().keys();
+}
+
+AbstractOsintModule *cli::osintModule(const QString &name, const ScanArgs &args){
+    ModuleFactory factory = moduleFactories().value(name.trimmed().toLower(), nullptr);
+    if(!factory)
+        return nullptr;
+    return factory(args);
+}
@@ -0,0 +1,515 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : starts the engines' scanners for the headless scan runner, each scan is configured
+          from the engine's configurations, loaded & started like the gui's, & overriden by the
+          command line options.
+*/
+
+#include "ScanRunner.h"
+#include "src/utils/Config.h"
+#include "src/modules/active/PortScanner.h"
+#include "src/modules/active/PTRScanner.h"
+
+#include <QMap>
+#include <QJsonArray>
+
+
+/* json array of a set of record values */
+static QJsonArray toJsonArray(const QSet<QString> &values){
+    QJsonArray array;
+    foreach(const QString &value, values)
+        array.append(value);
+    return array;
+}
+
+/* hostnames & addresses are queued, the addresses of cidr ranges are taken lazily by the scanners */
+static bool queueTargets(const QStringList &targets, int stride, QQueue<QString> &queue, s3s_CidrIterator &ranges,
+                         QString &invalid)
+{
+    foreach(const QString &target, targets){
+        if(!target.contains('/')){
+            queue.enqueue(target);
+            continue;
+        }
+        if(!ranges.add(target, stride)){
+            invalid = target;
+            return false;
+        }
+    }
+    return true;
+}
+
+static QJsonObject hostToJson(const s3s_struct::HOST &host){
+    QJsonObject object;
+    object.insert("host", host.host);
+    if(!host.ipv4.isEmpty())
+        object.insert("ipv4", host.ipv4);
+    if(!host.ipv6.isEmpty())
+        object.insert("ipv6", host.ipv6);
+    return object;
+}
+
+///
+/// brute...
+///
+
+bool cli::ScanRunner::startBrute(){
+    if(m_options.wordlist.isEmpty()){
+        this->error("no wordlist, use --wordlist");
+        return false;
+    }
+
+    m_bruteArgs = new brute::ScanArgs;
+    m_bruteArgs->config = new brute::ScanConfig;
+
+    brute::loadConfig(m_bruteArgs->config);
+    this->overrideConfig(m_bruteArgs->config);
+    this->overrideNameservers(m_bruteArgs->config->nameservers);
+    if(m_options.wildcard)
+        m_bruteArgs->config->checkWildcard = true;
+
+    /* targets & output type */
+    if(m_options.output == "tld"){
+        m_bruteArgs->output = brute::OUTPUT::TLD;
+        foreach(const QString &target, m_options.targets)
+            m_bruteArgs->targets.enqueue(target.split(".", QString::SkipEmptyParts).value(0));
+    }
+    else {
+        m_bruteArgs->output = brute::OUTPUT::SUBDOMAIN;
+        foreach(const QString &target, m_options.targets)
+            m_bruteArgs->targets.enqueue(target);
+    }
+    m_bruteArgs->config->recursive = m_options.recursive && m_bruteArgs->output == brute::OUTPUT::SUBDOMAIN;
+
+    m_bruteArgs->wordlist = m_options.wordlist;
+    m_bruteArgs->downstream = m_options.downstream;
+    m_bruteArgs->reScan = false;
+
+    qint64 work = brute::prepareScan(m_bruteArgs);
+    m_executor->startScanners<brute::Scanner>(m_bruteArgs, m_bruteArgs->config->threads, this->workFor(work),
+                                              [=](brute::Scanner *scanner){
+        connect(scanner, &brute::Scanner::scanResult, this, [=](s3s_struct::HOST host){
+            this->write(hostToJson(host));
+        });
+        connect(scanner, &brute::Scanner::scanLog, this, &cli::ScanRunner::onScanLog);
+    });
+    return true;
+}
+
+///
+/// active...
+///
+
+void cli::ScanRunner::initActiveArgs(){
+    m_activeArgs = new active::ScanArgs;
+    m_activeArgs->config = new active::ScanConfig;
+
+    active::loadConfig(m_activeArgs->config);
+    this->overrideConfig(m_activeArgs->config);
+    this->overrideNameservers(m_activeArgs->config->nameservers);
+}
+
+bool cli::ScanRunner::startActive(){
+    this->initActiveArgs();
+
+    foreach(const QString &target, m_options.targets)
+        m_activeArgs->targets.enqueue(target);
+    m_activeArgs->stream = m_options.stream;
+
+    qint64 work = active::prepareScan(m_activeArgs);
+    m_executor->startScanners<active::Scanner>(m_activeArgs, m_activeArgs->config->threads, this->workFor(work),
+                                               [=](active::Scanner *scanner){
+        connect(scanner, &active::Scanner::scanResult, this, [=](s3s_struct::HOST host){
+            if(m_filter.insert(host.host))
+                this->write(hostToJson(host));
+        });
+        connect(scanner, &active::Scanner::scanProgress, this, &cli::ScanRunner::targetDone);
+        connect(scanner, &active::Scanner::scanLog, this, &cli::ScanRunner::onScanLog);
+    });
+    return true;
+}
+
+///
+/// port...
+///
+
+bool cli::ScanRunner::startPort(){
+    if(m_options.ports.isEmpty()){
+        this->error("no ports, use --ports");
+        return false;
+    }
+
+    this->initActiveArgs();
+
+    QString invalid;
+    if(!queueTargets(m_options.targets, m_options.stride, m_activeArgs->targets, m_activeArgs->ranges, invalid)){
+        this->error("invalid range or larger than 2^"+QString::number(CIDR_MAX_HOST_BITS)+" addresses: "+invalid);
+        return false;
+    }
+    foreach(const quint16 &port, m_options.ports)
+        m_activeArgs->ports.insert(port);
+
+    qint64 work = active::prepareScan(m_activeArgs);
+    m_executor->startScanners<port::Scanner>(m_activeArgs, m_activeArgs->config->threads, this->workFor(work),
+                                             [=](port::Scanner *scanner){
+        connect(scanner, &port::Scanner::scanResult, this, [=](s3s_struct::HOST host){
+            QJsonObject object;
+            object.insert("host", host.host);
+            QJsonArray ports;
+            foreach(const quint16 &port, host.ports)
+                ports.append(port);
+            object.insert("ports", ports);
+            this->write(object);
+        });
+        connect(scanner, &port::Scanner::scanLog, this, &cli::ScanRunner::onScanLog);
+    });
+    return true;
+}
+
+///
+/// ptr...
+///
+
+bool cli::ScanRunner::startPtr(){
+    this->initActiveArgs();
+    if(m_options.inflight)
+        m_activeArgs->config->inflight = m_options.inflight;
+
+    /* the ranges' addresses are taken lazily by the scanners */
+    foreach(const QString &target, m_options.targets){
+        if(!m_activeArgs->ranges.add(target, m_options.stride)){
+            this->error("invalid range or larger than 2^"+QString::number(CIDR_MAX_HOST_BITS)+" addresses: "+target);
+            return false;
+        }
+    }
+    m_activeArgs->stream = m_options.stream;
+
+    qint64 work = active::prepareScan(m_activeArgs);
+    m_executor->startScanners<ptr::Scanner>(m_activeArgs, m_activeArgs->config->threads, this->workFor(work),
+                                            [=](ptr::Scanner *scanner){
+        connect(scanner, &ptr::Scanner::scanResult, this, [=](s3s_struct::HOST host){
+            this->write(hostToJson(host));
+        });
+        connect(scanner, &ptr::Scanner::scanLog, this, &cli::ScanRunner::onScanLog);
+    });
+    return true;
+}
+
+///
+/// dns...
+///
+
+bool cli::ScanRunner::startDns(){
+    m_dnsArgs = new dns::ScanArgs;
+    m_dnsArgs->config = new dns::ScanConfig;
+
+    dns::loadConfig(m_dnsArgs->config);
+    this->overrideConfig(m_dnsArgs->config);
+    this->overrideNameservers(m_dnsArgs->config->nameservers);
+
+    /* record types */
+    m_dnsArgs->RecordType_a = m_options.records.contains("a");
+    m_dnsArgs->RecordType_aaaa = m_options.records.contains("aaaa");
+    m_dnsArgs->RecordType_mx = m_options.records.contains("mx");
+    m_dnsArgs->RecordType_ns = m_options.records.contains("ns");
+    m_dnsArgs->RecordType_txt = m_options.records.contains("txt");
+    m_dnsArgs->RecordType_cname = m_options.records.contains("cname");
+    m_dnsArgs->RecordType_srv = m_options.records.contains("srv");
+    m_dnsArgs->RecordType_any = m_options.records.contains("any");
+
+    if(!(m_dnsArgs->RecordType_a || m_dnsArgs->RecordType_aaaa || m_dnsArgs->RecordType_mx ||
+         m_dnsArgs->RecordType_ns || m_dnsArgs->RecordType_txt || m_dnsArgs->RecordType_cname ||
+         m_dnsArgs->RecordType_srv || m_dnsArgs->RecordType_any))
+    {
+        this->error("no record types, use --records");
+        return false;
+    }
+    if(m_dnsArgs->RecordType_srv && m_options.wordlist.isEmpty()){
+        this->error("no srv wordlist, use --wordlist");
+        return false;
+    }
+
+    foreach(const QString &target, m_options.targets)
+        m_dnsArgs->targets.enqueue(target);
+    m_dnsArgs->stream = m_options.stream;
+    m_dnsArgs->srvWordlist = m_options.wordlist;
+
+    qint64 work = dns::prepareScan(m_dnsArgs);
+    m_executor->startScanners<dns::Scanner>(m_dnsArgs, m_dnsArgs->config->threads, this->workFor(work),
+                                            [=](dns::Scanner *scanner){
+        connect(scanner, &dns::Scanner::scanResult, this, [=](s3s_struct::DNS dns){
+            QJsonObject object;
+            object.insert("host", dns.dns);
+            if(!dns.A.isEmpty())
+                object.insert("a", toJsonArray(dns.A));
+            if(!dns.AAAA.isEmpty())
+                object.insert("aaaa", toJsonArray(dns.AAAA));
+            if(!dns.CNAME.isEmpty())
+                object.insert("cname", toJsonArray(dns.CNAME));
+            if(!dns.NS.isEmpty())
+                object.insert("ns", toJsonArray(dns.NS));
+            if(!dns.MX.isEmpty())
+                object.insert("mx", toJsonArray(dns.MX));
+            if(!dns.TXT.isEmpty())
+                object.insert("txt", toJsonArray(dns.TXT));
+            if(!dns.SRV.isEmpty()){
+                QJsonArray srv;
+                foreach(const QStringList &record, dns.SRV)
+                    srv.append(QJsonArray::fromStringList(record));
+                object.insert("srv", srv);
+            }
+            this->write(object);
+        });
+        connect(scanner, &dns::Scanner::scanProgress, this, &cli::ScanRunner::targetDone);
+        connect(scanner, &dns::Scanner::scanLog, this, &cli::ScanRunner::onScanLog);
+    });
+    return true;
+}
+
+///
+/// ssl...
+///
+
+bool cli::ScanRunner::startSsl(){
+    static const QMap<QString, ssl::PORT> ports = {
+        {"https", ssl::PORT::HTTPS}, {"ftp", ssl::PORT::FTP}, {"ftps", ssl::PORT::FTPs},
+        {"ssh", ssl::PORT::SSH}, {"smtp", ssl::PORT::SMTP}, {"imap", ssl::PORT::IMAP}, {"pop", ssl::PORT::POP}
+    };
+    static const QMap<QString, ssl::OUTPUT> outputs = {
+        {"subdomain", ssl::OUTPUT::SUBDOMAIN}, {"sha1", ssl::OUTPUT::SHA1}, {"sha256", ssl::OUTPUT::SHA256}
+    };
+
+    if(!ports.contains(m_options.port)){
+        this->error("unknown ssl port "+m_options.port);
+        return false;
+    }
+    QString output = m_options.output.isEmpty()? "subdomain" : m_options.output;
+    if(!outputs.contains(output)){
+        this->error("unknown ssl output "+output);
+        return false;
+    }
+
+    m_sslArgs = new ssl::ScanArgs;
+    m_sslArgs->config = new ssl::ScanConfig;
+
+    ssl::loadConfig(m_sslArgs->config);
+    this->overrideConfig(m_sslArgs->config);
+
+    m_sslArgs->port = ports.value(m_options.port);
+    m_sslArgs->output = outputs.value(output);
+    QString invalid;
+    if(!queueTargets(m_options.targets, m_options.stride, m_sslArgs->targets, m_sslArgs->ranges, invalid)){
+        this->error("invalid range or larger than 2^"+QString::number(CIDR_MAX_HOST_BITS)+" addresses: "+invalid);
+        return false;
+    }
+    m_sslArgs->stream = m_options.stream;
+
+    qint64 work = ssl::prepareScan(m_sslArgs);
+    m_executor->startScanners<ssl::Scanner>(m_sslArgs, m_sslArgs->config->threads, this->workFor(work),
+                                            [=](ssl::Scanner *scanner){
+        switch(m_sslArgs->output){
+        case ssl::OUTPUT::SUBDOMAIN:
+            connect(scanner, &ssl::Scanner::resultSubdomain, this, [=](QStringList subdomains){
+                foreach(const QString &subdomain, subdomains){
+                    if(m_filter.insert(subdomain))
+                        this->write(QJsonObject{{"subdomain", subdomain}});
+                }
+            });
+            break;
+        case ssl::OUTPUT::SHA1:
+            connect(scanner, &ssl::Scanner::resultSHA1, this, [=](QString sha1){
+                if(m_filter.insert(sha1))
+                    this->write(QJsonObject{{"sha1", sha1}});
+            });
+            break;
+        case ssl::OUTPUT::SHA256:
+            connect(scanner, &ssl::Scanner::resultSHA256, this, [=](QString sha256){
+                if(m_filter.insert(sha256))
+                    this->write(QJsonObject{{"sha256", sha256}});
+            });
+            break;
+        default:
+            break;
+        }
+        connect(scanner, &ssl::Scanner::scanProgress, this, &cli::ScanRunner::targetDone);
+        connect(scanner, &ssl::Scanner::scanLog, this, &cli::ScanRunner::onScanLog);
+    });
+    return true;
+}
+
+///
+/// url...
+///
+
+bool cli::ScanRunner::startUrl(){
+    m_urlArgs = new url::ScanArgs;
+    m_urlArgs->config = new url::ScanConfig;
+
+    url::loadConfig(m_urlArgs->config);
+    this->overrideConfig(m_urlArgs->config);
+
+    foreach(const QString &target, m_options.targets)
+        m_urlArgs->targets.enqueue(target);
+    m_urlArgs->stream = m_options.stream;
+
+    qint64 work = url::prepareScan(m_urlArgs);
+    m_executor->startScanners<url::Scanner>(m_urlArgs, m_urlArgs->config->threads, this->workFor(work),
+                                            [=](url::Scanner *scanner){
+        connect(scanner, &url::Scanner::scanResult, this, [=](s3s_struct::URL url){
+            QJsonObject object;
+            object.insert("url", url.url);
+            object.insert("status_code", url.status_code);
+            if(!url.banner.isEmpty())
+                object.insert("banner", url.banner);
+            if(!url.content_type.isEmpty())
+                object.insert("content_type", url.content_type);
+            this->write(object);
+        });
+        connect(scanner, &url::Scanner::scanProgress, this, &cli::ScanRunner::targetDone);
+        connect(scanner, &url::Scanner::scanLog, this, &cli::ScanRunner::onScanLog);
+    });
+    return true;
+}
+
+///
+/// osint...
+///
+
+bool cli::ScanRunner::startOsint(){
+    if(m_options.modules.isEmpty()){
+        this->error("no osint modules, use --module, --list-modules lists the modules");
+        return false;
+    }
+
+    m_osintArgs = new ScanArgs;
+    m_osintArgs->config = new ScanConfig;
+
+    osint::loadConfig(m_osintArgs->config, CFG_OSINT);
+    if(m_options.timeout){
+        m_osintArgs->config->timeout = m_options.timeout;
+        m_osintArgs->config->setTimeout = true;
+    }
+
+    /* input type */
+    const QString &input = m_options.input;
+    m_osintArgs->input_Domain = (input == "domain");
+    m_osintArgs->input_IP = (input == "ip");
+    m_osintArgs->input_Email = (input == "email");
+    m_osintArgs->input_URL = (input == "url");
+    m_osintArgs->input_ASN = (input == "asn");
+    m_osintArgs->input_SSL = (input == "cert");
+    m_osintArgs->input_CIDR = (input == "cidr");
+    m_osintArgs->input_Search = (input == "query");
+
+    /* output type */
+    const QString output = m_options.output.isEmpty()? "subdomain" : m_options.output;
+    m_osintArgs->output_Hostname = (output == "subdomain");
+    m_osintArgs->output_HostnameIP = (output == "subdomainip");
+    m_osintArgs->output_IP = (output == "ip");
+    m_osintArgs->output_Email = (output == "email");
+    m_osintArgs->output_URL = (output == "url");
+    m_osintArgs->output_ASN = (output == "asn");
+    m_osintArgs->output_SSL = (output == "cert");
+    m_osintArgs->output_CIDR = (output == "cidr");
+
+    static const QStringList inputs = {"domain", "ip", "email", "url", "asn", "cert", "cidr", "query"};
+    static const QStringList outputs = {"subdomain", "subdomainip", "ip", "email", "url", "asn", "cert", "cidr"};
+    if(!inputs.contains(input)){
+        this->error("unknown osint input "+input);
+        return false;
+    }
+    if(!outputs.contains(output)){
+        this->error("unknown osint output "+output);
+        return false;
+    }
+
+    foreach(const QString &target, m_options.targets)
+        m_osintArgs->targets.enqueue(target);
+
+    /* the modules are created first, so an unknown module fails before any scan starts */
+    QList<AbstractOsintModule*> modules;
+    foreach(const QString &name, m_options.modules){
+        AbstractOsintModule *module = cli::osintModule(name, *m_osintArgs);
+        if(!module){
+            qDeleteAll(modules);
+            this->error("unknown osint module "+name+", --list-modules lists the modules");
+            return false;
+        }
+        modules.append(module);
+    }
+
+    /* the scope of the hostnames, the domain targets if no pattern is given */
+    const QStringList &patterns = m_options.scope.isEmpty() && m_osintArgs->input_Domain? m_options.targets : m_options.scope;
+    foreach(const QString &pattern, patterns){
+        if(!m_scope.insert(pattern)){
+            qDeleteAll(modules);
+            this->error("invalid scope pattern "+pattern);
+            return false;
+        }
+    }
+
+    /*
+     * the modules run on the executor's threads, the results are checked against the duplicates filter
+     * in the module's thread & only unique results are queued to the runner. the hostnames are
+     * first normalized & the ones outside of the scope dropped.
+     */
+    s3s_ResultFilter *filter = &m_filter;
+    const s3s_Scope *scope = &m_scope;
+    auto hostname = [=](const QString &type, const QString &value){
+        QString name = scope->match(value);
+        if(!name.isNull() && filter->insert(name))
+            QMetaObject::invokeMethod(this, [=](){this->write(QJsonObject{{type, name}});}, Qt::QueuedConnection);
+    };
+
+    foreach(AbstractOsintModule *module, modules)
+    {
+
+        auto result = [=](const QString &type, const QString &value){
+            if(filter->insert(value))
+                QMetaObject::invokeMethod(this, [=](){this->write(QJsonObject{{type, value}});}, Qt::QueuedConnection);
+        };
+
+        if(output == "subdomain"){
+            connect(module, &AbstractOsintModule::resultSubdomain, module, [=](QString subdomain){hostname("subdomain", subdomain);});
+            connect(module, &AbstractOsintModule::resultCNAME, module, [=](QString CNAME){hostname("subdomain", CNAME);});
+            connect(module, &AbstractOsintModule::resultNS, module, [=](QString NS){hostname("subdomain", NS);});
+            connect(module, &AbstractOsintModule::resultMX, module, [=](QString MX){hostname("subdomain", MX);});
+        }
+        else if(output == "subdomainip"){
+            connect(module, &AbstractOsintModule::resultSubdomainIp, module, [=](QString subdomain, QString ip){
+                subdomain = scope->match(subdomain);
+                if(!subdomain.isNull() && filter->insert(subdomain))
+                    QMetaObject::invokeMethod(this, [=](){
+                        this->write(QJsonObject{{"subdomain", subdomain}, {"ip", ip}});
+                    }, Qt::QueuedConnection);
+            });
+        }
+        else if(output == "ip"){
+            connect(module, &AbstractOsintModule::resultIP, module, [=](QString ip){result("ip", ip);});
+            connect(module, &AbstractOsintModule::resultA, module, [=](QString A){result("ip", A);});
+            connect(module, &AbstractOsintModule::resultAAAA, module, [=](QString AAAA){result("ip", AAAA);});
+        }
+        else if(output == "email")
+            connect(module, &AbstractOsintModule::resultEmail, module, [=](QString email){result("email", email);});
+        else if(output == "url")
+            connect(module, &AbstractOsintModule::resultURL, module, [=](QString url){result("url", url);});
+        else if(output == "cert")
+            connect(module, &AbstractOsintModule::resultSSL, module, [=](QString cert){result("cert", cert);});
+        else if(output == "cidr")
+            connect(module, &AbstractOsintModule::resultCIDR, module, [=](QString cidr){result("cidr", cidr);});
+        else if(output == "asn"){
+            connect(module, &AbstractOsintModule::resultASN, module, [=](QString asn, QString name){
+                if(filter->insert(asn))
+                    QMetaObject::invokeMethod(this, [=](){
+                        this->write(QJsonObject{{"asn", asn}, {"name", name}});
+                    }, Qt::QueuedConnection);
+            });
+        }
+
+        connect(module, &AbstractOsintModule::scanLog, this, &cli::ScanRunner::onOsintLog);
+        m_executor->start(module);
+    }
+    return true;
+}
@@ -0,0 +1,655 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : local stub servers for the scanner benchmarks, an authoritative dns server, an http server,
+          a tls server, a farm of tcp listeners, a certificate transparency log & an smtp server, all on
+          the loopback interface.
+*/
+
+#include "StubServers.h"
+#include "src/utils/Metrics.h"
+
+#include <QFile>
+#include <QTimer>
+#include <QSslSocket>
+#include <QTcpSocket>
+#include <QRandomGenerator>
+#include <QUrlQuery>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QNetworkDatagram>
+
+/* dns header & record constants */
+#define DNS_HEADER_SIZE 12
+#define DNS_TYPE_A 1
+#define DNS_TYPE_NS 2
+#define DNS_TYPE_CNAME 5
+#define DNS_TYPE_MX 15
+#define DNS_TYPE_TXT 16
+#define DNS_TYPE_AAAA 28
+#define DNS_TYPE_ANY 255
+#define DNS_RCODE_NOERROR 0
+#define DNS_RCODE_FORMERR 1
+#define DNS_RCODE_NXDOMAIN 3
+#define DNS_TTL 60
+
+/* maximum size of an http request header read by the http stub */
+#define HTTP_MAX_REQUEST 8192
+
+/* entries returned by a get-entries request of the ct log stub */
+#define STUB_CT_MAX_ENTRIES 100
+
+/* maximum size of an smtp command line read by the smtp stub */
+#define SMTP_MAX_LINE 1024
+
+
+qint64 bench::now(){
+    return metrics::now();
+}
+
+///
+/// arrivals...
+///
+
+void bench::ArrivalLog::insert(const QString &key){
+    qint64 time = bench::now();
+    QMutexLocker locker(&m_mutex);
+    if(!m_arrivals.contains(key))
+        m_arrivals.insert(key, time);
+}
+
+qint64 bench::ArrivalLog::value(const QString &key){
+    QMutexLocker locker(&m_mutex);
+    return m_arrivals.value(key, -1);
+}
+
+int bench::ArrivalLog::size(){
+    QMutexLocker locker(&m_mutex);
+    return m_arrivals.size();
+}
+
+void bench::ArrivalLog::clear(){
+    QMutexLocker locker(&m_mutex);
+    m_arrivals.clear();
+}
+
+///
+/// dns...
+///
+
+/* reads an uncompressed name from a query, returns the offset after the name or -1 */
+static int readName(const QByteArray &message, int offset, QString &name){
+    QStringList labels;
+    while(offset < message.size())
+    {
+        int length = static_cast<quint8>(message.at(offset));
+        offset++;
+        if(length == 0){
+            name = labels.join('.').toLower();
+            return offset;
+        }
+        /* compression pointers are not expected in a question */
+        if(length > 63 || offset+length > message.size())
+            return -1;
+        labels.append(QString::fromLatin1(message.mid(offset, length)));
+        offset += length;
+    }
+    return -1;
+}
+
+static void writeUInt16(QByteArray &message, quint16 value){
+    message.append(static_cast<char>(value >> 8));
+    message.append(static_cast<char>(value & 0xff));
+}
+
+static void writeUInt32(QByteArray &message, quint32 value){
+    writeUInt16(message, static_cast<quint16>(value >> 16));
+    writeUInt16(message, static_cast<quint16>(value & 0xffff));
+}
+
+static QByteArray encodeName(const QString &name){
+    QByteArray encoded;
+    foreach(const QString &label, name.split('.', QString::SkipEmptyParts)){
+        QByteArray latin = label.toLatin1();
+        encoded.append(static_cast<char>(latin.size()));
+        encoded.append(latin);
+    }
+    encoded.append('\0');
+    return encoded;
+}
+
+/* an answer for the name of the question, the name is a pointer to the question */
+static void writeAnswer(QByteArray &message, quint16 type, const QByteArray &rdata){
+    writeUInt16(message, 0xc000 | DNS_HEADER_SIZE);
+    writeUInt16(message, type);
+    writeUInt16(message, 1); // IN
+    writeUInt32(message, DNS_TTL);
+    writeUInt16(message, static_cast<quint16>(rdata.size()));
+    message.append(rdata);
+}
+
+bench::DnsStub::DnsStub(const bench::StubConfig &config, bench::ArrivalLog *arrivals, QObject *parent): QObject(parent),
+    m_config(config),
+    m_arrivals(arrivals)
+{
+    connect(&m_socket, &QUdpSocket::readyRead, this, &bench::DnsStub::onReadyRead);
+}
+
+bool bench::DnsStub::listen(const QHostAddress &address, quint16 port){
+    return m_socket.bind(address, port);
+}
+
+void bench::DnsStub::onReadyRead(){
+    while(m_socket.hasPendingDatagrams())
+    {
+        QNetworkDatagram datagram = m_socket.receiveDatagram();
+        QByteArray query = datagram.data();
+
+        QString name;
+        if(query.size() > DNS_HEADER_SIZE && readName(query, DNS_HEADER_SIZE, name) != -1)
+            m_arrivals->insert(name);
+
+        /* dropped queries are left to the client's timeout */
+        if(m_config.loss > 0 && QRandomGenerator::global()->bounded(100.0) < m_config.loss)
+            continue;
+
+        QByteArray reply = this->reply(query);
+        if(reply.isEmpty())
+            continue;
+
+        QHostAddress sender = datagram.senderAddress();
+        quint16 senderPort = static_cast<quint16>(datagram.senderPort());
+        if(m_config.latency > 0)
+            QTimer::singleShot(m_config.latency, this, [=](){m_socket.writeDatagram(reply, sender, senderPort);});
+        else
+            m_socket.writeDatagram(reply, sender, senderPort);
+    }
+}
+
+QByteArray bench::DnsStub::reply(const QByteArray &query) const {
+    if(query.size() < DNS_HEADER_SIZE)
+        return QByteArray();
+
+    QString name;
+    int end = readName(query, DNS_HEADER_SIZE, name);
+    if(end == -1 || end+4 > query.size()){
+        /* a FORMERR with the query's id */
+        QByteArray reply = query.left(DNS_HEADER_SIZE);
+        reply[2] = static_cast<char>(0x80 | (query.at(2) & 0x01));
+        reply[3] = static_cast<char>(0x80 | DNS_RCODE_FORMERR);
+        reply.replace(4, 8, QByteArray(8, '\0'));
+        return reply;
+    }
+    quint16 type = static_cast<quint16>((static_cast<quint8>(query.at(end)) << 8) | static_cast<quint8>(query.at(end+1)));
+
+    /* names of a wildcard zone & live labels of the stub zone resolve */
+    bool wildcard = false;
+    foreach(const QString &zone, m_config.wildcardZones){
+        if(name.endsWith("."+zone)){
+            wildcard = true;
+            break;
+        }
+    }
+    bool exists = wildcard || name == STUB_ZONE ||
+            (name.endsWith("." STUB_ZONE) && name.startsWith(STUB_LIVE_PREFIX));
+
+    /* the answers, addresses are derived from the name so every lookup of a name agrees */
+    QList<QPair<quint16, QByteArray>> answers;
+    if(exists)
+    {
+        uint hash = qHash(name);
+        if(type == DNS_TYPE_A || type == DNS_TYPE_ANY){
+            QByteArray rdata;
+            if(wildcard)
+                writeUInt32(rdata, QHostAddress(STUB_WILDCARD_ADDRESS).toIPv4Address());
+            else
+                writeUInt32(rdata, (10u << 24) | (hash & 0x00ffffff));
+            answers.append(qMakePair(static_cast<quint16>(DNS_TYPE_A), rdata));
+        }
+        if(type == DNS_TYPE_AAAA){
+            QByteArray rdata(16, '\0');
+            rdata[0] = static_cast<char>(0xfd);
+            rdata[12] = static_cast<char>(hash >> 24);
+            rdata[13] = static_cast<char>(hash >> 16);
+            rdata[14] = static_cast<char>(hash >> 8);
+            rdata[15] = static_cast<char>(hash);
+            answers.append(qMakePair(static_cast<quint16>(DNS_TYPE_AAAA), rdata));
+        }
+        if(type == DNS_TYPE_MX){
+            QByteArray rdata;
+            writeUInt16(rdata, 10);
+            rdata.append(encodeName("mail." STUB_ZONE));
+            answers.append(qMakePair(static_cast<quint16>(DNS_TYPE_MX), rdata));
+        }
+        if(type == DNS_TYPE_NS)
+            answers.append(qMakePair(static_cast<quint16>(DNS_TYPE_NS), encodeName("ns1." STUB_ZONE)));
+        if(type == DNS_TYPE_CNAME && name != STUB_ZONE)
+            answers.append(qMakePair(static_cast<quint16>(DNS_TYPE_CNAME), encodeName("www." STUB_ZONE)));
+        if(type == DNS_TYPE_TXT){
+            QByteArray txt("v=stub");
+            QByteArray rdata;
+            rdata.append(static_cast<char>(txt.size()));
+            rdata.append(txt);
+            answers.append(qMakePair(static_cast<quint16>(DNS_TYPE_TXT), rdata));
+        }
+    }
+
+    /* header, the query's id & recursion desired flag, authoritative & recursion available */
+    QByteArray reply;
+    reply.append(query.left(2));
+    reply.append(static_cast<char>(0x84 | (query.at(2) & 0x01)));
+    reply.append(static_cast<char>(0x80 | (exists? DNS_RCODE_NOERROR : DNS_RCODE_NXDOMAIN)));
+    writeUInt16(reply, 1);
+    writeUInt16(reply, static_cast<quint16>(answers.size()));
+    writeUInt16(reply, 0);
+    writeUInt16(reply, 0);
+
+    /* the question, the query's additional records (eg. edns) are not echoed */
+    reply.append(query.mid(DNS_HEADER_SIZE, end+4-DNS_HEADER_SIZE));
+
+    for(int i = 0; i < answers.size(); i++)
+        writeAnswer(reply, answers.at(i).first, answers.at(i).second);
+
+    return reply;
+}
+
+///
+/// http...
+///
+
+bench::HttpStub::HttpStub(const bench::StubConfig &config, bench::ArrivalLog *arrivals, QObject *parent): QTcpServer(parent),
+    m_config(config),
+    m_arrivals(arrivals)
+{
+    connect(this, &QTcpServer::newConnection, this, &bench::HttpStub::onNewConnection);
+}
+
+void bench::HttpStub::onNewConnection(){
+    while(this->hasPendingConnections())
+    {
+        QTcpSocket *socket = this->nextPendingConnection();
+        connect(socket, &QTcpSocket::disconnected, socket, &QTcpSocket::deleteLater);
+        connect(socket, &QTcpSocket::readyRead, socket, [=](){
+            /* the request is answered once, when its header is complete */
+            if(socket->property("answered").toBool())
+                return;
+            QByteArray request = socket->peek(HTTP_MAX_REQUEST);
+            if(!request.contains("\r\n\r\n") && request.size() < HTTP_MAX_REQUEST)
+                return;
+            socket->readAll();
+            socket->setProperty("answered", true);
+
+            /* the request line, "GET /path HTTP/1.1" */
+            QList<QByteArray> requestLine = request.left(request.indexOf("\r\n")).split(' ');
+            QString path = requestLine.size() > 1? QString::fromLatin1(requestLine.at(1)) : QString("/");
+            m_arrivals->insert(path);
+
+            QByteArray body = "<html><head><title>stub</title></head><body>"+path.toLatin1()+"</body></html>";
+            QByteArray response = "HTTP/1.1 200 OK\r\n"
+                                  "Server: s3s-stub\r\n"
+                                  "Content-Type: text/html\r\n"
+                                  "Connection: close\r\n"
+                                  "Content-Length: "+QByteArray::number(body.size())+"\r\n\r\n"+body;
+
+            auto respond = [=](){
+                socket->write(response);
+                socket->disconnectFromHost();
+            };
+            if(m_config.latency > 0)
+                QTimer::singleShot(m_config.latency, socket, respond);
+            else
+                respond();
+        });
+    }
+}
+
+///
+/// tls...
+///
+
+bench::TlsStub::TlsStub(const bench::StubConfig &config, QObject *parent): QTcpServer(parent),
+    m_config(config)
+{
+}
+
+bool bench::TlsStub::loadCertificate(){
+    QFile certificate(":/files/res/files/bench_stub.crt");
+    QFile key(":/files/res/files/bench_stub.key");
+    if(!certificate.open(QIODevice::ReadOnly) || !key.open(QIODevice::ReadOnly))
+        return false;
+
+    m_certificate = QSslCertificate(certificate.readAll(), QSsl::Pem);
+    m_key = QSslKey(key.readAll(), QSsl::Rsa, QSsl::Pem);
+    return !m_certificate.isNull() && !m_key.isNull();
+}
+
+void bench::TlsStub::incomingConnection(qintptr socketDescriptor){
+    QSslSocket *socket = new QSslSocket(this);
+    if(!socket->setSocketDescriptor(socketDescriptor)){
+        delete socket;
+        return;
+    }
+    socket->setLocalCertificate(m_certificate);
+    socket->setPrivateKey(m_key);
+    socket->setPeerVerifyMode(QSslSocket::VerifyNone);
+
+    connect(socket, &QSslSocket::disconnected, socket, &QSslSocket::deleteLater);
+    connect(socket, static_cast<void(QSslSocket::*)(QAbstractSocket::SocketError)>(&QSslSocket::error),
+            socket, &QSslSocket::deleteLater);
+
+    if(m_config.latency > 0)
+        QTimer::singleShot(m_config.latency, socket, [=](){socket->startServerEncryption();});
+    else
+        socket->startServerEncryption();
+}
+
+///
+/// tcp...
+///
+
+bench::TcpFarm::TcpFarm(const bench::StubConfig &config, QObject *parent): QObject(parent),
+    m_config(config)
+{
+}
+
+bool bench::TcpFarm::listen(const QHostAddress &address){
+    for(int i = 0; i < m_config.tcpListeners; i++)
+    {
+        QTcpServer *server = new QTcpServer(this);
+        if(!server->listen(address)){
+            delete server;
+            return false;
+        }
+        /* connections are accepted & closed, the port scanner only connects */
+        connect(server, &QTcpServer::newConnection, server, [=](){
+            while(server->hasPendingConnections()){
+                QTcpSocket *socket = server->nextPendingConnection();
+                connect(socket, &QTcpSocket::disconnected, socket, &QTcpSocket::deleteLater);
+                socket->disconnectFromHost();
+            }
+        });
+        m_servers.append(server);
+    }
+    return true;
+}
+
+QList<quint16> bench::TcpFarm::ports() const {
+    QList<quint16> ports;
+    foreach(QTcpServer *server, m_servers)
+        ports.append(server->serverPort());
+    return ports;
+}
+
+///
+/// certificate transparency...
+///
+
+/* a DER element of a tag & its contents */
+static QByteArray der(quint8 tag, const QByteArray &contents){
+    QByteArray element(1, static_cast<char>(tag));
+    int length = contents.size();
+    if(length < 0x80)
+        element.append(static_cast<char>(length));
+    else if(length < 0x100){
+        element.append(static_cast<char>(0x81));
+        element.append(static_cast<char>(length));
+    }
+    else {
+        element.append(static_cast<char>(0x82));
+        element.append(static_cast<char>(length >> 8));
+        element.append(static_cast<char>(length & 0xff));
+    }
+    element.append(contents);
+    return element;
+}
+
+QByteArray bench::ctLeaf(qint64 index){
+    QByteArray name = "ct"+QByteArray::number(index)+"." STUB_ZONE;
+
+    /* a minimal certificate, the tailer reads its subject & its subject alternative names only */
+    QByteArray algorithm = der(0x30, der(0x06, QByteArray("\x2a\x86\x48\x86\xf7\x0d\x01\x01\x0b", 9))+der(0x05, QByteArray()));
+    QByteArray issuer = der(0x30, der(0x31, der(0x30, der(0x06, QByteArray("\x55\x04\x03", 3))+der(0x0c, "s3s stub ca"))));
+    QByteArray subject = der(0x30, der(0x31, der(0x30, der(0x06, QByteArray("\x55\x04\x03", 3))+der(0x0c, name))));
+    QByteArray validity = der(0x30, der(0x17, "260101000000Z")+der(0x17, "270101000000Z"));
+    QByteArray publicKey = der(0x30, algorithm+der(0x03, QByteArray(1, '\0')));
+    QByteArray altNames = der(0x30, der(0x82, name)+der(0x82, "www."+name));
+    QByteArray extensions = der(0xa3, der(0x30, der(0x30, der(0x06, QByteArray("\x55\x1d\x11", 3))+der(0x04, altNames))));
+
+    QByteArray tbs = der(0x30, der(0xa0, der(0x02, QByteArray(1, '\x02')))+der(0x02, QByteArray::number(index+1))+
+                         algorithm+issuer+validity+subject+publicKey+extensions);
+
+    /* every other entry is a precertificate, its TBSCertificate is logged after the issuer's key hash */
+    bool precert = index % 2;
+    QByteArray entry = precert? tbs : der(0x30, tbs+algorithm+der(0x03, QByteArray(1, '\0')));
+
+    QByteArray leaf(2, '\0');
+    writeUInt32(leaf, 0);
+    writeUInt32(leaf, static_cast<quint32>(index));
+    writeUInt16(leaf, precert? 1 : 0);
+    if(precert)
+        leaf.append(QByteArray(32, '\0'));
+    leaf.append(static_cast<char>(entry.size() >> 16));
+    leaf.append(static_cast<char>((entry.size() >> 8) & 0xff));
+    leaf.append(static_cast<char>(entry.size() & 0xff));
+    leaf.append(entry);
+    writeUInt16(leaf, 0);
+    return leaf;
+}
+
+bench::CtLogStub::CtLogStub(qint64 size, QObject *parent): QTcpServer(parent),
+    m_size(size)
+{
+    connect(this, &QTcpServer::newConnection, this, &bench::CtLogStub::onNewConnection);
+}
+
+void bench::CtLogStub::start(){
+    if(!this->listen(QHostAddress::LocalHost))
+        error = "ct log stub: "+this->errorString();
+}
+
+void bench::CtLogStub::stop(){
+    this->close();
+}
+
+QUrl bench::CtLogStub::url() const {
+    return QUrl(QString("http://127.0.0.1:%1/").arg(this->serverPort()));
+}
+
+void bench::CtLogStub::onNewConnection(){
+    while(this->hasPendingConnections())
+    {
+        QTcpSocket *socket = this->nextPendingConnection();
+        connect(socket, &QTcpSocket::disconnected, socket, &QTcpSocket::deleteLater);
+        connect(socket, &QTcpSocket::readyRead, socket, [=](){
+            if(socket->property("answered").toBool())
+                return;
+            QByteArray request = socket->peek(HTTP_MAX_REQUEST);
+            if(!request.contains("\r\n\r\n") && request.size() < HTTP_MAX_REQUEST)
+                return;
+            socket->readAll();
+            socket->setProperty("answered", true);
+
+            QList<QByteArray> requestLine = request.left(request.indexOf("\r\n")).split(' ');
+            socket->write(this->response(requestLine.size() > 1? QString::fromLatin1(requestLine.at(1)) : QString("/")));
+            socket->disconnectFromHost();
+        });
+    }
+}
+
+QByteArray bench::CtLogStub::response(const QString &path) const {
+    QUrl url("http://stub"+path);
+    QUrlQuery query(url);
+    QByteArray status("200 OK");
+    QJsonObject body;
+
+    if(url.path() == "/ct/v1/get-sth"){
+        body.insert("tree_size", static_cast<double>(m_size));
+        body.insert("timestamp", 0);
+        body.insert("sha256_root_hash", "");
+        body.insert("tree_head_signature", "");
+    }
+    else if(url.path() == "/ct/v1/get-entries"){
+        bool startOk = false, endOk = false;
+        qint64 start = query.queryItemValue("start").toLongLong(&startOk);
+        qint64 end = query.queryItemValue("end").toLongLong(&endOk);
+        if(!startOk || !endOk || start < 0 || end < start || start >= m_size)
+            status = "400 Bad Request";
+        else {
+            /* capped like the real logs, the client asks again for the rest */
+            end = qMin(qMin(end, m_size-1), start+STUB_CT_MAX_ENTRIES-1);
+
+            QJsonArray entries;
+            for(qint64 i = start; i <= end; i++)
+                entries.append(QJsonObject{{"leaf_input", QString::fromLatin1(bench::ctLeaf(i).toBase64())},
+                                           {"extra_data", ""}});
+            body.insert("entries", entries);
+        }
+    }
+    else
+        status = "404 Not Found";
+
+    QByteArray data = QJsonDocument(body).toJson(QJsonDocument::Compact);
+    return "HTTP/1.1 "+status+"\r\n"
+           "Server: s3s-stub\r\n"
+           "Content-Type: application/json\r\n"
+           "Connection: close\r\n"
+           "Content-Length: "+QByteArray::number(data.size())+"\r\n\r\n"+data;
+}
+
+///
+/// smtp...
+///
+
+bench::SmtpStub::SmtpStub(const QSet<QString> &mailboxes, const QSet<QString> &catchAllDomains, QObject *parent): QTcpServer(parent),
+    m_mailboxes(mailboxes),
+    m_catchAllDomains(catchAllDomains)
+{
+    connect(this, &QTcpServer::newConnection, this, &bench::SmtpStub::onNewConnection);
+}
+
+void bench::SmtpStub::start(){
+    if(!this->listen(QHostAddress::LocalHost))
+        error = "smtp stub: "+this->errorString();
+}
+
+void bench::SmtpStub::stop(){
+    this->close();
+}
+
+void bench::SmtpStub::onNewConnection(){
+    while(this->hasPendingConnections())
+    {
+        QTcpSocket *socket = this->nextPendingConnection();
+        connect(socket, &QTcpSocket::disconnected, socket, &QTcpSocket::deleteLater);
+        connect(socket, &QTcpSocket::readyRead, socket, [=](){
+            /* the pipelined commands are answered together, in their order */
+            QByteArray replies;
+            while(socket->canReadLine() && !socket->property("quit").toBool())
+                replies.append(this->reply(socket, socket->readLine(SMTP_MAX_LINE).trimmed()));
+            if(!replies.isEmpty())
+                socket->write(replies);
+            if(socket->property("quit").toBool())
+                socket->disconnectFromHost();
+        });
+        socket->write("220 s3s-stub ESMTP\r\n");
+    }
+}
+
+QByteArray bench::SmtpStub::reply(QTcpSocket *socket, const QByteArray &command) const {
+    QByteArray verb = command.left(command.indexOf(' ')).toUpper();
+
+    if(verb == "EHLO")
+        return "250-s3s-stub\r\n250-PIPELINING\r\n250 8BITMIME\r\n";
+    if(verb == "HELO" || verb == "NOOP")
+        return "250 s3s-stub\r\n";
+    if(verb == "MAIL"){
+        socket->setProperty("mail", true);
+        return "250 2.1.0 Ok\r\n";
+    }
+    if(verb == "RSET"){
+        socket->setProperty("mail", false);
+        return "250 2.0.0 Ok\r\n";
+    }
+    if(verb == "QUIT"){
+        socket->setProperty("quit", true);
+        return "221 2.0.0 Bye\r\n";
+    }
+    if(verb == "RCPT"){
+        if(!socket->property("mail").toBool())
+            return "503 5.5.1 Error: need MAIL command\r\n";
+
+        int start = command.indexOf('<');
+        int end = command.indexOf('>', start);
+        if(start < 0 || end < 0)
+            return "501 5.1.3 Bad recipient address syntax\r\n";
+
+        QString address = QString::fromUtf8(command.mid(start+1, end-start-1)).toLower();
+        if(m_mailboxes.contains(address) || m_catchAllDomains.contains(address.mid(address.lastIndexOf('@')+1)))
+            return "250 2.1.5 Ok\r\n";
+        return "550 5.1.1 User unknown\r\n";
+    }
+    return "502 5.5.2 Error: command not recognized\r\n";
+}
+
+///
+/// stubs...
+///
+
+bench::Stubs::Stubs(const bench::StubConfig &config): QObject(nullptr),
+    m_config(config)
+{
+}
+
+void bench::Stubs::start(){
+    QStringList errors;
+
+    /* QDnsLookup only queries nameservers on port 53 */
+    dns = new bench::DnsStub(m_config, &arrivals, this);
+    if(!dns->listen(QHostAddress::LocalHost, 53)){
+        errors.append("dns stub: "+dns->errorString());
+        delete dns;
+        dns = nullptr;
+    }
+
+    http = new bench::HttpStub(m_config, &arrivals, this);
+    if(!http->listen(QHostAddress::LocalHost)){
+        errors.append("http stub: "+http->errorString());
+        delete http;
+        http = nullptr;
+    }
+
+    /* the ssl scanner connects to the well known ports only */
+    tls = new bench::TlsStub(m_config, this);
+    if(!tls->loadCertificate()){
+        errors.append("tls stub: cannot load the certificate");
+        delete tls;
+        tls = nullptr;
+    }
+    else if(!tls->listen(QHostAddress::LocalHost, 443)){
+        errors.append("tls stub: "+tls->errorString());
+        delete tls;
+        tls = nullptr;
+    }
+
+    tcp = new bench::TcpFarm(m_config, this);
+    if(!tcp->listen(QHostAddress::LocalHost)){
+        errors.append("tcp stub: cannot listen");
+        delete tcp;
+        tcp = nullptr;
+    }
+
+    error = errors.join(", ");
+}
+
+void bench::Stubs::stop(){
+    delete dns;
+    delete http;
+    delete tls;
+    delete tcp;
+    dns = nullptr;
+    http = nullptr;
+    tls = nullptr;
+    tcp = nullptr;
+}
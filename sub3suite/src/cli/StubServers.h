@@ -0,0 +1,199 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : local stub servers for the scanner benchmarks, an authoritative dns server, an http server,
+          a tls server, a farm of tcp listeners, a certificate transparency log & an smtp server, all on
+          the loopback interface.
+*/
+
+#ifndef STUBSERVERS_H
+#define STUBSERVERS_H
+
+#include <QUrl>
+#include <QSet>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QUdpSocket>
+#include <QTcpServer>
+#include <QSslKey>
+#include <QSslCertificate>
+#include <QStringList>
+
+/* the zone served by the dns stub */
+#define STUB_ZONE "bench.test"
+
+/* labels starting with this prefix resolve, all other names are NXDOMAIN */
+#define STUB_LIVE_PREFIX "live"
+
+/* address every name of a wildcard zone resolves to */
+#define STUB_WILDCARD_ADDRESS "10.255.255.1"
+
+
+namespace bench {
+
+/* nanoseconds on a clock shared by the stubs & the benchmarks */
+qint64 now();
+
+struct StubConfig {
+    int latency = 0;    // milliseconds before every reply
+    double loss = 0;    // percentage of the dns queries dropped
+    QStringList wildcardZones; // zones where every name resolves
+    int tcpListeners = 16;
+};
+
+/* arrival times of the first request for each name or path, for the client side latencies */
+class ArrivalLog {
+    public:
+        void insert(const QString &key);
+        qint64 value(const QString &key); // -1 if never received
+        int size();
+        void clear();
+
+    private:
+        QMutex m_mutex;
+        QHash<QString, qint64> m_arrivals;
+};
+
+class DnsStub : public QObject {
+    Q_OBJECT
+
+    public:
+        DnsStub(const bench::StubConfig &config, bench::ArrivalLog *arrivals, QObject *parent = nullptr);
+        bool listen(const QHostAddress &address, quint16 port = 53);
+        QString errorString() const { return m_socket.errorString(); }
+
+    private slots:
+        void onReadyRead();
+
+    private:
+        bench::StubConfig m_config;
+        bench::ArrivalLog *m_arrivals;
+        QUdpSocket m_socket;
+
+        QByteArray reply(const QByteArray &query) const;
+};
+
+class HttpStub : public QTcpServer {
+    Q_OBJECT
+
+    public:
+        HttpStub(const bench::StubConfig &config, bench::ArrivalLog *arrivals, QObject *parent = nullptr);
+
+    private slots:
+        void onNewConnection();
+
+    private:
+        bench::StubConfig m_config;
+        bench::ArrivalLog *m_arrivals;
+};
+
+class TlsStub : public QTcpServer {
+    Q_OBJECT
+
+    public:
+        TlsStub(const bench::StubConfig &config, QObject *parent = nullptr);
+        bool loadCertificate(); // the bundled self-signed certificate of localhost
+        QSslCertificate certificate() const { return m_certificate; }
+
+    protected:
+        void incomingConnection(qintptr socketDescriptor) override;
+
+    private:
+        bench::StubConfig m_config;
+        QSslCertificate m_certificate;
+        QSslKey m_key;
+};
+
+class TcpFarm : public QObject {
+    Q_OBJECT
+
+    public:
+        TcpFarm(const bench::StubConfig &config, QObject *parent = nullptr);
+        bool listen(const QHostAddress &address);
+        QList<quint16> ports() const;
+
+    private:
+        bench::StubConfig m_config;
+        QList<QTcpServer*> m_servers;
+};
+
+/* a certificate transparency log of synthetic certificates for the ct tailer, started on its own thread */
+class CtLogStub : public QTcpServer {
+    Q_OBJECT
+
+    public:
+        explicit CtLogStub(qint64 size, QObject *parent = nullptr);
+
+        QString error; // why the stub failed to start
+        QUrl url() const; // the log's base url
+
+    public slots:
+        void start();
+        void stop();
+
+    private slots:
+        void onNewConnection();
+
+    private:
+        qint64 m_size; // the tree size
+
+        QByteArray response(const QString &path) const;
+};
+
+/* the leaf_input of a synthetic log entry, a certificate of ct<index>.STUB_ZONE & www.ct<index>.STUB_ZONE */
+QByteArray ctLeaf(qint64 index);
+
+/*
+ * an smtp server with pipelining for the email verifier, started on its own thread. it accepts the
+ * recipients of its mailboxes & any recipient of its catch-all domains.
+ */
+class SmtpStub : public QTcpServer {
+    Q_OBJECT
+
+    public:
+        SmtpStub(const QSet<QString> &mailboxes, const QSet<QString> &catchAllDomains, QObject *parent = nullptr);
+
+        QString error; // why the stub failed to start
+
+    public slots:
+        void start();
+        void stop();
+
+    private slots:
+        void onNewConnection();
+
+    private:
+        QSet<QString> m_mailboxes;
+        QSet<QString> m_catchAllDomains;
+
+        QByteArray reply(QTcpSocket *socket, const QByteArray &command) const;
+};
+
+/* all the stubs, started on their own thread */
+class Stubs : public QObject {
+    Q_OBJECT
+
+    public:
+        explicit Stubs(const bench::StubConfig &config);
+
+        bench::ArrivalLog arrivals;
+        QString error; // why a stub failed to start
+
+        bench::DnsStub *dns = nullptr;
+        bench::HttpStub *http = nullptr;
+        bench::TlsStub *tls = nullptr;
+        bench::TcpFarm *tcp = nullptr;
+
+    public slots:
+        void start();
+        void stop();
+
+    private:
+        bench::StubConfig m_config;
+};
+
+}
+
+#endif // STUBSERVERS_H
@@ -0,0 +1,111 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief :
+*/
+
+#include "CtLogDialog.h"
+#include "ui_CtLogDialog.h"
+
+#include <QDateTime>
+#include <QMessageBox>
+#include "src/utils/Config.h"
+
+
+CtLogDialog::CtLogDialog(ProjectModel *project, QWidget *parent): QDialog(parent),
+    ui(new Ui::CtLogDialog),
+    m_project(project)
+{
+    ui->setupUi(this);
+    this->setWindowIcon(QIcon(":/img/res/icons/ssl.png"));
+
+    ui->lineEditDomains->setPlaceholderText("example.com, example.org");
+    ui->spinBoxBacklog->setValue(CT_BACKLOG);
+    ui->buttonStop->setDisabled(true);
+
+    /* the logs of the last tail */
+    QStringList logs;
+    int size = CONFIG.beginReadArray(CFG_GRP_CT_LOGS);
+    for(int i = 0; i < size; ++i){
+        CONFIG.setArrayIndex(i);
+        logs.append(CONFIG.value("value").toString());
+    }
+    CONFIG.endArray();
+    ui->plainTextEditLogs->setPlainText(logs.join("\n"));
+}
+CtLogDialog::~CtLogDialog(){
+    delete m_tailer;
+    delete ui;
+}
+
+void CtLogDialog::on_buttonStart_clicked(){
+    ct::Config config;
+    foreach(const QString &log, ui->plainTextEditLogs->toPlainText().split('\n', QString::SkipEmptyParts)){
+        QUrl url(log.trimmed());
+        if(url.isValid() && (url.scheme() == "https" || url.scheme() == "http"))
+            config.logs.append(url);
+    }
+    if(config.logs.isEmpty()){
+        QMessageBox::warning(this, tr("Error!"), tr("Please Enter the Base URLs of the Logs!"));
+        return;
+    }
+    config.domains = ui->lineEditDomains->text().split(',', QString::SkipEmptyParts);
+    if(config.domains.isEmpty()){
+        QMessageBox::warning(this, tr("Error!"), tr("Please Enter the Domains to Monitor!"));
+        return;
+    }
+    config.backlog = ui->spinBoxBacklog->value();
+    config.follow = ui->checkBoxFollow->isChecked();
+
+    /* the logs are kept for the next tail */
+    CONFIG.beginWriteArray(CFG_GRP_CT_LOGS);
+    for(int i = 0; i < config.logs.size(); ++i){
+        CONFIG.setArrayIndex(i);
+        CONFIG.setValue("value", config.logs.at(i).toString());
+    }
+    CONFIG.endArray();
+
+    delete m_tailer;
+    m_tailer = new ct::Tailer(config);
+    connect(m_tailer, &ct::Tailer::result, this, &CtLogDialog::onResult);
+    connect(m_tailer, &ct::Tailer::progress, this, &CtLogDialog::onProgress);
+    connect(m_tailer, &ct::Tailer::error, this, &CtLogDialog::onError);
+    connect(m_tailer, &ct::Tailer::finished, this, &CtLogDialog::onFinished);
+
+    m_results = 0;
+    ui->labelResults->setNum(0);
+    ui->buttonStart->setDisabled(true);
+    ui->buttonStop->setEnabled(true);
+    ui->plainTextEditStatus->appendPlainText(QDateTime::currentDateTime().toString("hh:mm:ss  ")+"started");
+
+    m_tailer->start();
+}
+
+void CtLogDialog::on_buttonStop_clicked(){
+    m_tailer->stop();
+    this->onFinished();
+}
+
+void CtLogDialog::onResult(const QString &name, const QString &log, qint64 index){
+    Q_UNUSED(log)
+    Q_UNUSED(index)
+
+    m_project->addPassiveSubdomain(name);
+    ui->labelResults->setNum(++m_results);
+}
+
+void CtLogDialog::onProgress(const QString &log, qint64 index, qint64 size){
+    ui->labelProgress->setText(QString("%1  %2/%3").arg(log).arg(index).arg(size));
+}
+
+void CtLogDialog::onError(const QString &log, const QString &message){
+    ui->plainTextEditStatus->appendPlainText(QDateTime::currentDateTime().toString("hh:mm:ss  ")+log+": "+message);
+}
+
+void CtLogDialog::onFinished(){
+    ui->plainTextEditStatus->appendPlainText(QDateTime::currentDateTime().toString("hh:mm:ss  ")+
+                                             QString("ended, %1 entries parsed").arg(m_tailer->parsed()));
+    ui->buttonStart->setEnabled(true);
+    ui->buttonStop->setDisabled(true);
+}
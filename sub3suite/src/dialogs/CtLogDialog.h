@@ -0,0 +1,43 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : tails certificate transparency logs into the project, the names under the monitored apex
+          domains are added to the project's subdomains as the logs' entries are parsed.
+*/
+
+#ifndef CTLOGDIALOG_H
+#define CTLOGDIALOG_H
+
+#include <QDialog>
+#include "src/models/ProjectModel.h"
+#include "src/modules/ct/CtTailer.h"
+
+
+namespace Ui {
+class CtLogDialog;
+}
+
+class CtLogDialog : public QDialog{
+        Q_OBJECT
+
+    public:
+        explicit CtLogDialog(ProjectModel *project, QWidget *parent = nullptr);
+        ~CtLogDialog();
+
+    private slots:
+        void on_buttonStart_clicked();
+        void on_buttonStop_clicked();
+        void onResult(const QString &name, const QString &log, qint64 index);
+        void onProgress(const QString &log, qint64 index, qint64 size);
+        void onError(const QString &log, const QString &message);
+        void onFinished();
+
+    private:
+        Ui::CtLogDialog *ui;
+        ProjectModel *m_project;
+        ct::Tailer *m_tailer = nullptr;
+        int m_results = 0;
+};
+
+#endif // CTLOGDIALOG_H
@@ -11,6 +11,12 @@
 #include <QDir>
 #include <QDateTime>
 
+/* only the end of a large logfile is loaded */
+#define LOG_VIEW_MAX_BYTES (1024*1024)
+
+/* milliseconds between the checks for new lines in the current logfile */
+#define LOG_TAIL_INTERVAL 1000
+
 
 LogViewerDialog::LogViewerDialog(QWidget *parent): QDialog(parent),
     ui(new Ui::LogViewerDialog)
@@ -20,12 +26,7 @@ LogViewerDialog::LogViewerDialog(QWidget *parent): QDialog(parent),
 
     /* loading the current logfile to the editor */
     QString currentFile(QDateTime::currentDateTime().toString("dd-MM-yyyy"));
-    QFile logfile(QApplication::applicationDirPath()+"/logs/"+currentFile+".log");
-
-    if(logfile.open(QIODevice::ReadOnly | QIODevice::Text)){
-        ui->plainTextEdit->appendPlainText(logfile.readAll());
-        logfile.close();
-    }
+    this->loadLogfile(QApplication::applicationDirPath()+"/logs/"+currentFile+".log");
 
     /* loading all available logfiles names */
     QDir logsDir(QApplication::applicationDirPath()+"/logs");
@@ -35,30 +36,76 @@ LogViewerDialog::LogViewerDialog(QWidget *parent): QDialog(parent),
 
     /* syntax higlighting... */
     m_logsSyntaxHighlighter = new LogsSyntaxHighlighter(ui->plainTextEdit->document());
+
+    /* new lines of the current logfile are appended as they are written */
+    connect(&m_tailTimer, &QTimer::timeout, this, &LogViewerDialog::onTail);
+    m_tailTimer.start(LOG_TAIL_INTERVAL);
 }
 LogViewerDialog::~LogViewerDialog(){
+    m_tailTimer.stop();
     delete m_logsSyntaxHighlighter;
     delete ui;
 }
 
 void LogViewerDialog::on_comboBoxLogFile_currentIndexChanged(int index){
-    /* get logfile name */
+    /* get logfile name, only the current logfile is tailed */
     QString logfileName;
     switch (index) {
     case 0:
         logfileName = QString("%1.log").arg(QDateTime::currentDateTime().toString("dd-MM-yyyy"));
+        m_tailTimer.start(LOG_TAIL_INTERVAL);
         break;
     default:
         logfileName = ui->comboBoxLogFile->currentText();
+        m_tailTimer.stop();
         break;
     }
 
-    /* clear editor then load the logfile to the editor */
+    this->loadLogfile(QApplication::applicationDirPath()+"/logs/"+logfileName);
+}
+
+void LogViewerDialog::loadLogfile(const QString &path){
+    /* clear editor then load the end of the logfile to the editor */
     ui->plainTextEdit->clear();
-    QFile logfile(QApplication::applicationDirPath()+"/logs/"+logfileName);
-    if(logfile.open(QIODevice::ReadOnly | QIODevice::Text))
-    {
-        ui->plainTextEdit->appendPlainText(logfile.readAll());
-        logfile.close();
+    m_logfile = path;
+    m_position = 0;
+
+    QFile logfile(path);
+    if(!logfile.open(QIODevice::ReadOnly))
+        return;
+
+    if(logfile.size() > LOG_VIEW_MAX_BYTES){
+        /* starting from a whole line */
+        logfile.seek(logfile.size()-LOG_VIEW_MAX_BYTES);
+        logfile.readLine();
+    }
+    m_position = logfile.pos();
+    logfile.close();
+
+    this->onTail();
+}
+
+void LogViewerDialog::onTail(){
+    QFile logfile(m_logfile);
+    if(!logfile.open(QIODevice::ReadOnly))
+        return;
+
+    /* the logfile was rotated, the new one is loaded from its start */
+    if(logfile.size() < m_position){
+        ui->plainTextEdit->clear();
+        m_position = 0;
     }
+    if(logfile.size() == m_position)
+        return;
+
+    /* appending the new whole lines, a partly written line is read on the next check */
+    logfile.seek(m_position);
+    QByteArray lines = logfile.read(logfile.size()-m_position);
+    int end = lines.lastIndexOf('\n');
+    if(end == -1)
+        return;
+    lines.truncate(end);
+    m_position += end+1;
+
+    ui->plainTextEdit->appendPlainText(QString::fromUtf8(lines));
 }
@@ -9,6 +9,7 @@
 #define LOGVIEWERDIALOG_H
 
 #include <QDialog>
+#include <QTimer>
 #include "src/utils/LogsSyntaxHighlighter.h"
 
 
@@ -25,10 +26,18 @@ class LogViewerDialog : public QDialog{
 
     private slots:
         void on_comboBoxLogFile_currentIndexChanged(int index);
+        void onTail(); // appends the new lines of the logfile
 
     private:
         Ui::LogViewerDialog *ui;
         LogsSyntaxHighlighter *m_logsSyntaxHighlighter;
+
+        /* for tailing the logfile */
+        QTimer m_tailTimer;
+        QString m_logfile;
+        qint64 m_position = 0;
+
+        void loadLogfile(const QString &path);
 };
 
 #endif // LOGVIEWERDIALOG_H
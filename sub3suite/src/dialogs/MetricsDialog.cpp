@@ -0,0 +1,117 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : live view of the scanners' metrics, refreshed every second & exported as json or prometheus text.
+*/
+
+#include "MetricsDialog.h"
+#include "ui_MetricsDialog.h"
+
+#include <QFile>
+#include <QDebug>
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QJsonDocument>
+
+#define REFRESH_INTERVAL 1000
+
+/* the table's columns */
+#define COL_SCANNER 0
+#define COL_RESULTS 1
+#define COL_RATE 2
+#define COL_BACKLOG 3
+#define COL_FIRST_HISTOGRAM 4
+
+
+MetricsDialog::MetricsDialog(QWidget *parent): QDialog(parent),
+    ui(new Ui::MetricsDialog),
+    m_model(new QStandardItemModel(this))
+{
+    ui->setupUi(this);
+    this->setWindowIcon(QIcon(":/img/res/icons/log.png"));
+
+    /* a column for each histogram's p50/p99 */
+    QStringList labels{"Scanner", "Results", "Results/sec", "Backlog"};
+    for(int j = 0; j < static_cast<int>(metrics::HISTOGRAM::END); j++){
+        QString name = metrics::name(static_cast<metrics::HISTOGRAM>(j));
+        labels << name+" p50" << name+" p99";
+    }
+    m_model->setHorizontalHeaderLabels(labels);
+
+    for(int i = 0; i < static_cast<int>(metrics::SCANNER::END); i++){
+        QList<QStandardItem*> row;
+        for(int column = 0; column < labels.size(); column++)
+            row.append(new QStandardItem);
+        row.first()->setText(metrics::name(static_cast<metrics::SCANNER>(i)));
+        m_model->appendRow(row);
+
+        m_results[i] = metrics::results(static_cast<metrics::SCANNER>(i));
+    }
+    ui->tableView->setModel(m_model);
+    ui->tableView->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+
+    m_refreshed = metrics::now();
+    connect(&m_timer, &QTimer::timeout, this, &MetricsDialog::onRefresh);
+    m_timer.start(REFRESH_INTERVAL);
+    this->onRefresh();
+}
+MetricsDialog::~MetricsDialog(){
+    m_timer.stop();
+    delete ui;
+}
+
+void MetricsDialog::onRefresh(){
+    qint64 now = metrics::now();
+    double seconds = (now-m_refreshed)/1000000000.0;
+    m_refreshed = now;
+
+    for(int i = 0; i < static_cast<int>(metrics::SCANNER::END); i++)
+    {
+        metrics::SCANNER scanner = static_cast<metrics::SCANNER>(i);
+
+        /* results per second since the last refresh */
+        quint64 results = metrics::results(scanner);
+        double rate = (seconds > 0 && results >= m_results[i])? (results-m_results[i])/seconds : 0;
+        m_results[i] = results;
+
+        m_model->item(i, COL_RESULTS)->setText(QString::number(results));
+        m_model->item(i, COL_RATE)->setText(QString::number(rate, 'f', 1));
+        m_model->item(i, COL_BACKLOG)->setText(QString::number(metrics::backlog(scanner)));
+
+        for(int j = 0; j < static_cast<int>(metrics::HISTOGRAM::END); j++){
+            metrics::Snapshot snapshot = metrics::histogram(scanner, static_cast<metrics::HISTOGRAM>(j)).snapshot();
+            m_model->item(i, COL_FIRST_HISTOGRAM+j*2)->setText(QString::number(snapshot.p50));
+            m_model->item(i, COL_FIRST_HISTOGRAM+j*2+1)->setText(QString::number(snapshot.p99));
+        }
+    }
+}
+
+void MetricsDialog::on_buttonExportJson_clicked(){
+    this->exportToFile(QJsonDocument(metrics::toJson()).toJson());
+}
+
+void MetricsDialog::on_buttonExportPrometheus_clicked(){
+    this->exportToFile(metrics::toPrometheus().toUtf8());
+}
+
+void MetricsDialog::on_buttonReset_clicked(){
+    metrics::reset();
+    for(int i = 0; i < static_cast<int>(metrics::SCANNER::END); i++)
+        m_results[i] = 0;
+    this->onRefresh();
+}
+
+void MetricsDialog::exportToFile(const QByteArray &data){
+    QString filename = QFileDialog::getSaveFileName(this, tr("Save To File"), "./");
+    if(filename.isEmpty())
+        return;
+
+    QFile file(filename);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Text)){
+        qWarning() << "Metrics: Failed to open " << filename << " For saving the metrics";
+        return;
+    }
+    file.write(data);
+    file.close();
+}
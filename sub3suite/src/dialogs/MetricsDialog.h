@@ -0,0 +1,46 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : live view of the scanners' metrics, refreshed every second & exported as json or prometheus text.
+*/
+
+#ifndef METRICSDIALOG_H
+#define METRICSDIALOG_H
+
+#include <QDialog>
+#include <QTimer>
+#include <QStandardItemModel>
+#include "src/utils/Metrics.h"
+
+
+namespace Ui {
+class MetricsDialog;
+}
+
+class MetricsDialog : public QDialog{
+        Q_OBJECT
+
+    public:
+        explicit MetricsDialog(QWidget *parent = nullptr);
+        ~MetricsDialog();
+
+    private slots:
+        void onRefresh();
+        void on_buttonExportJson_clicked();
+        void on_buttonExportPrometheus_clicked();
+        void on_buttonReset_clicked();
+
+    private:
+        Ui::MetricsDialog *ui;
+        QStandardItemModel *m_model;
+        QTimer m_timer;
+
+        /* for results per second */
+        quint64 m_results[static_cast<int>(metrics::SCANNER::END)];
+        qint64 m_refreshed;
+
+        void exportToFile(const QByteArray &data);
+};
+
+#endif // METRICSDIALOG_H
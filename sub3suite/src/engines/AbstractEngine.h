@@ -42,11 +42,6 @@ class AbstractEngine : public QWidget{
         QItemSelectionModel *selectionModel = nullptr;
 
     signals:
-        /* signals to scanner threads */
-        void stopScanThread();
-        void pauseScanThread();
-        void resumeScanThread();
-
         /* status To mainwindow */
         void sendStatus(QString status);
 
@@ -25,6 +25,9 @@ Active::Active(QWidget *parent, ProjectModel *project) : AbstractEngine(parent,
 {
     this->initUI();
 
+    /* the scan's workers */
+    connect(&m_executor, &ScanExecutor::finished, this, &Active::onScanEnded);
+
     /* list model */
     ui->targets->setListName(tr("Targets"));
     ui->targets->setListModel(m_targetListModel);
@@ -42,6 +45,7 @@ Active::Active(QWidget *parent, ProjectModel *project) : AbstractEngine(parent,
     this->initConfigValues();
 }
 Active::~Active(){
+    m_executor.shutdown();
     delete m_model;
     delete m_targetListModel;
     delete m_scanStats;
@@ -128,7 +132,7 @@ void Active::on_buttonStart_clicked(){
         status->isNotActive = false;
 
         /* pause scan */
-        emit pauseScanThread();
+        m_executor.pause();
 
         /* logs */
         log("------------------ Paused ----------------");
@@ -148,7 +152,7 @@ void Active::on_buttonStart_clicked(){
         status->isNotActive = false;
 
         /* resume scan */
-        emit resumeScanThread();
+        m_executor.resume();
 
         /* logs */
         log("------------------ Resumed ----------------");
@@ -157,10 +161,7 @@ void Active::on_buttonStart_clicked(){
 }
 
 void Active::on_buttonStop_clicked(){
-    if(status->isPaused)
-        emit resumeScanThread();
-
-    emit stopScanThread();
+    m_executor.stop();
 
     status->isStopped = true;
     status->isPaused = false;
@@ -175,28 +176,7 @@ void Active::on_buttonConfig_clicked(){
 }
 
 void Active::initConfigValues(){
-    CONFIG.beginGroup(CFG_ACTIVE);
-    m_scanArgs->config->timeout = CONFIG.value(CFG_VAL_TIMEOUT).toInt();
-    m_scanArgs->config->threads = CONFIG.value(CFG_VAL_THREADS).toInt();
-    m_scanArgs->config->noDuplicates = CONFIG.value(CFG_VAL_DUPLICATES).toBool();
-    m_scanArgs->config->autoSaveToProject = CONFIG.value(CFG_VAL_AUTOSAVE).toBool();
-    m_scanArgs->config->setTimeout = CONFIG.value(CFG_VAL_SETTIMEOUT).toBool();
-    QString record = CONFIG.value(CFG_VAL_RECORD).toString();
-    CONFIG.endGroup();
-
-    if(record == "A")
-        m_scanArgs->config->recordType = QDnsLookup::A;
-    if(record == "AAAA")
-        m_scanArgs->config->recordType = QDnsLookup::AAAA;
-    if(record == "ANY")
-        m_scanArgs->config->recordType = QDnsLookup::ANY;
-
-    int size = CONFIG.beginReadArray("nameservers_active");
-    for (int i = 0; i < size; ++i) {
-        CONFIG.setArrayIndex(i);
-        m_scanArgs->config->nameservers.enqueue(CONFIG.value("value").toString());
-    }
-    CONFIG.endArray();
+    active::loadConfig(m_scanArgs->config);
 }
 
 void Active::log(QString log){
@@ -220,9 +200,15 @@ void Active::on_comboBoxOption_currentIndexChanged(int index){
     switch (index) {
     case 0: // ACTIVE DNS
         ui->framePort->hide();
+        ui->lineEditTarget->setPlaceholderText(tr(PLACEHOLDERTEXT_DOMAIN));
         break;
     case 1: // ACTIVE PORT
         ui->framePort->show();
+        ui->lineEditTarget->setPlaceholderText(tr(PLACEHOLDERTEXT_DOMAIN));
+        break;
+    case 2: // PTR SWEEP
+        ui->framePort->hide();
+        ui->lineEditTarget->setPlaceholderText(tr(PLACEHOLDERTEXT_CIDR));
         break;
     }
 }
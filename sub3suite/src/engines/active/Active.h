@@ -16,6 +16,7 @@
 #include "../AbstractEngine.h"
 #include "src/utils/utils.h"
 #include "src/modules/active/ActiveScanner.h"
+#include "src/modules/active/ScanExecutor.h"
 
 
 namespace Ui {
@@ -30,10 +31,11 @@ class Active : public AbstractEngine{
         ~Active();
 
     public slots:
-        void onScanThreadEnded();
+        void onScanEnded();
         void onScanLog(scan::Log log);
         void onScanResult_dns(s3s_struct::HOST host);
         void onScanResult_port(s3s_struct::HOST host);
+        void onScanResult_ptr(s3s_struct::HOST host);
         void onReScan(QQueue<QString> targets);
 
         /* receiving targets from other engines */
@@ -52,6 +54,7 @@ class Active : public AbstractEngine{
     private:
         Ui::Active *ui;
         QElapsedTimer m_timer;
+        ScanExecutor m_executor;
         QMap<QString,QString> m_failedScans;
         QMap<QString, s3s_item::HOST*> set_subdomain;
         active::ScanConfig *m_scanConfig;
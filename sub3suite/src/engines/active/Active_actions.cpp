@@ -416,8 +416,19 @@ void Active::sendSelectedToEnum(const ENUMERATOR &tool){
 ///
 
 void Active::onReceiveTargets(QSet<QString> targets, RESULT_TYPE resultType){
-    if(resultType == RESULT_TYPE::SUBDOMAIN)
+    switch (resultType) {
+    case RESULT_TYPE::SUBDOMAIN:
+        ui->targets->add(targets);
+        break;
+    case RESULT_TYPE::IP:
+    case RESULT_TYPE::CIDR:
+        /* addresses & ranges are swept for their PTR records */
+        ui->comboBoxOption->setCurrentIndex(2);
         ui->targets->add(targets);
+        break;
+    default:
+        break;
+    }
 
     /* set multiple targets checkbox checked */
     ui->checkBoxMultipleTargets->setChecked(true);
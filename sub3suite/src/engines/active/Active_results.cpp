@@ -7,6 +7,7 @@
 
 #include "Active.h"
 #include "ui_Active.h"
+#include "src/utils/ReverseIndex.h"
 
 
 void Active::onScanLog(scan::Log log){
@@ -43,6 +44,8 @@ void Active::onScanResult_port(s3s_struct::HOST host){
 }
 
 void Active::onScanResult_dns(s3s_struct::HOST host){
+    s3s_ReverseIndex::instance().insert(host);
+
     if(set_subdomain.contains(host.host)) // for existing entry...
     {
         s3s_item::HOST *item = set_subdomain.value(host.host);
@@ -76,3 +79,30 @@ void Active::onScanResult_dns(s3s_struct::HOST host){
     if(m_scanConfig->autoSaveToProject)
         project->addActiveHost(host);
 }
+
+void Active::onScanResult_ptr(s3s_struct::HOST host){
+    s3s_ReverseIndex::instance().insert(host);
+
+    if(set_subdomain.contains(host.host)) // for existing entry...
+    {
+        s3s_item::HOST *item = set_subdomain.value(host.host);
+        if(!host.ipv4.isEmpty())
+            item->setValue_ipv4(host.ipv4);
+        if(!host.ipv6.isEmpty())
+            item->setValue_ipv6(host.ipv6);
+    }
+    else // for new entry...
+    {
+        s3s_item::HOST *item = new s3s_item::HOST;
+        item->setValues(host);
+        m_model->appendRow({item, item->ipv4, item->ipv6, item->ports});
+        set_subdomain.insert(host.host, item);
+
+        ui->labelResultsCount->setNum(proxyModel->rowCount());
+        m_scanStats->resolved++;
+    }
+
+    /* save to Project model */
+    if(m_scanConfig->autoSaveToProject)
+        project->addActiveHost(host);
+}
@@ -10,8 +10,10 @@
 
 #include <QTime>
 #include <QThread>
+#include <climits>
 #include "src/dialogs/FailedScansDialog.h"
 #include "src/modules/active/PortScanner.h"
+#include "src/modules/active/PTRScanner.h"
 
 
 void Active::startScan(){
@@ -28,33 +30,41 @@ void Active::startScan(){
     ui->progressBar->show();
     ui->progressBar->reset();
     m_failedScans.clear();
-
-    /*
-     if the numner of threads is greater than the number of wordlists, set the
-     number of threads to use to the number of wordlists available to avoid
-     creating more threads than needed...
-    */
-    if(m_scanArgs->config->threads > m_scanArgs->targets.length())
-        status->activeScanThreads = m_scanArgs->targets.length();
-    else
-        status->activeScanThreads = m_scanArgs->config->threads;
+    m_scanArgs->retries.clear();
+
+    /* the ptr sweep takes its addresses lazily from the ranges */
+    m_scanArgs->ranges.clear();
+    if(ui->comboBoxOption->currentIndex() == 2){
+        /* overlapping & adjacent ranges are swept once */
+        QStringList ranges;
+        while(!m_scanArgs->targets.isEmpty()){
+            QString target = m_scanArgs->targets.dequeue();
+            if(QHostAddress::parseSubnet(target).second < 0 && QHostAddress(target).isNull())
+                log("Invalid range: "+target);
+            else
+                ranges.append(target);
+        }
+        foreach(const QString &range, s3s_CidrIterator::aggregate(ranges)){
+            if(!m_scanArgs->ranges.add(range))
+                log("Range larger than 2^"+QString::number(CIDR_MAX_HOST_BITS)+" addresses: "+range);
+        }
+    }
+    qint64 work = active::prepareScan(m_scanArgs);
 
     /* renewing scan statistics */
     m_scanStats->failed = 0;
     m_scanStats->resolved = 0;
-    m_scanStats->threads = status->activeScanThreads;
-    m_scanStats->targets = m_scanArgs->targets.length();
+    m_scanStats->targets = static_cast<int>(qMin<qint64>(work, INT_MAX));
     m_scanStats->nameservers = m_scanArgs->config->nameservers.length();
 
     /* set progressbar maximum value */
-    ui->progressBar->setMaximum(m_scanArgs->targets.length());
-    m_scanArgs->progress = 0;
+    ui->progressBar->setMaximum(m_scanStats->targets);
 
     /* start timer */
     m_timer.start();
 
     /* getting ports for port-scan */
-    if(ui->comboBoxOption->currentIndex()){
+    if(ui->comboBoxOption->currentIndex() == 1){
         m_scanArgs->ports.clear();
 
         if(ui->radioButtonDefault->isChecked())
@@ -73,46 +83,31 @@ void Active::startScan(){
         }
     }
 
-    /* loop to create threads for enumeration... */
-    for(int i = 0; i < status->activeScanThreads; i++)
-    {
-        switch (ui->comboBoxOption->currentIndex()) {
-        case 0: // ACTIVE DNS
-        {
-            active::Scanner *scanner = new active::Scanner(m_scanArgs);
-            QThread *cThread = new QThread;
-            scanner->startScan(cThread);
-            scanner->moveToThread(cThread);
-            connect(scanner, &active::Scanner::scanResult, this, &Active::onScanResult_dns);
+    /* the threads for enumeration, not more than the targets... */
+    switch (ui->comboBoxOption->currentIndex()) {
+    case 0: // ACTIVE DNS
+        m_scanStats->threads = m_executor.startScanners<active::Scanner>(m_scanArgs, m_scanArgs->config->threads, work,
+                                                                          [=](active::Scanner *scanner){
+            metrics::connect(metrics::SCANNER::ACTIVE, scanner, &active::Scanner::scanResult, this, &Active::onScanResult_dns);
             connect(scanner, &active::Scanner::scanProgress, ui->progressBar, &QProgressBar::setValue);
             connect(scanner, &active::Scanner::scanLog, this, &Active::onScanLog);
-            connect(cThread, &QThread::finished, this, &Active::onScanThreadEnded);
-            connect(cThread, &QThread::finished, scanner, &active::Scanner::deleteLater);
-            connect(cThread, &QThread::finished, cThread, &QThread::deleteLater);
-            connect(this, &Active::stopScanThread, scanner, &active::Scanner::onStopScan);
-            connect(this, &Active::pauseScanThread, scanner, &active::Scanner::onPauseScan);
-            connect(this, &Active::resumeScanThread, scanner, &active::Scanner::onResumeScan, Qt::DirectConnection);
-            cThread->start();
-            break;
-        }
-        case 1: // ACTIVE PORT
-        {
-            port::Scanner *scanner = new port::Scanner(m_scanArgs);
-            QThread *cThread = new QThread;
-            scanner->startScan(cThread);
-            scanner->moveToThread(cThread);
+        });
+        break;
+    case 1: // ACTIVE PORT
+        m_scanStats->threads = m_executor.startScanners<port::Scanner>(m_scanArgs, m_scanArgs->config->threads, work,
+                                                                        [=](port::Scanner *scanner){
             connect(scanner, &port::Scanner::scanResult, this, &Active::onScanResult_port);
             connect(scanner, &port::Scanner::scanProgress, ui->progressBar, &QProgressBar::setValue);
             connect(scanner, &port::Scanner::scanLog, this, &Active::onScanLog);
-            connect(cThread, &QThread::finished, this, &Active::onScanThreadEnded);
-            connect(cThread, &QThread::finished, scanner, &port::Scanner::deleteLater);
-            connect(cThread, &QThread::finished, cThread, &QThread::deleteLater);
-            connect(this, &Active::stopScanThread, scanner, &port::Scanner::onStopScan);
-            connect(this, &Active::pauseScanThread, scanner, &port::Scanner::onPauseScan);
-            connect(this, &Active::resumeScanThread, scanner, &port::Scanner::onResumeScan, Qt::DirectConnection);
-            cThread->start();
-        }
-        }
+        });
+        break;
+    case 2: // PTR SWEEP
+        m_scanStats->threads = m_executor.startScanners<ptr::Scanner>(m_scanArgs, m_scanArgs->config->threads, work,
+                                                                       [=](ptr::Scanner *scanner){
+            metrics::connect(metrics::SCANNER::ACTIVE, scanner, &ptr::Scanner::scanResult, this, &Active::onScanResult_ptr);
+            connect(scanner, &ptr::Scanner::scanProgress, ui->progressBar, &QProgressBar::setValue);
+            connect(scanner, &ptr::Scanner::scanLog, this, &Active::onScanLog);
+        });
     }
     status->isRunning = true;
 }
@@ -135,44 +130,40 @@ void Active::onReScan(QQueue<QString> targets){
     qInfo() << "[ACTIVE] Re-Scan Started";
 }
 
-void Active::onScanThreadEnded(){
-    status->activeScanThreads--;
-
-    /* if all Scan Threads have finished... */
-    if(status->activeScanThreads == 0)
-    {
-        /* display the scan summary on logs */
-        this->scanSummary();
+void Active::onScanEnded(){
+    /* display the scan summary on logs */
+    this->scanSummary();
 
-        if(status->isStopped)
-            log("---------------- Stopped ------------\n");
-        else
-            log("------------------ End --------------\n");
+    if(status->isStopped)
+        log("---------------- Stopped ------------\n");
+    else
+        log("------------------ End --------------\n");
 
-        qInfo() << "[ACTIVE] Scan Ended";
+    qInfo() << "[ACTIVE] Scan Ended";
 
-        /* set the progress bar to 100% just in case... */
-        if(!status->isStopped)
-            ui->progressBar->setValue(ui->progressBar->maximum());
+    /* set the progress bar to 100% just in case... */
+    if(!status->isStopped)
+        ui->progressBar->setValue(ui->progressBar->maximum());
 
-        m_scanArgs->targets.clear();
+    m_scanArgs->targets.clear();
+    m_scanArgs->retries.clear();
+    m_scanArgs->ranges.clear();
 
-        status->isNotActive = true;
-        status->isPaused = false;
-        status->isStopped = false;
-        status->isRunning = false;
+    status->isNotActive = true;
+    status->isPaused = false;
+    status->isStopped = false;
+    status->isRunning = false;
 
-        ui->buttonStart->setText("Start");
-        ui->buttonStop->setDisabled(true);
+    ui->buttonStart->setText("Start");
+    ui->buttonStop->setDisabled(true);
 
-        // launching the failed scans dialog if there were failed scans
-        if(!m_failedScans.isEmpty()){
-            FailedScansDialog *failedScansDialog = new FailedScansDialog(this, m_failedScans);
-            failedScansDialog->setAttribute(Qt::WA_DeleteOnClose, true);
+    // launching the failed scans dialog if there were failed scans
+    if(!m_failedScans.isEmpty()){
+        FailedScansDialog *failedScansDialog = new FailedScansDialog(this, m_failedScans);
+        failedScansDialog->setAttribute(Qt::WA_DeleteOnClose, true);
 
-            connect(failedScansDialog, &FailedScansDialog::reScan, this, &Active::onReScan);
-            failedScansDialog->show();
-        }
+        connect(failedScansDialog, &FailedScansDialog::reScan, this, &Active::onReScan);
+        failedScansDialog->show();
     }
 }
 
@@ -29,6 +29,9 @@ Brute::Brute(QWidget *parent, ProjectModel *project) : AbstractEngine(parent, pr
 {
     this->iniUI();
 
+    /* the scan's workers */
+    connect(&m_executor, &ScanExecutor::finished, this, &Brute::onScanEnded);
+
     /* list models */
     ui->targets->setListName(tr("Targets"));
     ui->wordlist->setListName(tr("Wordlist"));
@@ -47,11 +50,14 @@ Brute::Brute(QWidget *parent, ProjectModel *project) : AbstractEngine(parent, pr
     this->initConfigValues();
 }
 Brute::~Brute(){
+    m_executor.shutdown();
     delete m_model_tld;
     delete m_model_subdomain;
     delete m_wordlistModel;
     delete m_targetListModel;
     delete m_scanStats;
+    delete m_scanArgs->filter;
+    delete m_scanArgs->permutations;
     delete m_scanArgs;
     delete m_scanConfig;
     delete ui;
@@ -131,23 +137,30 @@ void Brute::on_buttonStart_clicked(){
         /* get wordlist */
         m_scanArgs->wordlist = m_wordlistModel->stringList();
 
+        /* permutations of the known subdomains of the targets, the wordlist are the permutation words */
+        delete m_scanArgs->permutations;
+        m_scanArgs->permutations = nullptr;
+        if(ui->checkBoxPermutations->isChecked() && m_scanArgs->output == brute::OUTPUT::SUBDOMAIN){
+            m_scanArgs->permutations = new brute::Permutations(this->knownSubdomains(), m_scanArgs->targets, m_scanArgs->wordlist);
+            if(m_scanArgs->permutations->seeds() == 0){
+                QMessageBox::warning(this, tr("Error!"), tr("No Known Subdomains of the Targets to Permute!"));
+                delete m_scanArgs->permutations;
+                m_scanArgs->permutations = nullptr;
+                return;
+            }
+        }
+
         /* ressetting and setting new values */
         ui->progressBar->show();
         ui->progressBar->reset();
-        ui->progressBar->setMaximum(m_scanArgs->wordlist.length()*m_scanArgs->targets.length());
-
-        /*
-         if the numner of threads is greater than the number of wordlists, set the
-         number of threads to use to the number of wordlists available to avoid
-         creating more threads than needed...
-        */
-        if(m_scanArgs->config->threads > m_scanArgs->wordlist.length())
-            status->activeScanThreads = m_scanArgs->wordlist.length();
-        else
-            status->activeScanThreads = m_scanArgs->config->threads;
-
-        m_scanArgs->currentWordlist = 0;
-        m_scanArgs->progress = 0;
+
+        /* recursive scan of the resolved subdomains */
+        m_scanArgs->config->recursive = ui->checkBoxRecursive->isChecked() && !m_scanArgs->permutations &&
+                                        m_scanArgs->output == brute::OUTPUT::SUBDOMAIN;
+        m_scanArgs->recursiveTargets.clear();
+        m_scanArgs->depths.clear();
+        m_scanArgs->currentDepth = 0;
+
         m_scanArgs->reScan = false;
 
         /* start scan */
@@ -171,7 +184,7 @@ void Brute::on_buttonStart_clicked(){
         status->isNotActive = false;
 
         /* pause scan */
-        emit pauseScanThread();
+        m_executor.pause();
 
         /* logs */
         log("------------------ Paused ----------------\n");
@@ -191,7 +204,7 @@ void Brute::on_buttonStart_clicked(){
         status->isNotActive = false;
 
         /* resume scan */
-        emit resumeScanThread();
+        m_executor.resume();
 
         /* logs */
         log("------------------ Resumed ----------------\n");
@@ -200,10 +213,7 @@ void Brute::on_buttonStart_clicked(){
 }
 
 void Brute::on_buttonStop_clicked(){
-    if(status->isPaused)
-        emit resumeScanThread();
-
-    emit stopScanThread();
+    m_executor.stop();
 
     status->isStopped = true;
     status->isPaused = false;
@@ -270,33 +280,26 @@ void Brute::on_comboBoxOutput_currentIndexChanged(int index){
     ui->labelResultsCount->setNum(proxyModel->rowCount());
 }
 
+QStringList Brute::knownSubdomains(){
+    QSet<QString> subdomains;
+
+    foreach(const QString &host, project->map_activeHost.keys())
+        subdomains.insert(host);
+    for(int i = 0; i < project->passiveSubdomain->rowCount(); i++)
+        subdomains.insert(project->passiveSubdomain->item(i, 0)->text());
+    for(int i = 0; i < project->passiveSubdomainIp->rowCount(); i++)
+        subdomains.insert(project->passiveSubdomainIp->item(i, 0)->text());
+    foreach(const QString &host, set_subdomain.keys())
+        subdomains.insert(host);
+
+    return subdomains.toList();
+}
+
 void Brute::log(const QString &log){
     QString logTime = QDateTime::currentDateTime().toString("hh:mm:ss  ");
     ui->plainTextEditLogs->appendPlainText("\n"+logTime+log+"\n");
 }
 
 void Brute::initConfigValues(){
-    CONFIG.beginGroup(CFG_BRUTE);
-    m_scanArgs->config->threads = CONFIG.value(CFG_VAL_THREADS).toInt();
-    m_scanArgs->config->timeout = CONFIG.value(CFG_VAL_TIMEOUT).toInt();
-    m_scanArgs->config->checkWildcard = CONFIG.value(CFG_VAL_WILDCARD).toBool();
-    m_scanArgs->config->noDuplicates = CONFIG.value(CFG_VAL_DUPLICATES).toBool();
-    m_scanArgs->config->autoSaveToProject = CONFIG.value(CFG_VAL_AUTOSAVE).toBool();
-    m_scanArgs->config->setTimeout = CONFIG.value(CFG_VAL_SETTIMEOUT).toBool();
-    QString record = CONFIG.value(CFG_VAL_RECORD).toString();
-    CONFIG.endGroup();
-
-    if(record == "A")
-        m_scanArgs->config->recordType = QDnsLookup::A;
-    if(record == "AAAA")
-        m_scanArgs->config->recordType = QDnsLookup::AAAA;
-    if(record == "ANY")
-        m_scanArgs->config->recordType = QDnsLookup::ANY;
-
-    int size = CONFIG.beginReadArray("nameservers_brute");
-    for (int i = 0; i < size; ++i) {
-        CONFIG.setArrayIndex(i);
-        m_scanArgs->config->nameservers.enqueue(CONFIG.value("value").toString());
-    }
-    CONFIG.endArray();
+    brute::loadConfig(m_scanArgs->config);
 }
@@ -16,6 +16,7 @@
 #include "../AbstractEngine.h"
 #include "src/utils/utils.h"
 #include "src/modules/active/BruteScanner.h"
+#include "src/modules/active/ScanExecutor.h"
 
 
 namespace Ui {
@@ -30,7 +31,7 @@ class Brute : public AbstractEngine{
         ~Brute();
 
     public slots:
-        void onScanThreadEnded();
+        void onScanEnded();
         void onScanLog(scan::Log log);
         void onWildcard(s3s_struct::Wildcard);
         void onResultSubdomain(s3s_struct::HOST host);
@@ -58,6 +59,7 @@ class Brute : public AbstractEngine{
         brute::ScanArgs *m_scanArgs;
         brute::ScanStat *m_scanStats;
         QElapsedTimer m_timer;
+        ScanExecutor m_executor;
 
         QStringListModel *m_wordlistModel;
         QStringListModel *m_targetListModel;
@@ -78,6 +80,9 @@ class Brute : public AbstractEngine{
         QString targetFilterSubdomain(QString target);
         QString targetFilterTLD(QString target);
 
+        /* subdomains known to the project & this engine, for permutations */
+        QStringList knownSubdomains();
+
         void log(const QString &log);
 
         /* for context menu */
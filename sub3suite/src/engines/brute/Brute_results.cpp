@@ -7,6 +7,7 @@
 
 #include "Brute.h"
 #include "ui_Brute.h"
+#include "src/utils/ReverseIndex.h"
 
 
 void Brute::onScanLog(scan::Log log){
@@ -29,6 +30,8 @@ void Brute::onWildcard(s3s_struct::Wildcard wildcard){
 }
 
 void Brute::onResultSubdomain(s3s_struct::HOST host){
+    s3s_ReverseIndex::instance().insert(host);
+
     if(set_subdomain.contains(host.host)) // for existing entry...
     {
         s3s_item::HOST *item = set_subdomain.value(host.host);
@@ -64,6 +67,8 @@ void Brute::onResultSubdomain(s3s_struct::HOST host){
 }
 
 void Brute::onResultTLD(s3s_struct::HOST host){
+    s3s_ReverseIndex::instance().insert(host);
+
     if(set_tld.contains(host.host)) // for existing entry...
     {
         s3s_item::HOST *item = set_tld.value(host.host);
@@ -9,6 +9,7 @@
 #include "ui_Brute.h"
 
 #include "src/dialogs/FailedScansDialog.h"
+#include "src/utils/Hostname.h"
 
 
 QString Brute::targetFilterSubdomain(QString target){
@@ -23,15 +24,15 @@ QString Brute::targetFilterSubdomain(QString target){
 }
 
 QString Brute::targetFilterTLD(QString target){
-    target = target.trimmed();
-
-    /* error modifications
-    target = target.remove(" ");
-    target = target.replace(',', '.');
-    */
-
-    target = target.split(".",QString::SkipEmptyParts)[0];
-    return target;
+    /* the label before the public suffix, "example" of "www.example.co.uk" */
+    QByteArray hostname = target.toUtf8();
+    if(!s3s_Hostname::normalize(hostname))
+        return target.trimmed().split(".", QString::SkipEmptyParts).value(0);
+
+    QByteArray domain = s3s_SuffixList::instance().registrableDomain(hostname);
+    if(domain.isEmpty())
+        return QString::fromLatin1(hostname.left(hostname.indexOf('.')));
+    return QString::fromLatin1(domain.left(domain.indexOf('.')));
 }
 
 void Brute::startScan(){
@@ -40,6 +41,8 @@ void Brute::startScan(){
 
     /* clear */
     m_failedScans.clear();
+    m_scanArgs->retries.clear();
+    m_scanArgs->wildcards.clear();
 
     /* status */
     status->isRunning = true;
@@ -50,45 +53,33 @@ void Brute::startScan(){
     /* renewing scan statistics */
     m_scanStats->failed = 0;
     m_scanStats->resolved = 0;
-    m_scanStats->threads = status->activeScanThreads;
     m_scanStats->wordlist = m_scanArgs->wordlist.size();
     m_scanStats->targets = m_scanArgs->targets.length();
     m_scanStats->nameservers = m_scanArgs->config->nameservers.length();
 
-    /* start timer */
-    m_timer.start();
-
-    /* get first target */
+    /* a new duplicates filter & the first target */
+    qint64 work = brute::prepareScan(m_scanArgs);
     if(!m_scanArgs->reScan)
-        m_scanArgs->currentTarget = m_scanArgs->targets.dequeue();
+        ui->progressBar->setMaximum(m_scanArgs->progressMaximum);
 
-    /* loop to create threads for scan... */
-    for(int i = 0; i < status->activeScanThreads; i++)
-    {
-        brute::Scanner *scanner = new brute::Scanner(m_scanArgs);
-        QThread *cThread = new QThread;
-        scanner->startScan(cThread);
-        scanner->moveToThread(cThread);
+    /* start timer */
+    m_timer.start();
 
+    /* the threads for scan, not more than the work... */
+    m_scanStats->threads = m_executor.startScanners<brute::Scanner>(m_scanArgs, m_scanArgs->config->threads, work,
+                                                                     [=](brute::Scanner *scanner){
         switch (ui->comboBoxOutput->currentIndex()){
         case brute::OUTPUT::SUBDOMAIN:
-            connect(scanner, &brute::Scanner::scanResult, this, &Brute::onResultSubdomain);
+            metrics::connect(metrics::SCANNER::BRUTE, scanner, &brute::Scanner::scanResult, this, &Brute::onResultSubdomain);
             break;
         case brute::OUTPUT::TLD:
-            connect(scanner, &brute::Scanner::scanResult, this, &Brute::onResultTLD);
+            metrics::connect(metrics::SCANNER::BRUTE, scanner, &brute::Scanner::scanResult, this, &Brute::onResultTLD);
         }
         connect(scanner, &brute::Scanner::wildcard, this, &Brute::onWildcard);
         connect(scanner, &brute::Scanner::scanProgress, ui->progressBar, &QProgressBar::setValue);
+        connect(scanner, &brute::Scanner::scanProgressMaximum, ui->progressBar, &QProgressBar::setMaximum);
         connect(scanner, &brute::Scanner::scanLog, this, &Brute::onScanLog);
-        connect(cThread, &QThread::finished, this, &Brute::onScanThreadEnded);
-        connect(cThread, &QThread::finished, scanner, &brute::Scanner::deleteLater);
-        connect(cThread, &QThread::finished, cThread, &QThread::deleteLater);
-        connect(this, &Brute::stopScanThread, scanner, &brute::Scanner::onStopScan);
-        connect(this, &Brute::pauseScanThread, scanner, &brute::Scanner::onPauseScan);
-        connect(this, &Brute::resumeScanThread, scanner, &brute::Scanner::onResumeScan, Qt::DirectConnection);
-
-        cThread->start();
-    }
+    });
     status->isRunning = true;
 }
 
@@ -116,19 +107,7 @@ void Brute::onReScan(QQueue<QString> targets){
     ui->progressBar->reset();
     ui->progressBar->setMaximum(m_scanArgs->targets.length());
 
-    /*
-     if the numner of threads is greater than the number of targets, set the
-     number of threads to use to the number of targets available to avoid
-     creating more threads than needed...
-    */
-    if(m_scanArgs->config->threads > m_scanArgs->targets.length())
-        status->activeScanThreads = m_scanArgs->targets.length();
-    else
-        status->activeScanThreads = m_scanArgs->config->threads;
-
     m_scanArgs->currentTarget.clear();
-    m_scanArgs->currentWordlist = 0;
-    m_scanArgs->progress = 0;
     m_scanArgs->reScan = true;
 
     /* start scan */
@@ -139,47 +118,53 @@ void Brute::onReScan(QQueue<QString> targets){
     qInfo() << "[BRUTE] Re-Scan Started";
 }
 
-void Brute::onScanThreadEnded(){
-    status->activeScanThreads--;
+void Brute::onScanEnded(){
+    /* display the scan summary on logs */
+    this->scanSummary();
 
-    /* if all Scan Threads have finished... */
-    if(status->activeScanThreads == 0)
-    {
-        /* display the scan summary on logs */
-        this->scanSummary();
+    if(status->isStopped)
+        log("---------------- Stopped ------------\n");
+    else
+        log("------------------ End --------------\n");
 
-        if(status->isStopped)
-            log("---------------- Stopped ------------\n");
-        else
-            log("------------------ End --------------\n");
+    qInfo() << "[BRUTE] Scan Ended";
 
-        qInfo() << "[BRUTE] Scan Ended";
+    /* set the progress bar to 100% just in case... */
+    if(!status->isStopped)
+        ui->progressBar->setValue(ui->progressBar->maximum());
 
-        /* set the progress bar to 100% just in case... */
-        if(!status->isStopped)
-            ui->progressBar->setValue(ui->progressBar->maximum());
+    m_scanArgs->targets.clear();
+    m_scanArgs->wordlist.clear();
+    m_scanArgs->currentTarget.clear();
+    m_scanArgs->currentWordlist = 0;
+
+    delete m_scanArgs->filter;
+    m_scanArgs->filter = nullptr;
+    m_scanArgs->retries.clear();
+    m_scanArgs->wildcards.clear();
 
-        m_scanArgs->targets.clear();
-        m_scanArgs->wordlist.clear();
-        m_scanArgs->currentTarget.clear();
-        m_scanArgs->currentWordlist = 0;
+    delete m_scanArgs->permutations;
+    m_scanArgs->permutations = nullptr;
+    m_scanArgs->recursiveTargets.clear();
+    m_scanArgs->depths.clear();
+    m_scanArgs->currentDepth = 0;
+    m_scanArgs->config->recursive = false;
 
-        status->isNotActive = true;
-        status->isPaused = false;
-        status->isStopped = false;
-        status->isRunning = false;
+    status->isNotActive = true;
+    status->isPaused = false;
+    status->isStopped = false;
+    status->isRunning = false;
 
-        ui->buttonStart->setText("Start");
-        ui->buttonStop->setDisabled(true);
+    ui->buttonStart->setText("Start");
+    ui->buttonStop->setDisabled(true);
 
-        // launching the failed scans dialog if there were failed scans
-        if(!m_failedScans.isEmpty()){
-            FailedScansDialog *failedScansDialog = new FailedScansDialog(this, m_failedScans);
-            failedScansDialog->setAttribute(Qt::WA_DeleteOnClose, true);
+    // launching the failed scans dialog if there were failed scans
+    if(!m_failedScans.isEmpty()){
+        FailedScansDialog *failedScansDialog = new FailedScansDialog(this, m_failedScans);
+        failedScansDialog->setAttribute(Qt::WA_DeleteOnClose, true);
 
-            connect(failedScansDialog, &FailedScansDialog::reScan, this, &Brute::onReScan);
-            failedScansDialog->show();
-        }
+        connect(failedScansDialog, &FailedScansDialog::reScan, this, &Brute::onReScan);
+        failedScansDialog->show();
     }
 }
 
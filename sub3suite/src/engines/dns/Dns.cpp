@@ -22,15 +22,21 @@ Dns::Dns(QWidget *parent, ProjectModel *project) : AbstractEngine(parent, projec
     m_scanStats(new dns::ScanStat),
     m_targetListModel(new QStringListModel),
     m_srvWordlitsModel(new QStringListModel),
+    m_zoneWordlistModel(new QStringListModel),
     m_model(new QStandardItemModel)
 {
     this->initUI();
 
+    /* the scan's workers */
+    connect(&m_executor, &ScanExecutor::finished, this, &Dns::onScanEnded);
+
     /* list model */
     ui->targets->setListName(tr("Targets"));
     ui->srvWordlist->setListName(tr("SRV"));
+    ui->zoneWordlist->setListName(tr("NSEC3 Wordlist"));
     ui->targets->setListModel(m_targetListModel);
     ui->srvWordlist->setListModel(m_srvWordlitsModel);
+    ui->zoneWordlist->setListModel(m_zoneWordlistModel);
 
     /* result model */
     ui->treeViewResults->setHeaderHidden(false);
@@ -44,7 +50,9 @@ Dns::Dns(QWidget *parent, ProjectModel *project) : AbstractEngine(parent, projec
     this->initConfigValues();
 }
 Dns::~Dns(){
+    m_executor.shutdown();
     delete m_model;
+    delete m_zoneWordlistModel;
     delete m_srvWordlitsModel;
     delete m_targetListModel;
     delete m_scanArgs;
@@ -63,6 +71,7 @@ void Dns::initUI(){
     /* hiddin & disabling widgets */
     ui->buttonStop->setDisabled(true);
     ui->srvWordlist->hide();
+    ui->zoneWordlist->hide();
     ui->progressBar->hide();
 
     /* placeholder texts */
@@ -91,7 +100,7 @@ void Dns::on_buttonStart_clicked(){
             QMessageBox::warning(this, tr("Error!"), tr("Please Enter the Targets for Enumeration!"));
             return;
         }
-        if((!ui->checkBoxSRV->isChecked()) && (!ui->checkBoxANY->isChecked() && !ui->checkBoxA->isChecked() && !ui->checkBoxAAAA->isChecked() && !ui->checkBoxMX->isChecked() && !ui->checkBoxNS->isChecked() && !ui->checkBoxTXT->isChecked() && !ui->checkBoxCNAME->isChecked())){
+        if((!ui->checkBoxSRV->isChecked() && !ui->checkBoxZONE->isChecked()) && (!ui->checkBoxANY->isChecked() && !ui->checkBoxA->isChecked() && !ui->checkBoxAAAA->isChecked() && !ui->checkBoxMX->isChecked() && !ui->checkBoxNS->isChecked() && !ui->checkBoxTXT->isChecked() && !ui->checkBoxCNAME->isChecked())){
             QMessageBox::warning(this, tr("Error!"), tr("Please Choose DNS Record To Enumerate!"));
             return;
         }
@@ -104,6 +113,7 @@ void Dns::on_buttonStart_clicked(){
         m_failedScans.clear();
         m_scanArgs->targets.clear();
         m_scanArgs->srvWordlist.clear();
+        m_scanArgs->zoneWordlist.clear();
 
         /* get targets */
         if(ui->checkBoxMultipleTargets->isChecked()){
@@ -134,7 +144,7 @@ void Dns::on_buttonStart_clicked(){
         status->isNotActive = false;
 
         /* pause scan */
-        emit pauseScanThread();
+        m_executor.pause();
 
         /* logs */
         log("------------------ Paused ----------------");
@@ -154,7 +164,7 @@ void Dns::on_buttonStart_clicked(){
         status->isNotActive = false;
 
         /* resume scan */
-        emit resumeScanThread();
+        m_executor.resume();
 
         /* logs */
         log("------------------ Resumed ----------------");
@@ -163,10 +173,7 @@ void Dns::on_buttonStart_clicked(){
 }
 
 void Dns::on_buttonStop_clicked(){
-    if(status->isPaused)
-        emit resumeScanThread();
-
-    emit stopScanThread();
+    m_executor.stop();
 
     status->isStopped = true;
     status->isPaused = false;
@@ -193,20 +200,7 @@ void Dns::on_checkBoxSRV_clicked(bool checked){
 }
 
 void Dns::initConfigValues(){
-    CONFIG.beginGroup(CFG_DNS);
-    m_scanArgs->config->threads = CONFIG.value(CFG_VAL_THREADS).toInt();
-    m_scanArgs->config->timeout = CONFIG.value(CFG_VAL_TIMEOUT).toInt();
-    m_scanArgs->config->noDuplicates = CONFIG.value(CFG_VAL_DUPLICATES).toBool();
-    m_scanArgs->config->autoSaveToProject = CONFIG.value(CFG_VAL_AUTOSAVE).toBool();
-    m_scanArgs->config->setTimeout = CONFIG.value(CFG_VAL_SETTIMEOUT).toBool();
-    CONFIG.endGroup();
-
-    int size = CONFIG.beginReadArray("nameservers_dns");
-    for (int i = 0; i < size; ++i) {
-        CONFIG.setArrayIndex(i);
-        m_scanArgs->config->nameservers.enqueue(CONFIG.value("value").toString());
-    }
-    CONFIG.endArray();
+    dns::loadConfig(m_scanArgs->config);
 }
 
 void Dns::log(QString log){
@@ -237,6 +231,7 @@ void Dns::on_checkBoxANY_toggled(bool checked){
         ui->checkBoxTXT->setChecked(false);
         ui->checkBoxAAAA->setChecked(false);
         ui->checkBoxCNAME->setChecked(false);
+        ui->checkBoxZONE->setChecked(false);
     }
     ui->srvWordlist->hide();
 }
@@ -250,13 +245,32 @@ void Dns::on_checkBoxSRV_toggled(bool checked){
         ui->checkBoxTXT->setChecked(false);
         ui->checkBoxAAAA->setChecked(false);
         ui->checkBoxCNAME->setChecked(false);
+        ui->checkBoxZONE->setChecked(false);
     }
 }
 
+void Dns::on_checkBoxZONE_toggled(bool checked){
+    if(checked){
+        ui->checkBoxA->setChecked(false);
+        ui->checkBoxMX->setChecked(false);
+        ui->checkBoxNS->setChecked(false);
+        ui->checkBoxANY->setChecked(false);
+        ui->checkBoxSRV->setChecked(false);
+        ui->checkBoxTXT->setChecked(false);
+        ui->checkBoxAAAA->setChecked(false);
+        ui->checkBoxCNAME->setChecked(false);
+        ui->srvWordlist->hide();
+        ui->zoneWordlist->show();
+    }
+    else
+        ui->zoneWordlist->hide();
+}
+
 void Dns::on_checkBoxA_clicked(bool checked){
     if(checked){
         ui->checkBoxSRV->setChecked(false);
         ui->checkBoxANY->setChecked(false);
+        ui->checkBoxZONE->setChecked(false);
     }
 }
 
@@ -264,6 +278,7 @@ void Dns::on_checkBoxAAAA_clicked(bool checked){
     if(checked){
         ui->checkBoxSRV->setChecked(false);
         ui->checkBoxANY->setChecked(false);
+        ui->checkBoxZONE->setChecked(false);
     }
 }
 
@@ -271,6 +286,7 @@ void Dns::on_checkBoxMX_clicked(bool checked){
     if(checked){
         ui->checkBoxSRV->setChecked(false);
         ui->checkBoxANY->setChecked(false);
+        ui->checkBoxZONE->setChecked(false);
     }
 }
 
@@ -278,6 +294,7 @@ void Dns::on_checkBoxNS_clicked(bool checked){
     if(checked){
         ui->checkBoxSRV->setChecked(false);
         ui->checkBoxANY->setChecked(false);
+        ui->checkBoxZONE->setChecked(false);
     }
 }
 
@@ -285,6 +302,7 @@ void Dns::on_checkBoxCNAME_clicked(bool checked){
     if(checked){
         ui->checkBoxSRV->setChecked(false);
         ui->checkBoxANY->setChecked(false);
+        ui->checkBoxZONE->setChecked(false);
     }
 }
 
@@ -292,5 +310,6 @@ void Dns::on_checkBoxTXT_clicked(bool checked){
     if(checked){
         ui->checkBoxSRV->setChecked(false);
         ui->checkBoxANY->setChecked(false);
+        ui->checkBoxZONE->setChecked(false);
     }
 }
@@ -17,6 +17,8 @@
 #include "../AbstractEngine.h"
 #include "src/utils/utils.h"
 #include "src/modules/active/DNSScanner.h"
+#include "src/modules/active/ZoneScanner.h"
+#include "src/modules/active/ScanExecutor.h"
 
 
 namespace Ui {
@@ -31,10 +33,11 @@ class Dns : public AbstractEngine{
         ~Dns();
 
     public slots:
-        void onScanThreadEnded();
+        void onScanEnded();
         void onScanLog(scan::Log log);
         void onScanResult(s3s_struct::DNS result);
         void onScanResult_srv(s3s_struct::DNS result);
+        void onScanResult_zone(s3s_struct::DNS result);
         void onReScan(QQueue<QString> targets);
 
         /* receiving targets from other engines */
@@ -52,6 +55,7 @@ class Dns : public AbstractEngine{
 
         void on_checkBoxANY_toggled(bool checked);
         void on_checkBoxSRV_toggled(bool checked);
+        void on_checkBoxZONE_toggled(bool checked);
         void on_checkBoxA_clicked(bool checked);
         void on_checkBoxAAAA_clicked(bool checked);
         void on_checkBoxMX_clicked(bool checked);
@@ -66,10 +70,12 @@ class Dns : public AbstractEngine{
         dns::ScanStat *m_scanStats;
         QStringListModel *m_targetListModel;
         QStringListModel *m_srvWordlitsModel;
+        QStringListModel *m_zoneWordlistModel;
         QStandardItemModel *m_model;
         QMap<QString, s3s_item::DNS*> m_resultSet;
         QMap<QString, QString> m_failedScans;
         QElapsedTimer m_timer;
+        ScanExecutor m_executor;
 
         void initUI();
         void initConfigValues();
@@ -7,6 +7,7 @@
 
 #include "Dns.h"
 #include "ui_Dns.h"
+#include "src/utils/ReverseIndex.h"
 
 
 void Dns::onScanLog(scan::Log log){
@@ -41,6 +42,9 @@ void Dns::onScanResult_srv(s3s_struct::DNS dns){
 }
 
 void Dns::onScanResult(s3s_struct::DNS dns){
+    /* indexed whether it is saved to the project or not, for the ns & mx enumerators */
+    s3s_ReverseIndex::instance().insert(dns);
+
     if(m_resultSet.contains(dns.dns)){
         s3s_item::DNS *item = m_resultSet.value(dns.dns);
         item->setValues(dns);
@@ -58,3 +62,34 @@ void Dns::onScanResult(s3s_struct::DNS dns){
     ui->labelResultsCount->setNum(proxyModel->rowCount());
     m_scanStats->resolved++;
 }
+
+void Dns::onScanResult_zone(s3s_struct::DNS dns){
+    s3s_ReverseIndex::instance().insert(dns);
+
+    if(m_resultSet.contains(dns.dns)){
+        s3s_item::DNS *item = m_resultSet.value(dns.dns);
+        item->setValues(dns);
+    }
+    else {
+        s3s_item::DNS *item = new s3s_item::DNS;
+        item->setValues(dns);
+        m_model->appendRow(item);
+        m_resultSet.insert(dns.dns, item);
+
+        ui->labelResultsCount->setNum(proxyModel->rowCount());
+        m_scanStats->resolved++;
+    }
+
+    if(m_scanConfig->autoSaveToProject){
+        /* the zone's names are hosts too, with their addresses if transferred */
+        project->addActiveDNS(dns);
+
+        s3s_struct::HOST host;
+        host.host = dns.dns;
+        if(!dns.A.isEmpty())
+            host.ipv4 = *dns.A.begin();
+        if(!dns.AAAA.isEmpty())
+            host.ipv6 = *dns.AAAA.begin();
+        project->addActiveHost(host);
+    }
+}
@@ -27,27 +27,19 @@ void Dns::startScan(){
     ui->progressBar->reset();
     m_failedScans.clear();
 
-    /* getting srv wordlist if checked &
-     if the numner of threads is greater than the number of wordlists, set the
-     number of threads to use to the number of wordlists available to avoid
-     creating more threads than needed...
-    */
+    /* getting srv wordlist if checked */
     if(ui->checkBoxSRV->isChecked()){
         m_scanArgs->srvWordlist = m_srvWordlitsModel->stringList();
 
-        if(m_scanArgs->config->threads > m_scanArgs->srvWordlist.length())
-            status->activeScanThreads = m_scanArgs->srvWordlist.length();
-        else
-            status->activeScanThreads = m_scanArgs->config->threads;
-
         /* set progressbar maximum value */
         ui->progressBar->setMaximum(m_scanArgs->targets.length()*m_scanArgs->srvWordlist.length());
     }
+    else if(ui->checkBoxZONE->isChecked()){
+        /* one zone for each thread at a time, its transfer or walk is sequential */
+        m_scanArgs->zoneWordlist = m_zoneWordlistModel->stringList();
+        ui->progressBar->setMaximum(m_scanArgs->targets.length());
+    }
     else {
-        if(m_scanArgs->config->threads > m_scanArgs->targets.length())
-            status->activeScanThreads = m_scanArgs->targets.length();
-        else
-            status->activeScanThreads = m_scanArgs->config->threads;
         /* set progressbar maximum value */
         ui->progressBar->setMaximum(m_scanArgs->targets.length());
     }
@@ -55,13 +47,10 @@ void Dns::startScan(){
     /* renewing scan statistics */
     m_scanStats->failed = 0;
     m_scanStats->resolved = 0;
-    m_scanStats->threads = status->activeScanThreads;
     m_scanStats->targets = m_scanArgs->targets.length();
     m_scanStats->nameservers = m_scanArgs->config->nameservers.length();
 
     /* getting the arguments for Dns Records Scan... */
-    m_scanArgs->currentSRV = 0;
-    m_scanArgs->progress = 0;
     m_scanArgs->RecordType_a = ui->checkBoxA->isChecked();
     m_scanArgs->RecordType_aaaa = ui->checkBoxAAAA->isChecked();
     m_scanArgs->RecordType_mx = ui->checkBoxMX->isChecked();
@@ -70,36 +59,34 @@ void Dns::startScan(){
     m_scanArgs->RecordType_cname = ui->checkBoxCNAME->isChecked();
     m_scanArgs->RecordType_srv = ui->checkBoxSRV->isChecked();
     m_scanArgs->RecordType_any = ui->checkBoxANY->isChecked();
+    m_scanArgs->RecordType_zone = ui->checkBoxZONE->isChecked();
 
     /* start timer */
     m_timer.start();
 
-    /* get first target */
-    if(m_scanArgs->RecordType_srv)
-        m_scanArgs->currentTarget = m_scanArgs->targets.dequeue();
-
-    /* loop to create threads for scan... */
-    for(int i = 0; i < status->activeScanThreads; i++)
-    {
-        dns::Scanner *scanner = new dns::Scanner(m_scanArgs);
-        QThread *cThread = new QThread(this);
-        scanner->startScan(cThread);
-        scanner->moveToThread(cThread);
-
-        if(m_scanArgs->RecordType_srv)
-            connect(scanner, &dns::Scanner::scanResult, this, &Dns::onScanResult_srv);
-        else
-            connect(scanner, &dns::Scanner::scanResult, this, &Dns::onScanResult);
-        connect(scanner, &dns::Scanner::scanProgress, ui->progressBar, &QProgressBar::setValue);
-        connect(scanner, &dns::Scanner::scanLog, this, &Dns::onScanLog);
-        connect(cThread, &QThread::finished, this, &Dns::onScanThreadEnded);
-        connect(cThread, &QThread::finished, scanner, &QThread::deleteLater);
-        connect(cThread, &QThread::finished, cThread, &QThread::deleteLater);
-        connect(this, &Dns::stopScanThread, scanner, &dns::Scanner::onStopScan);
-        connect(this, &Dns::pauseScanThread, scanner, &dns::Scanner::onPauseScan);
-        connect(this, &Dns::resumeScanThread, scanner, &dns::Scanner::onResumeScan, Qt::DirectConnection);
-
-        cThread->start();
+    /* the first target of a srv scan */
+    qint64 work = dns::prepareScan(m_scanArgs);
+
+    /* the threads for scan, not more than the work... */
+    if(m_scanArgs->RecordType_zone){
+        m_scanStats->threads = m_executor.startScanners<zone::Scanner>(m_scanArgs, m_scanArgs->config->threads, work,
+                                                                        [=](zone::Scanner *scanner){
+            metrics::connect(metrics::SCANNER::DNS, scanner, &zone::Scanner::scanResult, this, &Dns::onScanResult_zone);
+            connect(scanner, &zone::Scanner::scanStatus, this, &Dns::log);
+            connect(scanner, &zone::Scanner::scanProgress, ui->progressBar, &QProgressBar::setValue);
+            connect(scanner, &zone::Scanner::scanLog, this, &Dns::onScanLog);
+        });
+    }
+    else {
+        m_scanStats->threads = m_executor.startScanners<dns::Scanner>(m_scanArgs, m_scanArgs->config->threads, work,
+                                                                       [=](dns::Scanner *scanner){
+            if(m_scanArgs->RecordType_srv)
+                metrics::connect(metrics::SCANNER::DNS, scanner, &dns::Scanner::scanResult, this, &Dns::onScanResult_srv);
+            else
+                metrics::connect(metrics::SCANNER::DNS, scanner, &dns::Scanner::scanResult, this, &Dns::onScanResult);
+            connect(scanner, &dns::Scanner::scanProgress, ui->progressBar, &QProgressBar::setValue);
+            connect(scanner, &dns::Scanner::scanLog, this, &Dns::onScanLog);
+        });
     }
     status->isRunning = true;
 }
@@ -123,44 +110,38 @@ void Dns::onReScan(QQueue<QString> targets){
     qInfo() << "[DNS] Re-Scan Started";
 }
 
-void Dns::onScanThreadEnded(){
-    status->activeScanThreads--;
+void Dns::onScanEnded(){
+    /* display the scan summary on logs */
+    this->scanSummary();
 
-    /* if all Scan Threads have finished... */
-    if(status->activeScanThreads == 0)
-    {
-        /* display the scan summary on logs */
-        this->scanSummary();
+    if(status->isStopped)
+        log("---------------- Stopped ------------\n");
+    else
+        log("------------------ End --------------\n");
 
-        if(status->isStopped)
-            log("---------------- Stopped ------------\n");
-        else
-            log("------------------ End --------------\n");
+    qInfo() << "[DNS] Scan Ended";
 
-        qInfo() << "[DNS] Scan Ended";
+    /* set the progress bar to 100% just in case... */
+    if(!status->isStopped)
+        ui->progressBar->setValue(ui->progressBar->maximum());
 
-        /* set the progress bar to 100% just in case... */
-        if(!status->isStopped)
-            ui->progressBar->setValue(ui->progressBar->maximum());
-
-        m_scanArgs->targets.clear();
+    m_scanArgs->targets.clear();
 
-        status->isNotActive = true;
-        status->isPaused = false;
-        status->isStopped = false;
-        status->isRunning = false;
+    status->isNotActive = true;
+    status->isPaused = false;
+    status->isStopped = false;
+    status->isRunning = false;
 
-        ui->buttonStart->setText("Start");
-        ui->buttonStop->setDisabled(true);
+    ui->buttonStart->setText("Start");
+    ui->buttonStop->setDisabled(true);
 
-        // launching the failed scans dialog if there were failed scans
-        if(!m_failedScans.isEmpty()){
-            FailedScansDialog *failedScansDialog = new FailedScansDialog(this, m_failedScans);
-            failedScansDialog->setAttribute(Qt::WA_DeleteOnClose, true);
+    // launching the failed scans dialog if there were failed scans
+    if(!m_failedScans.isEmpty()){
+        FailedScansDialog *failedScansDialog = new FailedScansDialog(this, m_failedScans);
+        failedScansDialog->setAttribute(Qt::WA_DeleteOnClose, true);
 
-            connect(failedScansDialog, &FailedScansDialog::reScan, this, &Dns::onReScan);
-            failedScansDialog->show();
-        }
+        connect(failedScansDialog, &FailedScansDialog::reScan, this, &Dns::onReScan);
+        failedScansDialog->show();
     }
 }
 
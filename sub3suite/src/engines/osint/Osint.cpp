@@ -61,8 +61,13 @@ Osint::Osint(QWidget *parent, ProjectModel *project): AbstractEngine(parent, pro
     proxyModel->setSourceModel(m_model_subdomain);
     proxyModel->setFilterKeyColumn(0);
     ui->tableViewResults->setModel(proxyModel);
+
+    connect(&m_executor, &ScanExecutor::finished, this, &Osint::onScanEnded);
 }
 Osint::~Osint(){
+    m_executor.shutdown();
+    delete m_resultFilter;
+    delete m_scope;
     delete m_model_cidr;
     delete m_model_ssl;
     delete m_model_asn;
@@ -135,7 +140,7 @@ void Osint::on_buttonStart_clicked(){
 }
 
 void Osint::on_buttonStop_clicked(){
-    emit stopScanThread();
+    m_executor.stop();
 
     status->isStopped = true;
     status->isPaused = false;
@@ -305,11 +310,5 @@ void Osint::log(QString log){
 }
 
 void Osint::initConfigValues(){
-    CONFIG.beginGroup(CFG_OSINT);
-    m_scanConfig->timeout = CONFIG.value(CFG_VAL_TIMEOUT).toInt();
-    m_scanConfig->maxPage = CONFIG.value(CFG_VAL_MAXPAGES).toInt();
-    m_scanConfig->autosaveToProject = CONFIG.value(CFG_VAL_AUTOSAVE).toBool();
-    m_scanConfig->noDuplicates = CONFIG.value(CFG_VAL_DUPLICATES).toBool();
-    m_scanArgs->config->setTimeout = CONFIG.value(CFG_VAL_SETTIMEOUT).toBool();
-    CONFIG.endGroup();
+    osint::loadConfig(m_scanConfig, CFG_OSINT);
 }
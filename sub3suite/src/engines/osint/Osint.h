@@ -9,7 +9,10 @@
 #define OSINT_H
 
 #include "../AbstractEngine.h"
+#include "src/utils/ResultFilter.h"
+#include "src/utils/Hostname.h"
 #include "src/modules/passive/AbstractOsintModule.h"
+#include "src/modules/active/ScanExecutor.h"
 
 #include <QAction>
 
@@ -50,7 +53,7 @@ class Osint : public AbstractEngine{
         ~Osint();
 
     public slots:
-        void onScanThreadEnded();
+        void onScanEnded();
         void onScanLog(ScanLog log);
 
         void onResultSubdomainIp(QString subdomain, QString ip);
@@ -88,6 +91,7 @@ class Osint : public AbstractEngine{
         Ui::Osint *ui;
         ScanConfig *m_scanConfig;
         ScanArgs *m_scanArgs;
+        ScanExecutor m_executor;
 
         /* target listmodels */
         QStringListModel *m_targetListModel_host;
@@ -118,6 +122,12 @@ class Osint : public AbstractEngine{
         QSet<QString> set_cidr;
         int total_modules;
 
+        /* duplicates filter shared by the modules of the running scan */
+        s3s_ResultFilter *m_resultFilter = nullptr;
+
+        /* the target domains, the hostnames outside of them are dropped */
+        s3s_Scope *m_scope = nullptr;
+
         void initUI();
         void initModules();
         void initProfiles();
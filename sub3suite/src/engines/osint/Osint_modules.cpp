@@ -249,6 +249,12 @@ void Osint::initModules(){
     else
         ui->moduleRipe->hide();
 
+    ModuleInfo::Rdap rdap;
+    if(rdap.input_output.contains(INPUT_TYPE) && rdap.input_output[INPUT_TYPE].contains(OUTPUT_TYPE))
+        ui->moduleRdap->show();
+    else
+        ui->moduleRdap->hide();
+
     ModuleInfo::FullHunt fullhunt;
     if(fullhunt.input_output.contains(INPUT_TYPE) && fullhunt.input_output[INPUT_TYPE].contains(OUTPUT_TYPE))
         ui->moduleFullHunt->show();
@@ -508,6 +514,7 @@ void Osint::uncheckAllModules(){
     ui->moduleN45HT->setChecked(false);
     ui->moduleOnyphe->setChecked(false);
     ui->moduleRipe->setChecked(false);
+    ui->moduleRdap->setChecked(false);
     ui->moduleFullHunt->setChecked(false);
     ui->moduleNetworksDB->setChecked(false);
     ui->moduleSpyOnWeb->setChecked(false);
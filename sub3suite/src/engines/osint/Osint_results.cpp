@@ -7,6 +7,7 @@
 
 #include "Osint.h"
 #include "ui_Osint.h"
+#include "src/utils/ReverseIndex.h"
 
 
 void Osint::onScanLog(ScanLog log){
@@ -32,6 +33,8 @@ void Osint::onScanLog(ScanLog log){
 }
 
 void Osint::onResultSubdomainIp(QString subdomain, QString ip){
+    s3s_ReverseIndex::instance().insert(reverse::KIND::IP, ip, subdomain);
+
     if(set_subdomainIP.contains(subdomain))
         return;
 
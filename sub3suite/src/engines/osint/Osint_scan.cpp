@@ -2,21 +2,17 @@
  Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
  Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
 
- @brief : starts the OSINT scanning modules each in own thread
+ @brief : starts the OSINT scanning modules on the scan's worker threads
 */
 
 #include "Osint.h"
 #include "ui_Osint.h"
 
 #include "src/modules/passive/OsintHeaders.h"
+#include "src/utils/Metrics.h"
 
 
-void Osint::onScanThreadEnded(){
-    /* check if no active thread */
-    status->activeScanThreads--;
-    if(status->activeScanThreads)
-        return;
-
+void Osint::onScanEnded(){
     /* set the progress bar to 100% just in case */
     if(!status->isStopped)
         ui->progressBar->setValue(ui->progressBar->maximum());
@@ -26,6 +22,12 @@ void Osint::onScanThreadEnded(){
     status->isStopped = false;
     status->isRunning = false;
 
+    /* all modules ended, the scan's duplicates filter is no longer needed */
+    delete m_resultFilter;
+    m_resultFilter = nullptr;
+    delete m_scope;
+    m_scope = nullptr;
+
     /* reanabling the widgets... */
     ui->buttonStart->setEnabled(true);
     ui->buttonStop->setDisabled(true);
@@ -58,6 +60,10 @@ void Osint::startScan(){
     m_scanArgs->output_CIDR = false;
     total_modules = 0;
 
+    /* a new duplicates filter for the scan */
+    delete m_resultFilter;
+    m_resultFilter = new s3s_ResultFilter;
+
     /* get the targets... */
     if(ui->checkBoxMultipleTargets->isChecked()){
         foreach(const QString &target, ui->targets->getlistModel()->stringList())
@@ -93,6 +99,14 @@ void Osint::startScan(){
         break;
     }
 
+    /* the hostnames of a domains scan are kept to the target domains & their subdomains */
+    delete m_scope;
+    m_scope = new s3s_Scope;
+    if(m_scanArgs->input_Domain){
+        foreach(const QString &target, m_scanArgs->targets)
+            m_scope->insert(target);
+    }
+
     /* getting output type as specified by users */
     switch(ui->comboBoxOutput->currentIndex()){
     case osint::OUTPUT::SUBDOMAINIP:
@@ -247,6 +261,9 @@ void Osint::startScan(){
     if(ui->moduleRipe->isChecked())
         this->startScanThread(new Ripe(*m_scanArgs));
 
+    if(ui->moduleRdap->isChecked())
+        this->startScanThread(new Rdap(*m_scanArgs));
+
     if(ui->moduleFullHunt->isChecked())
         this->startScanThread(new FullHunt(*m_scanArgs));
 
@@ -371,7 +388,7 @@ void Osint::startScan(){
     ui->progressBar->setMaximum(total_modules*m_scanArgs->targets.length());
 
     /* after starting all choosen enumerations... */
-    if(status->activeScanThreads)
+    if(m_executor.isRunning())
     {
         ui->buttonStart->setDisabled(true);
         ui->buttonStop->setEnabled(true);
@@ -384,48 +401,91 @@ void Osint::startScan(){
 
 void Osint::startScanThread(AbstractOsintModule *module){
     total_modules++;
-    QThread *cThread = new QThread(this);
-    module->startScan(cThread);
-    module->moveToThread(cThread);
+    /*
+     * the results are checked against the scan's duplicates filter in the module's thread
+     * (the connections' context is the module), only unique results are queued to the engine.
+     * the hostnames are first normalized & checked against the scan's scope.
+     */
+    s3s_ResultFilter *filter = m_resultFilter;
+    const s3s_Scope *scope = m_scope;
 
     switch (ui->comboBoxOutput->currentIndex()) {
     case osint::OUTPUT::SUBDOMAIN:
-        connect(module, &AbstractOsintModule::resultSubdomain, this, &Osint::onResultSubdomain);
-        connect(module, &AbstractOsintModule::resultCNAME, this, &Osint::onResultCNAME);
-        connect(module, &AbstractOsintModule::resultNS, this, &Osint::onResultNS);
-        connect(module, &AbstractOsintModule::resultMX, this, &Osint::onResultMX);
+        connect(module, &AbstractOsintModule::resultSubdomain, module, [=](QString subdomain){
+            subdomain = scope->match(subdomain);
+            if(!subdomain.isNull() && filter->insert(subdomain))
+                metrics::post(metrics::SCANNER::OSINT, this, [=](){this->onResultSubdomain(subdomain);});
+        });
+        connect(module, &AbstractOsintModule::resultCNAME, module, [=](QString CNAME){
+            CNAME = scope->match(CNAME);
+            if(!CNAME.isNull() && filter->insert(CNAME))
+                metrics::post(metrics::SCANNER::OSINT, this, [=](){this->onResultCNAME(CNAME);});
+        });
+        connect(module, &AbstractOsintModule::resultNS, module, [=](QString NS){
+            NS = scope->match(NS);
+            if(!NS.isNull() && filter->insert(NS))
+                metrics::post(metrics::SCANNER::OSINT, this, [=](){this->onResultNS(NS);});
+        });
+        connect(module, &AbstractOsintModule::resultMX, module, [=](QString MX){
+            MX = scope->match(MX);
+            if(!MX.isNull() && filter->insert(MX))
+                metrics::post(metrics::SCANNER::OSINT, this, [=](){this->onResultMX(MX);});
+        });
         break;
     case osint::OUTPUT::IP:
-        connect(module, &AbstractOsintModule::resultIP, this, &Osint::onResultIP);
-        connect(module, &AbstractOsintModule::resultA, this, &Osint::onResultA);
-        connect(module, &AbstractOsintModule::resultAAAA, this, &Osint::onResultAAAA);
+        connect(module, &AbstractOsintModule::resultIP, module, [=](QString ip){
+            if(filter->insert(ip))
+                metrics::post(metrics::SCANNER::OSINT, this, [=](){this->onResultIP(ip);});
+        });
+        connect(module, &AbstractOsintModule::resultA, module, [=](QString A){
+            if(filter->insert(A))
+                metrics::post(metrics::SCANNER::OSINT, this, [=](){this->onResultA(A);});
+        });
+        connect(module, &AbstractOsintModule::resultAAAA, module, [=](QString AAAA){
+            if(filter->insert(AAAA))
+                metrics::post(metrics::SCANNER::OSINT, this, [=](){this->onResultAAAA(AAAA);});
+        });
         break;
     case osint::OUTPUT::SUBDOMAINIP:
-        connect(module, &AbstractOsintModule::resultSubdomainIp, this, &Osint::onResultSubdomainIp);
+        connect(module, &AbstractOsintModule::resultSubdomainIp, module, [=](QString subdomain, QString ip){
+            subdomain = scope->match(subdomain);
+            if(!subdomain.isNull() && filter->insert(subdomain))
+                metrics::post(metrics::SCANNER::OSINT, this, [=](){this->onResultSubdomainIp(subdomain, ip);});
+        });
         break;
     case osint::OUTPUT::EMAIL:
-        connect(module, &AbstractOsintModule::resultEmail, this, &Osint::onResultEmail);
+        connect(module, &AbstractOsintModule::resultEmail, module, [=](QString email){
+            if(filter->insert(email))
+                metrics::post(metrics::SCANNER::OSINT, this, [=](){this->onResultEmail(email);});
+        });
         break;
     case OUT_URL:
-        connect(module, &AbstractOsintModule::resultURL, this, &Osint::onResultURL);
+        connect(module, &AbstractOsintModule::resultURL, module, [=](QString url){
+            if(filter->insert(url))
+                metrics::post(metrics::SCANNER::OSINT, this, [=](){this->onResultURL(url);});
+        });
         break;
     case osint::OUTPUT::ASN:
-        connect(module, &AbstractOsintModule::resultASN, this, &Osint::onResultASN);
+        connect(module, &AbstractOsintModule::resultASN, module, [=](QString asn, QString name){
+            if(filter->insert(asn))
+                metrics::post(metrics::SCANNER::OSINT, this, [=](){this->onResultASN(asn, name);});
+        });
         break;
     case osint::OUTPUT::CIDR:
-        connect(module, &AbstractOsintModule::resultCIDR, this, &Osint::onResultCIDR);
+        connect(module, &AbstractOsintModule::resultCIDR, module, [=](QString cidr){
+            if(filter->insert(cidr))
+                metrics::post(metrics::SCANNER::OSINT, this, [=](){this->onResultCIDR(cidr);});
+        });
         break;
     case osint::OUTPUT::CERT:
-        connect(module, &AbstractOsintModule::resultSSL, this, &Osint::onResultSSL);
+        connect(module, &AbstractOsintModule::resultSSL, module, [=](QString ssl){
+            if(filter->insert(ssl))
+                metrics::post(metrics::SCANNER::OSINT, this, [=](){this->onResultSSL(ssl);});
+        });
         break;
     }
     connect(module, &AbstractOsintModule::scanProgress, ui->progressBar, &QProgressBar::setValue);
     connect(module, &AbstractOsintModule::scanLog, this, &Osint::onScanLog);
-    connect(this, &Osint::stopScanThread, module, &AbstractOsintModule::onStop);
-    connect(cThread, &QThread::finished, this, &Osint::onScanThreadEnded);
-    connect(cThread, &QThread::finished, module, &AbstractOsintModule::deleteLater);
-    connect(cThread, &QThread::finished, cThread, &QThread::deleteLater);
 
-    cThread->start();
-    status->activeScanThreads++;
+    m_executor.start(module);
 }
@@ -44,8 +44,11 @@ Raw::Raw(QWidget *parent, ProjectModel *project): AbstractEngine(parent, project
     /* ... */
     m_scanArgs->config = m_scanConfig;
     this->initConfigValues();
+
+    connect(&m_executor, &ScanExecutor::finished, this, &Raw::onScanEnded);
 }
 Raw::~Raw(){
+    m_executor.shutdown();
     delete m_scanConfig;
     delete m_scanArgs;
     delete m_targetListModel_url;
@@ -100,12 +103,7 @@ void Raw::initUI(){
 }
 
 void Raw::initConfigValues(){
-    CONFIG.beginGroup(CFG_RAW);
-    m_scanConfig->timeout = CONFIG.value(CFG_VAL_TIMEOUT).toInt();
-    m_scanConfig->autosaveToProject = CONFIG.value(CFG_VAL_AUTOSAVE).toBool();
-    m_scanConfig->noDuplicates = CONFIG.value(CFG_VAL_DUPLICATES).toBool();
-    m_scanArgs->config->setTimeout = CONFIG.value(CFG_VAL_SETTIMEOUT).toBool();
-    CONFIG.endGroup();
+    osint::loadConfig(m_scanConfig, CFG_RAW);
 }
 
 void Raw::on_lineEditTarget_returnPressed(){
@@ -136,7 +134,7 @@ void Raw::on_buttonStart_clicked(){
     this->startScan();
 
     /* after starting all choosen modules */
-    if(status->activeScanThreads){
+    if(m_executor.isRunning()){
         ui->buttonStart->setDisabled(true);
         ui->buttonStop->setEnabled(true);
         log("------------------ start --------------");
@@ -147,7 +145,7 @@ void Raw::on_buttonStart_clicked(){
 }
 
 void Raw::on_buttonStop_clicked(){
-    emit stopScanThread();
+    m_executor.stop();
 
     status->isStopped = true;
     status->isPaused = false;
@@ -16,6 +16,7 @@
 #include "../AbstractEngine.h"
 #include "src/utils/utils.h"
 #include "src/modules/passive/OsintHeaders.h"
+#include "src/modules/active/ScanExecutor.h"
 #include "src/utils/JsonSyntaxHighlighter.h"
 
 
@@ -30,11 +31,8 @@ class Raw : public AbstractEngine{
         Raw(QWidget *parent = nullptr, ProjectModel *project = nullptr);
         ~Raw();
 
-    signals:
-        void stopScanThread();
-
     public slots:
-        void onScanThreadEnded();
+        void onScanEnded();
         void onScanLog(ScanLog log);
 
         void onResults(s3s_struct::RAW raw); // for Json results
@@ -113,6 +111,7 @@ class Raw : public AbstractEngine{
         void on_moduleN45HT_clicked();
         void on_moduleOnyphe_clicked();
         void on_moduleRipe_clicked();
+        void on_moduleRdap_clicked();
         void on_moduleAfrinic_clicked();
         void on_moduleApnic_clicked();
         void on_moduleFullHunt_clicked();
@@ -167,6 +166,7 @@ class Raw : public AbstractEngine{
 
         ScanConfig *m_scanConfig;
         ScanArgs *m_scanArgs;
+        ScanExecutor m_executor;
         QMap<QString,QString> m_failedScans;
         QMap<QString, QStringList> m_optionSet;
         JsonSyntaxHighlighter *m_resultsHighlighter = nullptr;
@@ -115,6 +115,7 @@ void Raw::on_treeViewResults_customContextMenuRequested(const QPoint &pos){
     send_cidr_menu.setIcon(QIcon(":/img/res/icons/cidr.png"));
     send_cidr_menu.addAction(tr("Send CIDR to OSINT"), this, [=](){this->sendToEngine(ENGINE::OSINT, RESULT_TYPE::CIDR);});
     send_cidr_menu.addAction(tr("Send CIDR to RAW"), this, [=](){this->sendToEngine(ENGINE::RAW, RESULT_TYPE::CIDR);});
+    send_cidr_menu.addAction(tr("Send CIDR to ACTIVE"), this, [=](){this->sendToEngine(ENGINE::ACTIVE, RESULT_TYPE::CIDR);});
     send_cidr_menu.addSeparator();
     send_cidr_menu.addAction(tr("Send CIDR to CIDR-Enum"), this, [=](){this->sendToEnum(ENUMERATOR::CIDR, RESULT_TYPE::CIDR);});
 
@@ -459,6 +459,16 @@ void Raw::on_moduleRipe_clicked(){
     ui->comboBoxOptions->addItems(meta.flags.keys());
 }
 
+void Raw::on_moduleRdap_clicked(){
+    ui->comboBoxOptions->clear();
+    ModuleInfo::Rdap meta;
+    m_optionSet = meta.flags;
+    ui->labelUrl->setText("<a href=\""+meta.url+"\" style=\"color: green;\">"+meta.name+"</a>");
+    ui->labelApiDoc->setText("<a href=\""+meta.url_apiDoc+"\" style=\"color: green;\">"+meta.url_apiDoc+"</a>");
+    ui->textEditEngineSummary->setText(meta.summary);
+    ui->comboBoxOptions->addItems(meta.flags.keys());
+}
+
 void Raw::on_moduleAfrinic_clicked(){
     ui->comboBoxOptions->clear();
     ModuleInfo::Afrinic meta;
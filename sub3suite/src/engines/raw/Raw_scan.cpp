@@ -12,12 +12,7 @@
 #include "src/dialogs/FailedScansDialog.h"
 
 
-void Raw::onScanThreadEnded(){
-    /* check if no active thread */
-    status->activeScanThreads--;
-    if(status->activeScanThreads)
-        return;
-
+void Raw::onScanEnded(){
     /* set the progress bar to 100% just in case */
     if(!status->isStopped)
         ui->progressBar->setValue(ui->progressBar->maximum());
@@ -26,7 +21,6 @@ void Raw::onScanThreadEnded(){
     status->isPaused = false;
     status->isStopped = false;
     status->isRunning = false;
-    status->activeScanThreads = 0;
 
     /* reanabling the widgets... */
     ui->buttonStart->setEnabled(true);
@@ -207,6 +201,9 @@ void Raw::startScan(){
     if(ui->moduleRipe->isChecked())
         this->startScanThread(new Ripe(*m_scanArgs));
 
+    if(ui->moduleRdap->isChecked())
+        this->startScanThread(new Rdap(*m_scanArgs));
+
     if(ui->moduleAfrinic->isChecked())
         this->startScanThread(new Afrinic(*m_scanArgs));
 
@@ -323,21 +320,12 @@ void Raw::startScan(){
 }
 
 void Raw::startScanThread(AbstractOsintModule *module){
-    QThread *cThread = new QThread(this);
-    module->startScan(cThread);
-    module->moveToThread(cThread);
-
     connect(module, &AbstractOsintModule::scanProgress, ui->progressBar, &QProgressBar::setValue);
     connect(module, &AbstractOsintModule::resultRawJSON, this, &Raw::onResults);
     connect(module, &AbstractOsintModule::resultRawTXT, this, &Raw::onResultsTxt);
     connect(module, &AbstractOsintModule::scanLog, this, &Raw::onScanLog);
-    connect(this, &Raw::stopScanThread, module, &AbstractOsintModule::onStop);
-    connect(cThread, &QThread::finished, this, &Raw::onScanThreadEnded);
-    connect(cThread, &QThread::finished, module, &AbstractOsintModule::deleteLater);
-    connect(cThread, &QThread::finished, cThread, &QThread::deleteLater);
 
-    cThread->start();
-    status->activeScanThreads++;
+    m_executor.start(module);
 }
 
 void Raw::onReScan(QQueue<QString> targets){
@@ -351,7 +339,7 @@ void Raw::onReScan(QQueue<QString> targets){
     this->startScan();
 
     /* after starting all choosen modules */
-    if(status->activeScanThreads){
+    if(m_executor.isRunning()){
         ui->buttonStart->setDisabled(true);
         ui->buttonStop->setEnabled(true);
         log("------------------ start --------------");
@@ -26,6 +26,9 @@ Ssl::Ssl(QWidget *parent, ProjectModel *project): AbstractEngine(parent, project
 {
     this->initUI();
 
+    /* the scan's workers */
+    connect(&m_executor, &ScanExecutor::finished, this, &Ssl::onScanEnded);
+
     /* list models */
     ui->targets->setListName("Targets");
     ui->targets->setListModel(m_targetListModel);
@@ -43,6 +46,7 @@ Ssl::Ssl(QWidget *parent, ProjectModel *project): AbstractEngine(parent, project
     this->initConfigValues();
 }
 Ssl::~Ssl(){
+    m_executor.shutdown();
     delete m_model_hash;
     delete m_model_ssl;
     delete m_model_subdomain;
@@ -126,7 +130,7 @@ void Ssl::on_buttonStart_clicked(){
         status->isNotActive = false;
 
         /* pause scan */
-        emit pauseScanThread();
+        m_executor.pause();
 
         /* logs */
         log("------------------ Paused ----------------");
@@ -146,7 +150,7 @@ void Ssl::on_buttonStart_clicked(){
         status->isNotActive = false;
 
         /* resume scan */
-        emit resumeScanThread();
+        m_executor.resume();
 
         /* logs */
         log("------------------ Resumed ----------------");
@@ -155,10 +159,7 @@ void Ssl::on_buttonStart_clicked(){
 }
 
 void Ssl::on_buttonStop_clicked(){
-    if(status->isPaused)
-        emit resumeScanThread();
-
-    emit stopScanThread();
+    m_executor.stop();
 
     status->isStopped = true;
     status->isPaused = false;
@@ -208,13 +209,7 @@ void Ssl::on_lineEditFilter_textChanged(const QString &filterKeyword){
 }
 
 void Ssl::initConfigValues(){
-    CONFIG.beginGroup(CFG_SSL);
-    m_scanArgs->config->timeout = CONFIG.value(CFG_VAL_TIMEOUT).toInt();
-    m_scanArgs->config->threads = CONFIG.value(CFG_VAL_THREADS).toInt();
-    m_scanArgs->config->noDuplicates = CONFIG.value(CFG_VAL_DUPLICATES).toBool();
-    m_scanArgs->config->autoSaveToProject = CONFIG.value(CFG_VAL_AUTOSAVE).toBool();
-    m_scanArgs->config->setTimeout = CONFIG.value(CFG_VAL_SETTIMEOUT).toBool();
-    CONFIG.endGroup();
+    ssl::loadConfig(m_scanArgs->config);
 }
 
 void Ssl::log(const QString &log){
@@ -16,6 +16,7 @@
 #include "../AbstractEngine.h"
 #include "src/items/SSLItem.h"
 #include "src/modules/active/SSLScanner.h"
+#include "src/modules/active/ScanExecutor.h"
 
 
 namespace Ui {
@@ -30,7 +31,7 @@ class Ssl : public AbstractEngine{
         ~Ssl();
 
     public slots:
-        void onScanThreadEnded();
+        void onScanEnded();
         void onScanLog(scan::Log log);
 
         void onScanResultSHA1(QString sha1);
@@ -57,6 +58,7 @@ class Ssl : public AbstractEngine{
     private:
         Ui::Ssl *ui;
         QElapsedTimer m_timer;
+        ScanExecutor m_executor;
         ssl::ScanConfig *m_scanConfig;
         ssl::ScanArgs *m_scanArgs;
         ssl::ScanStat *m_scanStats;
@@ -10,6 +10,7 @@
 
 #include <QSslKey>
 #include "src/items/SSLItem.h"
+#include "src/utils/ReverseIndex.h"
 
 
 void Ssl::onScanLog(scan::Log log){
@@ -51,6 +52,8 @@ void Ssl::onScanResultSHA256(QString sha256){
 }
 
 void Ssl::onScanResultRaw(QString target, QSslCertificate ssl){
+    s3s_ReverseIndex::instance().insert(target, ssl);
+
     if(set_ssl.contains(target))
         return;
 
@@ -26,26 +26,17 @@ void Ssl::startScan(){
     ui->progressBar->show();
     ui->progressBar->reset();
     m_failedScans.clear();
+    m_scanArgs->retries.clear();
 
-    /*
-     if the numner of threads is greater than the number of wordlists, set the
-     number of threads to use to the number of wordlists available to avoid
-     creating more threads than needed...
-    */
-    if(m_scanArgs->config->threads > m_scanArgs->targets.length())
-        status->activeScanThreads = m_scanArgs->targets.length();
-    else
-        status->activeScanThreads = m_scanArgs->config->threads;
+    qint64 work = ssl::prepareScan(m_scanArgs);
 
     /* renewing scan statistics */
     m_scanStats->failed = 0;
     m_scanStats->resolved = 0;
-    m_scanStats->threads = status->activeScanThreads;
     m_scanStats->targets = m_scanArgs->targets.length();
 
     /* set progressbar maximum value */
     ui->progressBar->setMaximum(m_scanArgs->targets.length());
-    m_scanArgs->progress = 0;
 
     /* start timer */
     m_timer.start();
@@ -84,43 +75,31 @@ void Ssl::startScan(){
         break;
     }
 
-    /* loop to create threads for enumeration... */
-    for(int i = 0; i < status->activeScanThreads; i++)
-    {
-        ssl::Scanner *scanner = new ssl::Scanner(m_scanArgs);
-        QThread *cThread = new QThread;
-        scanner->startScan(cThread);
-        scanner->moveToThread(cThread);
-
+    /* the threads for enumeration, not more than the targets... */
+    m_scanStats->threads = m_executor.startScanners<ssl::Scanner>(m_scanArgs, m_scanArgs->config->threads, work,
+                                                                   [=](ssl::Scanner *scanner){
         /* results signals & slots... */
         switch (ui->comboBoxOutput->currentIndex()) {
         case 0: // subdomain
-            connect(scanner, &ssl::Scanner::resultSubdomain, this, &Ssl::onScanResultSubdomain);
+            metrics::connect(metrics::SCANNER::SSL, scanner, &ssl::Scanner::resultSubdomain, this, &Ssl::onScanResultSubdomain);
             break;
         case 1: // cert id
             switch (ui->comboBoxOption->currentIndex()) {
             case 0: // SHA1
-                connect(scanner, &ssl::Scanner::resultSHA1, this, &Ssl::onScanResultSHA1);
+                metrics::connect(metrics::SCANNER::SSL, scanner, &ssl::Scanner::resultSHA1, this, &Ssl::onScanResultSHA1);
                 break;
             case 1: // SHA256
-                connect(scanner, &ssl::Scanner::resultSHA256, this, &Ssl::onScanResultSHA256);
+                metrics::connect(metrics::SCANNER::SSL, scanner, &ssl::Scanner::resultSHA256, this, &Ssl::onScanResultSHA256);
                 break;
             }
             break;
         case 2: // raw cert
-            connect(scanner, &ssl::Scanner::resultRaw, this, &Ssl::onScanResultRaw);
+            metrics::connect(metrics::SCANNER::SSL, scanner, &ssl::Scanner::resultRaw, this, &Ssl::onScanResultRaw);
             break;
         }
         connect(scanner, &ssl::Scanner::scanProgress, ui->progressBar, &QProgressBar::setValue);
         connect(scanner, &ssl::Scanner::scanLog, this, &Ssl::onScanLog);
-        connect(cThread, &QThread::finished, this, &Ssl::onScanThreadEnded);
-        connect(cThread, &QThread::finished, scanner, &ssl::Scanner::deleteLater);
-        connect(cThread, &QThread::finished, cThread, &QThread::deleteLater);
-        connect(this, &Ssl::stopScanThread, scanner, &ssl::Scanner::onStopScan, Qt::DirectConnection);
-        connect(this, &Ssl::pauseScanThread, scanner, &ssl::Scanner::onPauseScan, Qt::DirectConnection);
-        connect(this, &Ssl::resumeScanThread, scanner, &ssl::Scanner::onResumeScan, Qt::DirectConnection);
-        cThread->start();
-    }
+    });
     status->isRunning = true;
 }
 
@@ -142,44 +121,39 @@ void Ssl::onReScan(QQueue<QString> targets){
     qInfo() << "[SSL] Re-Scan Started";
 }
 
-void Ssl::onScanThreadEnded(){
-    status->activeScanThreads--;
+void Ssl::onScanEnded(){
+    /* display the scan summary on logs */
+    this->scanSummary();
 
-    /* if all Scan Threads have finished... */
-    if(status->activeScanThreads == 0)
-    {
-        /* display the scan summary on logs */
-        this->scanSummary();
-
-        if(status->isStopped)
-            log("---------------- Stopped ------------\n");
-        else
-            log("------------------ End --------------\n");
+    if(status->isStopped)
+        log("---------------- Stopped ------------\n");
+    else
+        log("------------------ End --------------\n");
 
-        qInfo() << "[SSL] Scan Ended";
+    qInfo() << "[SSL] Scan Ended";
 
-        /* set the progress bar to 100% just in case... */
-        if(!status->isStopped)
-            ui->progressBar->setValue(ui->progressBar->maximum());
+    /* set the progress bar to 100% just in case... */
+    if(!status->isStopped)
+        ui->progressBar->setValue(ui->progressBar->maximum());
 
-        m_scanArgs->targets.clear();
+    m_scanArgs->targets.clear();
+    m_scanArgs->retries.clear();
 
-        status->isNotActive = true;
-        status->isPaused = false;
-        status->isStopped = false;
-        status->isRunning = false;
+    status->isNotActive = true;
+    status->isPaused = false;
+    status->isStopped = false;
+    status->isRunning = false;
 
-        ui->buttonStart->setText("Start");
-        ui->buttonStop->setDisabled(true);
+    ui->buttonStart->setText("Start");
+    ui->buttonStop->setDisabled(true);
 
-        // launching the failed scans dialog if there were failed scans
-        if(!m_failedScans.isEmpty()){
-            FailedScansDialog *failedScansDialog = new FailedScansDialog(this, m_failedScans);
-            failedScansDialog->setAttribute(Qt::WA_DeleteOnClose, true);
+    // launching the failed scans dialog if there were failed scans
+    if(!m_failedScans.isEmpty()){
+        FailedScansDialog *failedScansDialog = new FailedScansDialog(this, m_failedScans);
+        failedScansDialog->setAttribute(Qt::WA_DeleteOnClose, true);
 
-            connect(failedScansDialog, &FailedScansDialog::reScan, this, &Ssl::onReScan);
-            failedScansDialog->show();
-        }
+        connect(failedScansDialog, &FailedScansDialog::reScan, this, &Ssl::onReScan);
+        failedScansDialog->show();
     }
 }
 
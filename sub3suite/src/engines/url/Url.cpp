@@ -28,6 +28,9 @@ Url::Url(QWidget *parent, ProjectModel *project) : AbstractEngine(parent, projec
 {
     this->initUI();
 
+    /* the scan's workers */
+    connect(&m_executor, &ScanExecutor::finished, this, &Url::onScanEnded);
+
     /* result model */
     m_model->setHorizontalHeaderLabels({tr(" URL"), tr(" Status"), tr(" Server"), tr(" Content Type")});
     proxyModel->setSourceModel(m_model);
@@ -42,6 +45,7 @@ Url::Url(QWidget *parent, ProjectModel *project) : AbstractEngine(parent, projec
     this->initConfigValues();
 }
 Url::~Url(){
+    m_executor.shutdown();
     delete m_model;
     delete m_targetListModel;
     delete m_scanStats;
@@ -125,7 +129,7 @@ void Url::on_buttonStart_clicked(){
         status->isNotActive = false;
 
         /* pause scan */
-        emit pauseScanThread();
+        m_executor.pause();
 
         /* logs */
         log("------------------ Paused ----------------");
@@ -145,7 +149,7 @@ void Url::on_buttonStart_clicked(){
         status->isNotActive = false;
 
         /* resume scan */
-        emit resumeScanThread();
+        m_executor.resume();
 
         /* logs */
         log("------------------ Resumed ----------------");
@@ -154,10 +158,7 @@ void Url::on_buttonStart_clicked(){
 }
 
 void Url::on_buttonStop_clicked(){
-    if(status->isPaused)
-        emit resumeScanThread();
-
-    emit stopScanThread();
+    m_executor.stop();
 
     status->isStopped = true;
     status->isPaused = false;
@@ -172,13 +173,7 @@ void Url::on_buttonConfig_clicked(){
 }
 
 void Url::initConfigValues(){
-    CONFIG.beginGroup(CFG_URL);
-    m_scanArgs->config->timeout = CONFIG.value(CFG_VAL_TIMEOUT).toInt();
-    m_scanArgs->config->threads = CONFIG.value(CFG_VAL_THREADS).toInt();
-    m_scanArgs->config->noDuplicates = CONFIG.value(CFG_VAL_DUPLICATES).toBool();
-    m_scanArgs->config->autoSaveToProject = CONFIG.value(CFG_VAL_AUTOSAVE).toBool();
-    m_scanArgs->config->setTimeout = CONFIG.value(CFG_VAL_SETTIMEOUT).toBool();
-    CONFIG.endGroup();
+    url::loadConfig(m_scanArgs->config);
 }
 
 void Url::log(const QString &log){
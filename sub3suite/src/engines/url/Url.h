@@ -15,6 +15,7 @@
 #include "../AbstractEngine.h"
 #include "src/utils/utils.h"
 #include "src/modules/active/URLScanner.h"
+#include "src/modules/active/ScanExecutor.h"
 
 
 namespace Ui {
@@ -29,7 +30,7 @@ class Url : public AbstractEngine{
         ~Url();
 
     public slots:
-        void onScanThreadEnded();
+        void onScanEnded();
         void onScanLog(scan::Log log);
         void onScanResult(s3s_struct::URL url);
         void onReScan(QQueue<QString> targets);
@@ -49,6 +50,7 @@ class Url : public AbstractEngine{
     private:
         Ui::Url *ui;
         QElapsedTimer m_timer;
+        ScanExecutor m_executor;
         QMap<QString,QString> m_failedScans;
         url::ScanConfig *m_scanConfig;
         url::ScanArgs *m_scanArgs;
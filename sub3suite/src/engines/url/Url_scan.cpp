@@ -27,50 +27,28 @@ void Url::startScan(){
     ui->progressBar->show();
     ui->progressBar->reset();
     m_failedScans.clear();
+    m_scanArgs->retries.clear();
 
-    /*
-     if the numner of threads is greater than the number of wordlists, set the
-     number of threads to use to the number of wordlists available to avoid
-     creating more threads than needed...
-    */
-    if(m_scanArgs->config->threads > m_scanArgs->targets.length())
-        status->activeScanThreads = m_scanArgs->targets.length();
-    else
-        status->activeScanThreads = m_scanArgs->config->threads;
+    qint64 work = url::prepareScan(m_scanArgs);
 
     /* renewing scan statistics */
     m_scanStats->failed = 0;
     m_scanStats->resolved = 0;
-    m_scanStats->threads = status->activeScanThreads;
     m_scanStats->targets = m_scanArgs->targets.length();
 
     /* set progressbar maximum value */
     ui->progressBar->setMaximum(m_scanArgs->targets.length());
-    m_scanArgs->progress = 0;
 
     /* start timer */
     m_timer.start();
 
-    /* loop to create threads for enumeration... */
-    for(int i = 0; i < status->activeScanThreads; i++)
-    {
-        url::Scanner *scanner = new url::Scanner(m_scanArgs);
-        QThread *cThread = new QThread;
-        scanner->startScan(cThread);
-        scanner->moveToThread(cThread);
-
-        connect(scanner, &url::Scanner::scanResult, this, &Url::onScanResult);
+    /* the threads for enumeration, not more than the targets... */
+    m_scanStats->threads = m_executor.startScanners<url::Scanner>(m_scanArgs, m_scanArgs->config->threads, work,
+                                                                   [=](url::Scanner *scanner){
+        metrics::connect(metrics::SCANNER::URL, scanner, &url::Scanner::scanResult, this, &Url::onScanResult);
         connect(scanner, &url::Scanner::scanProgress, ui->progressBar, &QProgressBar::setValue);
         connect(scanner, &url::Scanner::scanLog, this, &Url::onScanLog);
-        connect(cThread, &QThread::finished, this, &Url::onScanThreadEnded);
-        connect(cThread, &QThread::finished, scanner, &url::Scanner::deleteLater);
-        connect(cThread, &QThread::finished, cThread, &QThread::deleteLater);
-        connect(this, &Url::stopScanThread, scanner, &url::Scanner::onStopScan);
-        connect(this, &Url::pauseScanThread, scanner, &url::Scanner::onPauseScan);
-        connect(this, &Url::resumeScanThread, scanner, &url::Scanner::onResumeScan, Qt::DirectConnection);
-
-        cThread->start();
-    }
+    });
     status->isRunning = true;
 }
 
@@ -92,44 +70,39 @@ void Url::onReScan(QQueue<QString> targets){
     qInfo() << "[URL] Re-Scan Started";
 }
 
-void Url::onScanThreadEnded(){
-    status->activeScanThreads--;
-
-    /* if all Scan Threads have finished... */
-    if(status->activeScanThreads == 0)
-    {
-        /* display the scan summary on logs */
-        scanSummary();
+void Url::onScanEnded(){
+    /* display the scan summary on logs */
+    scanSummary();
 
-        if(status->isStopped)
-            log("---------------- Stopped ------------\n");
-        else
-            log("------------------ End --------------\n");
+    if(status->isStopped)
+        log("---------------- Stopped ------------\n");
+    else
+        log("------------------ End --------------\n");
 
-        qInfo() << "[URL] Scan Ended";
+    qInfo() << "[URL] Scan Ended";
 
-        /* set the progress bar to 100% just in case... */
-        if(!status->isStopped)
-            ui->progressBar->setValue(ui->progressBar->maximum());
+    /* set the progress bar to 100% just in case... */
+    if(!status->isStopped)
+        ui->progressBar->setValue(ui->progressBar->maximum());
 
-        m_scanArgs->targets.clear();
+    m_scanArgs->targets.clear();
+    m_scanArgs->retries.clear();
 
-        status->isNotActive = true;
-        status->isPaused = false;
-        status->isStopped = false;
-        status->isRunning = false;
+    status->isNotActive = true;
+    status->isPaused = false;
+    status->isStopped = false;
+    status->isRunning = false;
 
-        ui->buttonStart->setText(tr("Start"));
-        ui->buttonStop->setDisabled(true);
+    ui->buttonStart->setText(tr("Start"));
+    ui->buttonStop->setDisabled(true);
 
-        // launching the failed scans dialog if there were failed scans
-        if(!m_failedScans.isEmpty()){
-            FailedScansDialog *failedScansDialog = new FailedScansDialog(this, m_failedScans);
-            failedScansDialog->setAttribute(Qt::WA_DeleteOnClose, true);
+    // launching the failed scans dialog if there were failed scans
+    if(!m_failedScans.isEmpty()){
+        FailedScansDialog *failedScansDialog = new FailedScansDialog(this, m_failedScans);
+        failedScansDialog->setAttribute(Qt::WA_DeleteOnClose, true);
 
-            connect(failedScansDialog, &FailedScansDialog::reScan, this, &Url::onReScan);
-            failedScansDialog->show();
-        }
+        connect(failedScansDialog, &FailedScansDialog::reScan, this, &Url::onReScan);
+        failedScansDialog->show();
     }
 }
 
@@ -36,11 +36,6 @@ class AbstractEnum : public QWidget{
         QItemSelectionModel *selectionModel = nullptr;
 
     signals:
-        /* signals to scanning threads */
-        void stopScanThread();
-        void pauseScanThread();
-        void resumeScanThread();
-
         /* status To mainwindow */
         void sendStatus(QString status);
 
@@ -34,8 +34,11 @@ ASNEnum::ASNEnum(QWidget *parent, ProjectModel *project) : AbstractEnum(parent,
 
     /* scan arguments */
     m_scanArgs->config = m_scanConfig;
+
+    connect(&m_executor, &ScanExecutor::finished, this, &ASNEnum::onScanEnded);
 }
 ASNEnum::~ASNEnum(){
+    m_executor.shutdown();
     delete m_scanArgs;
     delete m_scanConfig;
     delete m_targetsListModel;
@@ -57,6 +60,10 @@ void ASNEnum::on_buttonStart_clicked(){
         QMessageBox::warning(this, tr("Error!"), tr("Please Enter the Targets for Enumeration!"));
         return;
     }
+    if(ui->comboBoxEngine->currentIndex() == 2 && ui->comboBoxOption->currentIndex() != 0){
+        QMessageBox::warning(this, tr("Error!"), tr("The registries' RDAP records have the ASN's info only!"));
+        return;
+    }
 
     /* getting targets */
     m_scanArgs->targets.clear();
@@ -76,7 +83,7 @@ void ASNEnum::on_buttonStart_clicked(){
 }
 
 void ASNEnum::on_buttonStop_clicked(){
-    emit stopScanThread();
+    m_executor.stop();
 
     status->isStopped = true;
     status->isNotActive = false;
@@ -11,6 +11,7 @@
 #include "../AbstractEnum.h"
 #include "src/items/ASNItem.h"
 #include "src/modules/passive/OsintHeaders.h"
+#include "src/modules/active/ScanExecutor.h"
 
 
 namespace Ui {
@@ -29,7 +30,7 @@ class ASNEnum : public AbstractEnum{
         void onResultsAsnPeers(s3s_struct::ASN results);
         void onResultsAsnPrefixes(s3s_struct::ASN results);
 
-        void onScanThreadEnded();
+        void onScanEnded();
         void onScanLog(ScanLog log);
         void onReScan(QQueue<QString> targets);
 
@@ -54,6 +55,7 @@ class ASNEnum : public AbstractEnum{
 
         ScanConfig *m_scanConfig;
         ScanArgs *m_scanArgs;
+        ScanExecutor m_executor;
 
         void initUI();
         void initConfigValues();
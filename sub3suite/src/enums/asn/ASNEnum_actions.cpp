@@ -213,6 +213,10 @@ void ASNEnum::sendToEngine(const ENGINE &engine, const RESULT_TYPE &result_type)
         emit sendToRaw(targets, result_type);
         emit changeTabToRaw();
         break;
+    case ENGINE::ACTIVE:
+        emit sendToActive(targets, result_type);
+        emit changeTabToActive();
+        break;
     default:
         break;
     }
@@ -236,6 +240,10 @@ void ASNEnum::sendSelectedToEngine(const ENGINE &engine, const RESULT_TYPE &resu
         emit sendToRaw(targets, result_type);
         emit changeTabToRaw();
         break;
+    case ENGINE::ACTIVE:
+        emit sendToActive(targets, result_type);
+        emit changeTabToActive();
+        break;
     default:
         break;
     }
@@ -4,43 +4,37 @@
 #include "src/dialogs/FailedScansDialog.h"
 
 
-void ASNEnum::onScanThreadEnded(){
-    status->activeScanThreads--;
+void ASNEnum::onScanEnded(){
+    /* display the scan summary on logs
+    m_scanSummary();
+    */
 
-    /* if all Scan Threads have finished... */
-    if(status->activeScanThreads == 0)
-    {
-        /* display the scan summary on logs
-        m_scanSummary();
-        */
-
-        if(status->isStopped)
-            this->log("---------------- Stopped ------------\n");
-        else
-            this->log("------------------ End --------------\n");
+    if(status->isStopped)
+        this->log("---------------- Stopped ------------\n");
+    else
+        this->log("------------------ End --------------\n");
 
-        qInfo() << "[ASN-Enum] Scan Ended";
+    qInfo() << "[ASN-Enum] Scan Ended";
 
-        /* set the progress bar to 100% just in case... */
-        if(!status->isStopped)
-            ui->progressBar->setValue(ui->progressBar->maximum());
+    /* set the progress bar to 100% just in case... */
+    if(!status->isStopped)
+        ui->progressBar->setValue(ui->progressBar->maximum());
 
-        status->isNotActive = true;
-        status->isPaused = false;
-        status->isStopped = false;
-        status->isRunning = false;
+    status->isNotActive = true;
+    status->isPaused = false;
+    status->isStopped = false;
+    status->isRunning = false;
 
-        ui->buttonStart->setEnabled(true);
-        ui->buttonStop->setDisabled(true);
+    ui->buttonStart->setEnabled(true);
+    ui->buttonStop->setDisabled(true);
 
-        /* launching the failed scans dialog if there were failed scans */
-        if(!m_failedScans.isEmpty()){
-            FailedScansDialog *failedScansDialog = new FailedScansDialog(this, m_failedScans);
-            failedScansDialog->setAttribute(Qt::WA_DeleteOnClose, true);
+    /* launching the failed scans dialog if there were failed scans */
+    if(!m_failedScans.isEmpty()){
+        FailedScansDialog *failedScansDialog = new FailedScansDialog(this, m_failedScans);
+        failedScansDialog->setAttribute(Qt::WA_DeleteOnClose, true);
 
-            connect(failedScansDialog, &FailedScansDialog::reScan, this, &ASNEnum::onReScan);
-            failedScansDialog->show();
-        }
+        connect(failedScansDialog, &FailedScansDialog::reScan, this, &ASNEnum::onReScan);
+        failedScansDialog->show();
     }
 }
 
@@ -92,13 +86,13 @@ void ASNEnum::startScan(){
     case 1: // IpData
         this->startScanThread(new IpData(*m_scanArgs));
         break;
+    case 2: // RDAP
+        this->startScanThread(new Rdap(*m_scanArgs));
+        break;
     }
 }
 
 void ASNEnum::startScanThread(AbstractOsintModule *module){
-    QThread *cThread = new QThread;
-    module->startScan(cThread);
-    module->moveToThread(cThread);
 
     switch(ui->comboBoxOption->currentIndex()){
     case 0:
@@ -111,14 +105,9 @@ void ASNEnum::startScanThread(AbstractOsintModule *module){
         connect(module, &AbstractOsintModule::resultEnumASN, this, &ASNEnum::onResultsAsnPrefixes);
         break;
     }
-    connect(this, &ASNEnum::stopScanThread, module, &AbstractOsintModule::onStop);
     connect(module, &AbstractOsintModule::scanProgress, ui->progressBar, &QProgressBar::setValue);
     connect(module, &AbstractOsintModule::scanLog, this, &ASNEnum::onScanLog);
-    connect(cThread, &QThread::finished, this, &ASNEnum::onScanThreadEnded);
-    connect(cThread, &QThread::finished, module, &AbstractOsintModule::deleteLater);
-    connect(cThread, &QThread::finished, cThread, &QThread::deleteLater);
-    cThread->start();
-    status->activeScanThreads++;
+    m_executor.start(module);
 }
 
 void ASNEnum::onReScan(QQueue<QString> targets){
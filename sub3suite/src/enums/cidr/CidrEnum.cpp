@@ -34,8 +34,11 @@ CidrEnum::CidrEnum(QWidget *parent, ProjectModel *project) : AbstractEnum(parent
 
     /* scan arguments */
     m_scanArgs->config = m_scanConfig;
+
+    connect(&m_executor, &ScanExecutor::finished, this, &CidrEnum::onScanEnded);
 }
 CidrEnum::~CidrEnum(){
+    m_executor.shutdown();
     delete m_scanArgs;
     delete m_scanConfig;
     delete m_targetsListModel;
@@ -76,7 +79,7 @@ void CidrEnum::on_buttonStart_clicked(){
 }
 
 void CidrEnum::on_buttonStop_clicked(){
-    emit stopScanThread();
+    m_executor.stop();
 
     status->isStopped = true;
     status->isNotActive = false;
@@ -11,6 +11,7 @@
 #include "../AbstractEnum.h"
 #include "src/items/CIDRItem.h"
 #include "src/modules/passive/OsintHeaders.h"
+#include "src/modules/active/ScanExecutor.h"
 
 
 namespace Ui {
@@ -27,7 +28,7 @@ class CidrEnum : public AbstractEnum {
     public slots:
         void onResult(s3s_struct::CIDR);
 
-        void onScanThreadEnded();
+        void onScanEnded();
         void onScanLog(ScanLog log);
         void onReScan(QQueue<QString> targets);
 
@@ -53,6 +54,7 @@ class CidrEnum : public AbstractEnum {
 
         ScanConfig *m_scanConfig;
         ScanArgs *m_scanArgs;
+        ScanExecutor m_executor;
 
         void initUI();
         void initConfigValues();
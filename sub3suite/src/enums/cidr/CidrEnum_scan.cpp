@@ -4,43 +4,37 @@
 #include "src/dialogs/FailedScansDialog.h"
 
 
-void CidrEnum::onScanThreadEnded(){
-    status->activeScanThreads--;
+void CidrEnum::onScanEnded(){
+    /* display the scan summary on logs
+    m_scanSummary();
+    */
 
-    /* if all Scan Threads have finished... */
-    if(status->activeScanThreads == 0)
-    {
-        /* display the scan summary on logs
-        m_scanSummary();
-        */
-
-        if(status->isStopped)
-            this->log("---------------- Stopped ------------\n");
-        else
-            this->log("------------------ End --------------\n");
+    if(status->isStopped)
+        this->log("---------------- Stopped ------------\n");
+    else
+        this->log("------------------ End --------------\n");
 
-        qInfo() << "[CIDR-Enum] Scan Ended";
+    qInfo() << "[CIDR-Enum] Scan Ended";
 
-        /* set the progress bar to 100% just in case... */
-        if(!status->isStopped)
-            ui->progressBar->setValue(ui->progressBar->maximum());
+    /* set the progress bar to 100% just in case... */
+    if(!status->isStopped)
+        ui->progressBar->setValue(ui->progressBar->maximum());
 
-        status->isNotActive = true;
-        status->isPaused = false;
-        status->isStopped = false;
-        status->isRunning = false;
+    status->isNotActive = true;
+    status->isPaused = false;
+    status->isStopped = false;
+    status->isRunning = false;
 
-        ui->buttonStart->setEnabled(true);
-        ui->buttonStop->setDisabled(true);
+    ui->buttonStart->setEnabled(true);
+    ui->buttonStop->setDisabled(true);
 
-        /* launching the failed scans dialog if there were failed scans */
-        if(!m_failedScans.isEmpty()){
-            FailedScansDialog *failedScansDialog = new FailedScansDialog(this, m_failedScans);
-            failedScansDialog->setAttribute(Qt::WA_DeleteOnClose, true);
+    /* launching the failed scans dialog if there were failed scans */
+    if(!m_failedScans.isEmpty()){
+        FailedScansDialog *failedScansDialog = new FailedScansDialog(this, m_failedScans);
+        failedScansDialog->setAttribute(Qt::WA_DeleteOnClose, true);
 
-            connect(failedScansDialog, &FailedScansDialog::reScan, this, &CidrEnum::onReScan);
-            failedScansDialog->show();
-        }
+        connect(failedScansDialog, &FailedScansDialog::reScan, this, &CidrEnum::onReScan);
+        failedScansDialog->show();
     }
 }
 
@@ -73,22 +67,17 @@ void CidrEnum::startScan(){
     case 0: // Bgpview
         this->startScanThread(new Bgpview(*m_scanArgs));
         break;
+    case 1: // RDAP
+        this->startScanThread(new Rdap(*m_scanArgs));
+        break;
     }
 }
 
 void CidrEnum::startScanThread(AbstractOsintModule *module){
-    QThread *cThread = new QThread;
-    module->startScan(cThread);
-    module->moveToThread(cThread);
     connect(module, &AbstractOsintModule::resultEnumCIDR, this, &CidrEnum::onResult);
-    connect(this, &CidrEnum::stopScanThread, module, &AbstractOsintModule::onStop);
     connect(module, &AbstractOsintModule::scanProgress, ui->progressBar, &QProgressBar::setValue);
     connect(module, &AbstractOsintModule::scanLog, this, &CidrEnum::onScanLog);
-    connect(cThread, &QThread::finished, this, &CidrEnum::onScanThreadEnded);
-    connect(cThread, &QThread::finished, module, &AbstractOsintModule::deleteLater);
-    connect(cThread, &QThread::finished, cThread, &QThread::deleteLater);
-    cThread->start();
-    status->activeScanThreads++;
+    m_executor.start(module);
 }
 
 void CidrEnum::onReScan(QQueue<QString> targets){
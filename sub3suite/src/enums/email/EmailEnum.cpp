@@ -33,8 +33,12 @@ EmailEnum::EmailEnum(QWidget *parent, ProjectModel *project) : AbstractEnum(pare
 
     /* scan arguments */
     m_scanArgs->config = m_scanConfig;
+    m_smtpArgs.config = &m_smtpConfig;
+
+    connect(&m_executor, &ScanExecutor::finished, this, &EmailEnum::onScanEnded);
 }
 EmailEnum::~EmailEnum(){
+    m_executor.shutdown();
     delete m_scanArgs;
     delete m_scanConfig;
     delete m_targetsListModel;
@@ -75,7 +79,7 @@ void EmailEnum::on_buttonStart_clicked(){
 }
 
 void EmailEnum::on_buttonStop_clicked(){
-    emit stopScanThread();
+    m_executor.stop();
 
     status->isStopped = true;
     status->isNotActive = false;
@@ -119,6 +123,20 @@ void EmailEnum::initConfigValues(){
     m_scanConfig->setTimeout = CONFIG.value("set_timeout_email").toBool();
     m_scanConfig->timeout = CONFIG.value("timeout_email").toInt();
     CONFIG.endGroup();
+
+    CONFIG.beginGroup(CFG_SMTP);
+    m_smtpConfig.threads = CONFIG.value(CFG_VAL_THREADS, m_smtpConfig.threads).toInt();
+    m_smtpConfig.timeout = CONFIG.value(CFG_VAL_TIMEOUT, m_smtpConfig.timeout).toInt();
+    m_smtpConfig.connections = CONFIG.value(CFG_VAL_MX_CONNECTIONS, m_smtpConfig.connections).toInt();
+    m_smtpConfig.pipeline = CONFIG.value(CFG_VAL_PIPELINE, m_smtpConfig.pipeline).toInt();
+    m_smtpConfig.helo = CONFIG.value(CFG_VAL_HELO, m_smtpConfig.helo).toString();
+    m_smtpConfig.sender = CONFIG.value(CFG_VAL_SENDER).toString();
+    CONFIG.endGroup();
+
+    /* the mx records are resolved with the dns engine's nameservers */
+    m_smtpConfig.nameservers = Config::nameservers("nameservers_dns");
+    if(m_smtpConfig.nameservers.isEmpty())
+        m_smtpConfig.nameservers.enqueue("8.8.8.8");
 }
 
 void EmailEnum::log(QString log){
@@ -10,6 +10,8 @@
 
 #include "../AbstractEnum.h"
 #include "src/modules/passive/AbstractOsintModule.h"
+#include "src/modules/active/ScanExecutor.h"
+#include "src/modules/active/EmailScanner.h"
 
 
 namespace Ui {
@@ -26,8 +28,9 @@ class EmailEnum : public AbstractEnum {
     public slots:
         void onResult(s3s_struct::Email results);
 
-        void onScanThreadEnded();
+        void onScanEnded();
         void onScanLog(ScanLog log);
+        void onSmtpLog(scan::Log log);
         void onReScan(QQueue<QString> targets);
 
         void onReceiveTargets(QSet<QString>, RESULT_TYPE);
@@ -53,11 +56,23 @@ class EmailEnum : public AbstractEnum {
         ScanConfig *m_scanConfig;
         ScanArgs *m_scanArgs;
 
+        /* the smtp engine's verification on the mail exchangers */
+        email::ScanConfig m_smtpConfig;
+        email::ScanArgs m_smtpArgs;
+        QStringList m_smtpAddresses;
+
+        /* the names & bare domains of the targets, their patterns & names are found first */
+        email::Discovery m_discovery;
+        bool m_discovering = false;
+        ScanExecutor m_executor;
+
         void initUI();
         void initConfigValues();
 
         void startScan();
         void startScanThread(AbstractOsintModule*);
+        void startSmtpScan();
+        void startSmtpVerification();
         void log(QString log);
 
         /* for context menu */
@@ -49,3 +49,12 @@ void EmailEnum::onScanLog(ScanLog log){
 
     ui->plainTextEditLogs->appendPlainText("");
 }
+
+void EmailEnum::onSmtpLog(scan::Log log){
+    ScanLog scanLog;
+    scanLog.moduleName = log.recordType+" "+log.nameserver;
+    scanLog.target = log.target;
+    scanLog.message = log.message;
+    scanLog.error = true;
+    this->onScanLog(scanLog);
+}
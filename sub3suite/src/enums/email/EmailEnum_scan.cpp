@@ -3,45 +3,49 @@
 
 #include "src/modules/passive/OsintHeaders.h"
 #include "src/dialogs/FailedScansDialog.h"
+#include "src/utils/Hostname.h"
 
 
-void EmailEnum::onScanThreadEnded(){
-    status->activeScanThreads--;
+void EmailEnum::onScanEnded(){
+    /* the patterns & names are found, their candidates are verified next */
+    if(m_discovering){
+        m_discovering = false;
+        if(!status->isStopped){
+            this->startSmtpVerification();
+            return;
+        }
+    }
 
-    /* if all Scan Threads have finished... */
-    if(status->activeScanThreads == 0)
-    {
-        /* display the scan summary on logs
-        m_scanSummary();
-        */
+    /* display the scan summary on logs
+    m_scanSummary();
+    */
 
-        if(status->isStopped)
-            this->log("---------------- Stopped ------------\n");
-        else
-            this->log("------------------ End --------------\n");
+    if(status->isStopped)
+        this->log("---------------- Stopped ------------\n");
+    else
+        this->log("------------------ End --------------\n");
 
-        qInfo() << "[Email-Enum] Scan Ended";
+    qInfo() << "[Email-Enum] Scan Ended";
 
-        /* set the progress bar to 100% just in case... */
-        if(!status->isStopped)
-            ui->progressBar->setValue(ui->progressBar->maximum());
+    /* set the progress bar to 100% just in case... */
+    if(!status->isStopped)
+        ui->progressBar->setValue(ui->progressBar->maximum());
 
-        status->isNotActive = true;
-        status->isPaused = false;
-        status->isStopped = false;
-        status->isRunning = false;
+    status->isNotActive = true;
+    status->isPaused = false;
+    status->isStopped = false;
+    status->isRunning = false;
 
-        ui->buttonStart->setEnabled(true);
-        ui->buttonStop->setDisabled(true);
+    ui->buttonStart->setEnabled(true);
+    ui->buttonStop->setDisabled(true);
 
-        /* launching the failed scans dialog if there were failed scans */
-        if(!m_failedScans.isEmpty()){
-            FailedScansDialog *failedScansDialog = new FailedScansDialog(this, m_failedScans);
-            failedScansDialog->setAttribute(Qt::WA_DeleteOnClose, true);
+    /* launching the failed scans dialog if there were failed scans */
+    if(!m_failedScans.isEmpty()){
+        FailedScansDialog *failedScansDialog = new FailedScansDialog(this, m_failedScans);
+        failedScansDialog->setAttribute(Qt::WA_DeleteOnClose, true);
 
-            connect(failedScansDialog, &FailedScansDialog::reScan, this, &EmailEnum::onReScan);
-            failedScansDialog->show();
-        }
+        connect(failedScansDialog, &FailedScansDialog::reScan, this, &EmailEnum::onReScan);
+        failedScansDialog->show();
     }
 }
 
@@ -74,22 +78,78 @@ void EmailEnum::startScan(){
     case 0: // TruMail
         this->startScanThread(new TruMail(*m_scanArgs));
         break;
+    case 1: // SMTP
+        this->startSmtpScan();
+        break;
+    }
+}
+
+void EmailEnum::startSmtpScan(){
+    /*
+     * the targets are addresses, people's names on a domain eg. "Jane Doe@example.com" or bare domains,
+     * the people of a bare domain are found by the modules.
+     */
+    m_smtpAddresses.clear();
+    m_discovery = email::Discovery();
+    foreach(const QString &target, m_scanArgs->targets){
+        int at = target.lastIndexOf('@');
+        QString domain = s3s_Hostname::normalize(target.mid(at+1));
+        QString local = target.left(qMax(0, at)).trimmed();
+        if(domain.isNull())
+            continue;
+        if(local.contains(' ') || local.contains(','))
+            m_discovery.names[domain].append(local);
+        else if(at < 0)
+            m_discovery.names[domain];
+        else
+            m_smtpAddresses.append(target);
+    }
+
+    /* the domains' patterns & names are found with the EmailFormat & Hunter modules that have api keys */
+    m_discovering = email::discover(&m_executor, *m_scanArgs, &m_discovery, this) > 0;
+    if(m_discovering){
+        this->log(QString("finding the address patterns & the people of %1 domains...").arg(m_discovery.names.size()));
+        return;
     }
+    this->startSmtpVerification();
+}
+
+void EmailEnum::startSmtpVerification(){
+    /* the target addresses & the candidates of the names grouped by their domains */
+    m_smtpArgs.domains.clear();
+    m_smtpArgs.candidates.clear();
+    m_smtpArgs.addresses.clear();
+    m_smtpArgs.progress = 0;
+    email::group(&m_smtpArgs, m_smtpAddresses);
+    int candidates = email::group(&m_smtpArgs, email::candidates(m_discovery));
+    if(candidates)
+        this->log(QString("%1 candidate addresses of the names").arg(candidates));
+    m_smtpConfig.autoSaveToProject = m_scanConfig->autosaveToProject;
+
+    /* the progress is of the domains */
+    ui->progressBar->setMaximum(m_smtpArgs.domains.length());
+
+    int threads = ScanExecutor::workers(m_smtpConfig.threads, m_smtpArgs.domains.length());
+    for(int i = 0; i < threads && !m_smtpArgs.domains.isEmpty(); i++)
+    {
+        email::Scanner *scanner = new email::Scanner(&m_smtpArgs);
+        connect(scanner, &email::Scanner::scanResult, this, &EmailEnum::onResult);
+        connect(scanner, &email::Scanner::scanStatus, this, &EmailEnum::log);
+        connect(scanner, &email::Scanner::scanProgress, ui->progressBar, &QProgressBar::setValue);
+        connect(scanner, &email::Scanner::scanLog, this, &EmailEnum::onSmtpLog);
+        m_executor.start(scanner);
+    }
+
+    /* no valid address */
+    if(!m_executor.isRunning())
+        this->onScanEnded();
 }
 
 void EmailEnum::startScanThread(AbstractOsintModule *module){
-    QThread *cThread = new QThread;
-    module->startScan(cThread);
-    module->moveToThread(cThread);
     connect(module, &AbstractOsintModule::resultEnumEmail, this, &EmailEnum::onResult);
-    connect(this, &EmailEnum::stopScanThread, module, &AbstractOsintModule::onStop);
     connect(module, &AbstractOsintModule::scanProgress, ui->progressBar, &QProgressBar::setValue);
     connect(module, &AbstractOsintModule::scanLog, this, &EmailEnum::onScanLog);
-    connect(cThread, &QThread::finished, this, &EmailEnum::onScanThreadEnded);
-    connect(cThread, &QThread::finished, module, &AbstractOsintModule::deleteLater);
-    connect(cThread, &QThread::finished, cThread, &QThread::deleteLater);
-    cThread->start();
-    status->activeScanThreads++;
+    m_executor.start(module);
 }
 
 void EmailEnum::onReScan(QQueue<QString> targets){
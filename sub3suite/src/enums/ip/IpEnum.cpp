@@ -38,8 +38,11 @@ IpEnum::IpEnum(QWidget *parent, ProjectModel *project) : AbstractEnum(parent, pr
 
     /* scan arguments */
     m_scanArgs->config = m_scanConfig;
+
+    connect(&m_executor, &ScanExecutor::finished, this, &IpEnum::onScanEnded);
 }
 IpEnum::~IpEnum(){
+    m_executor.shutdown();
     delete m_scanArgs;
     delete m_scanConfig;
     delete m_targetsListModel;
@@ -67,6 +70,9 @@ void IpEnum::on_buttonStart_clicked(){
     if(ui->checkBoxMultipleTargets->isChecked()){
         foreach(const QString &target, m_targetsListModel->stringList())
             m_scanArgs->targets.enqueue(target);
+    }else if(ui->checkBoxBulk->isChecked()){
+        foreach(const QString &target, ui->lineEditTarget->text().split(',', QString::SkipEmptyParts))
+            m_scanArgs->targets.enqueue(target.trimmed());
     }else{
         m_scanArgs->targets.enqueue(ui->lineEditTarget->text());
     }
@@ -80,7 +86,7 @@ void IpEnum::on_buttonStart_clicked(){
 }
 
 void IpEnum::on_buttonStop_clicked(){
-    emit stopScanThread();
+    m_executor.stop();
 
     status->isStopped = true;
     status->isNotActive = false;
@@ -147,13 +153,23 @@ void IpEnum::on_comboBoxOutput_currentIndexChanged(int index){
     ui->comboBoxEngine->clear();
     switch(index){
     case 0:
-        ui->comboBoxEngine->addItems({"IpData", "IpRegistry", "IpInfo", "IpAPI" });
+        ui->comboBoxEngine->addItems({"IpData", "IpRegistry", "IpInfo", "IpAPI", "Offline"});
+        ui->checkBoxBulk->setEnabled(true);
         break;
     case 1:
         ui->comboBoxEngine->addItems({"Omnisint"});
+        ui->checkBoxBulk->setChecked(false);
+        ui->checkBoxBulk->setDisabled(true);
     }
 }
 
+void IpEnum::on_checkBoxBulk_toggled(bool checked){
+    if(checked)
+        ui->lineEditTarget->setPlaceholderText(PLACEHOLDERTEXT_BULK_IP);
+    else
+        ui->lineEditTarget->setPlaceholderText(PLACEHOLDERTEXT_IP);
+}
+
 void IpEnum::on_buttoApiKeys_clicked(){
     ApiKeysDialog *apiKeysDialog = new ApiKeysDialog(this);
     apiKeysDialog->setAttribute(Qt::WA_DeleteOnClose, true);
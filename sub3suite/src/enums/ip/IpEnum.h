@@ -10,6 +10,8 @@
 
 #include "../AbstractEnum.h"
 #include "src/modules/passive/OsintHeaders.h"
+#include "src/modules/active/ScanExecutor.h"
+#include "src/modules/active/IPDBScanner.h"
 
 #include <QAction>
 
@@ -29,8 +31,9 @@ class IpEnum : public AbstractEnum{
         void onResult(s3s_struct::IP);
         void onResult_reverse(s3s_struct::IP);
 
-        void onScanThreadEnded();
+        void onScanEnded();
         void onScanLog(ScanLog log);
+        void onOfflineLog(scan::Log log);
         void onReScan(QQueue<QString> targets);
 
         void onReceiveTargets(QSet<QString>, RESULT_TYPE);
@@ -44,6 +47,7 @@ class IpEnum : public AbstractEnum{
         void on_lineEditFilter_textChanged(const QString &arg1);
         void on_buttonAction_clicked();
         void on_comboBoxOutput_currentIndexChanged(int index);
+        void on_checkBoxBulk_toggled(bool checked);
 
         void on_buttoApiKeys_clicked();
 
@@ -59,12 +63,17 @@ private:
         ScanConfig *m_scanConfig;
         ScanArgs *m_scanArgs;
 
+        /* the lookups on the local ip database */
+        ipdb::ScanArgs m_offlineArgs;
+        ScanExecutor m_executor;
+
         void initUI();
         void initConfigValues();
 
         void startScan();
         void startScanThread(AbstractOsintModule*);
         void startScanThread_reverseIP(AbstractOsintModule*);
+        void startScanOffline();
         void log(QString log);
 
         /* for context menu */
@@ -7,6 +7,7 @@
 
 #include "IpEnum.h"
 #include "ui_IpEnum.h"
+#include "src/utils/ReverseIndex.h"
 
 
 void IpEnum::onResult(s3s_struct::IP results){
@@ -27,6 +28,8 @@ void IpEnum::onResult(s3s_struct::IP results){
 }
 
 void IpEnum::onResult_reverse(s3s_struct::IP results){
+    s3s_ReverseIndex::instance().insert(results);
+
     if(m_resultsSet.contains(results.ip))
     {
         s3s_item::IP *item = m_resultsSet.value(results.ip);
@@ -43,6 +46,15 @@ void IpEnum::onResult_reverse(s3s_struct::IP results){
         project->addEnumIP_domains(results);
 }
 
+void IpEnum::onOfflineLog(scan::Log log){
+    ScanLog scanLog;
+    scanLog.moduleName = "Offline";
+    scanLog.target = log.target;
+    scanLog.message = log.message;
+    scanLog.error = true;
+    this->onScanLog(scanLog);
+}
+
 void IpEnum::onScanLog(ScanLog log){
     if(log.error){
         QString message("<font color=\"red\">"+log.message+"</font>");
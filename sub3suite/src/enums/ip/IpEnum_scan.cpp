@@ -2,45 +2,40 @@
 #include "ui_IpEnum.h"
 
 #include "src/dialogs/FailedScansDialog.h"
+#include "src/utils/IpDatabase.h"
 
 
-void IpEnum::onScanThreadEnded(){
-    status->activeScanThreads--;
+void IpEnum::onScanEnded(){
+    /* display the scan summary on logs
+    m_scanSummary();
+    */
 
-    /* if all Scan Threads have finished... */
-    if(status->activeScanThreads == 0)
-    {
-        /* display the scan summary on logs
-        m_scanSummary();
-        */
-
-        if(status->isStopped)
-            this->log("---------------- Stopped ------------\n");
-        else
-            this->log("------------------ End --------------\n");
+    if(status->isStopped)
+        this->log("---------------- Stopped ------------\n");
+    else
+        this->log("------------------ End --------------\n");
 
-        qInfo() << "[IP-Enum] Scan Ended";
+    qInfo() << "[IP-Enum] Scan Ended";
 
-        /* set the progress bar to 100% just in case... */
-        if(!status->isStopped)
-            ui->progressBar->setValue(ui->progressBar->maximum());
+    /* set the progress bar to 100% just in case... */
+    if(!status->isStopped)
+        ui->progressBar->setValue(ui->progressBar->maximum());
 
-        status->isNotActive = true;
-        status->isPaused = false;
-        status->isStopped = false;
-        status->isRunning = false;
+    status->isNotActive = true;
+    status->isPaused = false;
+    status->isStopped = false;
+    status->isRunning = false;
 
-        ui->buttonStart->setEnabled(true);
-        ui->buttonStop->setDisabled(true);
+    ui->buttonStart->setEnabled(true);
+    ui->buttonStop->setDisabled(true);
 
-        /* launching the failed scans dialog if there were failed scans */
-        if(!m_failedScans.isEmpty()){
-            FailedScansDialog *failedScansDialog = new FailedScansDialog(this, m_failedScans);
-            failedScansDialog->setAttribute(Qt::WA_DeleteOnClose, true);
+    /* launching the failed scans dialog if there were failed scans */
+    if(!m_failedScans.isEmpty()){
+        FailedScansDialog *failedScansDialog = new FailedScansDialog(this, m_failedScans);
+        failedScansDialog->setAttribute(Qt::WA_DeleteOnClose, true);
 
-            connect(failedScansDialog, &FailedScansDialog::reScan, this, &IpEnum::onReScan);
-            failedScansDialog->show();
-        }
+        connect(failedScansDialog, &FailedScansDialog::reScan, this, &IpEnum::onReScan);
+        failedScansDialog->show();
     }
 }
 
@@ -66,6 +61,7 @@ void IpEnum::startScan(){
     m_scanArgs->config->progress = 0;
 
     m_scanArgs->output_EnumIP = true;
+    m_scanArgs->batch = ui->checkBoxBulk->isChecked();
 
     /* start scanthread */
     switch (ui->comboBoxOutput->currentIndex())
@@ -85,6 +81,9 @@ void IpEnum::startScan(){
         case 3: // IPAPI
             this->startScanThread(new IpApi(*m_scanArgs));
             break;
+        case 4: // OFFLINE
+            this->startScanOffline();
+            break;
         }
         break;
 
@@ -99,33 +98,17 @@ void IpEnum::startScan(){
 }
 
 void IpEnum::startScanThread(AbstractOsintModule *module){
-    QThread *cThread = new QThread;
-    module->startScan(cThread);
-    module->moveToThread(cThread);
     connect(module, &AbstractOsintModule::resultEnumIP, this, &IpEnum::onResult);
-    connect(this, &IpEnum::stopScanThread, module, &AbstractOsintModule::onStop);
     connect(module, &AbstractOsintModule::scanProgress, ui->progressBar, &QProgressBar::setValue);
     connect(module, &AbstractOsintModule::scanLog, this, &IpEnum::onScanLog);
-    connect(cThread, &QThread::finished, this, &IpEnum::onScanThreadEnded);
-    connect(cThread, &QThread::finished, module, &AbstractOsintModule::deleteLater);
-    connect(cThread, &QThread::finished, cThread, &QThread::deleteLater);
-    cThread->start();
-    status->activeScanThreads++;
+    m_executor.start(module);
 }
 
 void IpEnum::startScanThread_reverseIP(AbstractOsintModule *module){
-    QThread *cThread = new QThread;
-    module->startScan(cThread);
-    module->moveToThread(cThread);
     connect(module, &AbstractOsintModule::resultEnumIP, this, &IpEnum::onResult_reverse);
-    connect(this, &IpEnum::stopScanThread, module, &AbstractOsintModule::onStop);
     connect(module, &AbstractOsintModule::scanProgress, ui->progressBar, &QProgressBar::setValue);
     connect(module, &AbstractOsintModule::scanLog, this, &IpEnum::onScanLog);
-    connect(cThread, &QThread::finished, this, &IpEnum::onScanThreadEnded);
-    connect(cThread, &QThread::finished, module, &AbstractOsintModule::deleteLater);
-    connect(cThread, &QThread::finished, cThread, &QThread::deleteLater);
-    cThread->start();
-    status->activeScanThreads++;
+    m_executor.start(module);
 }
 
 void IpEnum::onReScan(QQueue<QString> targets){
@@ -142,3 +125,18 @@ void IpEnum::onReScan(QQueue<QString> targets){
     this->log("------------------ Re-Scan ----------------");
     qInfo() << "[IP-Enum] Re-Scan Started";
 }
+
+/* looks up the targets on the local ip database on a worker, no requests are sent */
+void IpEnum::startScanOffline(){
+    m_offlineArgs.targets = m_scanArgs->targets;
+    m_offlineArgs.progress = 0;
+    s3s_IpDatabase::configuredPaths(m_offlineArgs.routes, m_offlineArgs.names, m_offlineArgs.geo);
+
+    /* the lookups take microseconds, one worker */
+    ipdb::Scanner *scanner = new ipdb::Scanner(&m_offlineArgs);
+    connect(scanner, &ipdb::Scanner::scanResult, this, &IpEnum::onResult);
+    connect(scanner, &ipdb::Scanner::scanStatus, this, &IpEnum::log);
+    connect(scanner, &ipdb::Scanner::scanProgress, ui->progressBar, &QProgressBar::setValue);
+    connect(scanner, &ipdb::Scanner::scanLog, this, &IpEnum::onOfflineLog);
+    m_executor.start(scanner);
+}
@@ -34,8 +34,11 @@ MXEnum::MXEnum(QWidget *parent, ProjectModel *project) : AbstractEnum(parent, pr
 
     /* scan arguments */
     m_scanArgs->config = m_scanConfig;
+
+    connect(&m_executor, &ScanExecutor::finished, this, &MXEnum::onScanEnded);
 }
 MXEnum::~MXEnum(){
+    m_executor.shutdown();
     delete m_scanArgs;
     delete m_scanConfig;
     delete m_targetsListModel;
@@ -76,7 +79,7 @@ void MXEnum::on_buttonStart_clicked(){
 }
 
 void MXEnum::on_buttonStop_clicked(){
-    emit stopScanThread();
+    m_executor.stop();
 
     status->isStopped = true;
     status->isNotActive = false;
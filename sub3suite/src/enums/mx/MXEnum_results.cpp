@@ -7,9 +7,12 @@
 
 #include "MXEnum.h"
 #include "ui_MXEnum.h"
+#include "src/utils/ReverseIndex.h"
 
 
 void MXEnum::onResult(s3s_struct::MX results){
+    s3s_ReverseIndex::instance().insert(results);
+
     if(m_resultsSet.contains(results.mx))
     {
         s3s_item::MX *item = m_resultsSet.value(results.mx);
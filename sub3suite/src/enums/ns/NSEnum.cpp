@@ -34,8 +34,11 @@ NSEnum::NSEnum(QWidget *parent, ProjectModel *project) : AbstractEnum(parent, pr
 
     /* scan arguments */
     m_scanArgs->config = m_scanConfig;
+
+    connect(&m_executor, &ScanExecutor::finished, this, &NSEnum::onScanEnded);
 }
 NSEnum::~NSEnum(){
+    m_executor.shutdown();
     delete m_scanArgs;
     delete m_scanConfig;
     delete m_targetsListModel;
@@ -76,7 +79,7 @@ void NSEnum::on_buttonStart_clicked(){
 }
 
 void NSEnum::on_buttonStop_clicked(){
-    emit stopScanThread();
+    m_executor.stop();
 
     status->isStopped = true;
     status->isNotActive = false;
@@ -11,6 +11,7 @@
 #include "../AbstractEnum.h"
 #include "src/items/NSItem.h"
 #include "src/modules/passive/OsintHeaders.h"
+#include "src/modules/active/ScanExecutor.h"
 
 
 namespace Ui {
@@ -27,7 +28,7 @@ class NSEnum : public AbstractEnum {
     public slots:
         void onResult(s3s_struct::NS results);
 
-        void onScanThreadEnded();
+        void onScanEnded();
         void onScanLog(ScanLog log);
         void onReScan(QQueue<QString> targets);
 
@@ -55,11 +56,15 @@ private:
 
         ScanConfig *m_scanConfig;
         ScanArgs *m_scanArgs;
+        ScanExecutor m_executor;
 
         void initUI();
         void initConfigValues();
 
         void startScan();
+
+        /* answers the targets in the reverse index, returns the targets left for the api */
+        int lookupIndex();
         void startScanThread(AbstractOsintModule*);
         void log(QString log);
 
@@ -7,9 +7,12 @@
 
 #include "NSEnum.h"
 #include "ui_NSEnum.h"
+#include "src/utils/ReverseIndex.h"
 
 
 void NSEnum::onResult(s3s_struct::NS results){
+    s3s_ReverseIndex::instance().insert(results);
+
     if(m_resultsSet.contains(results.ns))
     {
         s3s_item::NS *item = m_resultsSet.value(results.ns);
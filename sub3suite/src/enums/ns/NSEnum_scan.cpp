@@ -2,41 +2,38 @@
 #include "ui_NSEnum.h"
 
 #include "src/dialogs/FailedScansDialog.h"
+#include "src/utils/ReverseIndex.h"
 
+#include <QTimer>
 
-void NSEnum::onScanThreadEnded(){
-    status->activeScanThreads--;
 
-    /* if all Scan Threads have finished... */
-    if(status->activeScanThreads == 0)
-    {
-        if(status->isStopped)
-            this->log("---------------- Stopped ------------\n");
-        else
-            this->log("------------------ End --------------\n");
+void NSEnum::onScanEnded(){
+    if(status->isStopped)
+        this->log("---------------- Stopped ------------\n");
+    else
+        this->log("------------------ End --------------\n");
 
-        qInfo() << "[NS-Enum] Scan Ended";
+    qInfo() << "[NS-Enum] Scan Ended";
 
-        /* set the progress bar to 100% just in case... */
-        if(!status->isStopped)
-            ui->progressBar->setValue(ui->progressBar->maximum());
+    /* set the progress bar to 100% just in case... */
+    if(!status->isStopped)
+        ui->progressBar->setValue(ui->progressBar->maximum());
 
-        status->isNotActive = true;
-        status->isPaused = false;
-        status->isStopped = false;
-        status->isRunning = false;
+    status->isNotActive = true;
+    status->isPaused = false;
+    status->isStopped = false;
+    status->isRunning = false;
 
-        ui->buttonStart->setEnabled(true);
-        ui->buttonStop->setDisabled(true);
+    ui->buttonStart->setEnabled(true);
+    ui->buttonStop->setDisabled(true);
 
-        /* launching the failed scans dialog if there were failed scans */
-        if(!m_failedScans.isEmpty()){
-            FailedScansDialog *failedScansDialog = new FailedScansDialog(this, m_failedScans);
-            failedScansDialog->setAttribute(Qt::WA_DeleteOnClose, true);
+    /* launching the failed scans dialog if there were failed scans */
+    if(!m_failedScans.isEmpty()){
+        FailedScansDialog *failedScansDialog = new FailedScansDialog(this, m_failedScans);
+        failedScansDialog->setAttribute(Qt::WA_DeleteOnClose, true);
 
-            connect(failedScansDialog, &FailedScansDialog::reScan, this, &NSEnum::onReScan);
-            failedScansDialog->show();
-        }
+        connect(failedScansDialog, &FailedScansDialog::reScan, this, &NSEnum::onReScan);
+        failedScansDialog->show();
     }
 }
 
@@ -57,6 +54,12 @@ void NSEnum::startScan(){
     status->isStopped = false;
     status->isPaused = false;
 
+    /* the targets in the reverse index are answered locally, the api is queried for the others */
+    if(ui->checkBoxLocalIndex->isChecked() && this->lookupIndex() == 0){
+        QTimer::singleShot(0, this, &NSEnum::onScanEnded);
+        return;
+    }
+
     /* progressbar maximum value */
     ui->progressBar->setMaximum(m_scanArgs->targets.length());
     m_scanArgs->config->progress = 0;
@@ -89,18 +92,32 @@ void NSEnum::startScan(){
 }
 
 void NSEnum::startScanThread(AbstractOsintModule *module){
-    QThread *cThread = new QThread;
-    module->startScan(cThread);
-    module->moveToThread(cThread);
     connect(module, &AbstractOsintModule::resultEnumNS, this, &NSEnum::onResult);
-    connect(this, &NSEnum::stopScanThread, module, &AbstractOsintModule::onStop);
     connect(module, &AbstractOsintModule::scanProgress, ui->progressBar, &QProgressBar::setValue);
     connect(module, &AbstractOsintModule::scanLog, this, &NSEnum::onScanLog);
-    connect(cThread, &QThread::finished, this, &NSEnum::onScanThreadEnded);
-    connect(cThread, &QThread::finished, module, &AbstractOsintModule::deleteLater);
-    connect(cThread, &QThread::finished, cThread, &QThread::deleteLater);
-    cThread->start();
-    status->activeScanThreads++;
+    m_executor.start(module);
+}
+
+int NSEnum::lookupIndex(){
+    s3s_ReverseIndex &index = s3s_ReverseIndex::instance();
+
+    QQueue<QString> targets;
+    foreach(const QString &target, m_scanArgs->targets){
+        QStringList domains = index.lookup(reverse::KIND::NS, target);
+        if(domains.isEmpty()){
+            targets.enqueue(target);
+            continue;
+        }
+
+        s3s_struct::NS result;
+        result.ns = target;
+        result.domains = domains.toSet();
+        this->onResult(result);
+        this->log(target+": "+QString::number(domains.size())+" domains from the local index");
+    }
+
+    m_scanArgs->targets = targets;
+    return targets.length();
 }
 
 void NSEnum::onReScan(QQueue<QString> targets){
@@ -33,8 +33,11 @@ SSLEnum::SSLEnum(QWidget *parent, ProjectModel *project) : AbstractEnum(parent,
 
     /* scan arguments */
     m_scanArgs->config = m_scanConfig;
+
+    connect(&m_executor, &ScanExecutor::finished, this, &SSLEnum::onScanEnded);
 }
 SSLEnum::~SSLEnum(){
+    m_executor.shutdown();
     delete m_scanArgs;
     delete m_scanConfig;
     delete m_targetsListModel;
@@ -75,7 +78,7 @@ void SSLEnum::on_buttonStart_clicked(){
 }
 
 void SSLEnum::on_buttonStop_clicked(){
-    emit stopScanThread();
+    m_executor.stop();
 
     status->isStopped = true;
     status->isNotActive = false;
@@ -10,6 +10,7 @@
 
 #include "../AbstractEnum.h"
 #include "src/modules/passive/OsintHeaders.h"
+#include "src/modules/active/ScanExecutor.h"
 
 
 namespace Ui {
@@ -26,7 +27,7 @@ class SSLEnum : public AbstractEnum {
     public slots:
         void onResult(QString target, QSslCertificate ssl);
 
-        void onScanThreadEnded();
+        void onScanEnded();
         void onScanLog(ScanLog log);
         void onReScan(QQueue<QString> targets);
 
@@ -53,6 +54,7 @@ class SSLEnum : public AbstractEnum {
 
         ScanConfig *m_scanConfig;
         ScanArgs *m_scanArgs;
+        ScanExecutor m_executor;
 
         void initUI();
         void initConfigValues();
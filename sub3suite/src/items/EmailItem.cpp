@@ -30,6 +30,8 @@ s3s_struct::Email email_to_struct(s3s_item::Email *item){
     else
         email.deliverable = false;
 
+    email.catchAll = (item->catchAll->text() == "true");
+
     return email;
 }
 
@@ -45,6 +47,7 @@ QJsonObject email_to_json(s3s_item::Email *item){
     email.insert("hostExists", item->hostExists->text());
     email.insert("disposable", item->disposable->text());
     email.insert("deliverable", item->deliverable->text());
+    email.insert("catchAll", item->catchAll->text());
     email.insert("item_info", item_info);
 
     return email;
@@ -57,6 +60,7 @@ void json_to_email(const QJsonObject &email, s3s_item::Email *item){
     item->hostExists->setText(email.value("hostExists").toString());
     item->disposable->setText(email.value("disposable").toString());
     item->deliverable->setText(email.value("deliverable").toString());
+    item->catchAll->setText(email.value("catchAll").toString());
 
     QJsonObject item_info = email.value("item_info").toObject();
     item->comment = item_info["comment"].toString();
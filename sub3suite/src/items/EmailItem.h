@@ -24,6 +24,7 @@ struct Email {
     bool hostExists;
     bool disposable;
     bool deliverable;
+    bool catchAll = false;
 };
 }
 
@@ -36,7 +37,8 @@ public:
         free(new QStandardItem),
         hostExists(new QStandardItem),
         disposable(new QStandardItem),
-        deliverable(new QStandardItem)
+        deliverable(new QStandardItem),
+        catchAll(new QStandardItem)
     {
         this->setForeground(Qt::white);
         this->setIcon(QIcon(":/img/res/icons/folder.png"));
@@ -49,6 +51,7 @@ public:
         info->appendRow({new QStandardItem("Host Exists"), hostExists});
         info->appendRow({new QStandardItem("Disposable"), disposable});
         info->appendRow({new QStandardItem("Deliverable"), deliverable});
+        info->appendRow({new QStandardItem("Catch All"), catchAll});
 
         info->setWhatsThis(JSON_OBJECT);
 
@@ -65,6 +68,7 @@ public:
     QStandardItem *hostExists;
     QStandardItem *disposable;
     QStandardItem *deliverable;
+    QStandardItem *catchAll;
 
     /* summary */
     QString last_modified;
@@ -95,6 +99,11 @@ public:
         else
             hostExists->setText("false");
 
+        if(email.catchAll)
+            catchAll->setText("true");
+        else
+            catchAll->setText("false");
+
         /* last modified */
         last_modified = QDate::currentDate().toString();
     }
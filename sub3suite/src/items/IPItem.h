@@ -42,12 +42,12 @@ struct IP {
     QString companyInfo_domain;
 
     /* privacyInfo */
-    bool privacyInfo_proxy;
-    bool privacyInfo_anonymous;
-    bool privacyInfo_tor;
-    bool privacyInfo_attacker;
-    bool privacyInfo_abuser;
-    bool privacyInfo_threat;
+    bool privacyInfo_proxy = false;
+    bool privacyInfo_anonymous = false;
+    bool privacyInfo_tor = false;
+    bool privacyInfo_attacker = false;
+    bool privacyInfo_abuser = false;
+    bool privacyInfo_threat = false;
 
     /* ... */
     QSet<QString> domains;
@@ -7,7 +7,15 @@
 
 #include "MainWindow.h"
 #include "src/utils/Config.h"
+#include "src/utils/Logger.h"
+#include "src/utils/Hostname.h"
 #include "src/dialogs/StartupDialog.h"
+#include "src/cli/ScanRunner.h"
+#include "src/cli/Bench.h"
+#include "src/cli/Pipeline.h"
+#include "src/cli/Expand.h"
+#include "src/cli/CtTail.h"
+#include "src/cli/EmailVerify.h"
 
 #include <QMap>
 #include <QApplication>
@@ -49,46 +57,6 @@ void registerMetaTypes(){
     qRegisterMetaType<QSslCertificate>("QSslCertificate");
 }
 
-///
-/// a custom messagehandler for logging messages to log file
-///
-void s3s_MessageHandler(QtMsgType type, const QMessageLogContext &, const QString & msg)
-{
-    QString log;
-    QString time(QDateTime::currentDateTime().toString("hh:mm:ss"));
-
-    switch (type) {
-    case QtInfoMsg:
-        log = QString("[%1] INFO: %2").arg(time).arg(msg);
-        break;
-    case QtDebugMsg:
-        log = QString("[%1] DEBUG: %2").arg(time).arg(msg);
-        break;
-    case QtWarningMsg:
-        log = QString("[%1] WARNING: %2").arg(time).arg(msg);
-        break;
-    case QtCriticalMsg:
-	case QtFatalMsg:
-        log = QString("[%1] ERROR: %2").arg(time).arg(msg);
-        break;
-    }
-
-    QMutex mutex;
-    mutex.lock();
-
-    QString date = QDateTime::currentDateTime().toString("dd-MM-yyyy");
-    QFile logfile(QApplication::applicationDirPath()+"/logs/"+date+".log");
-
-    if(logfile.open(QIODevice::WriteOnly | QIODevice::Append)){
-        QTextStream ts(&logfile);
-        ts << log << endl;
-        logfile.flush();
-        logfile.close();
-    }
-
-    mutex.unlock();
-}
-
 ///
 /// a custom QApplication with exceptions handling
 ///
@@ -118,6 +86,40 @@ public:
 
 int main(int argc, char *argv[])
 {
+    /* the public suffix list, loaded before any scanning thread uses it */
+    s3s_SuffixList::instance();
+
+    /* headless scan, "sub3suite scan --help" for the options */
+    if(argc > 1 && qstrcmp(argv[1], "scan") == 0){
+        registerMetaTypes();
+        return cli::run(argc, argv);
+    }
+    /* scanner benchmarks, "sub3suite bench --help" for the options */
+    if(argc > 1 && qstrcmp(argv[1], "bench") == 0){
+        registerMetaTypes();
+        return bench::run(argc, argv);
+    }
+    /* scan pipelines, "sub3suite pipeline --help" for the options */
+    if(argc > 1 && qstrcmp(argv[1], "pipeline") == 0){
+        registerMetaTypes();
+        return cli::runPipeline(argc, argv);
+    }
+    /* asn expansion & sweeps, "sub3suite expand --help" for the options */
+    if(argc > 1 && qstrcmp(argv[1], "expand") == 0){
+        registerMetaTypes();
+        return cli::runExpand(argc, argv);
+    }
+    /* certificate transparency tail, "sub3suite ct --help" for the options */
+    if(argc > 1 && qstrcmp(argv[1], "ct") == 0){
+        registerMetaTypes();
+        return cli::runCt(argc, argv);
+    }
+    /* email verification, "sub3suite email --help" for the options */
+    if(argc > 1 && qstrcmp(argv[1], "email") == 0){
+        registerMetaTypes();
+        return cli::runEmail(argc, argv);
+    }
+
     /* dpi scalling */
     qputenv("QT_AUTO_SCREEN_SCALE_FACTOR", "1");
     s3s_Application::setAttribute(Qt::AA_EnableHighDpiScaling);
@@ -131,9 +133,6 @@ int main(int argc, char *argv[])
     /* removing context help button from all on dialogs for now */
     QApplication::setAttribute(Qt::AA_DisableWindowContextHelpButton);
 
-    /* installing the message handler */
-    qInstallMessageHandler(s3s_MessageHandler);
-
     /* app info */
     QCoreApplication::setOrganizationName("Sub3 Suite");
     QCoreApplication::setApplicationName("Sub3 Suite");
@@ -143,6 +142,9 @@ int main(int argc, char *argv[])
     /* create the sub3suite app */
     s3s_Application s3s_app(argc, argv);
 
+    /* the logger, installs the message handler & writes the log files on its own thread */
+    s3s_Logger logger(QApplication::applicationDirPath()+"/logs");
+
 #if defined(Q_OS_LINUX) || defined(Q_OS_WIN)
     /* initializing the crash handler */
     Breakpad::CrashHandler::instance()->Init(QGuiApplication::applicationDirPath()+"/logs");
@@ -195,6 +195,59 @@ void ProjectModel::clearModels(){
     this->setHeaderLabels();
 }
 
+int ProjectModel::removeDuplicates(QStandardItemModel *model){
+    QSet<QString> set;
+    bool duplicates = false;
+    for(int i = 0; i < model->rowCount() && !duplicates; i++){
+        QString text = model->item(i,0)->text();
+        duplicates = set.contains(text);
+        set.insert(text);
+    }
+    if(!duplicates)
+        return 0;
+
+    /*
+     * removing a row shifts all the rows after it, instead the rows are taken out from the end
+     * (nothing to shift) & the unique rows are put back in their order.
+     */
+    QList<QList<QStandardItem*>> rows;
+    rows.reserve(model->rowCount());
+    while(model->rowCount())
+        rows.prepend(model->takeRow(model->rowCount()-1));
+
+    int removed = 0;
+    set.clear();
+    foreach(const QList<QStandardItem*> &row, rows){
+        if(set.contains(row.first()->text())){
+            qDeleteAll(row);
+            removed++;
+        }
+        else {
+            set.insert(row.first()->text());
+            model->appendRow(row);
+        }
+    }
+    return removed;
+}
+
+QQueue<QString> ProjectModel::getIPs(){
+    /* the unique ips, in one pass over the hosts */
+    QSet<QString> ips;
+    foreach(s3s_item::HOST *host, map_activeHost){
+        if(!host->ipv4->text().isEmpty())
+            ips.insert(host->ipv4->text());
+        if(!host->ipv6->text().isEmpty())
+            ips.insert(host->ipv6->text());
+    }
+    foreach(const QString &ip, map_enumIP.keys())
+        ips.insert(ip);
+
+    QQueue<QString> queue;
+    foreach(const QString &ip, ips)
+        queue.enqueue(ip);
+    return queue;
+}
+
 int ProjectModel::getItemsCount(){
     return  activeHost->rowCount()+
             activeWildcard->rowCount()+
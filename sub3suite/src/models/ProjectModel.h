@@ -30,7 +30,6 @@
 
 #include "ExplorerModel.h"
 
-
 struct ProjectStruct{
     QString name;
     QString path;
@@ -57,11 +56,20 @@ public:
     void saveProjectCopy();
     void closeProject();
 
+    /* writes the compressed project to the file, without updating the project's status */
+    bool saveProjectFile(const QString &path);
+
     /* actions */
     void clearModels();
     int getItemsCount();
     void setHeaderLabels();
 
+    /* removes the rows whose first column repeats an earlier row, returns the number removed */
+    static int removeDuplicates(QStandardItemModel *model);
+
+    /* the unique ips of the hosts & of the enumerated ips, for the offline enrichment */
+    QQueue<QString> getIPs();
+
     /* project  information */
     ProjectStruct info;
 
@@ -10,6 +10,7 @@
 
 #include "src/utils/Config.h"
 #include "src/items/ASNItem.h"
+#include "src/utils/ReverseIndex.h"
 
 
 void ProjectModel::openExistingProject(QString name, QString path){
@@ -30,13 +31,8 @@ void ProjectModel::openExistingProject(QString name, QString path){
 void ProjectModel::saveProject(){
     qDebug() << "Saving Project: " << info.path;
 
-    QFile file(info.path);
-    if(file.open(QIODevice::WriteOnly))
+    if(this->saveProjectFile(info.path))
     {
-        /* compress the data then save */
-        file.write(qCompress(this->getJson()));
-        file.close();
-
         /* adding to recent projects */
         CONFIG.beginGroup(CFG_GRP_RECENT);
         CONFIG.setValue(info.name, info.path);
@@ -50,6 +46,8 @@ void ProjectModel::saveProject(){
         info.isConfigured = true;
 
         qDebug() << "Project Saved!";
+
+        s3s_ReverseIndex::instance().saveConfigured();
     }
     else
         qWarning() << "Failed To Open Project File";
@@ -58,13 +56,8 @@ void ProjectModel::saveProject(){
 void ProjectModel::saveProjectCopy(){
     qDebug() << "Saving Project Copy: " << info.path;
 
-    QFile file(info.path);
-    if(file.open(QIODevice::WriteOnly))
+    if(this->saveProjectFile(info.path))
     {
-        /* compress the data then save */
-        file.write(qCompress(this->getJson()));
-        file.close();
-
         /* adding to recent projects */
         CONFIG.beginGroup(CFG_GRP_RECENT);
         CONFIG.setValue(info.name, info.path);
@@ -76,6 +69,17 @@ void ProjectModel::saveProjectCopy(){
         qWarning() << "Failed To Open Project Copy File";
 }
 
+bool ProjectModel::saveProjectFile(const QString &path){
+    QFile file(path);
+    if(!file.open(QIODevice::WriteOnly))
+        return false;
+
+    /* compress the data then save */
+    file.write(qCompress(this->getJson()));
+    file.close();
+    return true;
+}
+
 void ProjectModel::closeProject(){
     if(modified){
         int retVal = QMessageBox::warning(nullptr, "Sub3 Suite",
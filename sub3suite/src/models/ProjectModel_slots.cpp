@@ -217,7 +217,7 @@ void ProjectModel::addEnumCIDR(const s3s_struct::CIDR &cidr){
 }
 
 void ProjectModel::addEnumIP(const s3s_struct::IP &ip){
-    if(map_enumASN.contains(ip.ip)){
+    if(map_enumIP.contains(ip.ip)){
         s3s_item::IP *item = map_enumIP.value(ip.ip);
         item->addValues(ip);
         return;
@@ -231,7 +231,7 @@ void ProjectModel::addEnumIP(const s3s_struct::IP &ip){
 }
 
 void ProjectModel::addEnumIP_domains(const s3s_struct::IP &ip){
-    if(map_enumASN.contains(ip.ip)){
+    if(map_enumIP.contains(ip.ip)){
         s3s_item::IP *item = map_enumIP.value(ip.ip);
         item->addDomains(ip);
         return;
@@ -10,13 +10,17 @@
 
 #include <QObject>
 #include <QThread>
-#include <QSemaphore>
+#include <QDnsLookup>
+#include <QNetworkReply>
 #include "src/utils/utils.h"
+#include "src/utils/Metrics.h"
+#include "src/utils/StreamQueue.h"
 
 
 enum class RETVAL{
     LOOKUP,
     NEXT,
+    WAIT, // a streamed target may still come
     QUIT
 };
 
@@ -26,6 +30,12 @@ struct Log{
     QString message;
     QString nameserver;
     QString recordType;
+    bool error = true; // a failed lookup, not a miss
+};
+
+struct Control{ // shared by a scan's workers, set by the ScanExecutor
+    QAtomicInt paused;
+    QAtomicInt stopped;
 };
 }
 
@@ -36,31 +46,35 @@ class AbstractScanner : public QObject{
         explicit AbstractScanner(QObject *parent = nullptr)
             : QObject(parent)
         {
+            /* the thread is shared with other workers, the scanner's events after it quit do nothing */
+            connect(this, &AbstractScanner::quitThread, this, [this](){
+                m_ended = true;
+            });
         }
 
-        /* start the scan Object... */
-        void startScan(QThread *cThread)
-        {
-            connect(cThread, &QThread::started, this, &AbstractScanner::lookup);
-            connect(this, &AbstractScanner::quitThread, cThread, &QThread::quit);
+        void setControl(scan::Control *control){
+            m_control = control;
         }
 
+        /* the scanners making blocking calls are given a thread of their own */
+        virtual bool isBlocking() const { return false; }
+
     public slots:
         /* the main method that performs the lookup... */
         virtual void lookup() = 0;
 
-        /* quiting all running threads upon receiving stop signal... */
+        /* cancels the lookups in flight & quits the thread upon receiving stop signal... */
         virtual void onStopScan(){
+            this->cancel();
             emit quitThread();
         }
 
-        /* use QSemaphore to pause and resume threads */
-        virtual void onPauseScan(){
-            semaphore.acquire();
-        }
-
+        /* a worker parked on a pause continues with its next lookup */
         virtual void onResumeScan(){
-            semaphore.release();
+            if(!m_parked)
+                return;
+            m_parked = false;
+            this->lookup();
         }
 
     signals:
@@ -69,10 +83,53 @@ class AbstractScanner : public QObject{
         void scanProgress(int value);
 
     private:
-        QSemaphore semaphore;
+        scan::Control *m_control = nullptr;
+        bool m_parked = false;
+        bool m_ended = false;
 
     protected:
         scan::Log log;
+
+        /*
+         * cooperative checkpoint at the start of each lookup, returns false if the worker should not
+         * go on. a paused worker parks without blocking its event loop until onResumeScan.
+         */
+        bool checkpoint(){
+            if(m_ended)
+                return false;
+            if(!m_control)
+                return true;
+            if(m_control->stopped.loadAcquire()){
+                emit quitThread();
+                return false;
+            }
+            if(m_control->paused.loadAcquire()){
+                m_parked = true;
+                return false;
+            }
+            return true;
+        }
+
+        /* for the lookups that take long on one target, true once the scan is stopped */
+        bool stopped() const {
+            return m_control && m_control->stopped.loadAcquire();
+        }
+
+        /* aborts the lookups & requests in flight, their answers are dropped */
+        virtual void cancel(){
+            foreach(QDnsLookup *dns, this->findChildren<QDnsLookup*>()){
+                dns->blockSignals(true);
+                dns->abort();
+            }
+            foreach(QNetworkReply *reply, this->findChildren<QNetworkReply*>()){
+                reply->blockSignals(true);
+                reply->abort();
+            }
+        }
+
+        /* for metrics, start times from metrics::now() */
+        qint64 m_queryStart = 0; // a target taken
+        qint64 m_lookupStart = 0; // its lookup sent
 };
 
 #endif // ABSTRACTSCANNER_H
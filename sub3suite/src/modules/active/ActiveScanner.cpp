@@ -7,6 +7,9 @@
 
 #include "ActiveScanner.h"
 #include "src/utils/s3s.h"
+#include "src/utils/Config.h"
+
+#include <QTimer>
 
 
 active::Scanner::Scanner(active::ScanArgs *args): AbstractScanner(nullptr),
@@ -16,9 +19,10 @@ active::Scanner::Scanner(active::ScanArgs *args): AbstractScanner(nullptr),
     m_dns->setType(m_args->config->recordType);
 
     /* setting nameserver */
-    QString nameserver = m_args->config->nameservers.dequeue();
-    m_dns->setNameserver(QHostAddress(nameserver));
-    m_args->config->nameservers.enqueue(nameserver);
+    m_nameservers = m_args->config->nameservers;
+    m_nameserver = m_args->config->nameservers.dequeue();
+    m_dns->setNameserver(QHostAddress(m_nameserver));
+    m_args->config->nameservers.enqueue(m_nameserver);
 
     connect(m_dns, &QDnsLookup::finished, this, &active::Scanner::lookupFinished);
     connect(this, &active::Scanner::next, this, &active::Scanner::lookup);
@@ -28,6 +32,14 @@ active::Scanner::~Scanner(){
 }
 
 void active::Scanner::lookupFinished(){
+    metrics::recordSince(metrics::SCANNER::ACTIVE, metrics::HISTOGRAM::RESOLVER_RTT, m_lookupStart);
+
+    /* failures worth retrying are looked up again later instead of being logged */
+    if(this->schedule_retry()){
+        emit next();
+        return;
+    }
+
     switch(m_dns->error()){
     case QDnsLookup::NotFoundError:
         break;
@@ -86,6 +98,8 @@ void active::Scanner::lookupFinished(){
         break;
     }
 
+    metrics::recordSince(metrics::SCANNER::ACTIVE, metrics::HISTOGRAM::QUERY_LATENCY, m_queryStart);
+
     /* send results and continue scan */
     m_args->progress++;
     emit scanProgress(m_args->progress);
@@ -93,25 +107,121 @@ void active::Scanner::lookupFinished(){
 }
 
 void active::Scanner::lookup(){
+    if(!this->checkpoint())
+        return;
+
+    m_queryStart = metrics::now();
+
+    /* targets waiting for a retry go first */
+    if(this->lookup_retry())
+        return;
+
     switch (getTarget(m_dns, m_args)) {
     case RETVAL::LOOKUP:
+        m_lookupStart = metrics::now();
         m_dns->lookup();
         if(m_args->config->setTimeout)
             s3s_LookupTimeout::set(m_dns, m_args->config->timeout);
         break;
+    case RETVAL::WAIT:
+        QTimer::singleShot(STREAM_WAIT, this, &active::Scanner::lookup);
+        break;
     default:
-        emit quitThread();
+        this->quit_scan();
         break;
     }
 }
 
+///
+/// retries...
+///
+bool active::Scanner::schedule_retry(){
+    retry::ERROR error = retry::classify(m_dns->error());
+    if(!m_args->config->retry.retries(error, m_retry+1))
+        return false;
+
+    m_args->retries.schedule(m_dns->name(), m_retry+1, m_args->config->retry.delay(m_retry+1));
+    return true;
+}
+
+bool active::Scanner::lookup_retry(){
+    QString target;
+    int retry = 0;
+    if(!m_args->retries.take(target, retry)){
+        if(m_retry){
+            /* back to the scanner's own nameserver */
+            m_retry = 0;
+            m_dns->setNameserver(QHostAddress(m_nameserver));
+        }
+        return false;
+    }
+
+    /* each retry uses a different nameserver if there are more than one */
+    m_retry = retry;
+    m_dns->setName(target);
+    m_dns->setNameserver(QHostAddress(retry::rotate(m_nameservers, m_nameserver, retry)));
+    m_lookupStart = metrics::now();
+    m_dns->lookup();
+    if(m_args->config->setTimeout)
+        s3s_LookupTimeout::set(m_dns, m_args->config->timeout);
+    return true;
+}
+
+void active::Scanner::quit_scan(){
+    /* the thread ends only when no targets are waiting for a retry */
+    int delay = m_args->retries.nextDelay();
+    if(delay == -1)
+        emit quitThread();
+    else
+        QTimer::singleShot(delay, this, &active::Scanner::lookup);
+}
+
 RETVAL active::getTarget(QDnsLookup *dns, active::ScanArgs *args){
-    QMutexLocker(&args->mutex);
+    QMutexLocker locker(&args->mutex);
 
     if(!args->targets.isEmpty()){
         dns->setName(args->targets.dequeue());
         return RETVAL::LOOKUP;
     }
-    else
-        return RETVAL::QUIT;
+    if(args->stream){
+        QString target;
+        switch(args->stream->take(target)){
+        case s3s_StreamQueue::TAKE::TARGET:
+            dns->setName(target);
+            return RETVAL::LOOKUP;
+        case s3s_StreamQueue::TAKE::WAIT:
+            return RETVAL::WAIT;
+        case s3s_StreamQueue::TAKE::CLOSED:
+            break;
+        }
+    }
+    return RETVAL::QUIT;
+}
+
+void active::loadConfig(active::ScanConfig *config){
+    CONFIG.beginGroup(CFG_ACTIVE);
+    config->threads = CONFIG.value(CFG_VAL_THREADS, config->threads).toInt();
+    config->timeout = CONFIG.value(CFG_VAL_TIMEOUT, config->timeout).toInt();
+    config->noDuplicates = CONFIG.value(CFG_VAL_DUPLICATES).toBool();
+    config->autoSaveToProject = CONFIG.value(CFG_VAL_AUTOSAVE).toBool();
+    config->setTimeout = CONFIG.value(CFG_VAL_SETTIMEOUT).toBool();
+    config->retry.maxRetries = CONFIG.value(CFG_VAL_MAXRETRIES, config->retry.maxRetries).toInt();
+    config->retry.backoff = CONFIG.value(CFG_VAL_BACKOFF, config->retry.backoff).toInt();
+    config->inflight = CONFIG.value(CFG_VAL_INFLIGHT, config->inflight).toInt();
+    QString record = CONFIG.value(CFG_VAL_RECORD).toString();
+    CONFIG.endGroup();
+
+    if(record == "A")
+        config->recordType = QDnsLookup::A;
+    if(record == "AAAA")
+        config->recordType = QDnsLookup::AAAA;
+    if(record == "ANY")
+        config->recordType = QDnsLookup::ANY;
+
+    config->nameservers = Config::nameservers("nameservers_active");
+}
+
+qint64 active::prepareScan(active::ScanArgs *args){
+    args->progress = 0;
+    return args->targets.length()+static_cast<qint64>(args->ranges.total());
 }
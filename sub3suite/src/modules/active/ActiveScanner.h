@@ -13,6 +13,8 @@
 #include <QQueue>
 #include "AbstractScanner.h"
 #include "src/items/HostItem.h"
+#include "src/utils/RetryPolicy.h"
+#include "src/utils/CidrIterator.h"
 
 
 namespace active {
@@ -30,20 +32,26 @@ struct ScanConfig { // scan configurations
     QQueue<QString> nameservers;
     int threads = 50;
     int timeout = 3000;
+    int inflight = 16; // lookups in flight per thread, ptr sweep
 
     bool setTimeout = false;
     bool noDuplicates = false;
     bool autoSaveToProject = false;
+
+    retry::Policy retry;
 };
 
 struct ScanArgs { // scan arguments
     QMutex mutex;
     active::ScanConfig *config;
+    retry::Queue retries; // failed targets waiting for their retry
     QQueue<QString> targets;
+    s3s_StreamQueue *stream = nullptr; // targets streamed from a pipeline's stage, after the targets
     QHostAddress nameserver;
     int progress;
 
     QSet<quint16> ports;
+    s3s_CidrIterator ranges; // addresses of a ptr or port sweep
 };
 
 
@@ -65,10 +73,25 @@ class Scanner : public AbstractScanner{
     private:
         active::ScanArgs *m_args;
         QDnsLookup *m_dns;
+
+        /* for retries */
+        QStringList m_nameservers;
+        QString m_nameserver;
+        int m_retry = 0;
+
+        bool lookup_retry();
+        bool schedule_retry();
+        void quit_scan();
 };
 
 RETVAL getTarget(QDnsLookup *dns, active::ScanArgs *args);
 
+/* the configurations of the [active] section, of the active, port & ptr scans */
+void loadConfig(active::ScanConfig *config);
+
+/* returns the targets & the ranges' addresses, the work of the scan's threads */
+qint64 prepareScan(active::ScanArgs *args);
+
 }
 
 #endif // ACTIVESCANNER_H
@@ -7,21 +7,27 @@
 
 #include "BruteScanner.h"
 #include "src/utils/s3s.h"
+#include "src/utils/Config.h"
+
+#include <QTimer>
+#include <climits>
+
+/* milliseconds an idle thread waits for new recursive targets */
+#define RECURSIVE_WAIT 200
 
 
 brute::Scanner::Scanner(brute::ScanArgs *args): AbstractScanner(nullptr),
     m_args(args),
-    m_dns(new QDnsLookup(this)),
-    m_dns_wildcard(new QDnsLookup(this))
+    m_dns(new QDnsLookup(this))
 {
     m_dns->setType(m_args->config->recordType);
 
     /* setting nameserver */
-    QString nameserver = m_args->config->nameservers.dequeue();
-    m_dns->setNameserver(QHostAddress(nameserver));
-    m_args->config->nameservers.enqueue(nameserver);
+    m_nameservers = m_args->config->nameservers;
+    m_nameserver = m_args->config->nameservers.dequeue();
+    m_dns->setNameserver(QHostAddress(m_nameserver));
+    m_args->config->nameservers.enqueue(m_nameserver);
 
-    connect(m_dns_wildcard, &QDnsLookup::finished, this, &brute::Scanner::lookupFinished_wildcard);
     connect(m_dns, &QDnsLookup::finished, this, &brute::Scanner::lookupFinished);
     connect(this, &brute::Scanner::next, this, &brute::Scanner::lookup);
 }
@@ -30,6 +36,15 @@ brute::Scanner::~Scanner(){
 }
 
 void brute::Scanner::lookupFinished(){
+    metrics::recordSince(metrics::SCANNER::BRUTE, metrics::HISTOGRAM::RESOLVER_RTT, m_lookupStart);
+
+    /* failures worth retrying are looked up again later instead of being logged */
+    if(this->schedule_retry()){
+        m_args->activeLookups.deref();
+        emit next();
+        return;
+    }
+
     switch(m_dns->error()){
     case QDnsLookup::NotFoundError:
         break;
@@ -42,52 +57,27 @@ void brute::Scanner::lookupFinished(){
         break;
 
     case QDnsLookup::NoError:
+    {
         if(m_dns->hostAddressRecords().isEmpty())
             break;
 
-        switch (m_args->config->recordType) {
-        case QDnsLookup::A:
-        {
-            QString address = m_dns->hostAddressRecords().at(0).value().toString();
-            if(m_args->config->checkWildcard && has_wildcards){
-                if(address == wildcard_ip)
-                    break;
-            }
-            s3s_struct::HOST host;
-            host.host = m_dns->name();
-            host.ipv4 = address;
-            emit scanResult(host);
-        }
-            break;
-        case QDnsLookup::AAAA:
-        {
-            QString address = m_dns->hostAddressRecords().at(0).value().toString();
-            if(m_args->config->checkWildcard && has_wildcards){
-                if(address == wildcard_ip)
-                    break;
-            }
-            s3s_struct::HOST host;
-            host.host = m_dns->name();
-            host.ipv6 = address;
-            emit scanResult(host);
-        }
-            break;
-        case QDnsLookup::ANY:
-        {
-            s3s_struct::HOST host;
-            host.host = m_dns->name();
-            foreach(const QDnsHostAddressRecord &addr, m_dns->hostAddressRecords()){
-                if(addr.value().protocol() == QAbstractSocket::IPv4Protocol)
-                    host.ipv4 = addr.value().toString();
-                if(addr.value().protocol() == QAbstractSocket::IPv6Protocol)
-                    host.ipv6 = addr.value().toString();
-            }
-            emit scanResult(host);
-        }
-            break;
-        default:
-            break;
+        brute::WildcardResult result;
+        result.host.host = m_dns->name();
+        foreach(const QDnsHostAddressRecord &addr, m_dns->hostAddressRecords()){
+            result.answers.insert(addr.value().toString());
+            if(addr.value().protocol() == QAbstractSocket::IPv4Protocol && result.host.ipv4.isEmpty())
+                result.host.ipv4 = addr.value().toString();
+            if(addr.value().protocol() == QAbstractSocket::IPv6Protocol && result.host.ipv6.isEmpty())
+                result.host.ipv6 = addr.value().toString();
         }
+
+        /* wildcards are only analysed for subdomains */
+        if(m_args->config->checkWildcard && m_args->output == OUTPUT::SUBDOMAIN)
+            result.zones = brute::wildcardZones(result.host.host, m_target);
+        result.target = m_target;
+
+        this->filter_wildcard(result);
+    }
         break;
 
     default:
@@ -98,6 +88,11 @@ void brute::Scanner::lookupFinished(){
         break;
     }
 
+    metrics::recordSince(metrics::SCANNER::BRUTE, metrics::HISTOGRAM::QUERY_LATENCY, m_queryStart);
+
+    /* the lookup ends once its result is recursed, the other threads wait for the sublevel till then */
+    m_args->activeLookups.deref();
+
     /* send results and continue scan */
     m_args->progress++;
     emit scanProgress(m_args->progress);
@@ -105,15 +100,42 @@ void brute::Scanner::lookupFinished(){
 }
 
 void brute::Scanner::lookup(){
+    if(!this->checkpoint())
+        return;
+
+    /* backpressure, the pipeline's stages drain their queues first */
+    foreach(s3s_StreamQueue *queue, m_args->downstream){
+        if(queue->isFull()){
+            QTimer::singleShot(STREAM_WAIT, this, &brute::Scanner::lookup);
+            return;
+        }
+    }
+
+    m_queryStart = metrics::now();
+
+    /* targets waiting for a retry go first */
+    if(this->lookup_retry())
+        return;
+
     if(m_args->reScan){
+        m_target.clear();
         switch(brute::getTarget_reScan(m_dns, m_args)){
         case RETVAL::LOOKUP:
-            m_dns->lookup();
-            if(m_args->config->setTimeout)
-                s3s_LookupTimeout::set(m_dns, m_args->config->timeout);
+            this->start_lookup();
             return;
         default:
-            emit quitThread();
+            this->quit_scan();
+            return;
+        }
+    }
+
+    if(m_args->permutations){
+        switch(brute::getTarget_permutation(m_dns, m_args, m_target)){
+        case RETVAL::LOOKUP:
+            this->start_lookup();
+            return;
+        default:
+            this->quit_scan();
             return;
         }
     }
@@ -121,90 +143,218 @@ void brute::Scanner::lookup(){
     switch(m_args->output)
     {
     case OUTPUT::SUBDOMAIN:
-        switch(brute::getTarget_subdomain(this, m_dns, m_args)){
+        switch(brute::getTarget_subdomain(m_dns, m_args, m_target)){
         case RETVAL::LOOKUP:
-            m_dns->lookup();
-            if(m_args->config->setTimeout)
-                s3s_LookupTimeout::set(m_dns, m_args->config->timeout);
+            this->start_lookup();
             break;
         case RETVAL::NEXT:
             emit next();
             break;
+        case RETVAL::WAIT: // only streamed targets wait
         case RETVAL::QUIT:
-            emit quitThread();
+            this->quit_scan();
             break;
         }
         break;
 
     case OUTPUT::TLD:
+        m_target.clear();
         switch(brute::getTarget_tld(m_dns, m_args)){
         case RETVAL::LOOKUP:
-            m_dns->lookup();
-            if(m_args->config->setTimeout)
-                s3s_LookupTimeout::set(m_dns, m_args->config->timeout);
+            this->start_lookup();
             break;
         case RETVAL::NEXT:
             emit next();
             break;
+        case RETVAL::WAIT: // only streamed targets wait
         case RETVAL::QUIT:
-            emit quitThread();
+            this->quit_scan();
             break;
         }
     }
 }
 
 ///
-/// wildcard scan...
+/// retries...
 ///
-void brute::Scanner::lookup_wildcard(){
-    m_dns_wildcard->setType(m_dns->type());
-    m_dns_wildcard->setNameserver(m_dns->nameserver());
-    m_dns_wildcard->setName(m_args->currentTarget);
-    m_dns_wildcard->lookup();
+bool brute::Scanner::schedule_retry(){
+    retry::ERROR error = retry::classify(m_dns->error());
+    if(!m_args->config->retry.retries(error, m_retry+1))
+        return false;
+
+    /* the name keeps its target, for the wildcard check & the recursion once it resolves */
+    m_args->retries.schedule(m_dns->name(), m_target, m_retry+1, m_args->config->retry.delay(m_retry+1));
+    return true;
+}
+
+bool brute::Scanner::lookup_retry(){
+    QString name, target;
+    int retry = 0;
+    if(!m_args->retries.take(name, target, retry)){
+        if(m_retry){
+            /* back to the scanner's own nameserver */
+            m_retry = 0;
+            m_dns->setNameserver(QHostAddress(m_nameserver));
+        }
+        return false;
+    }
+
+    /* each retry uses a different nameserver if there are more than one */
+    m_retry = retry;
+    m_target = target;
+    m_dns->setName(name);
+    m_dns->setNameserver(QHostAddress(retry::rotate(m_nameservers, m_nameserver, retry)));
+    this->start_lookup();
+    return true;
+}
+
+void brute::Scanner::quit_scan(){
+    /* the thread ends only when no targets are waiting for a retry & its wildcard probes have ended */
+    int delay = m_args->retries.nextDelay();
+
+    /* on a recursive scan, lookups still in flight on other threads may bring new targets */
+    if(delay == -1 && m_args->config->recursive && m_args->activeLookups.load() > 0)
+        delay = RECURSIVE_WAIT;
+
+    if(delay == -1){
+        m_quit = !m_probes.isEmpty();
+        if(!m_quit)
+            emit quitThread();
+    }
+    else
+        QTimer::singleShot(delay, this, &brute::Scanner::lookup);
+}
+
+void brute::Scanner::start_lookup(){
+    m_args->activeLookups.ref();
+    m_lookupStart = metrics::now();
+    m_dns->lookup();
     if(m_args->config->setTimeout)
         s3s_LookupTimeout::set(m_dns, m_args->config->timeout);
 }
 
-void brute::Scanner::lookupFinished_wildcard(){
-    switch(m_dns_wildcard->error()){
-    case QDnsLookup::NoError:
+///
+/// recursive scan...
+///
+void brute::Scanner::recurse(const QString &name, const QString &target){
+    if(!m_args->config->recursive || target.isEmpty() || m_args->permutations)
+        return;
+
+    QMutexLocker locker(&m_args->mutex);
+
+    /* each resolved subdomain is scanned once, up to the depth limit */
+    int depth = m_args->depths.value(target, 0)+1;
+    if(depth > m_args->config->recursiveDepth || m_args->depths.contains(name))
+        return;
+
+    m_args->depths.insert(name, depth);
+    m_args->recursiveTargets.enqueue(name);
+
+    m_args->progressMaximum += qMin(m_args->wordlist.length(), m_args->config->recursiveWordlist);
+    emit scanProgressMaximum(m_args->progressMaximum);
+}
+
+///
+/// wildcard analysis...
+///
+void brute::Scanner::filter_wildcard(brute::WildcardResult result){
+    while(!result.zones.isEmpty())
     {
-        if(m_dns_wildcard->hostAddressRecords().isEmpty())
+        switch(m_args->wildcards.check(result)){
+        case brute::WildcardCache::CHECK::NOT_WILDCARD:
+            result.zones.removeFirst();
             break;
+        case brute::WildcardCache::CHECK::WILDCARD:
+            return;
+        case brute::WildcardCache::CHECK::PROBE:
+            this->probe_wildcard(result.zones.first());
+            return;
+        case brute::WildcardCache::CHECK::PENDING:
+            return;
+        }
+    }
 
-        s3s_struct::Wildcard wcard;
-        wcard.wildcard = "*."+m_args->currentTarget;
+    if(!m_args->filter->insert(result.host.host))
+        return;
 
-        QString address = m_dns_wildcard->hostAddressRecords()[0].value().toString();
-        if(m_dns_wildcard->type() == QDnsLookup::A)
-            wcard.ipv4 = address;
-        else
-            wcard.ipv6 = address;
+    emit scanResult(result.host);
 
-        has_wildcards = true;
-        wildcard_ip = address;
+    this->recurse(result.host.host, result.target);
+}
 
-        emit wildcard(wcard);
+void brute::Scanner::probe_wildcard(const QString &zone){
+    m_probes.insert(zone, Probe());
+
+    /* the zone's results wait for its probes, they are recursed once the probes end */
+    m_args->activeLookups.ref();
+
+    for(int i = 0; i < WILDCARD_PROBES; i++){
+        QDnsLookup *dns = new QDnsLookup(m_dns->type(), brute::randomLabel()+"."+zone, m_dns->nameserver(), this);
+        dns->setProperty("zone", zone);
+        connect(dns, &QDnsLookup::finished, this, &brute::Scanner::lookupFinished_wildcard);
+        dns->lookup();
+        if(m_args->config->setTimeout)
+            s3s_LookupTimeout::set(dns, m_args->config->timeout);
     }
-        break;
-    default:
-        has_wildcards = false;
-        break;
+}
+
+void brute::Scanner::lookupFinished_wildcard(){
+    QDnsLookup *dns = qobject_cast<QDnsLookup*>(sender());
+    QString zone = dns->property("zone").toString();
+
+    Probe &probe = m_probes[zone];
+    if(dns->error() == QDnsLookup::NoError){
+        foreach(const QDnsHostAddressRecord &addr, dns->hostAddressRecords())
+            probe.answers.insert(addr.value().toString());
+    }
+    dns->deleteLater();
+
+    if(--probe.remaining)
+        return;
+
+    /* all probes of the zone have ended */
+    QSet<QString> answers = probe.answers;
+    m_probes.remove(zone);
+
+    if(!answers.isEmpty()){
+        s3s_struct::Wildcard wcard;
+        wcard.wildcard = "*."+zone;
+        foreach(const QString &address, answers){
+            if(QHostAddress(address).protocol() == QAbstractSocket::IPv4Protocol)
+                wcard.ipv4 = address;
+            else
+                wcard.ipv6 = address;
+        }
+        emit wildcard(wcard);
     }
+
+    /* the results that were waiting for the zone continue with their next zones */
+    foreach(const brute::WildcardResult &result, m_args->wildcards.setAnswers(zone, answers))
+        this->filter_wildcard(result);
+    m_args->activeLookups.deref();
+
+    if(m_quit && m_probes.isEmpty())
+        this->quit_scan();
 }
 
 ///
 /// getting targets...
 ///
-RETVAL brute::getTarget_subdomain(brute::Scanner *scanner, QDnsLookup *dns, brute::ScanArgs *args){
+RETVAL brute::getTarget_subdomain(QDnsLookup *dns, brute::ScanArgs *args, QString &target){
     /* lock */
-    QMutexLocker(&args->mutex);
+    QMutexLocker locker(&args->mutex);
+
+    /* levels below the targets use the first words of the wordlist */
+    int wordlist = args->wordlist.length();
+    if(args->currentDepth > 0)
+        wordlist = qMin(wordlist, args->config->recursiveWordlist);
 
     /* check if Reached end of the wordlist */
-    if(args->currentWordlist < args->wordlist.length())
+    if(args->currentWordlist < wordlist)
     {
         /* append to target then set the name */
         dns->setName(args->wordlist.at(args->currentWordlist)+"."+args->currentTarget);
+        target = args->currentTarget;
 
         /* next wordlist */
         args->currentWordlist++;
@@ -215,12 +365,15 @@ RETVAL brute::getTarget_subdomain(brute::Scanner *scanner, QDnsLookup *dns, brut
         if(!args->targets.isEmpty()){
             /* next target */
             args->currentWordlist = 0;
+            args->currentDepth = 0;
             args->currentTarget = args->targets.dequeue();
-
-            /* wildcard check */
-            if(args->config->checkWildcard)
-                scanner->lookup_wildcard();
-
+            return RETVAL::NEXT;
+        }
+        if(!args->recursiveTargets.isEmpty()){
+            /* the resolved subdomains after all targets, level by level */
+            args->currentWordlist = 0;
+            args->currentTarget = args->recursiveTargets.dequeue();
+            args->currentDepth = args->depths.value(args->currentTarget);
             return RETVAL::NEXT;
         }
         else
@@ -230,7 +383,7 @@ RETVAL brute::getTarget_subdomain(brute::Scanner *scanner, QDnsLookup *dns, brut
 
 RETVAL brute::getTarget_tld(QDnsLookup *dns, brute::ScanArgs *args){
     /* lock */
-    QMutexLocker(&args->mutex);
+    QMutexLocker locker(&args->mutex);
 
     /* check if Reached end of the wordlist */
     if(args->currentWordlist < args->wordlist.length())
@@ -255,9 +408,26 @@ RETVAL brute::getTarget_tld(QDnsLookup *dns, brute::ScanArgs *args){
     }
 }
 
+RETVAL brute::getTarget_permutation(QDnsLookup *dns, brute::ScanArgs *args, QString &target){
+    /* lock */
+    QMutexLocker locker(&args->mutex);
+
+    /* candidates are generated one at a time, the skipped positions count to the progress */
+    QString candidate;
+    quint64 skipped = args->permutations->skipped();
+    bool generated = args->permutations->next(candidate, target);
+    args->progress += static_cast<int>(args->permutations->skipped()-skipped);
+    if(generated){
+        dns->setName(candidate);
+        return RETVAL::LOOKUP;
+    }
+    else
+        return RETVAL::QUIT;
+}
+
 RETVAL brute::getTarget_reScan(QDnsLookup *dns, brute::ScanArgs *args){
     /* lock */
-    QMutexLocker(&args->mutex);
+    QMutexLocker locker(&args->mutex);
 
     if(!args->targets.isEmpty()){
         dns->setName(args->targets.dequeue());
@@ -266,3 +436,57 @@ RETVAL brute::getTarget_reScan(QDnsLookup *dns, brute::ScanArgs *args){
     else
         return RETVAL::QUIT;
 }
+
+void brute::loadConfig(brute::ScanConfig *config){
+    CONFIG.beginGroup(CFG_BRUTE);
+    config->threads = CONFIG.value(CFG_VAL_THREADS, config->threads).toInt();
+    config->timeout = CONFIG.value(CFG_VAL_TIMEOUT, config->timeout).toInt();
+    config->checkWildcard = CONFIG.value(CFG_VAL_WILDCARD).toBool();
+    config->noDuplicates = CONFIG.value(CFG_VAL_DUPLICATES).toBool();
+    config->autoSaveToProject = CONFIG.value(CFG_VAL_AUTOSAVE).toBool();
+    config->setTimeout = CONFIG.value(CFG_VAL_SETTIMEOUT).toBool();
+    config->recursiveDepth = CONFIG.value(CFG_VAL_RECURSIVE_DEPTH, config->recursiveDepth).toInt();
+    config->recursiveWordlist = CONFIG.value(CFG_VAL_RECURSIVE_WORDLIST, config->recursiveWordlist).toInt();
+    config->retry.maxRetries = CONFIG.value(CFG_VAL_MAXRETRIES, config->retry.maxRetries).toInt();
+    config->retry.backoff = CONFIG.value(CFG_VAL_BACKOFF, config->retry.backoff).toInt();
+    QString record = CONFIG.value(CFG_VAL_RECORD).toString();
+    CONFIG.endGroup();
+
+    if(record == "A")
+        config->recordType = QDnsLookup::A;
+    if(record == "AAAA")
+        config->recordType = QDnsLookup::AAAA;
+    if(record == "ANY")
+        config->recordType = QDnsLookup::ANY;
+
+    config->nameservers = Config::nameservers("nameservers_brute");
+}
+
+qint64 brute::prepareScan(brute::ScanArgs *args){
+    args->currentWordlist = 0;
+    args->progress = 0;
+
+    /*
+     * a new duplicates filter for the scan, an exact one: only the resolved names are filtered, a few
+     * of the candidates, so it isn't sized by the wordlist or the permutations.
+     */
+    delete args->filter;
+    args->filter = new s3s_ResultFilter;
+
+    /* a re-scan takes its targets one at a time */
+    if(args->reScan)
+        return args->targets.length();
+
+    if(args->permutations)
+        args->progressMaximum = static_cast<int>(qMin<quint64>(args->permutations->count(), INT_MAX));
+    else
+        args->progressMaximum = args->wordlist.length()*args->targets.length();
+
+    /* get first target */
+    args->currentTarget = args->targets.dequeue();
+
+    /* the permutations are generated as they are taken */
+    if(args->permutations)
+        return INT_MAX;
+    return args->wordlist.length();
+}
@@ -10,10 +10,16 @@
 
 #include <QMutex>
 #include <QQueue>
+#include <QHash>
+#include <QAtomicInt>
 #include <QDnsLookup>
 #include <QHostAddress>
 
 #include "AbstractScanner.h"
+#include "src/utils/ResultFilter.h"
+#include "src/utils/RetryPolicy.h"
+#include "WildcardCache.h"
+#include "Permutations.h"
 #include "src/items/HostItem.h"
 #include "src/items/WildcardItem.h"
 
@@ -44,6 +50,13 @@ struct ScanConfig{ // scan configurations
     bool noDuplicates = false;
     bool autoSaveToProject = false;
     bool checkWildcard = false;
+
+    /* recursive scan, resolved subdomains are scanned as new targets */
+    bool recursive = false;
+    int recursiveDepth = 2; // levels below the targets
+    int recursiveWordlist = 500; // first words of the wordlist used for the levels below the targets
+
+    retry::Policy retry;
 };
 
 struct ScanArgs { // scan arguments
@@ -51,12 +64,24 @@ struct ScanArgs { // scan arguments
     QHostAddress nameserver;
     brute::OUTPUT output;
     brute::ScanConfig *config;
+    s3s_ResultFilter *filter = nullptr; // duplicates filter shared by the scanner threads
+    brute::WildcardCache wildcards; // wildcard answers of the zones, shared by the scanner threads
+    brute::Permutations *permutations = nullptr; // permutations of known subdomains instead of the wordlist
+    retry::Queue retries; // failed targets waiting for their retry
+    QList<s3s_StreamQueue*> downstream; // a pipeline's queues fed by the results, no lookups start while one is full
     QQueue<QString> targets;
     QStringList wordlist;
     QString currentTarget;
     int currentWordlist;
     int progress;
     bool reScan;
+
+    /* for recursive scan */
+    QQueue<QString> recursiveTargets; // resolved subdomains, scanned after the targets level by level
+    QHash<QString, int> depths; // levels of the recursive targets below the targets
+    int currentDepth = 0;
+    int progressMaximum = 0;
+    QAtomicInt activeLookups; // lookups & wildcard probes till their results are recursed, recursive targets may still come while they are
 };
 
 class Scanner : public AbstractScanner{
@@ -66,8 +91,6 @@ class Scanner : public AbstractScanner{
         explicit Scanner(brute::ScanArgs *args);
         ~Scanner() override;
 
-        void lookup_wildcard();
-
     private slots:
         void lookup() override;
         void lookupFinished();
@@ -77,20 +100,47 @@ class Scanner : public AbstractScanner{
         void next(); // next lookup
         void scanResult(s3s_struct::HOST host); // lookup results
         void wildcard(s3s_struct::Wildcard wildcard); // found wildcard
+        void scanProgressMaximum(int maximum); // the scan grew with new recursive targets
 
     private:
         brute::ScanArgs *m_args;
         QDnsLookup *m_dns;
-        QDnsLookup *m_dns_wildcard;
+        QString m_target; // target of the current lookup, empty if not known
+
+        /* for retries */
+        QStringList m_nameservers;
+        QString m_nameserver;
+        int m_retry = 0;
+
+        bool lookup_retry();
+        bool schedule_retry();
+        void quit_scan();
 
         /* for wildcards */
-        bool has_wildcards = true;
-        QString wildcard_ip;
+        struct Probe {
+            int remaining = WILDCARD_PROBES;
+            QSet<QString> answers;
+        };
+        QHash<QString, Probe> m_probes; // zones being probed by this scanner
+        bool m_quit = false; // no more targets, waiting for the probes to end
+
+        void probe_wildcard(const QString &zone);
+        void filter_wildcard(brute::WildcardResult result);
+
+        void start_lookup();
+        void recurse(const QString &name, const QString &target);
 };
 
-RETVAL getTarget_subdomain(brute::Scanner*, QDnsLookup*, ScanArgs*);
+RETVAL getTarget_subdomain(QDnsLookup*, ScanArgs*, QString &target);
 RETVAL getTarget_tld(QDnsLookup*, ScanArgs*);
+RETVAL getTarget_permutation(QDnsLookup*, ScanArgs*, QString &target);
 RETVAL getTarget_reScan(QDnsLookup*, ScanArgs*);
 
+/* the configurations of the [brute] section, the gui's & the cli's scans */
+void loadConfig(brute::ScanConfig *config);
+
+/* a new duplicates filter & the first target, returns the work of the scan's threads */
+qint64 prepareScan(brute::ScanArgs *args);
+
 }
 #endif //BRUTE_H
@@ -5,9 +5,11 @@
  @brief :
 */
 
+#include <QTimer>
 #include <QDnsLookup>
 #include "DNSScanner.h"
 #include "src/utils/s3s.h"
+#include "src/utils/Config.h"
 
 /*
  * BUG:
@@ -69,6 +71,8 @@ dns::Scanner::~Scanner(){
 }
 
 void dns::Scanner::lookupFinished_a(){
+    metrics::recordSince(metrics::SCANNER::DNS, metrics::HISTOGRAM::RESOLVER_RTT, m_lookupStart);
+
     switch(m_dns_a->error()){
     case QDnsLookup::NotFoundError:
         break;
@@ -97,6 +101,7 @@ void dns::Scanner::lookupFinished_a(){
     m_activeLookups--;
     if(m_activeLookups == 0)
     {
+        metrics::recordSince(metrics::SCANNER::DNS, metrics::HISTOGRAM::QUERY_LATENCY, m_queryStart);
         if(has_record)
             emit scanResult(m_result);
         m_args->progress++;
@@ -106,6 +111,8 @@ void dns::Scanner::lookupFinished_a(){
 }
 
 void dns::Scanner::lookupFinished_aaaa(){
+    metrics::recordSince(metrics::SCANNER::DNS, metrics::HISTOGRAM::RESOLVER_RTT, m_lookupStart);
+
     switch(m_dns_aaaa->error()){
     case QDnsLookup::NotFoundError:
         break;
@@ -134,6 +141,7 @@ void dns::Scanner::lookupFinished_aaaa(){
     m_activeLookups--;
     if(m_activeLookups == 0)
     {
+        metrics::recordSince(metrics::SCANNER::DNS, metrics::HISTOGRAM::QUERY_LATENCY, m_queryStart);
         if(has_record)
             emit scanResult(m_result);
         m_args->progress++;
@@ -143,6 +151,8 @@ void dns::Scanner::lookupFinished_aaaa(){
 }
 
 void dns::Scanner::lookupFinished_mx(){
+    metrics::recordSince(metrics::SCANNER::DNS, metrics::HISTOGRAM::RESOLVER_RTT, m_lookupStart);
+
     switch(m_dns_mx->error()){
     case QDnsLookup::NotFoundError:
         break;
@@ -171,6 +181,7 @@ void dns::Scanner::lookupFinished_mx(){
     m_activeLookups--;
     if(m_activeLookups == 0)
     {
+        metrics::recordSince(metrics::SCANNER::DNS, metrics::HISTOGRAM::QUERY_LATENCY, m_queryStart);
         if(has_record)
             emit scanResult(m_result);
         m_args->progress++;
@@ -180,6 +191,8 @@ void dns::Scanner::lookupFinished_mx(){
 }
 
 void dns::Scanner::lookupFinished_cname(){
+    metrics::recordSince(metrics::SCANNER::DNS, metrics::HISTOGRAM::RESOLVER_RTT, m_lookupStart);
+
     switch(m_dns_cname->error()){
     case QDnsLookup::NotFoundError:
         break;
@@ -208,6 +221,7 @@ void dns::Scanner::lookupFinished_cname(){
     m_activeLookups--;
     if(m_activeLookups == 0)
     {
+        metrics::recordSince(metrics::SCANNER::DNS, metrics::HISTOGRAM::QUERY_LATENCY, m_queryStart);
         if(has_record)
             emit scanResult(m_result);
         m_args->progress++;
@@ -217,6 +231,8 @@ void dns::Scanner::lookupFinished_cname(){
 }
 
 void dns::Scanner::lookupFinished_ns(){
+    metrics::recordSince(metrics::SCANNER::DNS, metrics::HISTOGRAM::RESOLVER_RTT, m_lookupStart);
+
     switch(m_dns_ns->error()){
     case QDnsLookup::NotFoundError:
         break;
@@ -245,6 +261,7 @@ void dns::Scanner::lookupFinished_ns(){
     m_activeLookups--;
     if(m_activeLookups == 0)
     {
+        metrics::recordSince(metrics::SCANNER::DNS, metrics::HISTOGRAM::QUERY_LATENCY, m_queryStart);
         if(has_record)
             emit scanResult(m_result);
         m_args->progress++;
@@ -254,6 +271,8 @@ void dns::Scanner::lookupFinished_ns(){
 }
 
 void dns::Scanner::lookupFinished_txt(){
+    metrics::recordSince(metrics::SCANNER::DNS, metrics::HISTOGRAM::RESOLVER_RTT, m_lookupStart);
+
     switch(m_dns_txt->error()){
     case QDnsLookup::NotFoundError:
         break;
@@ -284,6 +303,7 @@ void dns::Scanner::lookupFinished_txt(){
     m_activeLookups--;
     if(m_activeLookups == 0)
     {
+        metrics::recordSince(metrics::SCANNER::DNS, metrics::HISTOGRAM::QUERY_LATENCY, m_queryStart);
         if(has_record)
             emit scanResult(m_result);
         m_args->progress++;
@@ -293,6 +313,8 @@ void dns::Scanner::lookupFinished_txt(){
 }
 
 void dns::Scanner::lookupFinished_any(){
+    metrics::recordSince(metrics::SCANNER::DNS, metrics::HISTOGRAM::RESOLVER_RTT, m_lookupStart);
+
     switch(m_dns_any->error()){
     case QDnsLookup::NotFoundError:
         break;
@@ -332,12 +354,16 @@ void dns::Scanner::lookupFinished_any(){
         break;
     }
 
+    metrics::recordSince(metrics::SCANNER::DNS, metrics::HISTOGRAM::QUERY_LATENCY, m_queryStart);
+
     m_args->progress++;
     emit scanProgress(m_args->progress);
     emit next();
 }
 
 void dns::Scanner::lookupFinished_srv(){
+    metrics::recordSince(metrics::SCANNER::DNS, metrics::HISTOGRAM::RESOLVER_RTT, m_lookupStart);
+
     switch(m_dns_srv->error()){
     case QDnsLookup::NotFoundError:
         break;
@@ -366,15 +392,23 @@ void dns::Scanner::lookupFinished_srv(){
         break;
     }
 
+    metrics::recordSince(metrics::SCANNER::DNS, metrics::HISTOGRAM::QUERY_LATENCY, m_queryStart);
+
     m_args->progress++;
     emit scanProgress(m_args->progress);
     emit next();
 }
 
 void dns::Scanner::lookup(){
+    if(!this->checkpoint())
+        return;
+
+    m_queryStart = metrics::now();
+
     if(m_args->RecordType_srv){
         switch(dns::getTarget_srv(m_dns_srv, m_args)){
         case RETVAL::LOOKUP:
+            m_lookupStart = metrics::now();
             m_dns_srv->lookup();
             if(m_args->config->setTimeout)
                 s3s_LookupTimeout::set(m_dns_srv, m_args->config->timeout);
@@ -382,6 +416,7 @@ void dns::Scanner::lookup(){
         case RETVAL::NEXT:
             emit next();
             break;
+        case RETVAL::WAIT: // only streamed targets wait
         case RETVAL::QUIT:
             emit quitThread();
             break;
@@ -390,7 +425,16 @@ void dns::Scanner::lookup(){
     else {
         has_record = false;
         m_activeLookups = 0;
-        m_currentTarget = dns::getTarget(m_args);
+        switch(dns::getTarget(m_args, m_currentTarget)){
+        case RETVAL::LOOKUP:
+            break;
+        case RETVAL::WAIT:
+            QTimer::singleShot(STREAM_WAIT, this, &dns::Scanner::lookup);
+            return;
+        default:
+            emit quitThread();
+            return;
+        }
 
         m_result.dns = m_currentTarget;
         m_result.A.clear();
@@ -401,11 +445,8 @@ void dns::Scanner::lookup(){
         m_result.CNAME.clear();
         m_result.SRV.clear();
 
-        /* quit if target is null */
-        if(m_currentTarget.isNull()){
-            emit quitThread();
-            return;
-        }
+        /* the record lookups are sent together */
+        m_lookupStart = metrics::now();
 
         if(m_args->RecordType_a){
             m_activeLookups++;
@@ -458,19 +499,30 @@ void dns::Scanner::lookup(){
     }
 }
 
-QString dns::getTarget(dns::ScanArgs *args){
+RETVAL dns::getTarget(dns::ScanArgs *args, QString &target){
     /* lock */
-    QMutexLocker(&args->mutex);
+    QMutexLocker locker(&args->mutex);
 
-    if(!args->targets.isEmpty())
-        return args->targets.dequeue();
-    else
-        return nullptr;
+    if(!args->targets.isEmpty()){
+        target = args->targets.dequeue();
+        return RETVAL::LOOKUP;
+    }
+    if(args->stream){
+        switch(args->stream->take(target)){
+        case s3s_StreamQueue::TAKE::TARGET:
+            return RETVAL::LOOKUP;
+        case s3s_StreamQueue::TAKE::WAIT:
+            return RETVAL::WAIT;
+        case s3s_StreamQueue::TAKE::CLOSED:
+            break;
+        }
+    }
+    return RETVAL::QUIT;
 }
 
 RETVAL dns::getTarget_srv(QDnsLookup *dns, dns::ScanArgs *args){
     /* lock */
-    QMutexLocker(&args->mutex);
+    QMutexLocker locker(&args->mutex);
 
     /* check if Reached end of the wordlist */
     if(args->currentSRV < args->srvWordlist.length())
@@ -492,3 +544,27 @@ RETVAL dns::getTarget_srv(QDnsLookup *dns, dns::ScanArgs *args){
         }
     }
 }
+
+void dns::loadConfig(dns::ScanConfig *config){
+    CONFIG.beginGroup(CFG_DNS);
+    config->threads = CONFIG.value(CFG_VAL_THREADS, config->threads).toInt();
+    config->timeout = CONFIG.value(CFG_VAL_TIMEOUT, config->timeout).toInt();
+    config->noDuplicates = CONFIG.value(CFG_VAL_DUPLICATES).toBool();
+    config->autoSaveToProject = CONFIG.value(CFG_VAL_AUTOSAVE).toBool();
+    config->setTimeout = CONFIG.value(CFG_VAL_SETTIMEOUT).toBool();
+    CONFIG.endGroup();
+
+    config->nameservers = Config::nameservers("nameservers_dns");
+}
+
+qint64 dns::prepareScan(dns::ScanArgs *args){
+    args->currentSRV = 0;
+    args->progress = 0;
+
+    /* the srv names of one target at a time */
+    if(args->RecordType_srv){
+        args->currentTarget = args->targets.dequeue();
+        return args->srvWordlist.length();
+    }
+    return args->targets.length();
+}
@@ -38,8 +38,10 @@ struct ScanConfig { // scan configurations
 struct ScanArgs {   // scan arguments
     QMutex mutex;
     QQueue<QString> targets;
+    s3s_StreamQueue *stream = nullptr; // targets streamed from a pipeline's stage, after the targets
     dns::ScanConfig *config;
     QStringList srvWordlist;
+    QStringList zoneWordlist; // names for the nsec3 hashes of a zone
     QString currentTarget;
     int currentSRV;
     int progress;
@@ -52,6 +54,7 @@ struct ScanArgs {   // scan arguments
     bool RecordType_cname;
     bool RecordType_srv;
     bool RecordType_any;
+    bool RecordType_zone; // a zone transfer or a walk of the zone, zone::Scanner
 };
 
 class Scanner: public AbstractScanner {
@@ -95,8 +98,14 @@ class Scanner: public AbstractScanner {
         QDnsLookup *m_dns_any;
 };
 
-QString getTarget(dns::ScanArgs *args);
+RETVAL getTarget(dns::ScanArgs *args, QString &target);
 RETVAL getTarget_srv(QDnsLookup *dns, dns::ScanArgs *args);
 
+/* the configurations of the [dns] section, of the dns & zone scans */
+void loadConfig(dns::ScanConfig *config);
+
+/* the first target of a srv scan, returns the work of the scan's threads */
+qint64 prepareScan(dns::ScanArgs *args);
+
 }
 #endif // DNSRECORDSSCANNER_H
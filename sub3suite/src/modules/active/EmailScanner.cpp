@@ -0,0 +1,521 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief :
+*/
+
+#include "EmailScanner.h"
+#include "ScanExecutor.h"
+#include "src/utils/Hostname.h"
+#include "src/utils/Config.h"
+#include "src/modules/passive/email/EmailFormat.h"
+#include "src/modules/passive/email/Hunter.h"
+
+#include <QTimer>
+#include <QEventLoop>
+#include <QDnsLookup>
+#include <QRandomGenerator>
+#include <algorithm>
+
+/* milliseconds between the checks of a saturated mail exchanger's connections */
+#define SMTP_WAIT 50
+
+/* connections tried for a domain's addresses, a dropped connection is opened again */
+#define SMTP_ATTEMPTS 3
+
+
+///
+/// candidates...
+///
+
+/* the ascii letters & digits of a part of a name, "José" is "jose" */
+static QString namePart(const QString &part){
+    QString ascii;
+    foreach(const QChar &c, part.normalized(QString::NormalizationForm_KD).toLower()){
+        if(c.unicode() < 0x80 && c.isLetterOrNumber())
+            ascii.append(c);
+    }
+    return ascii;
+}
+
+/* letters, digits, '.', '_' & '-', without a leading, trailing or double dot */
+static bool isLocalPart(const QString &local){
+    if(local.isEmpty() || local.startsWith('.') || local.endsWith('.') || local.contains(".."))
+        return false;
+    foreach(const QChar &c, local){
+        if(!((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '.' || c == '_' || c == '-'))
+            return false;
+    }
+    return true;
+}
+
+QStringList email::commonPatterns(){
+    return {"{first}.{last}", "{first}{last}", "{f}{last}", "{f}.{last}", "{first}_{last}",
+            "{first}", "{last}", "{last}.{first}", "{first}{l}", "{last}{f}"};
+}
+
+QStringList email::permutations(const QString &name, const QStringList &patterns, const QString &domain){
+    /* "last, first" is turned to "first last" */
+    QString fullName = name;
+    int comma = fullName.indexOf(',');
+    if(comma > 0)
+        fullName = fullName.mid(comma+1)+" "+fullName.left(comma);
+
+    QStringList parts;
+    foreach(const QString &part, fullName.split(QRegExp("[\\s]+"), QString::SkipEmptyParts)){
+        QString ascii = namePart(part);
+        if(!ascii.isEmpty())
+            parts.append(ascii);
+    }
+    if(parts.isEmpty())
+        return QStringList();
+
+    QHash<QString, QString> values;
+    values.insert("first", parts.first());
+    values.insert("last", parts.size() > 1? parts.last() : QString());
+    values.insert("middle", parts.mid(1, parts.size()-2).join(""));
+    values.insert("f", values.value("first").left(1));
+    values.insert("l", values.value("last").left(1));
+    values.insert("m", values.value("middle").left(1));
+
+    QStringList addresses;
+    foreach(const QString &pattern, patterns)
+    {
+        /* a pattern with a placeholder the name does not have is skipped */
+        QString local;
+        bool complete = true;
+        for(int i = 0; i < pattern.size() && complete; i++){
+            if(pattern.at(i) != '{'){
+                local.append(pattern.at(i).toLower());
+                continue;
+            }
+            int end = pattern.indexOf('}', i);
+            QString value = end > i? values.value(pattern.mid(i+1, end-i-1).toLower()) : QString();
+            complete = !value.isEmpty();
+            local.append(value);
+            i = end;
+        }
+
+        QString address = local+"@"+domain;
+        if(complete && isLocalPart(local) && !addresses.contains(address))
+            addresses.append(address);
+    }
+    return addresses;
+}
+
+int email::group(email::ScanArgs *args, const QStringList &addresses){
+    QMutexLocker locker(&args->mutex);
+
+    int count = 0;
+    foreach(const QString &address, addresses){
+        int at = address.lastIndexOf('@');
+        QString local = address.left(at).trimmed().toLower();
+        QString domain = s3s_Hostname::normalize(address.mid(at+1));
+        if(at < 1 || !isLocalPart(local) || domain.isNull())
+            continue;
+
+        QString normalized = local+"@"+domain;
+        if(args->addresses.contains(normalized))
+            continue;
+        args->addresses.insert(normalized);
+
+        /* a domain is queued once, or again if its addresses were taken by a worker */
+        if(!args->candidates.contains(domain))
+            args->domains.enqueue(domain);
+        args->candidates[domain].append(normalized);
+        count++;
+    }
+    return count;
+}
+
+QStringList email::candidates(const email::Discovery &discovery, const QStringList &patterns){
+    QStringList addresses;
+    QHash<QString, QStringList>::const_iterator i = discovery.names.constBegin();
+    for(; i != discovery.names.constEnd(); ++i){
+        QStringList domainPatterns = discovery.patterns.value(i.key());
+        if(domainPatterns.isEmpty())
+            domainPatterns = patterns.isEmpty()? email::commonPatterns() : patterns;
+
+        foreach(const QString &name, i.value())
+            addresses.append(email::permutations(name, domainPatterns, i.key()));
+    }
+    return addresses;
+}
+
+int email::discover(ScanExecutor *executor, const ::ScanArgs &args, email::Discovery *discovery, QObject *context){
+    ::ScanArgs moduleArgs = args;
+    moduleArgs.targets.clear();
+    foreach(const QString &domain, discovery->names.keys())
+        moduleArgs.targets.enqueue(domain);
+    moduleArgs.input_Domain = true;
+    moduleArgs.output_EmailPattern = true;
+    if(moduleArgs.targets.isEmpty())
+        return 0;
+
+    QList<AbstractOsintModule*> modules;
+    if(!APIKEY.value(OSINT_MODULE_EMAILFORMAT).toString().isEmpty())
+        modules.append(new EmailFormat(moduleArgs));
+    if(!APIKEY.value(OSINT_MODULE_HUNTER).toString().isEmpty())
+        modules.append(new Hunter(moduleArgs));
+
+    foreach(AbstractOsintModule *module, modules)
+    {
+        QObject::connect(module, &AbstractOsintModule::resultEmailPattern, context, [=](QString domain, QString pattern){
+            QStringList &patterns = discovery->patterns[domain];
+            if(!patterns.contains(pattern))
+                patterns.append(pattern);
+        });
+        QObject::connect(module, &AbstractOsintModule::resultEmailName, context, [=](QString domain, QString name){
+            QStringList &names = discovery->names[domain];
+            if(!names.contains(name, Qt::CaseInsensitive))
+                names.append(name);
+        });
+        executor->start(module);
+    }
+    return modules.size();
+}
+
+///
+/// connections...
+///
+
+bool email::ConnectionLimit::tryAcquire(const QString &host, int limit){
+    QMutexLocker locker(&m_mutex);
+    int &open = m_open[host];
+    if(open >= limit)
+        return false;
+    open++;
+    return true;
+}
+
+void email::ConnectionLimit::release(const QString &host){
+    QMutexLocker locker(&m_mutex);
+    if(--m_open[host] <= 0)
+        m_open.remove(host);
+}
+
+///
+/// the scanner...
+///
+
+email::Scanner::Scanner(email::ScanArgs *args): AbstractScanner(nullptr),
+    m_args(args)
+{
+    /* queued, the commands are blocking & the stop & resume signals are handled between the domains */
+    connect(this, &email::Scanner::next, this, &email::Scanner::lookup, Qt::QueuedConnection);
+
+    /* setting nameserver */
+    if(!m_args->config->nameservers.isEmpty()){
+        QMutexLocker locker(&m_args->mutex);
+        QString nameserver = m_args->config->nameservers.dequeue();
+        m_nameserver = QHostAddress(nameserver);
+        m_args->config->nameservers.enqueue(nameserver);
+    }
+}
+email::Scanner::~Scanner(){
+    this->close();
+}
+
+void email::Scanner::lookup(){
+    if(!this->checkpoint())
+        return;
+
+    QStringList addresses;
+    {
+        QMutexLocker locker(&m_args->mutex);
+        if(m_args->domains.isEmpty()){
+            locker.unlock();
+            this->close();
+            emit quitThread();
+            return;
+        }
+        m_domain = m_args->domains.dequeue();
+        addresses = m_args->candidates.take(m_domain);
+    }
+
+    bool exists = true;
+    bool lookupFailed = false;
+    QStringList hosts = this->mailExchangers(exists, lookupFailed);
+    if(lookupFailed)
+        this->failed(addresses, "MX lookup failed");
+    else if(hosts.isEmpty()){
+        /* no mail exchanger, nothing is deliverable */
+        foreach(const QString &address, addresses){
+            s3s_struct::Email result;
+            result.email = address;
+            result.domain = m_domain;
+            result.free = false;
+            result.disposable = false;
+            result.hostExists = false;
+            result.deliverable = false;
+            emit scanResult(result);
+        }
+        emit scanStatus(m_domain+(exists? ": no mail exchanger, null MX" : ": the domain does not exist"));
+    }
+    else
+        this->verify(hosts, addresses);
+
+    m_args->progress++;
+    emit scanProgress(m_args->progress);
+    emit next();
+}
+
+void email::Scanner::cancel(){
+    AbstractScanner::cancel();
+    this->close();
+}
+
+QStringList email::Scanner::mailExchangers(bool &exists, bool &failed){
+    if(!m_args->config->mailExchanger.isEmpty())
+        return {m_args->config->mailExchanger};
+
+    QDnsLookup dns(QDnsLookup::MX, m_domain, m_nameserver);
+    QEventLoop loop;
+    QTimer timer;
+    timer.setSingleShot(true);
+    connect(&dns, &QDnsLookup::finished, &loop, &QEventLoop::quit);
+    connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
+    timer.start(m_args->config->timeout);
+    dns.lookup();
+    loop.exec();
+
+    QStringList hosts;
+    if(!dns.isFinished()){
+        dns.abort();
+        failed = true;
+        return hosts;
+    }
+
+    switch(dns.error()){
+    case QDnsLookup::NoError:
+        break;
+    case QDnsLookup::NotFoundError:
+        exists = false;
+        return hosts;
+    default:
+        failed = true;
+        return hosts;
+    }
+
+    QList<QDnsMailExchangeRecord> records = dns.mailExchangeRecords();
+    std::sort(records.begin(), records.end(), [](const QDnsMailExchangeRecord &a, const QDnsMailExchangeRecord &b){
+        return a.preference() < b.preference();
+    });
+
+    /* the implicit mx of a domain without mx records, rfc5321 */
+    if(records.isEmpty())
+        return {m_domain};
+
+    foreach(const QDnsMailExchangeRecord &record, records){
+        QString host = record.exchange().toLower();
+        while(host.endsWith('.'))
+            host.chop(1);
+
+        /* a null mx, the domain accepts no mail, rfc7505 */
+        if(host.isEmpty())
+            return QStringList();
+        if(!hosts.contains(host))
+            hosts.append(host);
+    }
+    return hosts;
+}
+
+void email::Scanner::verify(const QStringList &hosts, const QStringList &addresses){
+    /* an address that can not exist, only a catch-all domain accepts it */
+    QString probe = QString("s3s-%1@%2").arg(QRandomGenerator::global()->generate64(), 0, 16).arg(m_domain);
+    bool catchAll = false;
+
+    QStringList pending(probe);
+    pending.append(addresses);
+
+    int attempts = 0;
+    while(!pending.isEmpty() && !this->stopped())
+    {
+        if(!this->session(hosts)){
+            this->failed(pending.mid(pending.first() == probe? 1 : 0), "no mail exchanger could be connected to");
+            return;
+        }
+
+        int size = qMin(pending.size(), m_session.pipelining? qMax(1, m_args->config->pipeline) : 1);
+        size = qMin(size, SMTP_MAX_RCPT-m_session.recipients);
+        QStringList batch = pending.mid(0, size);
+
+        /* a dropped connection is opened again for the batch */
+        QList<int> codes;
+        if(!this->recipients(batch, codes)){
+            this->close();
+            if(++attempts < SMTP_ATTEMPTS)
+                continue;
+            this->failed(pending.mid(pending.first() == probe? 1 : 0), "the connection to the mail exchanger failed");
+            return;
+        }
+
+        for(int i = 0; i < batch.size(); i++)
+        {
+            int code = codes.at(i);
+            if(batch.at(i) == probe){
+                catchAll = (code/100 == 2);
+                if(catchAll)
+                    emit scanStatus(m_domain+": catch-all, "+m_session.host+" accepts any address");
+                continue;
+            }
+
+            /* temporary failures eg. greylisting, for a later re-scan */
+            if(code/100 == 4){
+                this->failed({batch.at(i)}, QString("temporary failure %1").arg(code));
+                continue;
+            }
+
+            s3s_struct::Email result;
+            result.email = batch.at(i);
+            result.domain = m_domain;
+            result.free = false;
+            result.disposable = false;
+            result.hostExists = true;
+            result.catchAll = catchAll;
+            result.deliverable = (code/100 == 2) && !catchAll;
+            emit scanResult(result);
+        }
+        pending = pending.mid(size);
+    }
+}
+
+///
+/// smtp...
+///
+
+bool email::Scanner::session(const QStringList &hosts){
+    /* the connection of the previous domain, if it is to one of the domain's exchangers */
+    if(m_session.socket){
+        if(hosts.contains(m_session.host) && m_session.socket->state() == QAbstractSocket::ConnectedState &&
+           (m_session.recipients < SMTP_MAX_RCPT || this->transaction()))
+            return true;
+        this->close();
+    }
+
+    foreach(const QString &host, hosts){
+        while(!m_args->connections.tryAcquire(host, qMax(1, m_args->config->connections))){
+            if(this->stopped())
+                return false;
+            QThread::msleep(SMTP_WAIT);
+        }
+        if(this->open(host))
+            return true;
+        m_args->connections.release(host);
+    }
+    return false;
+}
+
+bool email::Scanner::open(const QString &host){
+    m_session.socket = new QTcpSocket;
+    m_session.host = host;
+    m_session.pipelining = false;
+    m_session.recipients = 0;
+
+    int code;
+    QByteArray text;
+    m_session.socket->connectToHost(host, m_args->config->port);
+    bool opened = m_session.socket->waitForConnected(m_args->config->timeout) && this->reply(code, text) && code == 220;
+
+    /* EHLO for the extensions, else HELO */
+    if(opened){
+        QByteArray helo = m_args->config->helo.toUtf8();
+        if(this->command("EHLO "+helo, code, text) && code == 250){
+            foreach(const QByteArray &extension, text.split('\n'))
+                m_session.pipelining |= extension.trimmed().toUpper().startsWith("PIPELINING");
+        }
+        else
+            opened = this->command("HELO "+helo, code, text) && code == 250;
+    }
+    if(opened)
+        opened = this->transaction();
+
+    if(!opened){
+        emit scanStatus(m_domain+": "+host+": "+(text.isEmpty()? m_session.socket->errorString() : QString::fromUtf8(text).trimmed()));
+        m_session.socket->abort();
+        delete m_session.socket;
+        m_session = Session();
+    }
+    return opened;
+}
+
+bool email::Scanner::transaction(){
+    int code;
+    QByteArray text;
+    if(m_session.recipients > 0 && (!this->command("RSET", code, text) || code != 250))
+        return false;
+    if(!this->command("MAIL FROM:<"+m_args->config->sender.toUtf8()+">", code, text) || code != 250)
+        return false;
+
+    m_session.recipients = 0;
+    return true;
+}
+
+void email::Scanner::close(){
+    if(!m_session.socket)
+        return;
+
+    if(m_session.socket->state() == QAbstractSocket::ConnectedState){
+        m_session.socket->write("QUIT\r\n");
+        m_session.socket->waitForBytesWritten(SMTP_WAIT);
+    }
+    m_session.socket->abort();
+    delete m_session.socket;
+    m_args->connections.release(m_session.host);
+    m_session = Session();
+}
+
+bool email::Scanner::recipients(const QStringList &addresses, QList<int> &codes){
+    QByteArray commands;
+    foreach(const QString &address, addresses)
+        commands.append("RCPT TO:<"+address.toUtf8()+">\r\n");
+    m_session.socket->write(commands);
+    m_session.recipients += addresses.size();
+
+    /* the replies come in the order of the commands, 421 is the server closing the connection */
+    int code;
+    QByteArray text;
+    for(int i = 0; i < addresses.size(); i++){
+        if(!this->reply(code, text) || code == 421)
+            return false;
+        codes.append(code);
+    }
+    return true;
+}
+
+bool email::Scanner::command(const QByteArray &line, int &code, QByteArray &text){
+    m_session.socket->write(line+"\r\n");
+    return this->reply(code, text);
+}
+
+bool email::Scanner::reply(int &code, QByteArray &text){
+    text.clear();
+
+    /* a multiline reply's lines are "250-...", its last line "250 ..." */
+    while(true){
+        while(!m_session.socket->canReadLine()){
+            if(!m_session.socket->waitForReadyRead(m_args->config->timeout))
+                return false;
+        }
+        QByteArray line = m_session.socket->readLine().trimmed();
+
+        bool ok = false;
+        code = line.left(3).toInt(&ok);
+        if(!ok)
+            return false;
+        text.append(line.mid(4)).append('\n');
+        if(line.size() == 3 || line.at(3) != '-')
+            return true;
+    }
+}
+
+void email::Scanner::failed(const QStringList &addresses, const QString &message){
+    log.nameserver = m_session.host;
+    log.recordType = "SMTP";
+    log.message = message;
+    foreach(const QString &address, addresses){
+        log.target = address;
+        emit scanLog(log);
+    }
+}
@@ -0,0 +1,166 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : verifying email addresses on their domains' mail exchangers, the candidate addresses are
+          grouped by domain, the domain's mx records are resolved & the addresses are checked with
+          RCPT TO commands, pipelined to the exchangers that support it. a worker keeps its connection
+          open for the next domain on the same exchanger, the connections to an exchanger are limited
+          across the workers & an address that can not exist is checked first for catch-all domains.
+          the commands are sent on blocking sockets, like the port scanner.
+*/
+
+#ifndef EMAILSCANNER_H
+#define EMAILSCANNER_H
+
+#include <QSet>
+#include <QHash>
+#include <QMutex>
+#include <QQueue>
+#include <QTcpSocket>
+#include <QHostAddress>
+
+#include "AbstractScanner.h"
+#include "src/items/EmailItem.h"
+
+#define SMTP_PORT 25
+
+/* milliseconds to wait for a connection or a reply */
+#define SMTP_TIMEOUT 10000
+
+/* RCPT TO commands written at once to the exchangers with PIPELINING */
+#define SMTP_PIPELINE 32
+
+/* recipients of a transaction, then the transaction is reset */
+#define SMTP_MAX_RCPT 100
+
+/* connections open at once to each mail exchanger, by all the workers */
+#define SMTP_MX_CONNECTIONS 4
+
+struct ScanArgs;
+class ScanExecutor;
+
+
+namespace email {
+
+struct ScanConfig {
+    QQueue<QString> nameservers; // for the mx records
+    int threads = 8;
+    int timeout = SMTP_TIMEOUT;
+    int connections = SMTP_MX_CONNECTIONS; // to each mail exchanger
+    int pipeline = SMTP_PIPELINE;
+    QString helo = "localhost";
+    QString sender;         // of MAIL FROM, the null sender if empty
+    QString mailExchanger;  // of every domain instead of their mx records, eg. a local smtp stub
+    quint16 port = SMTP_PORT;
+    bool autoSaveToProject = false;
+};
+
+/* the connections open to each mail exchanger, counted across the workers */
+class ConnectionLimit {
+    public:
+        bool tryAcquire(const QString &host, int limit);
+        void release(const QString &host);
+
+    private:
+        QMutex m_mutex;
+        QHash<QString, int> m_open;
+};
+
+struct ScanArgs {
+    QMutex mutex;
+    email::ScanConfig *config;
+    QQueue<QString> domains;                // the domains not verified yet
+    QHash<QString, QStringList> candidates; // the addresses of each domain
+    QSet<QString> addresses;                // all the addresses added, for the duplicates
+    email::ConnectionLimit connections;
+    int progress = 0;
+};
+
+/*
+ * the addresses of a person's name for each pattern, the name is "first [middle] last" & the
+ * patterns' placeholders are {first}, {middle}, {last} & their initials {f}, {m}, {l}, the
+ * pattern syntax of hunter.io's domain search eg. "{first}.{last}".
+ */
+QStringList permutations(const QString &name, const QStringList &patterns, const QString &domain);
+
+/* the common patterns, for the domains without a known pattern */
+QStringList commonPatterns();
+
+/* adds the addresses to the scan, grouped by their domain. returns the number of new addresses */
+int group(email::ScanArgs *args, const QStringList &addresses);
+
+/* the patterns & the people's names of each domain, given or found by the osint modules */
+struct Discovery {
+    QHash<QString, QStringList> patterns; // the most likely first
+    QHash<QString, QStringList> names;
+};
+
+/*
+ * the addresses of each domain's names, with the domain's patterns, else the given patterns,
+ * else the common patterns.
+ */
+QStringList candidates(const email::Discovery &discovery, const QStringList &patterns = QStringList());
+
+/*
+ * starts the EmailFormat & Hunter modules that have an api key on the domains of the discovery.
+ * their patterns & names are added to it on the context's thread. the osint arguments give the
+ * modules' config. returns the number of modules started.
+ */
+int discover(ScanExecutor *executor, const ::ScanArgs &args, email::Discovery *discovery, QObject *context);
+
+class Scanner: public AbstractScanner {
+    Q_OBJECT
+
+    public:
+        explicit Scanner(email::ScanArgs *args);
+        ~Scanner() override;
+
+        /* the smtp sessions are made with blocking sockets */
+        bool isBlocking() const override { return true; }
+
+    private slots:
+        void lookup() override;
+
+    signals:
+        void scanResult(s3s_struct::Email);
+        void scanStatus(QString);
+        void next();
+
+    protected:
+        /* the connection is closed on the worker's thread */
+        void cancel() override;
+
+    private:
+        /* a connection to a mail exchanger, kept open for the next domain on the same exchanger */
+        struct Session {
+            QTcpSocket *socket = nullptr;
+            QString host;
+            bool pipelining = false;
+            int recipients = 0; // of the current transaction
+        };
+
+        email::ScanArgs *m_args;
+        QHostAddress m_nameserver;
+        Session m_session;
+        QString m_domain;
+
+        /* the domain's mail exchangers by preference, the domain itself if it has no mx record */
+        QStringList mailExchangers(bool &exists, bool &failed);
+        void verify(const QStringList &hosts, const QStringList &addresses);
+
+        bool session(const QStringList &hosts);
+        bool open(const QString &host);
+        bool transaction();
+        void close();
+
+        /* the replies of the pipelined RCPT TO commands, false if the connection failed */
+        bool recipients(const QStringList &addresses, QList<int> &codes);
+        bool command(const QByteArray &line, int &code, QByteArray &text);
+        bool reply(int &code, QByteArray &text);
+
+        void failed(const QStringList &addresses, const QString &message);
+};
+
+}
+#endif // EMAILSCANNER_H
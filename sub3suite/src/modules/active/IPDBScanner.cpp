@@ -0,0 +1,66 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief :
+*/
+
+#include "IPDBScanner.h"
+#include "src/utils/IpDatabase.h"
+
+
+ipdb::Scanner::Scanner(ipdb::ScanArgs *args): AbstractScanner(nullptr),
+    m_args(args)
+{
+}
+ipdb::Scanner::~Scanner(){
+}
+
+void ipdb::Scanner::lookup(){
+    if(!this->checkpoint())
+        return;
+
+    s3s_IpDatabase &database = s3s_IpDatabase::instance();
+
+    /* the files are loaded once, the other workers wait on the database's lock */
+    if(!m_loaded){
+        m_loaded = true;
+        if(!database.load(m_args->routes, m_args->names, m_args->geo))
+            emit scanStatus(database.error());
+        if(!database.isLoaded()){
+            emit quitThread();
+            return;
+        }
+    }
+
+    for(int i = 0; i < IPDB_BATCH; i++)
+    {
+        QString target;
+        int progress;
+        {
+            QMutexLocker locker(&m_args->mutex);
+            if(m_args->targets.isEmpty()){
+                locker.unlock();
+                emit quitThread();
+                return;
+            }
+            target = m_args->targets.dequeue();
+            progress = ++m_args->progress;
+        }
+
+        s3s_struct::IP ip;
+        ip.ip = target;
+        if(database.lookup(target, ip))
+            emit scanResult(ip);
+        else{
+            log.target = target;
+            log.message = "Not found on the local ip database";
+            log.error = false;
+            emit scanLog(log);
+        }
+        emit scanProgress(progress);
+    }
+
+    /* the next batch after the events, a stop or a pause is taken in between */
+    QMetaObject::invokeMethod(this, "lookup", Qt::QueuedConnection);
+}
@@ -0,0 +1,54 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : offline ip enrichment on a worker, the local ip database is loaded & the addresses are
+          looked up in batches, a stop or a pause is taken between the batches. no requests are sent.
+*/
+
+#ifndef IPDBSCANNER_H
+#define IPDBSCANNER_H
+
+#include <QMutex>
+#include <QQueue>
+
+#include "AbstractScanner.h"
+#include "src/items/IPItem.h"
+
+/* addresses looked up between two checkpoints */
+#define IPDB_BATCH 256
+
+
+namespace ipdb {
+
+struct ScanArgs {
+    QMutex mutex;
+    QQueue<QString> targets;
+    QString routes; // the database's files, read from the configurations on the gui thread
+    QString names;
+    QString geo;
+    int progress = 0;
+};
+
+class Scanner : public AbstractScanner{
+    Q_OBJECT
+
+    public:
+        explicit Scanner(ipdb::ScanArgs *args);
+        ~Scanner() override;
+
+    private slots:
+        void lookup() override;
+
+    signals:
+        void scanResult(s3s_struct::IP ip);
+        void scanStatus(const QString &status);
+
+    private:
+        ipdb::ScanArgs *m_args;
+        bool m_loaded = false;
+};
+
+}
+
+#endif // IPDBSCANNER_H
@@ -0,0 +1,201 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief :
+*/
+
+#include "PTRScanner.h"
+#include "src/utils/s3s.h"
+
+#include <QTimer>
+
+/* properties of each lookup */
+#define PTR_ADDRESS "ptr_address"
+#define PTR_RETRY "ptr_retry"
+#define PTR_START "ptr_start"
+
+
+ptr::Scanner::Scanner(active::ScanArgs *args): AbstractScanner(nullptr),
+    m_args(args)
+{
+    /* setting nameserver */
+    m_nameservers = m_args->config->nameservers;
+    m_nameserver = m_args->config->nameservers.dequeue();
+    m_args->config->nameservers.enqueue(m_nameserver);
+
+    for(int i = 0; i < qMax(1, m_args->config->inflight); i++){
+        QDnsLookup *dns = new QDnsLookup(QDnsLookup::PTR, QString(), QHostAddress(m_nameserver), this);
+        connect(dns, &QDnsLookup::finished, this, &ptr::Scanner::lookupFinished);
+        m_idle.append(dns);
+    }
+
+    connect(this, &ptr::Scanner::next, this, &ptr::Scanner::lookup);
+}
+ptr::Scanner::~Scanner(){
+}
+
+void ptr::Scanner::lookupFinished(){
+    QDnsLookup *dns = qobject_cast<QDnsLookup*>(this->sender());
+    m_inflight--;
+    m_idle.append(dns);
+
+    metrics::recordSince(metrics::SCANNER::ACTIVE, metrics::HISTOGRAM::RESOLVER_RTT, dns->property(PTR_START).toLongLong());
+
+    /* failures worth retrying are looked up again later instead of being logged */
+    if(this->schedule_retry(dns)){
+        emit next();
+        return;
+    }
+
+    QString address = dns->property(PTR_ADDRESS).toString();
+
+    switch(dns->error()){
+    case QDnsLookup::NotFoundError:
+        break;
+
+    case QDnsLookup::OperationCancelledError:
+        log.message = "Operation Cancelled due to Timeout";
+        log.target = address;
+        log.nameserver = dns->nameserver().toString();
+        emit scanLog(log);
+        break;
+
+    case QDnsLookup::NoError:
+        foreach(const QDnsDomainNameRecord &record, dns->pointerRecords()){
+            s3s_struct::HOST host;
+            host.host = record.value();
+            if(host.host.endsWith('.'))
+                host.host.chop(1);
+            if(address.contains(':'))
+                host.ipv6 = address;
+            else
+                host.ipv4 = address;
+            emit scanResult(host);
+        }
+        break;
+
+    default:
+        log.message = dns->errorString();
+        log.target = address;
+        log.nameserver = dns->nameserver().toString();
+        emit scanLog(log);
+        break;
+    }
+
+    m_args->progress++;
+    emit scanProgress(m_args->progress);
+    emit next();
+}
+
+void ptr::Scanner::lookup(){
+    if(!this->checkpoint())
+        return;
+
+    /* fills the idle lookups, targets waiting for a retry go first */
+    while(!m_idle.isEmpty())
+    {
+        QString target;
+        int retry = 0;
+        if(m_args->retries.take(target, retry)){
+            this->send(m_idle.takeLast(), target, retry);
+            continue;
+        }
+
+        QHostAddress address;
+        switch(getTarget(m_args, address)){
+        case RETVAL::LOOKUP:
+            this->send(m_idle.takeLast(), address.toString(), 0);
+            continue;
+        case RETVAL::WAIT:
+            /* the lookups in flight take the next targets when they finish */
+            if(!m_inflight)
+                QTimer::singleShot(STREAM_WAIT, this, &ptr::Scanner::lookup);
+            return;
+        default:
+            if(!m_inflight)
+                this->quit_scan();
+            return;
+        }
+    }
+}
+
+void ptr::Scanner::send(QDnsLookup *dns, const QString &address, int retry){
+    /* each retry uses a different nameserver if there are more than one */
+    dns->setNameserver(QHostAddress(retry? retry::rotate(m_nameservers, m_nameserver, retry) : m_nameserver));
+    dns->setName(reverseName(QHostAddress(address)));
+    dns->setProperty(PTR_ADDRESS, address);
+    dns->setProperty(PTR_RETRY, retry);
+    dns->setProperty(PTR_START, metrics::now());
+
+    /* the timeouts of the lookup's previous targets */
+    qDeleteAll(dns->findChildren<s3s_LookupTimeout*>());
+
+    m_inflight++;
+    dns->lookup();
+    if(m_args->config->setTimeout)
+        s3s_LookupTimeout::set(dns, m_args->config->timeout);
+}
+
+///
+/// retries...
+///
+bool ptr::Scanner::schedule_retry(QDnsLookup *dns){
+    int retry = dns->property(PTR_RETRY).toInt()+1;
+    if(!m_args->config->retry.retries(retry::classify(dns->error()), retry))
+        return false;
+
+    m_args->retries.schedule(dns->property(PTR_ADDRESS).toString(), retry, m_args->config->retry.delay(retry));
+    return true;
+}
+
+void ptr::Scanner::quit_scan(){
+    /* the thread ends only when no targets are waiting for a retry */
+    int delay = m_args->retries.nextDelay();
+    if(delay == -1)
+        emit quitThread();
+    else
+        QTimer::singleShot(delay, this, &ptr::Scanner::lookup);
+}
+
+QString ptr::reverseName(const QHostAddress &address){
+    QStringList labels;
+
+    if(address.protocol() == QAbstractSocket::IPv4Protocol){
+        quint32 ipv4 = address.toIPv4Address();
+        for(int i = 0; i < 4; i++, ipv4 >>= 8)
+            labels << QString::number(ipv4 & 0xff);
+        labels << "in-addr" << "arpa";
+    }
+    else{
+        Q_IPV6ADDR ipv6 = address.toIPv6Address();
+        for(int i = 15; i >= 0; i--)
+            labels << QString::number(ipv6[i] & 0x0f, 16) << QString::number(ipv6[i] >> 4, 16);
+        labels << "ip6" << "arpa";
+    }
+    return labels.join('.');
+}
+
+RETVAL ptr::getTarget(active::ScanArgs *args, QHostAddress &address){
+    QMutexLocker locker(&args->mutex);
+
+    if(args->ranges.next(address))
+        return RETVAL::LOOKUP;
+
+    if(args->stream){
+        QString target;
+        switch(args->stream->take(target)){
+        case s3s_StreamQueue::TAKE::TARGET:
+            /* a streamed address or range, the range is swept from here on */
+            if(!args->ranges.add(target))
+                return RETVAL::WAIT;
+            args->ranges.next(address);
+            return RETVAL::LOOKUP;
+        case s3s_StreamQueue::TAKE::WAIT:
+            return RETVAL::WAIT;
+        case s3s_StreamQueue::TAKE::CLOSED:
+            break;
+        }
+    }
+    return RETVAL::QUIT;
+}
@@ -0,0 +1,53 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : class for reverse dns (PTR) sweeps of cidr ranges, each scanner keeps a number of
+          lookups in flight on its thread & takes the addresses lazily from the ranges.
+*/
+
+#ifndef PTRSCANNER_H
+#define PTRSCANNER_H
+
+#include "ActiveScanner.h"
+
+
+namespace ptr {
+
+class Scanner: public AbstractScanner{
+    Q_OBJECT
+
+    public:
+        explicit Scanner(active::ScanArgs *args);
+        ~Scanner() override;
+
+    signals:
+        void next(); // next lookup
+        void scanResult(s3s_struct::HOST host);
+
+    private slots:
+        void lookup() override;
+        void lookupFinished();
+
+    private:
+        active::ScanArgs *m_args;
+        QList<QDnsLookup*> m_idle; // lookups not in flight
+        int m_inflight = 0;
+
+        /* for retries */
+        QStringList m_nameservers;
+        QString m_nameserver;
+
+        void send(QDnsLookup *dns, const QString &address, int retry);
+        bool schedule_retry(QDnsLookup *dns);
+        void quit_scan();
+};
+
+/* the in-addr.arpa or ip6.arpa name of an address */
+QString reverseName(const QHostAddress &address);
+
+RETVAL getTarget(active::ScanArgs *args, QHostAddress &address);
+
+}
+
+#endif // PTRSCANNER_H
@@ -0,0 +1,233 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : subdomain permutations for the brute scanner, alterations of the known subdomains
+          are generated lazily one candidate at a time. the duplicates are skipped among the
+          candidates of each known subdomain, so only one subdomain's candidates are held in
+          memory, a candidate of two subdomains is looked up twice.
+*/
+
+#include "Permutations.h"
+
+/* number of candidates from each label's number, incremented & decremented by 1 to 3 */
+#define NUMBER_DELTAS 6
+
+static const int numberDeltas[NUMBER_DELTAS] = {1, 2, 3, -1, -2, -3};
+
+/* a hostname label, letters, digits & hyphens not at the ends */
+static bool isValidLabel(const QString &label){
+    if(label.isEmpty() || label.length() > 63)
+        return false;
+    if(label.startsWith('-') || label.endsWith('-'))
+        return false;
+
+    foreach(const QChar &c, label){
+        if(!((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '-'))
+            return false;
+    }
+    return true;
+}
+
+
+brute::Permutations::Permutations(const QStringList &subdomains, const QStringList &targets, const QStringList &words)
+{
+    foreach(const QString &target, targets){
+        QString t = target.trimmed().toLower();
+        if(!t.isEmpty() && !m_targets.contains(t))
+            m_targets.append(t);
+    }
+
+    foreach(const QString &word, words){
+        QString w = word.trimmed().toLower();
+        if(!w.isEmpty() && !m_words.contains(w))
+            m_words.append(w);
+    }
+
+    ///
+    /// the known subdomains of the targets are the seeds...
+    ///
+    foreach(const QString &subdomain, subdomains)
+    {
+        QString name = subdomain.trimmed().toLower();
+        if(m_known.contains(name))
+            continue;
+
+        /* the longest target the subdomain belongs to */
+        int target = -1;
+        for(int i = 0; i < m_targets.size(); i++){
+            if(name.endsWith("."+m_targets.at(i)) &&
+                    (target == -1 || m_targets.at(i).length() > m_targets.at(target).length()))
+                target = i;
+        }
+        if(target == -1)
+            continue;
+
+        Seed seed;
+        seed.target = target;
+        seed.labels = name.left(name.length()-m_targets.at(target).length()-1).split('.', QString::SkipEmptyParts);
+        if(seed.labels.isEmpty())
+            continue;
+
+        m_known.insert(name);
+        m_seeds.append(seed);
+
+        const quint64 labels = static_cast<quint64>(seed.labels.size());
+        const quint64 words = static_cast<quint64>(m_words.size());
+        m_count += (labels+1)*words + 4*words + labels*words + labels*NUMBER_DELTAS;
+    }
+}
+
+bool brute::Permutations::next(QString &candidate, QString &target){
+    while(m_seed < m_seeds.size())
+    {
+        const Seed &seed = m_seeds.at(m_seed);
+
+        /* next seed */
+        if(m_rule == PERMUTATION::END){
+            m_seed++;
+            m_rule = PERMUTATION::INSERT;
+            m_i = 0;
+            m_j = 0;
+            m_generated.clear();
+            continue;
+        }
+        /* next rule */
+        if(m_i >= this->sizeI(seed)){
+            m_rule = static_cast<PERMUTATION>(static_cast<int>(m_rule)+1);
+            m_i = 0;
+            m_j = 0;
+            continue;
+        }
+        /* next label position */
+        if(m_j >= this->sizeJ()){
+            m_i++;
+            m_j = 0;
+            continue;
+        }
+
+        QStringList labels;
+        bool permuted = this->permute(seed, labels);
+        m_j++;
+        if(!permuted){
+            m_skipped++;
+            continue;
+        }
+
+        /* every label of the candidate must be valid, words may have more than one label */
+        QStringList parts = labels.join('.').split('.');
+        bool valid = true;
+        foreach(const QString &part, parts){
+            if(!isValidLabel(part)){
+                valid = false;
+                break;
+            }
+        }
+        if(!valid){
+            m_skipped++;
+            continue;
+        }
+
+        candidate = parts.join('.')+"."+m_targets.at(seed.target);
+        if(m_known.contains(candidate) || m_generated.contains(candidate)){
+            m_skipped++;
+            continue;
+        }
+        m_generated.insert(candidate);
+
+        target = m_targets.at(seed.target);
+        return true;
+    }
+    return false;
+}
+
+int brute::Permutations::sizeI(const Seed &seed) const {
+    switch(m_rule){
+    case PERMUTATION::INSERT:
+        return seed.labels.size()+1;
+    case PERMUTATION::AFFIX:
+        return 4;
+    case PERMUTATION::SWAP:
+    case PERMUTATION::NUMBER:
+        return seed.labels.size();
+    default:
+        return 0;
+    }
+}
+
+int brute::Permutations::sizeJ() const {
+    if(m_rule == PERMUTATION::NUMBER)
+        return NUMBER_DELTAS;
+    return m_words.size();
+}
+
+bool brute::Permutations::permute(const Seed &seed, QStringList &labels) const {
+    labels = seed.labels;
+
+    switch(m_rule){
+    case PERMUTATION::INSERT:
+        labels.insert(m_i, m_words.at(m_j));
+        return true;
+
+    case PERMUTATION::AFFIX:
+    {
+        const QString &word = m_words.at(m_j);
+        const QString first = labels.first();
+        switch(m_i){
+        case 0:
+            labels[0] = word+"-"+first;
+            break;
+        case 1:
+            labels[0] = first+"-"+word;
+            break;
+        case 2:
+            labels[0] = word+first;
+            break;
+        default:
+            labels[0] = first+word;
+        }
+        return true;
+    }
+
+    case PERMUTATION::SWAP:
+        if(labels.at(m_i) == m_words.at(m_j))
+            return false;
+        labels[m_i] = m_words.at(m_j);
+        return true;
+
+    case PERMUTATION::NUMBER:
+    {
+        const QString &label = labels.at(m_i);
+
+        /* the first number in the label */
+        int begin = 0;
+        while(begin < label.length() && !label.at(begin).isDigit())
+            begin++;
+        if(begin == label.length())
+            return false;
+        int end = begin;
+        while(end < label.length() && label.at(end).isDigit())
+            end++;
+
+        /* numbers too long to be counters are left alone */
+        if(end-begin > 6)
+            return false;
+
+        const QString digits = label.mid(begin, end-begin);
+        int number = digits.toInt()+numberDeltas[m_j];
+        if(number < 0)
+            return false;
+
+        /* zero padded numbers keep their width eg. web01 -> web02 */
+        QString replacement = QString::number(number);
+        if(digits.startsWith('0'))
+            replacement = replacement.rightJustified(digits.length(), '0');
+
+        labels[m_i] = label.left(begin)+replacement+label.mid(end);
+        return true;
+    }
+
+    default:
+        return false;
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : subdomain permutations for the brute scanner, alterations of the known subdomains
+          are generated lazily one candidate at a time. the duplicates are skipped among the
+          candidates of each known subdomain, so only one subdomain's candidates are held in
+          memory, a candidate of two subdomains is looked up twice.
+*/
+
+#ifndef PERMUTATIONS_H
+#define PERMUTATIONS_H
+
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+
+namespace brute {
+
+enum class PERMUTATION { // permutation rules
+    INSERT, // a word inserted as a new label at every position eg. dev.api -> word.dev.api, dev.word.api
+    AFFIX,  // a word prepended & appended to the first label eg. dev -> word-dev, dev-word, worddev, devword
+    SWAP,   // each label swapped with a word eg. dev.api -> word.api, dev.word
+    NUMBER, // numbers in a label incremented & decremented eg. dev1 -> dev2, dev0
+    END
+};
+
+class Permutations {
+    public:
+        /* the subdomains of the targets are permuted with the words */
+        Permutations(const QStringList &subdomains, const QStringList &targets, const QStringList &words);
+
+        /* the next candidate & its target, returns false when all candidates were generated */
+        bool next(QString &candidate, QString &target);
+
+        /* the generator's positions, each is a candidate or skipped, the progress maximum */
+        quint64 count() const { return m_count; }
+
+        /* the positions skipped so far, invalid names, duplicates & the known subdomains */
+        quint64 skipped() const { return m_skipped; }
+
+        /* number of known subdomains being permuted */
+        int seeds() const { return m_seeds.size(); }
+
+    private:
+        struct Seed {
+            QStringList labels; // labels before the target
+            int target;
+        };
+        QList<Seed> m_seeds;
+        QStringList m_targets;
+        QStringList m_words;
+        quint64 m_count = 0;
+        quint64 m_skipped = 0;
+
+        /* the known subdomains & the current seed's candidates, to skip duplicates */
+        QSet<QString> m_known;
+        QSet<QString> m_generated;
+
+        /* position of the generator */
+        int m_seed = 0;
+        brute::PERMUTATION m_rule = brute::PERMUTATION::INSERT;
+        int m_i = 0;
+        int m_j = 0;
+
+        int sizeI(const Seed &seed) const;
+        int sizeJ() const;
+        bool permute(const Seed &seed, QStringList &labels) const;
+};
+
+}
+
+#endif // PERMUTATIONS_H
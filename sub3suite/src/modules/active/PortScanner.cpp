@@ -17,51 +17,60 @@ port::Scanner::Scanner(active::ScanArgs *args): AbstractScanner(nullptr),
     m_args(args),
     m_socket(new QTcpSocket(this))
 {
+    /* queued, the connections are blocking & the stop & resume signals are handled between them */
+    connect(this, &port::Scanner::next, this, &port::Scanner::lookup, Qt::QueuedConnection);
 }
 port::Scanner::~Scanner(){
     delete m_socket;
 }
 
 void port::Scanner::lookup(){
+    if(!this->checkpoint())
+        return;
+
     m_target = getTarget(m_args);
+    if(m_target == nullptr){
+        emit quitThread();
+        return;
+    }
 
-    while(m_target != nullptr)
-    {
-        s3s_struct::HOST host;
-        host.host = m_target;
+    s3s_struct::HOST host;
+    host.host = m_target;
 
-        foreach(const quint16 &port, m_args->ports)
+    foreach(const quint16 &port, m_args->ports)
+    {
+        m_socket->connectToHost(m_target, port);
+        if(m_socket->waitForConnected(m_args->config->timeout))
         {
-            m_socket->connectToHost(m_target, port);
-            if(m_socket->waitForConnected(m_args->config->timeout))
-            {
-                /* close connection */
-                m_socket->close();
+            /* close connection */
+            m_socket->close();
 
-                /* add port to list of open ports */
-                host.ports.append(port);
-            }
+            /* add port to list of open ports */
+            host.ports.append(port);
         }
-        /* scan progress */
-        m_args->progress++;
-        emit scanProgress(m_args->progress);
-
-        /* send results if open ports found */
-        if(!host.ports.isEmpty())
-            emit scanResult(host);
-
-        /* next target */
-        m_target = getTarget(m_args);
     }
+    /* scan progress */
+    m_args->progress++;
+    emit scanProgress(m_args->progress);
+
+    /* send results if open ports found */
+    if(!host.ports.isEmpty())
+        emit scanResult(host);
 
-    emit quitThread();
+    /* next target */
+    emit next();
 }
 
 QString port::getTarget(active::ScanArgs *args){
-    QMutexLocker(&args->mutex);
+    QMutexLocker locker(&args->mutex);
 
     if(!args->targets.isEmpty())
         return args->targets.dequeue();
-    else
-        return nullptr;
+
+    /* the addresses of a range sweep */
+    QHostAddress address;
+    if(args->ranges.next(address))
+        return address.toString();
+
+    return nullptr;
 }
@@ -13,7 +13,11 @@ class Scanner: public AbstractScanner{
         explicit Scanner(active::ScanArgs *args);
         ~Scanner() override;
 
+        /* the connections are made with blocking sockets */
+        bool isBlocking() const override { return true; }
+
     signals:
+        void next(); // next lookup
         void scanResult(s3s_struct::HOST host);
 
     private slots:
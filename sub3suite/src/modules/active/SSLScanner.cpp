@@ -8,121 +8,195 @@
 */
 
 #include "SSLScanner.h"
+#include "src/utils/Config.h"
 
+#include <QTimer>
 
 ssl::Scanner::Scanner(ssl::ScanArgs *args): AbstractScanner (nullptr),
     m_args(args)
 {
+    /* queued, the connections are blocking & the stop & resume signals are handled between them */
+    connect(this, &ssl::Scanner::next, this, &ssl::Scanner::lookup, Qt::QueuedConnection);
 }
 ssl::Scanner::~Scanner(){
 }
 
 void ssl::Scanner::lookup(){
+    if(!this->checkpoint())
+        return;
+
     /* get target */
-    QSslSocket socket;
-    QString target = ssl::getTarget(m_args);
+    QString target;
+    int retry = 0;
+    switch(this->nextTarget(target, retry)){
+    case RETVAL::LOOKUP:
+        break;
+    case RETVAL::WAIT:
+        QTimer::singleShot(STREAM_WAIT, this, &ssl::Scanner::lookup);
+        return;
+    default:
+        this->quit_scan();
+        return;
+    }
 
     /* a blocking connection to the target to obtain ssl certificate */
-    while(!target.isNull())
-    {
-        m_mutex.lock();
+    QSslSocket socket;
 
-        /* if received pause signal lock the thread, dont unlock until resume signal*/
-        if(m_pause)
-            m_wait.wait(&m_mutex);
+    /* the connection is blocking, its round trip is the connect & the handshake */
+    m_queryStart = metrics::now();
+
+    switch(m_args->port){
+    case HTTPS:
+        socket.connectToHostEncrypted(target, 443);
+        break;
+    case FTP:
+        socket.connectToHostEncrypted(target, 21);
+        break;
+    case FTPs:
+        socket.connectToHostEncrypted(target, 990);
+        break;
+    case SSH:
+        socket.connectToHostEncrypted(target, 22);
+        break;
+    case SMTP:
+        socket.connectToHostEncrypted(target, 465);
+        break;
+    case IMAP:
+        socket.connectToHostEncrypted(target, 993);
+        break;
+    case POP:
+        socket.connectToHostEncrypted(target, 995);
+        break;
+    }
 
-        /* check if received stop signal */
-        if(m_stop)
-            break;
+    bool encrypted = socket.waitForEncrypted(m_args->config->timeout);
+    metrics::recordSince(metrics::SCANNER::SSL, metrics::HISTOGRAM::RESOLVER_RTT, m_queryStart);
 
-        m_mutex.unlock();
+    if(!encrypted)
+    {
+        /* failures worth retrying are connected again later instead of being logged */
+        if(m_args->config->retry.retries(retry::classify(socket.error()), retry+1)){
+            socket.abort();
+            m_args->retries.schedule(target, retry+1, m_args->config->retry.delay(retry+1));
+            emit next();
+            return;
+        }
 
-        switch(m_args->port){
-        case HTTPS:
-            socket.connectToHostEncrypted(target, 443);
-            break;
-        case FTP:
-            socket.connectToHostEncrypted(target, 21);
-            break;
-        case FTPs:
-            socket.connectToHostEncrypted(target, 990);
-            break;
-        case SSH:
-            socket.connectToHostEncrypted(target, 22);
-            break;
-        case SMTP:
-            socket.connectToHostEncrypted(target, 465);
-            break;
-        case IMAP:
-            socket.connectToHostEncrypted(target, 993);
-            break;
-        case POP:
-            socket.connectToHostEncrypted(target, 995);
+        switch (socket.error())
+        {
+        case QAbstractSocket::ConnectionRefusedError:
+        case QAbstractSocket::HostNotFoundError:
             break;
+        default:
+            log.target = target;
+            log.message = socket.errorString();
+            emit scanLog(log);
         }
+    }
+    else
+    {
+        /* obtaining the certificate */
+        QSslCertificate certificate = socket.peerCertificate();
 
-        if(!socket.waitForEncrypted(m_args->config->timeout))
+        /* close connetion after obtaining the certificate */
+        socket.close();
+
+        if(!certificate.isNull())
         {
-            switch (socket.error())
-            {
-            case QAbstractSocket::ConnectionRefusedError:
-            case QAbstractSocket::HostNotFoundError:
+            /* emiting the obtained results */
+            switch (m_args->output) {
+            case ssl::OUTPUT::RAW:
+                emit resultRaw(target, certificate);
+                break;
+            case ssl::OUTPUT::SHA1:
+                emit resultSHA1(certificate.digest(QCryptographicHash::Sha1).toHex());
+                break;
+            case ssl::OUTPUT::SHA256:
+                emit resultSHA256(certificate.digest(QCryptographicHash::Sha256).toHex());
+                break;
+            case ssl::OUTPUT::SUBDOMAIN:
+                QStringList subdomains;
+                foreach(const QString &domain, certificate.subjectAlternativeNames())
+                    subdomains.append(domain);
+                emit resultSubdomain(subdomains);
                 break;
-            default:
-                log.target = target;
-                log.message = socket.errorString();
-                emit scanLog(log);
-            }
-        }
-        else
-        {
-            /* obtaining the certificate */
-            QSslCertificate certificate = socket.peerCertificate();
-
-            /* close connetion after obtaining the certificate */
-            socket.close();
-
-            if(!certificate.isNull())
-            {
-                /* emiting the obtained results */
-                switch (m_args->output) {
-                case ssl::OUTPUT::RAW:
-                    emit resultRaw(target, certificate);
-                    break;
-                case ssl::OUTPUT::SHA1:
-                    emit resultSHA1(certificate.digest(QCryptographicHash::Sha1).toHex());
-                    break;
-                case ssl::OUTPUT::SHA256:
-                    emit resultSHA256(certificate.digest(QCryptographicHash::Sha256).toHex());
-                    break;
-                case ssl::OUTPUT::SUBDOMAIN:
-                    QStringList subdomains;
-                    foreach(const QString &domain, certificate.subjectAlternativeNames())
-                        subdomains.append(domain);
-                    emit resultSubdomain(subdomains);
-                    break;
-                }
             }
         }
+    }
+
+    metrics::recordSince(metrics::SCANNER::SSL, metrics::HISTOGRAM::QUERY_LATENCY, m_queryStart);
 
-        /* scan progress */
-        m_args->progress++;
-        emit scanProgress(m_args->progress);
+    /* scan progress */
+    m_args->progress++;
+    emit scanProgress(m_args->progress);
 
-        /* next target */
-        target = getTarget(m_args);
+    /* next target */
+    emit next();
+}
+
+RETVAL ssl::Scanner::nextTarget(QString &target, int &retry){
+    if(m_args->retries.take(target, retry))
+        return RETVAL::LOOKUP;
+
+    retry = 0;
+    target = ssl::getTarget(m_args);
+    if(!target.isNull())
+        return RETVAL::LOOKUP;
+
+    /* targets streamed from a pipeline's stage */
+    if(m_args->stream){
+        switch(m_args->stream->take(target)){
+        case s3s_StreamQueue::TAKE::TARGET:
+            return RETVAL::LOOKUP;
+        case s3s_StreamQueue::TAKE::WAIT:
+            return RETVAL::WAIT;
+        case s3s_StreamQueue::TAKE::CLOSED:
+            break;
+        }
     }
+    return RETVAL::QUIT;
+}
 
-    /* end of targets */
-    emit quitThread();
+void ssl::Scanner::quit_scan(){
+    /* the thread ends only when no targets are waiting for a retry */
+    int delay = m_args->retries.nextDelay();
+    if(delay == -1)
+        emit quitThread();
+    else
+        QTimer::singleShot(delay, this, &ssl::Scanner::lookup);
 }
 
 QString ssl::getTarget(ssl::ScanArgs *args){
     /* lock */
-    QMutexLocker(&args->mutex);
+    QMutexLocker locker(&args->mutex);
 
     if(!args->targets.isEmpty())
         return args->targets.dequeue();
-    else
-        return nullptr;
+
+    /* the addresses of a range sweep */
+    QHostAddress address;
+    if(args->ranges.next(address))
+        return address.toString();
+
+    return nullptr;
+}
+
+void ssl::loadConfig(ssl::ScanConfig *config){
+    CONFIG.beginGroup(CFG_SSL);
+    config->threads = CONFIG.value(CFG_VAL_THREADS, config->threads).toInt();
+    config->timeout = CONFIG.value(CFG_VAL_TIMEOUT, config->timeout).toInt();
+    config->noDuplicates = CONFIG.value(CFG_VAL_DUPLICATES).toBool();
+    config->autoSaveToProject = CONFIG.value(CFG_VAL_AUTOSAVE).toBool();
+    config->setTimeout = CONFIG.value(CFG_VAL_SETTIMEOUT).toBool();
+    config->retry.maxRetries = CONFIG.value(CFG_VAL_MAXRETRIES, config->retry.maxRetries).toInt();
+    config->retry.backoff = CONFIG.value(CFG_VAL_BACKOFF, config->retry.backoff).toInt();
+    CONFIG.endGroup();
+
+    /* a refused connection means there is no ssl service on the port, not worth retrying */
+    config->retry.onRefused = false;
+}
+
+qint64 ssl::prepareScan(ssl::ScanArgs *args){
+    args->progress = 0;
+    return args->targets.length()+static_cast<qint64>(args->ranges.total());
 }
@@ -13,9 +13,10 @@
 #include <QMutex>
 #include <QQueue>
 #include <QSslSocket>
-#include <QWaitCondition>
 #include <QSslCertificate>
 #include "AbstractScanner.h"
+#include "src/utils/RetryPolicy.h"
+#include "src/utils/CidrIterator.h"
 
 
 namespace ssl {
@@ -51,6 +52,8 @@ struct ScanConfig { // scan configurations
     bool setTimeout = false;
     bool noDuplicates = false;
     bool autoSaveToProject = false;
+
+    retry::Policy retry;
 };
 
 struct ScanArgs { // scan arguments
@@ -58,7 +61,10 @@ struct ScanArgs { // scan arguments
     ssl::PORT port;
     ssl::OUTPUT output;
     ssl::ScanConfig *config;
+    retry::Queue retries; // failed targets waiting for their retry
     QQueue<QString> targets;
+    s3s_CidrIterator ranges; // addresses of a range sweep, after the targets
+    s3s_StreamQueue *stream = nullptr; // targets streamed from a pipeline's stage, after the ranges
     int progress;
 };
 
@@ -70,47 +76,37 @@ class Scanner : public AbstractScanner{
         explicit Scanner(ssl::ScanArgs *args);
         ~Scanner() override;
 
+        /* the handshakes are made with blocking sockets */
+        bool isBlocking() const override { return true; }
+
     signals:
         void resultSHA1(QString sha1);
         void resultSHA256(QString sha256);
         void resultSubdomain(QStringList subdomain);
         void resultRaw(QString target, QSslCertificate certificate);
 
-    public slots:
-        virtual void onStopScan() override {
-            m_stop = true;
-        }
-
-        /*
-         * use QWaitCondition to pause and resume the thread, QSemaphore is
-         * not ideal in this class using loop with blocking connection to target.
-         */
-        void onPauseScan() override {
-            m_mutex.lock();
-            m_pause = true;
-            m_mutex.unlock();
-        }
-
-        void onResumeScan() override {
-            m_mutex.lock();
-            m_pause = false;
-            m_mutex.unlock();
-            m_wait.wakeAll();
-        }
+    signals:
+        void next(); // next lookup
 
     private slots:
         void lookup() override;
 
     private:
         ssl::ScanArgs *m_args;
-        bool m_pause = false;
-        bool m_stop = false;
-        QWaitCondition m_wait;
-        QMutex m_mutex;
+
+        /* next target, targets waiting for a retry go first */
+        RETVAL nextTarget(QString &target, int &retry);
+        void quit_scan();
 };
 
 QString getTarget(ssl::ScanArgs *args);
 
+/* the configurations of the [ssl] section */
+void loadConfig(ssl::ScanConfig *config);
+
+/* returns the targets & the ranges' addresses, the work of the scan's threads */
+qint64 prepareScan(ssl::ScanArgs *args);
+
 }
 
 #endif // CERTSCANNER_H
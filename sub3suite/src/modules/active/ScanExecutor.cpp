@@ -0,0 +1,227 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : runs a scan's scanners & osint modules on a pool of worker threads, pauses them without
+          blocking their event loops, stops them with their lookups in flight cancelled & keeps each
+          worker's statistics.
+*/
+
+#include "ScanExecutor.h"
+#include "src/modules/passive/AbstractOsintModule.h"
+
+#include <QDebug>
+
+/* the executors alive, created & destroyed on the main thread */
+static QList<ScanExecutor*> executors;
+
+
+ScanExecutor::ScanExecutor(QObject *parent): QObject(parent)
+{
+    executors.append(this);
+}
+ScanExecutor::~ScanExecutor(){
+    executors.removeOne(this);
+    this->shutdown();
+}
+
+void ScanExecutor::shutdown(){
+    /* the running workers are deleted on their threads as the threads finish */
+    this->stop();
+    foreach(const Worker &worker, m_workers){
+        if(worker.object)
+            worker.object->deleteLater();
+    }
+    foreach(QThread *thread, m_threads)
+        thread->quit();
+    foreach(QThread *thread, m_threads){
+        thread->disconnect(this);
+        thread->wait();
+        delete thread;
+    }
+    m_threads.clear();
+    m_workers.clear();
+    m_load.clear();
+    m_blocking.clear();
+    m_running = 0;
+}
+
+QList<scan::WorkerStat> ScanExecutor::statistics() const {
+    QList<scan::WorkerStat> statistics = m_statistics;
+    for(int i = 0; i < statistics.size(); i++){
+        statistics[i].targets = m_counters.at(i)->targets.loadAcquire();
+        statistics[i].errors = m_counters.at(i)->errors.loadAcquire();
+    }
+    return statistics;
+}
+
+int ScanExecutor::workers(int configured, int work){
+    int threads = configured > 0? configured : QThread::idealThreadCount();
+    return qMax(1, qMin(threads, work));
+}
+
+void ScanExecutor::start(AbstractScanner *scanner){
+    scanner->setControl(&m_control);
+    int worker = this->run(scanner, scanner->isBlocking(), "onStopScan", true);
+
+    /* the worker's statistics, counted on its own thread without an event to the executor's */
+    QSharedPointer<scan::WorkerCounters> counters = m_counters.at(worker);
+    connect(scanner, &AbstractScanner::scanProgress, scanner, [=](){
+        counters->targets.ref();
+    });
+    connect(scanner, &AbstractScanner::scanLog, scanner, [=](const scan::Log &log){
+        if(log.error)
+            counters->errors.ref();
+    });
+    connect(scanner, &AbstractScanner::quitThread, this, [=](){
+        this->onWorkerEnded(worker);
+    });
+
+    QMetaObject::invokeMethod(scanner, "lookup", Qt::QueuedConnection);
+}
+
+void ScanExecutor::start(AbstractOsintModule *module){
+    module->prepareScan();
+    int worker = this->run(module, false, "onStop", false);
+
+    QSharedPointer<scan::WorkerCounters> counters = m_counters.at(worker);
+    connect(module, &AbstractOsintModule::scanProgress, module, [=](){
+        counters->targets.ref();
+    });
+    connect(module, &AbstractOsintModule::scanLog, module, [=](const ScanLog &log){
+        if(log.error)
+            counters->errors.ref();
+    });
+    connect(module, &AbstractOsintModule::quitThread, this, [=](){
+        this->onWorkerEnded(worker);
+    });
+
+    QMetaObject::invokeMethod(module, "start", Qt::QueuedConnection);
+}
+
+int ScanExecutor::run(QObject *object, bool blocking, const char *stopSlot, bool pausable){
+    /* the first worker of a new scan */
+    if(!m_running){
+        m_control.paused.storeRelease(0);
+        m_control.stopped.storeRelease(0);
+        m_workers.clear();
+        m_statistics.clear();
+        m_counters.clear();
+        m_timer.start();
+    }
+
+    Worker worker;
+    worker.object = object;
+    worker.thread = this->thread(blocking);
+    worker.stopSlot = stopSlot;
+    worker.pausable = pausable;
+    object->moveToThread(worker.thread);
+
+    m_workers.append(worker);
+    m_statistics.append(scan::WorkerStat());
+    m_statistics.last().running = true;
+    m_counters.append(QSharedPointer<scan::WorkerCounters>::create());
+    m_running++;
+    return m_workers.size()-1;
+}
+
+QThread *ScanExecutor::thread(bool blocking){
+    /* an idle thread of the scan, or the least loaded shared thread once they are as many as the cores */
+    QThread *idle = nullptr, *least = nullptr;
+    int shared = 0;
+    QHash<QThread*, int>::const_iterator i = m_load.constBegin();
+    for(; i != m_load.constEnd(); ++i){
+        if(!i.value()){
+            idle = i.key();
+            continue;
+        }
+        if(m_blocking.value(i.key()))
+            continue;
+        shared++;
+        if(!least || i.value() < m_load.value(least))
+            least = i.key();
+    }
+
+    QThread *thread = idle;
+    if(!blocking && least && shared >= QThread::idealThreadCount())
+        thread = least;
+    if(!thread){
+        thread = new QThread;
+        connect(thread, &QThread::finished, this, [=](){
+            m_threads.removeOne(thread);
+            thread->deleteLater();
+        });
+        m_threads.append(thread);
+        thread->start();
+    }
+
+    m_load[thread]++;
+    m_blocking[thread] = blocking;
+    return thread;
+}
+
+/* the workers park at their next checkpoint, their lookups in flight finish */
+void ScanExecutor::pause(){
+    m_control.paused.storeRelease(1);
+}
+
+void ScanExecutor::resume(){
+    m_control.paused.storeRelease(0);
+    foreach(const Worker &worker, m_workers){
+        if(worker.object && worker.pausable)
+            QMetaObject::invokeMethod(worker.object, "onResumeScan", Qt::QueuedConnection);
+    }
+}
+
+/* parked & busy workers quit at once, the workers in a blocking lookup quit after it */
+void ScanExecutor::stop(){
+    m_control.stopped.storeRelease(1);
+    m_control.paused.storeRelease(0);
+    foreach(const Worker &worker, m_workers){
+        if(worker.object)
+            QMetaObject::invokeMethod(worker.object, worker.stopSlot, Qt::QueuedConnection);
+    }
+}
+
+void ScanExecutor::stopAll(){
+    foreach(ScanExecutor *executor, executors){
+        if(executor->isRunning())
+            executor->stop();
+    }
+}
+
+void ScanExecutor::onWorkerEnded(int worker){
+    /* a worker may quit more than once, eg. a module stopped as it ended */
+    if(!m_workers.at(worker).object)
+        return;
+
+    /* its events after it quit go nowhere, it is deleted on its thread */
+    QObject *object = m_workers.at(worker).object;
+    object->disconnect();
+    object->deleteLater();
+    m_workers[worker].object = nullptr;
+
+    QThread *thread = m_workers.at(worker).thread;
+    if(--m_load[thread] == 0)
+        m_blocking[thread] = false;
+
+    m_statistics[worker].running = false;
+    m_statistics[worker].time = m_timer.elapsed();
+    m_running--;
+    if(m_running)
+        return;
+
+    /* the scan's threads end with it */
+    foreach(QThread *thread, m_load.keys())
+        thread->quit();
+    m_load.clear();
+    m_blocking.clear();
+
+    QList<scan::WorkerStat> statistics = this->statistics();
+    for(int i = 0; i < statistics.size(); i++){
+        const scan::WorkerStat &stat = statistics.at(i);
+        qInfo().noquote() << QString("[SCAN] Worker %1: %2 targets, %3 errors, %4 ms")
+                             .arg(i).arg(stat.targets).arg(stat.errors).arg(stat.time);
+    }
+    emit finished();
+}
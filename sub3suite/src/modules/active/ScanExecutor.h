@@ -0,0 +1,116 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : runs a scan's scanners & osint modules on a pool of worker threads, pauses them without
+          blocking their event loops, stops them with their lookups in flight cancelled & keeps each
+          worker's statistics. the workers waiting on their lookups' events share the threads, up to the
+          hardware concurrency, a scanner making blocking calls has a thread of its own.
+*/
+
+#ifndef SCANEXECUTOR_H
+#define SCANEXECUTOR_H
+
+#include <QList>
+#include <QHash>
+#include <QSharedPointer>
+#include <QElapsedTimer>
+#include <climits>
+
+#include "AbstractScanner.h"
+
+class AbstractOsintModule;
+
+
+namespace scan {
+struct WorkerStat{
+    int targets = 0;  // targets scanned
+    int errors = 0;   // logged failures
+    qint64 time = 0;  // milliseconds the worker ran
+    bool running = false;
+};
+
+struct WorkerCounters{ // counted on the worker's thread, read by statistics()
+    QAtomicInt targets;
+    QAtomicInt errors;
+};
+}
+
+class ScanExecutor : public QObject{
+    Q_OBJECT
+
+    public:
+        explicit ScanExecutor(QObject *parent = nullptr);
+
+        /* shuts the scan down, see shutdown() */
+        ~ScanExecutor() override;
+
+        /*
+         * stops the scan & waits for the workers, they use the executor's control & their scan's
+         * arguments. the stopped workers end at their next event, a blocking scanner after its call.
+         * an owner deleting the arguments in its destructor calls it first.
+         */
+        void shutdown();
+
+        /* workers for a scan, the configured threads or the hardware concurrency, not more than the work */
+        static int workers(int configured, int work);
+
+        /* runs the scanner on a worker thread, connect its results before starting it */
+        void start(AbstractScanner *scanner);
+
+        /* runs the osint module on a worker thread, the modules are stopped but not paused */
+        void start(AbstractOsintModule *module);
+
+        /*
+         * starts the workers of a scan, the configured threads up to its work, on the scan's arguments.
+         * setup(scanner) connects each scanner's results before it starts, returns the workers started.
+         */
+        template<typename Scanner, typename Args, typename Setup>
+        int startScanners(Args *args, int threads, qint64 work, Setup setup){
+            int count = workers(threads, static_cast<int>(qMin<qint64>(work, INT_MAX)));
+            for(int i = 0; i < count; i++)
+            {
+                Scanner *scanner = new Scanner(args);
+                setup(scanner);
+                this->start(scanner);
+            }
+            return count;
+        }
+
+        void pause();
+        void resume();
+        void stop();
+
+        /* stops the scans of all the executors, when the application closes their workers end meanwhile */
+        static void stopAll();
+
+        bool isRunning() const { return m_running > 0; }
+        int running() const { return m_running; }
+        QList<scan::WorkerStat> statistics() const;
+
+    signals:
+        void finished(); // all the workers ended
+
+    private:
+        struct Worker {
+            QObject *object = nullptr; // nullptr once it ended
+            QThread *thread = nullptr;
+            const char *stopSlot = nullptr;
+            bool pausable = false;
+        };
+        scan::Control m_control;
+        QList<Worker> m_workers;
+        QList<scan::WorkerStat> m_statistics;
+        QList<QSharedPointer<scan::WorkerCounters>> m_counters;
+        QList<QThread*> m_threads;      // the threads not finished yet
+        QHash<QThread*, int> m_load;    // the running workers of the scan's threads
+        QHash<QThread*, bool> m_blocking;
+        QElapsedTimer m_timer;
+        int m_running = 0;
+
+        int run(QObject *worker, bool blocking, const char *stopSlot, bool pausable);
+        QThread *thread(bool blocking);
+        void onWorkerEnded(int worker);
+};
+
+#endif // SCANEXECUTOR_H
@@ -6,7 +6,9 @@
 */
 
 #include "URLScanner.h"
+#include "src/utils/Config.h"
 
+#include <QTimer>
 #include <QNetworkReply>
 
 /*
@@ -26,6 +28,15 @@ url::Scanner::~Scanner(){
 }
 
 void url::Scanner::lookupFinished(QNetworkReply *reply){
+    metrics::recordSince(metrics::SCANNER::URL, metrics::HISTOGRAM::RESOLVER_RTT, m_lookupStart);
+
+    /* failures worth retrying are requested again later instead of being logged */
+    if(this->schedule_retry(reply)){
+        reply->deleteLater();
+        emit next();
+        return;
+    }
+
     switch (reply->error()) {
     case QNetworkReply::OperationCanceledError:
     {
@@ -57,36 +68,117 @@ void url::Scanner::lookupFinished(QNetworkReply *reply){
         break;
     }
 
+    metrics::recordSince(metrics::SCANNER::URL, metrics::HISTOGRAM::QUERY_LATENCY, m_queryStart);
+
     m_args->progress++;
     emit scanProgress(m_args->progress);
     emit next();
 }
 
 void url::Scanner::lookup(){
+    if(!this->checkpoint())
+        return;
+
+    m_queryStart = metrics::now();
+
+    /* targets waiting for a retry go first */
+    if(this->lookup_retry())
+        return;
+
     QNetworkRequest request;
     QUrl url;
 
     switch (url::getTarget(m_args, url)) {
     case RETVAL::LOOKUP:
         request.setUrl(url);
+        m_lookupStart = metrics::now();
         m_manager->get(request);
         break;
+    case RETVAL::WAIT:
+        QTimer::singleShot(STREAM_WAIT, this, &url::Scanner::lookup);
+        break;
     case RETVAL::QUIT:
-        emit quitThread();
+        this->quit_scan();
         break;
     default:
-        emit quitThread();
+        this->quit_scan();
     }
 }
 
+///
+/// retries...
+///
+bool url::Scanner::schedule_retry(QNetworkReply *reply){
+    if(reply->error() == QNetworkReply::NoError)
+        return false;
+
+    int retry = reply->request().attribute(RETRY_ATTRIBUTE, 0).toInt()+1;
+    if(!m_args->config->retry.retries(retry::classify(reply), retry))
+        return false;
+
+    m_args->retries.schedule(reply->url().toString(), retry, m_args->config->retry.delay(retry));
+    return true;
+}
+
+bool url::Scanner::lookup_retry(){
+    QString target;
+    int retry = 0;
+    if(!m_args->retries.take(target, retry))
+        return false;
+
+    QNetworkRequest request;
+    request.setUrl(QUrl(target));
+    request.setAttribute(RETRY_ATTRIBUTE, retry);
+    m_lookupStart = metrics::now();
+    m_manager->get(request);
+    return true;
+}
+
+void url::Scanner::quit_scan(){
+    /* the thread ends only when no targets are waiting for a retry */
+    int delay = m_args->retries.nextDelay();
+    if(delay == -1)
+        emit quitThread();
+    else
+        QTimer::singleShot(delay, this, &url::Scanner::lookup);
+}
+
 RETVAL url::getTarget(url::ScanArgs *args, QUrl &url){
     /* lock */
-    QMutexLocker(&args->mutex);
+    QMutexLocker locker(&args->mutex);
 
     if(!args->targets.isEmpty()){
          url.setUrl(args->targets.dequeue());
          return RETVAL::LOOKUP;
     }
-    else
-        return RETVAL::QUIT;
+    if(args->stream){
+        QString target;
+        switch(args->stream->take(target)){
+        case s3s_StreamQueue::TAKE::TARGET:
+            url.setUrl(target);
+            return RETVAL::LOOKUP;
+        case s3s_StreamQueue::TAKE::WAIT:
+            return RETVAL::WAIT;
+        case s3s_StreamQueue::TAKE::CLOSED:
+            break;
+        }
+    }
+    return RETVAL::QUIT;
+}
+
+void url::loadConfig(url::ScanConfig *config){
+    CONFIG.beginGroup(CFG_URL);
+    config->threads = CONFIG.value(CFG_VAL_THREADS, config->threads).toInt();
+    config->timeout = CONFIG.value(CFG_VAL_TIMEOUT, config->timeout).toInt();
+    config->noDuplicates = CONFIG.value(CFG_VAL_DUPLICATES).toBool();
+    config->autoSaveToProject = CONFIG.value(CFG_VAL_AUTOSAVE).toBool();
+    config->setTimeout = CONFIG.value(CFG_VAL_SETTIMEOUT).toBool();
+    config->retry.maxRetries = CONFIG.value(CFG_VAL_MAXRETRIES, config->retry.maxRetries).toInt();
+    config->retry.backoff = CONFIG.value(CFG_VAL_BACKOFF, config->retry.backoff).toInt();
+    CONFIG.endGroup();
+}
+
+qint64 url::prepareScan(url::ScanArgs *args){
+    args->progress = 0;
+    return args->targets.length();
 }
@@ -12,6 +12,7 @@
 #include "AbstractScanner.h"
 #include "src/utils/s3s.h"
 #include "src/items/URLItem.h"
+#include "src/utils/RetryPolicy.h"
 
 #include <QMutex>
 #include <QQueue>
@@ -33,12 +34,16 @@ struct ScanConfig { // scan configurations
     bool setTimeout = false;
     bool noDuplicates = false;
     bool autoSaveToProject = false;
+
+    retry::Policy retry;
 };
 
 struct ScanArgs { // scan arguments
     QMutex mutex;
     url::ScanConfig *config;
+    retry::Queue retries; // failed targets waiting for their retry
     QQueue<QString> targets;
+    s3s_StreamQueue *stream = nullptr; // targets streamed from a pipeline's stage, after the targets
     int progress;
 };
 
@@ -85,10 +90,20 @@ class Scanner : public AbstractScanner{
     private:
         url::ScanArgs *m_args;
         NetworkAccessManager *m_manager;
+
+        bool lookup_retry();
+        bool schedule_retry(QNetworkReply *reply);
+        void quit_scan();
 };
 
 RETVAL getTarget(url::ScanArgs *args, QUrl &url);
 
+/* the configurations of the [url] section */
+void loadConfig(url::ScanConfig *config);
+
+/* returns the targets, the work of the scan's threads */
+qint64 prepareScan(url::ScanArgs *args);
+
 }
 
 #endif // URLSCANNER_H
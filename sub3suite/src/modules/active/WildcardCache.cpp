@@ -0,0 +1,95 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : wildcard analysis for the brute scanner, the answer sets of random labels probed on each
+          zone are cached & shared by all scanner threads, resolved names are then filtered by
+          comparing their answer sets to the answer sets of the wildcards of their zones.
+*/
+
+#include "WildcardCache.h"
+
+#include <QRandomGenerator>
+
+#define RANDOM_LABEL_LENGTH 16
+
+
+brute::WildcardCache::CHECK brute::WildcardCache::check(const brute::WildcardResult &result){
+    const QString &zone = result.zones.first();
+    Shard &shard = m_shards[qHash(zone) % WILDCARD_SHARDS];
+    QMutexLocker locker(&shard.mutex);
+
+    QHash<QString, Zone>::iterator it = shard.zones.find(zone);
+    if(it == shard.zones.end()){
+        it = shard.zones.insert(zone, Zone());
+        it->waiting.append(result);
+        return CHECK::PROBE;
+    }
+
+    if(!it->probed){
+        it->waiting.append(result);
+        return CHECK::PENDING;
+    }
+
+    /*
+     * a name whose answers are all among the answers of the zone's wildcard is the wildcard,
+     * a name with any other answer has its own record.
+     */
+    if(!it->answers.isEmpty() && it->answers.contains(result.answers))
+        return CHECK::WILDCARD;
+
+    return CHECK::NOT_WILDCARD;
+}
+
+QList<brute::WildcardResult> brute::WildcardCache::setAnswers(const QString &zone, const QSet<QString> &answers){
+    Shard &shard = m_shards[qHash(zone) % WILDCARD_SHARDS];
+    QMutexLocker locker(&shard.mutex);
+
+    Zone &z = shard.zones[zone];
+    z.probed = true;
+    z.answers = answers;
+
+    QList<brute::WildcardResult> waiting = z.waiting;
+    z.waiting.clear();
+    return waiting;
+}
+
+void brute::WildcardCache::clear(){
+    for(int i = 0; i < WILDCARD_SHARDS; i++){
+        QMutexLocker locker(&m_shards[i].mutex);
+        m_shards[i].zones.clear();
+    }
+}
+
+QStringList brute::wildcardZones(const QString &name, const QString &target){
+    QStringList zones;
+
+    /* without a known target, every parent with at least two labels */
+    bool inTarget = !target.isEmpty() && name.endsWith("."+target);
+
+    int dot = name.indexOf('.');
+    while(dot != -1)
+    {
+        QString zone = name.mid(dot+1);
+        if(inTarget){
+            if(zone.length() < target.length())
+                break;
+        }
+        else if(!zone.contains('.'))
+            break;
+
+        zones.append(zone);
+        dot = name.indexOf('.', dot+1);
+    }
+    return zones;
+}
+
+QString brute::randomLabel(){
+    static const char chars[] = "abcdefghijklmnopqrstuvwxyz0123456789";
+
+    QString label;
+    label.reserve(RANDOM_LABEL_LENGTH);
+    for(int i = 0; i < RANDOM_LABEL_LENGTH; i++)
+        label.append(QLatin1Char(chars[QRandomGenerator::global()->bounded(36)]));
+    return label;
+}
@@ -0,0 +1,75 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : wildcard analysis for the brute scanner, the answer sets of random labels probed on each
+          zone are cached & shared by all scanner threads, resolved names are then filtered by
+          comparing their answer sets to the answer sets of the wildcards of their zones.
+*/
+
+#ifndef WILDCARDCACHE_H
+#define WILDCARDCACHE_H
+
+#include <QSet>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+#include "src/items/HostItem.h"
+
+/* number of random labels probed on each zone */
+#define WILDCARD_PROBES 3
+
+/* number of independently locked zone maps */
+#define WILDCARD_SHARDS 16
+
+
+namespace brute {
+
+struct WildcardResult { // a resolved name waiting for the wildcard analysis of its zones
+    s3s_struct::HOST host;
+    QSet<QString> answers;
+    QStringList zones; // zones not yet compared, nearest zone first
+    QString target; // target the name was found on, empty if not known
+};
+
+class WildcardCache {
+    public:
+        enum class CHECK {
+            NOT_WILDCARD,   // the result is not a wildcard answer of the zone
+            WILDCARD,       // the result is a wildcard answer of the zone
+            PROBE,          // the zone was not analysed, the caller probes it & the result waits for it
+            PENDING         // the zone is being probed by another thread, the result waits for it
+        };
+
+        /* compares the result to the wildcard answers of the result's first zone */
+        CHECK check(const brute::WildcardResult &result);
+
+        /* sets the probed answers of the zone, returns the results that were waiting for it */
+        QList<brute::WildcardResult> setAnswers(const QString &zone, const QSet<QString> &answers);
+
+        void clear();
+
+    private:
+        struct Zone {
+            bool probed = false;
+            QSet<QString> answers; // union of the answers of all probes, empty if not a wildcard
+            QList<brute::WildcardResult> waiting;
+        };
+        struct Shard {
+            QMutex mutex;
+            QHash<QString, Zone> zones;
+        };
+        Shard m_shards[WILDCARD_SHARDS];
+};
+
+/* the parent zones of the name down to the target, nearest zone first */
+QStringList wildcardZones(const QString &name, const QString &target);
+
+/* a random label unlikely to exist on any zone */
+QString randomLabel();
+
+}
+
+#endif // WILDCARDCACHE_H
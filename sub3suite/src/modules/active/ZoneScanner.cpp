@@ -0,0 +1,747 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief :
+*/
+
+#include "ZoneScanner.h"
+
+#include <QUrl>
+#include <QTimer>
+#include <QTcpSocket>
+#include <QUdpSocket>
+#include <QElapsedTimer>
+#include <QNetworkDatagram>
+#include <QRandomGenerator>
+#include <QCryptographicHash>
+
+#define DNS_PORT 53
+#define DNS_HEADER_SIZE 12
+#define DNS_CLASS_IN 1
+#define DNS_EDNS_SIZE 4096
+#define DNS_MAX_POINTERS 64
+#define DNS_MAX_NAME 255 // octets of a name in wire format
+
+#define DNS_TYPE_A 1
+#define DNS_TYPE_NS 2
+#define DNS_TYPE_CNAME 5
+#define DNS_TYPE_SOA 6
+#define DNS_TYPE_MX 15
+#define DNS_TYPE_TXT 16
+#define DNS_TYPE_AAAA 28
+#define DNS_TYPE_SRV 33
+#define DNS_TYPE_OPT 41
+#define DNS_TYPE_NSEC 47
+#define DNS_TYPE_NSEC3 50
+#define DNS_TYPE_IXFR 251
+#define DNS_TYPE_AXFR 252
+
+#define DNS_RCODE_NOERROR 0
+
+/* milliseconds for a query or each message of a transfer, if the scan has no timeout */
+#define ZONE_TIMEOUT 3000
+
+/* names followed on an nsec chain */
+#define ZONE_MAX_WALK 100000
+
+/* queries for the records of an nsec3 chain */
+#define ZONE_MAX_NSEC3_QUERIES 10000
+
+/* names hashed locally to find one in a gap of an nsec3 chain */
+#define ZONE_MAX_CANDIDATES 100000
+
+
+///
+/// the dns messages...
+///
+
+static quint16 readUInt16(const QByteArray &message, int offset){
+    return static_cast<quint16>((static_cast<quint8>(message.at(offset)) << 8) | static_cast<quint8>(message.at(offset+1)));
+}
+
+static quint32 readUInt32(const QByteArray &message, int offset){
+    return (static_cast<quint32>(readUInt16(message, offset)) << 16) | readUInt16(message, offset+2);
+}
+
+static void writeUInt16(QByteArray &message, quint16 value){
+    message.append(static_cast<char>(value >> 8));
+    message.append(static_cast<char>(value & 0xff));
+}
+
+static void writeUInt32(QByteArray &message, quint32 value){
+    writeUInt16(message, static_cast<quint16>(value >> 16));
+    writeUInt16(message, static_cast<quint16>(value & 0xffff));
+}
+
+/* a name in wire format, an empty array if the name is invalid or longer than 255 octets */
+static QByteArray encodeName(const QString &name){
+    QByteArray encoded;
+    foreach(const QString &label, name.split('.', QString::SkipEmptyParts)){
+        /* an internationalized label is sent in its ascii compatible form */
+        QByteArray ascii = label.toLatin1();
+        foreach(const QChar &c, label){
+            if(c.unicode() > 0x7f){
+                ascii = QUrl::toAce(label);
+                break;
+            }
+        }
+        if(ascii.isEmpty() || ascii.size() > 63)
+            return QByteArray();
+
+        encoded.append(static_cast<char>(ascii.size()));
+        encoded.append(ascii);
+    }
+    encoded.append('\0');
+    if(encoded.size() > DNS_MAX_NAME)
+        return QByteArray();
+    return encoded;
+}
+
+/* reads a possibly compressed name, returns the offset after it or -1 if malformed */
+static int readName(const QByteArray &message, int offset, QString &name){
+    QStringList labels;
+    int end = -1;
+    int pointers = 0;
+
+    while(offset < message.size()){
+        int length = static_cast<quint8>(message.at(offset));
+        if(length == 0){
+            name = labels.join('.').toLower();
+            return (end < 0)? offset+1 : end;
+        }
+        if((length & 0xc0) == 0xc0){
+            if(offset+1 >= message.size() || ++pointers > DNS_MAX_POINTERS)
+                return -1;
+            if(end < 0)
+                end = offset+2;
+            offset = ((length & 0x3f) << 8) | static_cast<quint8>(message.at(offset+1));
+            continue;
+        }
+        if(length > 63 || offset+1+length > message.size())
+            return -1;
+
+        labels.append(QString::fromLatin1(message.mid(offset+1, length)));
+        offset += length+1;
+    }
+    return -1;
+}
+
+/* reads a resource record, returns the offset after it or -1 if malformed */
+static int readRecord(const QByteArray &message, int offset, zone::Record &record){
+    offset = readName(message, offset, record.name);
+    if(offset < 0 || offset+10 > message.size())
+        return -1;
+
+    record.type = readUInt16(message, offset);
+    int length = readUInt16(message, offset+8);
+    int rdata = offset+10;
+    int end = rdata+length;
+    if(end > message.size())
+        return -1;
+
+    switch(record.type){
+    case DNS_TYPE_A:
+        if(length == 4)
+            record.value = QHostAddress(readUInt32(message, rdata)).toString();
+        break;
+    case DNS_TYPE_AAAA:
+        if(length == 16)
+            record.value = QHostAddress(reinterpret_cast<const quint8*>(message.constData()+rdata)).toString();
+        break;
+    case DNS_TYPE_NS:
+    case DNS_TYPE_CNAME:
+    case DNS_TYPE_SOA:  // the primary nameserver
+    case DNS_TYPE_NSEC: // the next name
+        if(readName(message, rdata, record.value) < 0)
+            return -1;
+        break;
+    case DNS_TYPE_MX:
+        if(length < 3 || readName(message, rdata+2, record.value) < 0)
+            return -1;
+        break;
+    case DNS_TYPE_SRV:
+    {
+        QString target;
+        if(length < 7 || readName(message, rdata+6, target) < 0)
+            return -1;
+        record.srv = QStringList{record.name, target, QString::number(readUInt16(message, rdata+4))};
+    }
+        break;
+    case DNS_TYPE_TXT:
+        for(int i = rdata; i < end; i += static_cast<quint8>(message.at(i))+1)
+            record.value.append(QString::fromUtf8(message.mid(i+1, qMin(static_cast<int>(static_cast<quint8>(message.at(i))), end-i-1))));
+        break;
+    case DNS_TYPE_NSEC3:
+    {
+        if(length < 5)
+            return -1;
+        int saltLength = static_cast<quint8>(message.at(rdata+4));
+        int hash = rdata+5+saltLength;
+        if(hash >= end || hash+1+static_cast<quint8>(message.at(hash)) > end)
+            return -1;
+
+        record.iterations = readUInt16(message, rdata+2);
+        record.salt = message.mid(rdata+5, saltLength);
+        record.next = message.mid(hash+1, static_cast<quint8>(message.at(hash)));
+    }
+        break;
+    default:
+        break;
+    }
+    return end;
+}
+
+static bool parse(const QByteArray &data, zone::Message &message){
+    message = zone::Message();
+    if(data.size() < DNS_HEADER_SIZE)
+        return false;
+
+    message.id = readUInt16(data, 0);
+    message.truncated = data.at(2) & 0x02;
+    message.rcode = data.at(3) & 0x0f;
+
+    int offset = DNS_HEADER_SIZE;
+    for(int i = 0; i < readUInt16(data, 4); i++){
+        QString name;
+        offset = readName(data, offset, name);
+        if(offset < 0 || offset+4 > data.size())
+            return false;
+        offset += 4;
+    }
+
+    QList<zone::Record> *sections[] = {&message.answers, &message.authorities, &message.additionals};
+    for(int section = 0; section < 3; section++)
+    {
+        int count = readUInt16(data, 6+section*2);
+        for(int i = 0; i < count; i++){
+            zone::Record record;
+            offset = readRecord(data, offset, record);
+            if(offset < 0)
+                return false;
+            if(record.type != DNS_TYPE_OPT)
+                sections[section]->append(record);
+        }
+    }
+    return true;
+}
+
+/*
+ * a query, the authoritative queries are not recursive & ask for the dnssec records. an ixfr
+ * query carries the soa of the serial the transfer starts from, from serial 0 the whole zone.
+ */
+static QByteArray query(quint16 id, const QByteArray &name, quint16 type, bool recursive){
+    bool dnssec = !recursive;
+
+    QByteArray message;
+    writeUInt16(message, id);
+    writeUInt16(message, recursive? 0x0100 : 0x0000);
+    writeUInt16(message, 1);
+    writeUInt16(message, 0);
+    writeUInt16(message, (type == DNS_TYPE_IXFR)? 1 : 0);
+    writeUInt16(message, dnssec? 1 : 0);
+
+    message.append(name);
+    writeUInt16(message, type);
+    writeUInt16(message, DNS_CLASS_IN);
+
+    if(type == DNS_TYPE_IXFR){
+        message.append(name);
+        writeUInt16(message, DNS_TYPE_SOA);
+        writeUInt16(message, DNS_CLASS_IN);
+        writeUInt32(message, 0);
+        writeUInt16(message, 22);
+        message.append(QByteArray(2, '\0')); // root mname & rname
+        for(int i = 0; i < 5; i++)
+            writeUInt32(message, 0);
+    }
+    if(dnssec){
+        /* edns0 with the DO bit */
+        message.append('\0');
+        writeUInt16(message, DNS_TYPE_OPT);
+        writeUInt16(message, DNS_EDNS_SIZE);
+        writeUInt32(message, 0x00008000);
+        writeUInt16(message, 0);
+    }
+    return message;
+}
+
+/* reads a length prefixed message from a tcp connection */
+static bool readMessage(QTcpSocket &socket, int timeout, QByteArray &data){
+    while(socket.bytesAvailable() < 2){
+        if(!socket.waitForReadyRead(timeout))
+            return false;
+    }
+    QByteArray prefix = socket.read(2);
+    int length = readUInt16(prefix, 0);
+
+    while(socket.bytesAvailable() < length){
+        if(!socket.waitForReadyRead(timeout))
+            return false;
+    }
+    data = socket.read(length);
+    return true;
+}
+
+static QString rcodeName(quint8 rcode){
+    switch(rcode){
+    case 1: return "FORMERR";
+    case 2: return "SERVFAIL";
+    case 3: return "NXDOMAIN";
+    case 4: return "NOTIMP";
+    case 5: return "REFUSED";
+    case 9: return "NOTAUTH";
+    default: return "RCODE "+QString::number(rcode);
+    }
+}
+
+///
+/// nsec & nsec3...
+///
+
+/* the next name of the nsec record owned by a name */
+static QString nsecNext(const zone::Message &reply, const QString &owner){
+    foreach(const zone::Record &record, reply.answers + reply.authorities){
+        if(record.type == DNS_TYPE_NSEC && record.name == owner)
+            return record.value;
+    }
+    return QString();
+}
+
+static QByteArray fromBase32Hex(const QString &text){
+    static const QString alphabet("0123456789abcdefghijklmnopqrstuv");
+
+    QByteArray bytes;
+    quint32 buffer = 0;
+    int bits = 0;
+    foreach(const QChar &c, text){
+        int value = alphabet.indexOf(c.toLower());
+        if(value < 0)
+            return QByteArray();
+
+        buffer = (buffer << 5) | static_cast<quint32>(value);
+        bits += 5;
+        if(bits >= 8){
+            bits -= 8;
+            bytes.append(static_cast<char>((buffer >> bits) & 0xff));
+        }
+    }
+    return bytes;
+}
+
+/* the nsec3 records of a reply into the chain, hashed owner name to the next hashed owner name */
+static void collect(const zone::Message &reply, const QString &zone, QMap<QByteArray, QByteArray> &chain,
+                    QByteArray &salt, quint16 &iterations)
+{
+    foreach(const zone::Record &record, reply.answers + reply.authorities){
+        if(record.type != DNS_TYPE_NSEC3 || record.name.section('.', 1) != zone)
+            continue;
+
+        QByteArray owner = fromBase32Hex(record.name.section('.', 0, 0));
+        if(owner.isEmpty() || record.next.isEmpty())
+            continue;
+
+        chain.insert(owner, record.next);
+        salt = record.salt;
+        iterations = record.iterations;
+    }
+}
+
+/* true if the hash is an owner of the chain or falls between an owner & its next */
+static bool covered(const QMap<QByteArray, QByteArray> &chain, const QByteArray &hash){
+    if(chain.contains(hash))
+        return true;
+
+    /* the record before the hash, before the first owner it is the last record that wraps around */
+    QMap<QByteArray, QByteArray>::const_iterator it = chain.upperBound(hash);
+    if(it == chain.constBegin())
+        it = chain.constEnd();
+    --it;
+
+    if(it.key() < it.value())
+        return it.key() < hash && hash < it.value();
+    return it.key() < hash || hash < it.value();
+}
+
+/* true once every next hashed owner name is an owner, the chain goes round the zone */
+static bool closed(const QMap<QByteArray, QByteArray> &chain){
+    foreach(const QByteArray &next, chain){
+        if(!chain.contains(next))
+            return false;
+    }
+    return true;
+}
+
+QByteArray zone::nsec3Hash(const QString &name, const QByteArray &salt, quint16 iterations){
+    QByteArray hash = encodeName(name.toLower());
+    if(hash.isEmpty())
+        return QByteArray();
+    for(int i = 0; i <= iterations; i++){
+        hash.append(salt);
+        hash = QCryptographicHash::hash(hash, QCryptographicHash::Sha1);
+    }
+    return hash;
+}
+
+///
+/// the scanner...
+///
+
+zone::Scanner::Scanner(dns::ScanArgs *args): AbstractScanner(nullptr),
+    m_args(args),
+    m_id(static_cast<quint16>(QRandomGenerator::global()->bounded(0x10000))),
+    m_timeout(args->config->timeout > 0? args->config->timeout : ZONE_TIMEOUT)
+{
+    /* queued, the queries are blocking & the stop & resume signals are handled between the zones */
+    connect(this, &zone::Scanner::next, this, &zone::Scanner::lookup, Qt::QueuedConnection);
+
+    /* setting nameserver */
+    QString nameserver = m_args->config->nameservers.dequeue();
+    m_nameserver = QHostAddress(nameserver);
+    m_args->config->nameservers.enqueue(nameserver);
+}
+zone::Scanner::~Scanner(){
+}
+
+void zone::Scanner::lookup(){
+    if(!this->checkpoint())
+        return;
+
+    switch(dns::getTarget(m_args, m_zone)){
+    case RETVAL::LOOKUP:
+        break;
+    case RETVAL::WAIT:
+        QTimer::singleShot(STREAM_WAIT, this, &zone::Scanner::lookup);
+        return;
+    default:
+        emit quitThread();
+        return;
+    }
+    m_zone = m_zone.trimmed().toLower();
+    while(m_zone.endsWith('.'))
+        m_zone.chop(1);
+
+    m_queryStart = metrics::now();
+
+    QList<zone::Server> servers = this->nameservers();
+    if(servers.isEmpty()){
+        log.message = "No nameservers found for the zone";
+        log.target = m_zone;
+        log.nameserver = m_nameserver.toString();
+        log.recordType = "NS";
+        emit scanLog(log);
+    }
+    else {
+        /* the zone is the same on all its nameservers, a transfer or a walk from one is enough */
+        bool enumerated = false;
+        foreach(const zone::Server &server, servers){
+            if(this->stopped() || enumerated)
+                break;
+            enumerated = this->transfer(server, false) || this->transfer(server, true);
+        }
+        foreach(const zone::Server &server, servers){
+            if(this->stopped() || enumerated)
+                break;
+            enumerated = this->walkNsec(server) || this->walkNsec3(server);
+        }
+        if(!enumerated && !this->stopped())
+            emit scanStatus(m_zone+": no zone transfer allowed & no nsec or nsec3 chain to walk");
+    }
+
+    metrics::recordSince(metrics::SCANNER::DNS, metrics::HISTOGRAM::QUERY_LATENCY, m_queryStart);
+
+    m_args->progress++;
+    emit scanProgress(m_args->progress);
+    emit next();
+}
+
+QList<zone::Server> zone::Scanner::nameservers(){
+    QList<zone::Server> servers;
+    zone::Message reply;
+
+    if(!this->exchange(m_nameserver, encodeName(m_zone), DNS_TYPE_NS, true, reply))
+        return servers;
+
+    QStringList names;
+    foreach(const zone::Record &record, reply.answers){
+        if(record.type == DNS_TYPE_NS && !names.contains(record.value))
+            names.append(record.value);
+    }
+
+    /* the ipv4 addresses of each nameserver, else its ipv6 addresses */
+    const QList<quint16> types = {DNS_TYPE_A, DNS_TYPE_AAAA};
+    foreach(const QString &name, names){
+        foreach(quint16 type, types){
+            if(!this->exchange(m_nameserver, encodeName(name), type, true, reply))
+                continue;
+
+            int count = servers.size();
+            foreach(const zone::Record &record, reply.answers){
+                if(record.type != type || record.value.isEmpty())
+                    continue;
+                zone::Server server;
+                server.name = name;
+                server.address = QHostAddress(record.value);
+                servers.append(server);
+            }
+            if(servers.size() > count)
+                break;
+        }
+    }
+    return servers;
+}
+
+bool zone::Scanner::transfer(const zone::Server &server, bool incremental){
+    QString method(incremental? "IXFR" : "AXFR");
+    quint16 id = ++m_id;
+    QByteArray message = query(id, encodeName(m_zone), incremental? DNS_TYPE_IXFR : DNS_TYPE_AXFR, false);
+
+    QTcpSocket socket;
+    socket.connectToHost(server.address, DNS_PORT);
+    if(!socket.waitForConnected(m_timeout)){
+        this->status(server, method, socket.errorString());
+        return false;
+    }
+    QByteArray prefix;
+    writeUInt16(prefix, static_cast<quint16>(message.size()));
+    socket.write(prefix+message);
+
+    /*
+     * the records are sent as they arrive, grouped by their owner name. the transfer starts &
+     * ends with the zone's soa.
+     */
+    s3s_struct::DNS result;
+    QByteArray data;
+    zone::Message reply;
+    int records = 0;
+    int soa = 0;
+    while(soa < 2 && !this->stopped())
+    {
+        if(!readMessage(socket, m_timeout, data) || !parse(data, reply) || reply.id != id)
+            break;
+        if(reply.rcode != DNS_RCODE_NOERROR){
+            this->status(server, method, rcodeName(reply.rcode));
+            break;
+        }
+        if(reply.answers.isEmpty())
+            break;
+
+        foreach(const zone::Record &record, reply.answers){
+            if(record.type == DNS_TYPE_SOA){
+                soa++;
+                continue;
+            }
+            records++;
+
+            if(record.name != result.dns){
+                if(!result.dns.isEmpty())
+                    emit scanResult(result);
+                result = s3s_struct::DNS();
+                result.dns = record.name;
+            }
+            switch(record.type){
+            case DNS_TYPE_A:
+                result.A.insert(record.value);
+                break;
+            case DNS_TYPE_AAAA:
+                result.AAAA.insert(record.value);
+                break;
+            case DNS_TYPE_NS:
+                result.NS.insert(record.value);
+                break;
+            case DNS_TYPE_MX:
+                result.MX.insert(record.value);
+                break;
+            case DNS_TYPE_TXT:
+                result.TXT.insert(record.value);
+                break;
+            case DNS_TYPE_CNAME:
+                result.CNAME.insert(record.value);
+                break;
+            case DNS_TYPE_SRV:
+                result.SRV.insert(record.srv);
+                break;
+            }
+        }
+    }
+    socket.abort();
+
+    if(!result.dns.isEmpty())
+        emit scanResult(result);
+
+    if(records == 0){
+        if(soa == 0 && reply.rcode == DNS_RCODE_NOERROR)
+            this->status(server, method, "refused");
+        return false;
+    }
+    this->status(server, method, QString("%1 records%2").arg(records).arg((soa < 2)? ", the transfer was cut short" : ""));
+    return true;
+}
+
+bool zone::Scanner::walkNsec(const zone::Server &server){
+    QSet<QString> walked;
+    QString name = m_zone;
+    zone::Message reply;
+    bool complete = false;
+
+    while(!this->stopped() && walked.size() < ZONE_MAX_WALK)
+    {
+        walked.insert(name);
+
+        /*
+         * the nsec record of a name, else the one denying its first child in the canonical order,
+         * "\000.name", which is owned by the name.
+         */
+        QString child = QString(QChar(0))+"."+name;
+        if(!this->exchange(server.address, encodeName(name), DNS_TYPE_NSEC, false, reply))
+            break;
+        QString next = nsecNext(reply, name);
+        if(next.isNull()){
+            if(!this->exchange(server.address, encodeName(child), DNS_TYPE_A, false, reply))
+                break;
+            next = nsecNext(reply, name);
+        }
+
+        if(next.isNull() || !(next == m_zone || next.endsWith("."+m_zone)))
+            break;
+
+        /*
+         * compact denial of existence ("black lies"), the nsec records are made up for each query
+         * & the next name is the "\000" child of the queried name. the zone can not be walked.
+         */
+        if(next == child || next.startsWith(QString(QChar(0))+".")){
+            this->status(server, "NSEC walk", "compact denial of existence, the zone can not be walked");
+            return false;
+        }
+        if(next == m_zone || walked.contains(next)){
+            complete = true;
+            break;
+        }
+
+        s3s_struct::DNS result;
+        result.dns = next;
+        emit scanResult(result);
+
+        name = next;
+    }
+
+    /* the apex only, the zone is not signed with nsec */
+    if(walked.size() < 2)
+        return false;
+
+    this->status(server, "NSEC walk", QString("%1 names%2").arg(walked.size()-1).arg(complete? "" : ", the walk was cut short"));
+    return true;
+}
+
+bool zone::Scanner::walkNsec3(const zone::Server &server){
+    QMap<QByteArray, QByteArray> chain;
+    QByteArray salt;
+    quint16 iterations = 0;
+    zone::Message reply;
+
+    /* the denial of the apex's nsec record has the zone's first nsec3 records & their parameters */
+    if(!this->exchange(server.address, encodeName(m_zone), DNS_TYPE_NSEC, false, reply))
+        return false;
+    collect(reply, m_zone, chain, salt, iterations);
+    if(chain.isEmpty())
+        return false;
+
+    /*
+     * names are hashed locally until one falls in a gap of the chain, its denial returns the
+     * nsec3 record covering the gap. one query for each record of the zone.
+     */
+    int queries = 1;
+    quint32 candidate = 0;
+    while(!closed(chain) && queries < ZONE_MAX_NSEC3_QUERIES && !this->stopped())
+    {
+        QString name;
+        bool found = false;
+        for(int i = 0; i < ZONE_MAX_CANDIDATES && !found; i++){
+            name = QString::number(candidate++, 36)+"."+m_zone;
+            QByteArray hash = zone::nsec3Hash(name, salt, iterations);
+            found = !hash.isEmpty() && !covered(chain, hash);
+        }
+        if(!found || !this->exchange(server.address, encodeName(name), DNS_TYPE_A, false, reply))
+            break;
+
+        queries++;
+        collect(reply, m_zone, chain, salt, iterations);
+    }
+
+    /* offline, the wordlist's names whose hashes are in the chain */
+    int cracked = 0;
+    QSet<QByteArray> hashes;
+    foreach(const QString &word, m_args->zoneWordlist){
+        if(this->stopped())
+            break;
+
+        QString name = word.trimmed().toLower();
+        if(name.isEmpty())
+            continue;
+        name += "."+m_zone;
+
+        QByteArray hash = zone::nsec3Hash(name, salt, iterations);
+        if(!chain.contains(hash) || hashes.contains(hash))
+            continue;
+        hashes.insert(hash);
+
+        s3s_struct::DNS result;
+        result.dns = name;
+        emit scanResult(result);
+        cracked++;
+    }
+
+    this->status(server, "NSEC3", QString("%1 hashes in %2 queries%3, %4 cracked with the wordlist, %5 iterations")
+                 .arg(chain.size()).arg(queries).arg(closed(chain)? "" : " (the chain is incomplete)").arg(cracked).arg(iterations));
+    return true;
+}
+
+bool zone::Scanner::exchange(const QHostAddress &server, const QByteArray &name, quint16 type, bool recursive, zone::Message &reply){
+    if(name.isEmpty())
+        return false;
+
+    quint16 id = ++m_id;
+    QByteArray message = query(id, name, type, recursive);
+    m_lookupStart = metrics::now();
+
+    QUdpSocket socket;
+    if(socket.writeDatagram(message, server, DNS_PORT) != message.size())
+        return false;
+
+    QElapsedTimer timer;
+    timer.start();
+    while(timer.elapsed() < m_timeout && socket.waitForReadyRead(m_timeout-static_cast<int>(timer.elapsed())))
+    {
+        while(socket.hasPendingDatagrams()){
+            QNetworkDatagram datagram = socket.receiveDatagram();
+            if(!parse(datagram.data(), reply) || reply.id != id)
+                continue;
+
+            metrics::recordSince(metrics::SCANNER::DNS, metrics::HISTOGRAM::RESOLVER_RTT, m_lookupStart);
+            if(reply.truncated)
+                return this->exchangeTcp(server, message, reply);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool zone::Scanner::exchangeTcp(const QHostAddress &server, const QByteArray &query, zone::Message &reply){
+    QTcpSocket socket;
+    socket.connectToHost(server, DNS_PORT);
+    if(!socket.waitForConnected(m_timeout))
+        return false;
+
+    QByteArray prefix;
+    writeUInt16(prefix, static_cast<quint16>(query.size()));
+    socket.write(prefix+query);
+
+    QByteArray data;
+    bool received = readMessage(socket, m_timeout, data) && parse(data, reply) && reply.id == readUInt16(query, 0);
+    socket.abort();
+    return received;
+}
+
+void zone::Scanner::status(const zone::Server &server, const QString &method, const QString &message){
+    emit scanStatus(QString("%1 %2 from %3 (%4): %5").arg(method, m_zone, server.name, server.address.toString(), message));
+}
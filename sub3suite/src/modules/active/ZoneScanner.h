@@ -0,0 +1,91 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : enumerating the names of a zone from its nameservers, a zone transfer (AXFR, else IXFR)
+          is tried on each nameserver of the zone. if none allows it, a signed zone is walked, its
+          NSEC chain is followed name by name or its NSEC3 hashes are collected & cracked offline
+          against a wordlist. the queries are sent on blocking sockets, like the port scanner.
+*/
+
+#ifndef ZONESCANNER_H
+#define ZONESCANNER_H
+
+#include <QMap>
+#include <QHostAddress>
+
+#include "DNSScanner.h"
+
+
+namespace zone {
+
+/* a resource record of a dns message */
+struct Record {
+    QString name;
+    quint16 type = 0;
+    QString value;      // the address, name or text of the rdata
+    QStringList srv;    // srv, name, target & port
+
+    /* nsec3 */
+    QByteArray salt;
+    quint16 iterations = 0;
+    QByteArray next;    // the next hashed owner name
+};
+
+struct Message {
+    quint16 id = 0;
+    quint8 rcode = 0;
+    bool truncated = false;
+    QList<zone::Record> answers;
+    QList<zone::Record> authorities;
+    QList<zone::Record> additionals;
+};
+
+/* a nameserver of the zone */
+struct Server {
+    QString name;
+    QHostAddress address;
+};
+
+class Scanner: public AbstractScanner {
+    Q_OBJECT
+
+    public:
+        explicit Scanner(dns::ScanArgs *args);
+        ~Scanner() override;
+
+        /* the transfers & the walks are made with blocking sockets */
+        bool isBlocking() const override { return true; }
+
+    private slots:
+        void lookup() override;
+
+    signals:
+        void scanResult(s3s_struct::DNS);
+        void scanStatus(QString);
+        void next();
+
+    private:
+        dns::ScanArgs *m_args;
+        QHostAddress m_nameserver; // the resolver, for the zone's nameservers
+        QString m_zone;
+        quint16 m_id;
+        int m_timeout;
+
+        QList<zone::Server> nameservers();
+        bool transfer(const zone::Server &server, bool incremental);
+        bool walkNsec(const zone::Server &server);
+        bool walkNsec3(const zone::Server &server);
+
+        /* a query & its answer, over udp then over tcp if the answer is truncated */
+        bool exchange(const QHostAddress &server, const QByteArray &name, quint16 type, bool recursive, zone::Message &reply);
+        bool exchangeTcp(const QHostAddress &server, const QByteArray &query, zone::Message &reply);
+
+        void status(const zone::Server &server, const QString &method, const QString &message);
+};
+
+/* the nsec3 hash of a name, rfc5155. empty if the name is not valid in wire format */
+QByteArray nsec3Hash(const QString &name, const QByteArray &salt, quint16 iterations);
+
+}
+#endif // ZONESCANNER_H
@@ -0,0 +1,456 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief :
+*/
+
+#include "CtTailer.h"
+
+#include <functional>
+#include <QTimer>
+#include <QRunnable>
+#include <QUrlQuery>
+#include <QJsonObject>
+#include <QJsonDocument>
+
+#define REQUEST_STH 0
+#define REQUEST_ENTRIES 1
+
+/* names remembered for their deduplication, a long tail forgets them after that many */
+#define CT_MAX_SEEN 1000000
+
+/* DER tags */
+#define DER_SEQUENCE 0x30
+#define DER_SET 0x31
+#define DER_OID 0x06
+#define DER_OCTET_STRING 0x04
+#define DER_UTF8_STRING 0x0c
+#define DER_PRINTABLE_STRING 0x13
+#define DER_T61_STRING 0x14
+#define DER_IA5_STRING 0x16
+#define DER_VERSION 0xa0    // [0], the version of a TBSCertificate
+#define DER_EXTENSIONS 0xa3 // [3], the extensions of a TBSCertificate
+#define DER_DNS_NAME 0x82   // [2], a dNSName of a GeneralName
+
+/* ct leaf entry types, rfc6962 */
+#define CT_X509_ENTRY 0
+#define CT_PRECERT_ENTRY 1
+
+static const QByteArray OID_COMMON_NAME("\x55\x04\x03", 3);      // 2.5.4.3
+static const QByteArray OID_SUBJECT_ALT_NAME("\x55\x1d\x11", 3); // 2.5.29.17
+
+
+namespace ct {
+
+/* a parsing job of the worker pool */
+class ParseJob : public QRunnable {
+    public:
+        explicit ParseJob(const std::function<void()> &run): m_run(run) {}
+        void run() override { m_run(); }
+
+    private:
+        std::function<void()> m_run;
+};
+
+}
+
+///
+/// the entries...
+///
+
+struct Der { // a DER element, its contents are [start, end)
+    quint8 tag = 0;
+    int start = 0;
+    int end = 0;
+};
+
+/* reads the element at the offset within the limit */
+static bool readDer(const QByteArray &data, int offset, int limit, Der &element){
+    if(offset+2 > limit)
+        return false;
+
+    element.tag = static_cast<quint8>(data.at(offset));
+    int length = static_cast<quint8>(data.at(offset+1));
+    offset += 2;
+    if(length & 0x80){
+        int bytes = length & 0x7f;
+        if(bytes == 0 || bytes > 3 || offset+bytes > limit)
+            return false;
+        length = 0;
+        for(int i = 0; i < bytes; i++)
+            length = (length << 8) | static_cast<quint8>(data.at(offset++));
+    }
+    if(length > limit-offset)
+        return false;
+
+    element.start = offset;
+    element.end = offset+length;
+    return true;
+}
+
+/* the children of a constructed element */
+static QList<Der> children(const QByteArray &data, const Der &parent){
+    QList<Der> elements;
+    Der element;
+    int offset = parent.start;
+    while(offset < parent.end && readDer(data, offset, parent.end, element)){
+        elements.append(element);
+        offset = element.end;
+    }
+    return elements;
+}
+
+static QByteArray contents(const QByteArray &data, const Der &element){
+    return data.mid(element.start, element.end-element.start);
+}
+
+/* the common names of a subject, Name ::= SEQUENCE OF SET OF AttributeTypeAndValue */
+static void subjectNames(const QByteArray &data, const Der &subject, QStringList &names){
+    foreach(const Der &set, children(data, subject)){
+        if(set.tag != DER_SET)
+            continue;
+        foreach(const Der &attribute, children(data, set)){
+            QList<Der> pair = children(data, attribute);
+            if(pair.size() != 2 || pair.at(0).tag != DER_OID || contents(data, pair.at(0)) != OID_COMMON_NAME)
+                continue;
+
+            switch(pair.at(1).tag){
+            case DER_UTF8_STRING:
+                names.append(QString::fromUtf8(contents(data, pair.at(1))));
+                break;
+            case DER_PRINTABLE_STRING:
+            case DER_T61_STRING:
+            case DER_IA5_STRING:
+                names.append(QString::fromLatin1(contents(data, pair.at(1))));
+                break;
+            }
+        }
+    }
+}
+
+/* the dns names of the subject alternative name extension */
+static void extensionNames(const QByteArray &data, const Der &extensions, QStringList &names){
+    foreach(const Der &sequence, children(data, extensions)){
+        foreach(const Der &extension, children(data, sequence)){
+            /* Extension ::= SEQUENCE { extnID, critical BOOLEAN DEFAULT FALSE, extnValue OCTET STRING } */
+            QList<Der> fields = children(data, extension);
+            if(fields.size() < 2 || fields.first().tag != DER_OID || contents(data, fields.first()) != OID_SUBJECT_ALT_NAME)
+                continue;
+            if(fields.last().tag != DER_OCTET_STRING)
+                continue;
+
+            Der generalNames;
+            if(!readDer(data, fields.last().start, fields.last().end, generalNames) || generalNames.tag != DER_SEQUENCE)
+                continue;
+            foreach(const Der &name, children(data, generalNames)){
+                if(name.tag == DER_DNS_NAME)
+                    names.append(QString::fromLatin1(contents(data, name)));
+            }
+        }
+    }
+}
+
+QStringList ct::entryNames(const QByteArray &leafInput){
+    QStringList names;
+
+    /* MerkleTreeLeaf, version & leaf type 0, then a TimestampedEntry, timestamp & entry type */
+    if(leafInput.size() < 15 || leafInput.at(0) != 0 || leafInput.at(1) != 0)
+        return names;
+
+    int type = (static_cast<quint8>(leafInput.at(10)) << 8) | static_cast<quint8>(leafInput.at(11));
+    int offset = 12;
+    if(type == CT_PRECERT_ENTRY)
+        offset += 32; // the issuer's key hash
+    else if(type != CT_X509_ENTRY)
+        return names;
+    if(offset+3 > leafInput.size())
+        return names;
+
+    /* the certificate or the precertificate's TBSCertificate, with a 24 bit length */
+    int length = (static_cast<quint8>(leafInput.at(offset)) << 16) |
+                 (static_cast<quint8>(leafInput.at(offset+1)) << 8) |
+                  static_cast<quint8>(leafInput.at(offset+2));
+    offset += 3;
+    if(offset+length > leafInput.size())
+        return names;
+
+    Der tbs;
+    if(!readDer(leafInput, offset, offset+length, tbs) || tbs.tag != DER_SEQUENCE)
+        return names;
+    if(type == CT_X509_ENTRY){
+        Der certificate = tbs;
+        if(!readDer(leafInput, certificate.start, certificate.end, tbs) || tbs.tag != DER_SEQUENCE)
+            return names;
+    }
+
+    /*
+     * TBSCertificate ::= SEQUENCE { [0] version OPTIONAL, serialNumber, signature, issuer, validity,
+     *                               subject, subjectPublicKeyInfo, ..., [3] extensions OPTIONAL }
+     */
+    int field = 0;
+    foreach(const Der &element, children(leafInput, tbs)){
+        if(element.tag == DER_VERSION)
+            continue;
+        field++;
+        if(field == 5 && element.tag == DER_SEQUENCE)
+            subjectNames(leafInput, element, names);
+        else if(element.tag == DER_EXTENSIONS)
+            extensionNames(leafInput, element, names);
+    }
+    return names;
+}
+
+///
+/// the tailer...
+///
+
+ct::Tailer::Tailer(const ct::Config &config, QObject *parent): QObject(parent),
+    m_config(config),
+    m_manager(new s3sNetworkAccessManager(this, config.timeout, true))
+{
+    connect(m_manager, &QNetworkAccessManager::finished, this, &ct::Tailer::replyFinished);
+
+    m_config.batch = qMax(1, m_config.batch);
+    m_config.parallel = qMax(1, m_config.parallel);
+    if(m_config.workers > 0)
+        m_pool.setMaxThreadCount(m_config.workers);
+
+    foreach(const QString &domain, m_config.domains)
+        m_scope.insert(domain);
+
+    foreach(QUrl url, m_config.logs){
+        if(!url.path().endsWith('/'))
+            url.setPath(url.path()+"/");
+
+        Log *log = new Log;
+        log->url = url;
+        log->name = url.host()+url.path();
+        log->batch = m_config.batch;
+        m_logs.append(log);
+    }
+}
+ct::Tailer::~Tailer(){
+    this->stop();
+    m_pool.waitForDone();
+    qDeleteAll(m_logs);
+}
+
+void ct::Tailer::start(){
+    m_stopped = 0;
+    if(m_logs.isEmpty()){
+        QTimer::singleShot(0, this, &ct::Tailer::finished);
+        return;
+    }
+    foreach(Log *log, m_logs)
+        this->getSth(log);
+}
+
+void ct::Tailer::stop(){
+    if(m_stopped.fetchAndStoreOrdered(1))
+        return;
+
+    m_pool.clear();
+    foreach(QNetworkReply *reply, m_manager->findChildren<QNetworkReply*>()){
+        reply->blockSignals(true);
+        reply->abort();
+    }
+}
+
+void ct::Tailer::getSth(Log *log){
+    QNetworkRequest request(log->url.resolved(QUrl("ct/v1/get-sth")));
+    request.setAttribute(QNetworkRequest::User, REQUEST_STH);
+    request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+
+    QNetworkReply *reply = m_manager->get(request);
+    reply->setProperty("log", m_logs.indexOf(log));
+}
+
+void ct::Tailer::getEntries(Log *log, const Range &range){
+    QUrl url(log->url.resolved(QUrl("ct/v1/get-entries")));
+    QUrlQuery query;
+    query.addQueryItem("start", QString::number(range.start));
+    query.addQueryItem("end", QString::number(range.end));
+    url.setQuery(query);
+
+    QNetworkRequest request(url);
+    request.setAttribute(QNetworkRequest::User, REQUEST_ENTRIES);
+    request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+    request.setAttribute(QNetworkRequest::HTTP2AllowedAttribute, true);
+
+    QNetworkReply *reply = m_manager->get(request);
+    reply->setProperty("log", m_logs.indexOf(log));
+    reply->setProperty("start", range.start);
+    reply->setProperty("end", range.end);
+    reply->setProperty("retry", range.retry);
+    log->inflight++;
+}
+
+void ct::Tailer::schedule(Log *log){
+    while(!m_stopped && log->inflight < m_config.parallel)
+    {
+        /* the failed ranges & the rest of the ranges the log returned in part first */
+        if(!log->retries.isEmpty()){
+            this->getEntries(log, log->retries.dequeue());
+            continue;
+        }
+        if(log->next >= log->end)
+            break;
+
+        Range range{log->next, qMin(log->next+log->batch, log->end)-1, 0};
+        log->next = range.end+1;
+        this->getEntries(log, range);
+    }
+}
+
+void ct::Tailer::replyFinished(QNetworkReply *reply){
+    reply->deleteLater();
+    if(m_stopped)
+        return;
+
+    Log *log = m_logs.value(reply->property("log").toInt(), nullptr);
+    if(!log)
+        return;
+
+    ///
+    /// the tree head...
+    ///
+    if(reply->property(REQUEST_TYPE).toInt() == REQUEST_STH)
+    {
+        QJsonObject sth = QJsonDocument::fromJson(reply->readAll()).object();
+        if(reply->error() != QNetworkReply::NoError || !sth.contains("tree_size")){
+            emit error(log->name, "get-sth: "+reply->errorString());
+
+            /* a followed log is polled again, else it is given up */
+            if(log->next < 0 || !m_config.follow){
+                log->done = true;
+                this->checkFinished();
+            }
+            else
+                this->finishLog(log);
+            return;
+        }
+
+        log->size = static_cast<qint64>(sth.value("tree_size").toDouble());
+        if(log->next < 0){
+            log->next = (m_config.start >= 0)? m_config.start : qMax<qint64>(0, log->size-m_config.backlog);
+            log->end = (m_config.end >= 0)? qMin(m_config.end, log->size) : log->size;
+        }
+        else if(m_config.end < 0)
+            log->end = log->size;
+
+        emit progress(log->name, log->next, log->size);
+        this->schedule(log);
+        this->finishLog(log);
+        return;
+    }
+
+    ///
+    /// the entries...
+    ///
+    Range range{reply->property("start").toLongLong(), reply->property("end").toLongLong(), reply->property("retry").toInt()};
+
+    QJsonArray entries;
+    if(reply->error() == QNetworkReply::NoError)
+        entries = QJsonDocument::fromJson(reply->readAll()).object().value("entries").toArray();
+
+    if(entries.isEmpty()){
+        retry::ERROR failure = (reply->error() == QNetworkReply::NoError)? retry::ERROR::SERVFAIL : retry::classify(reply);
+        if(m_policy.retries(failure, range.retry)){
+            range.retry++;
+            QTimer::singleShot(m_policy.delay(range.retry), this, [=](){
+                log->inflight--;
+                log->retries.enqueue(range);
+                this->schedule(log);
+            });
+            return;
+        }
+        emit error(log->name, QString("get-entries %1-%2: %3").arg(range.start).arg(range.end).arg(reply->errorString()));
+        log->inflight--;
+        this->schedule(log);
+        this->finishLog(log);
+        return;
+    }
+
+    /* the logs cap their batches, the rest of the range is requested again & later ranges are smaller */
+    int count = entries.size();
+    if(count < range.end-range.start+1){
+        log->batch = qMin(log->batch, count);
+        log->retries.enqueue(Range{range.start+count, range.end, 0});
+    }
+
+    /* parsed on the worker pool, the range stays in flight until it is parsed */
+    qint64 start = range.start;
+    m_pool.start(new ct::ParseJob([=](){
+        if(m_stopped)
+            return;
+
+        QList<QPair<qint64, QStringList>> names;
+        for(int i = 0; i < entries.size(); i++)
+        {
+            QByteArray leafInput = QByteArray::fromBase64(entries.at(i).toObject().value("leaf_input").toString().toLatin1());
+            QStringList matched;
+            foreach(const QString &name, ct::entryNames(leafInput)){
+                QString hostname = m_scope.match(name);
+                if(!hostname.isNull() && !matched.contains(hostname))
+                    matched.append(hostname);
+            }
+            if(!matched.isEmpty())
+                names.append(qMakePair(start+i, matched));
+        }
+        QMetaObject::invokeMethod(this, [=](){
+            this->onParsed(log, start, entries.size(), names);
+        }, Qt::QueuedConnection);
+    }));
+}
+
+void ct::Tailer::onParsed(Log *log, qint64 start, int count, const QList<QPair<qint64, QStringList>> &names){
+    if(m_stopped)
+        return;
+
+    log->inflight--;
+    log->parsed += count;
+    m_parsed += count;
+
+    if(m_seen.size() > CT_MAX_SEEN)
+        m_seen.clear();
+
+    for(int i = 0; i < names.size(); i++){
+        foreach(const QString &name, names.at(i).second){
+            if(m_seen.contains(name))
+                continue;
+            m_seen.insert(name);
+            emit result(name, log->name, names.at(i).first);
+        }
+    }
+    emit progress(log->name, start+count, log->size);
+
+    this->schedule(log);
+    this->finishLog(log);
+}
+
+void ct::Tailer::finishLog(Log *log){
+    if(log->inflight > 0 || !log->retries.isEmpty() || log->next < log->end || log->polling)
+        return;
+
+    /* a followed log's tree head is polled for the new entries */
+    if(m_config.follow && m_config.end < 0){
+        log->polling = true;
+        QTimer::singleShot(m_config.interval, this, [=](){
+            log->polling = false;
+            if(!m_stopped)
+                this->getSth(log);
+        });
+        return;
+    }
+    log->done = true;
+    this->checkFinished();
+}
+
+void ct::Tailer::checkFinished(){
+    foreach(Log *log, m_logs){
+        if(!log->done)
+            return;
+    }
+    emit finished();
+}
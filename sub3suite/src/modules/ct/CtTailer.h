@@ -0,0 +1,122 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : certificate transparency log tailer, the entries of ct logs are downloaded straight from
+          their get-entries endpoints in parallel ranges, the certificates are parsed on a pool of
+          worker threads & the names under the monitored apex domains are streamed as they come.
+          with follow, the tree heads are polled & the new entries tailed.
+*/
+
+#ifndef CTTAILER_H
+#define CTTAILER_H
+
+#include <QUrl>
+#include <QSet>
+#include <QMap>
+#include <QQueue>
+#include <QObject>
+#include <QThreadPool>
+#include <QJsonArray>
+#include <QAtomicInt>
+#include <QNetworkReply>
+
+#include "src/utils/s3s.h"
+#include "src/utils/RetryPolicy.h"
+#include "src/utils/Hostname.h"
+
+/* entries of a get-entries request, the logs may return fewer */
+#define CT_BATCH 256
+
+/* get-entries requests in flight for each log */
+#define CT_PARALLEL 8
+
+/* entries before the tree head to start from, if no start index is given */
+#define CT_BACKLOG 10000
+
+/* milliseconds between the polls of a followed log's tree head */
+#define CT_INTERVAL 10000
+
+
+namespace ct {
+
+struct Config {
+    QList<QUrl> logs;       // the logs' base urls, eg. https://ct.googleapis.com/logs/us1/argon2026h2/
+    QStringList domains;    // the monitored apex domains, all the names if empty
+    qint64 start = -1;      // first index, the tree head minus the backlog if negative
+    qint64 end = -1;        // index after the last, the tree size if negative
+    qint64 backlog = CT_BACKLOG;
+    bool follow = false;    // keeps polling the tree heads for new entries
+    int batch = CT_BATCH;
+    int parallel = CT_PARALLEL;
+    int workers = 0;        // parsing threads, the ideal thread count if 0
+    int interval = CT_INTERVAL;
+    int timeout = 30000;    // milliseconds for each request
+};
+
+/* the subject common names & the dns alternative names of a log entry's leaf_input */
+QStringList entryNames(const QByteArray &leafInput);
+
+class Tailer : public QObject {
+    Q_OBJECT
+
+    public:
+        Tailer(const ct::Config &config, QObject *parent = nullptr);
+        ~Tailer() override;
+
+        void start();
+        void stop();
+
+        /* entries downloaded & parsed */
+        qint64 parsed() const { return m_parsed; }
+
+    signals:
+        void result(const QString &name, const QString &log, qint64 index);
+        void progress(const QString &log, qint64 index, qint64 size);
+        void error(const QString &log, const QString &message);
+        void finished();
+
+    private slots:
+        void replyFinished(QNetworkReply *reply);
+
+    private:
+        struct Range {
+            qint64 start;
+            qint64 end; // inclusive, like get-entries
+            int retry;
+        };
+        struct Log {
+            QUrl url;
+            QString name;
+            qint64 next = -1;   // the next index to request
+            qint64 end = 0;     // index after the last to request
+            qint64 size = 0;    // the tree size
+            qint64 parsed = 0;  // entries parsed so far
+            int inflight = 0;   // ranges requested or being parsed
+            int batch = CT_BATCH; // lowered to the log's own limit
+            bool polling = false;
+            bool done = false;
+            QQueue<Range> retries;
+        };
+
+        ct::Config m_config;
+        s3sNetworkAccessManager *m_manager;
+        QThreadPool m_pool;
+        retry::Policy m_policy;
+        QList<Log*> m_logs;
+        s3s_Scope m_scope; // the monitored apex domains
+        QSet<QString> m_seen;
+        QAtomicInt m_stopped;
+        qint64 m_parsed = 0;
+
+        void getSth(Log *log);
+        void getEntries(Log *log, const Range &range);
+        void schedule(Log *log);
+        void onParsed(Log *log, qint64 start, int count, const QList<QPair<qint64, QStringList>> &names);
+        void finishLog(Log *log);
+        void checkFinished();
+};
+
+}
+
+#endif // CTTAILER_H
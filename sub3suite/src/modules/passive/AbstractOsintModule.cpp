@@ -0,0 +1,22 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : the osint modules' configurations.
+*/
+
+#include "AbstractOsintModule.h"
+#include "src/utils/Config.h"
+
+
+void osint::loadConfig(ScanConfig *config, const QString &group){
+    CONFIG.beginGroup(group);
+    config->timeout = CONFIG.value(CFG_VAL_TIMEOUT, config->timeout).toInt();
+    config->maxPage = CONFIG.value(CFG_VAL_MAXPAGES, config->maxPage).toInt();
+    config->autosaveToProject = CONFIG.value(CFG_VAL_AUTOSAVE).toBool();
+    config->noDuplicates = CONFIG.value(CFG_VAL_DUPLICATES).toBool();
+    config->setTimeout = CONFIG.value(CFG_VAL_SETTIMEOUT).toBool();
+    config->retry.maxRetries = CONFIG.value(CFG_VAL_MAXRETRIES, config->retry.maxRetries).toInt();
+    config->retry.backoff = CONFIG.value(CFG_VAL_BACKOFF, config->retry.backoff).toInt();
+    CONFIG.endGroup();
+}
@@ -3,6 +3,7 @@
 
 #include <QObject>
 #include <QThread>
+#include <QTimer>
 #include <QQueue>
 #include <QStack>
 #include <QNetworkReply>
@@ -10,7 +11,10 @@
 
 #include "src/utils/s3s.h"
 #include "src/utils/utils.h"
+#include "src/utils/RetryPolicy.h"
+#include "src/utils/Hostname.h"
 #include "OsintDefinitions.h"
+#include "HtmlScanner.h"
 #include "gumbo-parser/src/gumbo.h"
 
 #include "src/items/IPItem.h"
@@ -42,6 +46,16 @@
 #define OUT_SSLCERT 6
 #define OUT_CIDR 7
 
+/* number of pages requested at once by the pagination driver */
+#define PAGING_CONCURRENCY 4
+
+/* number of batches requested at once by the batching driver */
+#define BATCH_CONCURRENCY 4
+
+/* the addresses of a batch request & the body of a batch POST request */
+#define BATCH_ATTRIBUTE static_cast<QNetworkRequest::Attribute>(QNetworkRequest::User+10)
+#define BATCH_BODY_ATTRIBUTE static_cast<QNetworkRequest::Attribute>(QNetworkRequest::User+11)
+
 
 struct ScanLog {
     QString moduleName;
@@ -59,6 +73,8 @@ struct ScanConfig {
     bool autosaveToProject = false;
     int timeout = 2000;
     int progress = 0;
+
+    retry::Policy retry;
 };
 
 struct ScanArgs {
@@ -96,9 +112,43 @@ struct ScanArgs {
     bool output_EnumASNPeers = false;
     bool output_EnumASNPrefixes = false;
 
+    /* the address patterns & the people's names of the domains, for the email permutations */
+    bool output_EmailPattern = false;
+
     /* for raw output */
     int raw_query_id = 0;
     QString raw_query_name;
+
+    /* ip enumeration in batches, for the modules with a batch endpoint */
+    bool batch = false;
+};
+
+namespace osint {
+
+/* the configurations of the modules' section, [osint] of the osint engine & the cli, [raw] of the raw engine */
+void loadConfig(ScanConfig *config, const QString &group);
+
+}
+
+enum class PAGING {
+    NONE,
+    OFFSET, // numbered pages, requested in parallel
+    INDEX,  // a known list of pages eg. index urls, requested in parallel
+    CURSOR  // the next page is obtained from a cursor in the current reply
+};
+
+struct PagingState {
+    int requested = 0;
+    int inFlight = 0;
+    uint resultsCount = 0;
+    bool active = false;
+    bool exhausted = false;
+    QString cursor;
+};
+
+struct BatchState {
+    int inFlight = 0;
+    bool active = false;
 };
 
 ///
@@ -123,32 +173,14 @@ public:
         return nullptr;
     }
 
-    /* getting document's title */
+    /* getting document's title, the text of the first <h1> */
     static QString getTitle(QNetworkReply *reply) {
         QString title;
-        QStack<GumboNode*> node_stack;
-        GumboOutput *output = gumbo_parse(reply->readAll());
-        node_stack.push(GumboMethods::getBody(output->root));
-
-        GumboNode *node;
-        while(!node_stack.isEmpty())
-        {
-            node = node_stack.pop();
-            if (node->type != GUMBO_NODE_ELEMENT)
-                continue;
-
-            if (node->v.element.tag == GUMBO_TAG_H1){
-                GumboNode* title_text = static_cast<GumboNode*>(node->v.element.children.data[0]);
-                title = QString::fromUtf8(title_text->v.text.text);
-                break;
-            }
-
-            GumboVector *children = &node->v.element.children;
-            for(unsigned int i = 0; i < children->length; i++)
-                node_stack.push(static_cast<GumboNode*>(children->data[i]));
-        }
-
-        gumbo_destroy_output(&kGumboDefaultOptions, output);
+        html::Scanner scanner({html::Rule::text("h1")}, [&](int, const QString &value){
+            title = value;
+            scanner.stop();
+        });
+        scanner.scan(reply);
         return title;
     }
 
@@ -156,30 +188,10 @@ public:
     static QSet<QString> getLinks(QNetworkReply *reply)
     {
         QSet<QString> links;
-        QStack<GumboNode*> node_stack;
-        GumboOutput *output = gumbo_parse(reply->readAll());
-        node_stack.push(GumboMethods::getBody(output->root));
-
-        GumboNode *node;
-        while(!node_stack.isEmpty())
-        {
-            node = node_stack.pop();
-            if (node->type != GUMBO_NODE_ELEMENT)
-                continue;
-
-            if (node->v.element.tag == GUMBO_TAG_A){
-                GumboAttribute* href = gumbo_get_attribute(&node->v.element.attributes, "href");
-                if (href)
-                    links.insert(QString::fromUtf8(href->value));
-                continue;
-            }
-
-            GumboVector *children = &node->v.element.children;
-            for(unsigned int i = 0; i < children->length; i++)
-                node_stack.push(static_cast<GumboNode*>(children->data[i]));
-        }
-
-        gumbo_destroy_output(&kGumboDefaultOptions, output);
+        html::Scanner scanner({html::Rule::attributeOf("a", "href")}, [&](int, const QString &value){
+            links.insert(value);
+        });
+        scanner.scan(reply);
         return links;
     }
 };
@@ -201,11 +213,10 @@ public:
     {
     }
 
-    void startScan(QThread* cThread)
+    /* called by the ScanExecutor before the module is moved to its worker thread */
+    void prepareScan()
     {
-        connect(cThread, &QThread::started, this, &AbstractOsintModule::start);
         connect(this, &AbstractOsintModule::nextTarget, this, &AbstractOsintModule::start);
-        connect(this, &AbstractOsintModule::quitThread, cThread, &QThread::quit);
 
         /* first target */
         target = args.targets.dequeue();
@@ -245,6 +256,10 @@ signals:
     void resultEnumIP(s3s_struct::IP);
     void resultEnumEmail(s3s_struct::Email);
 
+    /* a pattern eg. "{first}.{last}" & a person's name found on the domain */
+    void resultEmailPattern(QString domain, QString pattern);
+    void resultEmailName(QString domain, QString name);
+
 public slots:
     void onStop(){
         log.statusCode = 0;
@@ -276,11 +291,14 @@ protected slots:
     virtual void replyFinishedEnumNS(QNetworkReply*){} // returns NS records info
 
     virtual void replyFinishedEnumEmail(QNetworkReply*){} // returns Email info
+    virtual void replyFinishedEmailPattern(QNetworkReply*){} // returns address patterns & names
 
     virtual void replyFinishedRawNdjson(QNetworkReply *reply) // returns raw json results from ndjson
     {
-        if(reply->error())
+        if(reply->error()){
             this->onError(reply);
+            return;
+        }
         else
         {
             /* converting ndjson to json array document */
@@ -303,8 +321,10 @@ protected slots:
 
     virtual void replyFinishedRawJson(QNetworkReply *reply) // returns raw json results
     {
-        if(reply->error())
+        if(reply->error()){
             this->onError(reply);
+            return;
+        }
         else{
             s3s_struct::RAW raw;
             raw.module = log.moduleName;
@@ -319,8 +339,10 @@ protected slots:
 
     virtual void replyFinishedRawTxt(QNetworkReply *reply) // returns raw txt results
     {
-        if(reply->error())
+        if(reply->error()){
             this->onError(reply);
+            return;
+        }
         else{
             s3s_struct::RAW raw;
             raw.module = log.moduleName;
@@ -339,6 +361,41 @@ protected:
     QString target;
     s3sNetworkAccessManager *manager = nullptr;
 
+    /*
+     * pagination, a module that supports paging sets its paging mode, implements pageRequest
+     * and calls startPaging() from start(). the pages are then requested up to the maxPage
+     * limit and the paging for a target ends once a page returns no results.
+     */
+    PAGING paging = PAGING::NONE;
+    int pagingCount = 0; // number of pages available for PAGING::INDEX
+    int pagingConcurrency = PAGING_CONCURRENCY; // pages requested at once for OFFSET & INDEX
+    PagingState m_paging;
+
+    virtual QNetworkRequest pageRequest(int page, const QString &cursor){
+        Q_UNUSED(page);
+        Q_UNUSED(cursor);
+        return QNetworkRequest();
+    }
+
+    void startPaging(){
+        m_paging = PagingState();
+        m_paging.active = true;
+        m_paging.resultsCount = log.resultsCount;
+
+        this->requestPages();
+
+        /* no page to request */
+        if(m_paging.inFlight == 0){
+            m_paging.active = false;
+            this->next();
+        }
+    }
+
+    /* for PAGING::CURSOR, call from the reply handler before end() */
+    void setNextCursor(const QString &cursor){
+        m_paging.cursor = cursor;
+    }
+
     void checkAPIKey(QString key){
         if(key.isNull() || key.isEmpty()){
             log.message = "API key Required!";
@@ -350,36 +407,203 @@ protected:
     }
 
     void onError(QNetworkReply *reply) {
+        /* failures worth retrying are requested again, the reply is then handled by the same slot */
+        if(this->retryRequest(reply))
+            return;
+
         switch(reply->error()){
         case QNetworkReply::OperationCanceledError:
-            log.target = target;
             log.message = "Operation Cancelled due to Timeout";
             log.statusCode = 0;
-            log.error = true;
-            emit scanLog(log);
             break;
         default:
-            log.target = target;
             log.message = reply->errorString();
             log.statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
-            log.error = true;
-            emit scanLog(log);
             break;
         }
+        log.error = true;
+
+        /* each address of a failed batch is logged, for the re-scan of the failed targets */
+        if(m_batching.active){
+            foreach(const QString &address, this->batchTargets(reply)){
+                log.target = address;
+                emit scanLog(log);
+            }
+        }else {
+            log.target = target;
+            emit scanLog(log);
+        }
+        log.error = false;
+
+        reply->close();
+        reply->deleteLater();
+
+        if(m_batching.active)
+            this->batchFinished(reply);
+        else if(m_paging.active)
+            this->pageFinished(true);
+        else
+            this->next();
+    }
+
+    bool retryRequest(QNetworkReply *reply) {
+        /* only GET requests & batch POST requests, which keep their body, can be sent again */
+        QByteArray body = reply->request().attribute(BATCH_BODY_ATTRIBUTE).toByteArray();
+        if(reply->operation() != QNetworkAccessManager::GetOperation &&
+           !(reply->operation() == QNetworkAccessManager::PostOperation && !body.isEmpty()))
+            return false;
+
+        int retry = reply->request().attribute(RETRY_ATTRIBUTE, 0).toInt()+1;
+        if(!args.config->retry.retries(retry::classify(reply), retry))
+            return false;
+
+        QNetworkRequest request = reply->request();
+        request.setAttribute(RETRY_ATTRIBUTE, retry);
 
         reply->close();
         reply->deleteLater();
-        this->next();
+
+        QTimer::singleShot(args.config->retry.delay(retry), this, [=](){
+            if(body.isEmpty())
+                manager->get(request);
+            else
+                manager->post(request, body);
+        });
+        return true;
     }
 
     void end(QNetworkReply *reply) {
-        log.target = target;
+        log.target = m_batching.active? this->batchTargets(reply).join(",") : target;
         log.statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
         emit scanLog(log);
 
         reply->close();
         reply->deleteLater();
-        this->next();
+
+        if(m_batching.active)
+            this->batchFinished(reply);
+        else if(m_paging.active)
+            this->pageFinished(false);
+        else
+            this->next();
+    }
+
+    int maxPages() const {
+        int max = args.config->maxPage;
+        if(paging == PAGING::INDEX && pagingCount < max)
+            max = pagingCount;
+        return max;
+    }
+
+    void requestPages(){
+        int window = (paging == PAGING::CURSOR)? 1 : pagingConcurrency;
+
+        while(!m_paging.exhausted && m_paging.inFlight < window && m_paging.requested < this->maxPages())
+        {
+            QNetworkRequest request = this->pageRequest(m_paging.requested, m_paging.cursor);
+            m_paging.cursor.clear();
+
+            /* the module has no more pages */
+            if(request.url().isEmpty()){
+                m_paging.exhausted = true;
+                break;
+            }
+
+            m_paging.requested++;
+            m_paging.inFlight++;
+            manager->get(request);
+        }
+    }
+
+    void pageFinished(bool failed){
+        m_paging.inFlight--;
+
+        /* replies are handled one at a time, so the difference is this page's results */
+        uint pageResults = log.resultsCount-m_paging.resultsCount;
+        m_paging.resultsCount = log.resultsCount;
+
+        /* early termination on a failed or an empty page, index pages are independent of each other */
+        if(paging != PAGING::INDEX && (failed || pageResults == 0))
+            m_paging.exhausted = true;
+
+        /* a cursor page without a cursor for the next page is the last one */
+        if(paging == PAGING::CURSOR && m_paging.cursor.isEmpty())
+            m_paging.exhausted = true;
+
+        this->requestPages();
+
+        /* all pages of the current target are done */
+        if(m_paging.inFlight == 0){
+            m_paging.active = false;
+            this->next();
+        }
+    }
+
+    /*
+     * batching, a module with a batch endpoint for the ip enumeration sets batchSize, implements
+     * batchRequest and calls startBatching() from start() if args.batch is set. the targets are then
+     * requested batchSize at a time, batchConcurrency batches at once, and the reply handler emits
+     * a result for each address of the batch before calling end().
+     */
+    int batchSize = 0; // addresses per request, 0 for no batch endpoint
+    int batchConcurrency = BATCH_CONCURRENCY;
+    BatchState m_batching;
+
+    /* the request of a batch, a body is sent as a POST request */
+    virtual QNetworkRequest batchRequest(const QStringList &targets, QByteArray &body){
+        Q_UNUSED(targets);
+        Q_UNUSED(body);
+        return QNetworkRequest();
+    }
+
+    void startBatching(){
+        m_batching = BatchState();
+        m_batching.active = true;
+
+        /* the first target was taken by startScan */
+        args.targets.prepend(target);
+
+        this->requestBatches();
+        if(m_batching.inFlight == 0)
+            emit quitThread();
+    }
+
+    QStringList batchTargets(QNetworkReply *reply) const {
+        return reply->request().attribute(BATCH_ATTRIBUTE).toStringList();
+    }
+
+    void requestBatches(){
+        while(m_batching.inFlight < batchConcurrency && !args.targets.isEmpty())
+        {
+            QStringList batch;
+            while(batch.size() < batchSize && !args.targets.isEmpty())
+                batch.append(args.targets.dequeue());
+
+            QByteArray body;
+            QNetworkRequest request = this->batchRequest(batch, body);
+            request.setAttribute(BATCH_ATTRIBUTE, batch);
+
+            m_batching.inFlight++;
+            if(body.isEmpty())
+                manager->get(request);
+            else{
+                request.setAttribute(BATCH_BODY_ATTRIBUTE, body);
+                manager->post(request, body);
+            }
+        }
+    }
+
+    void batchFinished(QNetworkReply *reply){
+        m_batching.inFlight--;
+
+        args.config->progress += this->batchTargets(reply).size();
+        emit scanProgress(args.config->progress);
+
+        this->requestBatches();
+
+        /* all batches are done */
+        if(m_batching.inFlight == 0)
+            emit quitThread();
     }
 
     void next() {
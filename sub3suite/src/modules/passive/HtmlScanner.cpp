@@ -0,0 +1,404 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : a lightweight streaming html scanner, extracts values from html documents using
+          declarative rules at the tokenizer level without building a DOM tree.
+*/
+
+#include "HtmlScanner.h"
+
+#include <cctype>
+
+#define SCAN_CHUNK_SIZE 65536
+
+
+html::Scanner::Scanner(const QList<html::Rule> &rules, Callback callback):
+    m_rules(rules),
+    m_callback(callback)
+{
+}
+
+void html::Scanner::scan(QIODevice *device){
+    while(!m_stopped){
+        QByteArray chunk = device->read(SCAN_CHUNK_SIZE);
+        if(chunk.isEmpty())
+            break;
+        this->feed(chunk);
+    }
+    this->finish();
+}
+
+void html::Scanner::finish(){
+    if(!m_stopped)
+        this->flushText();
+
+    m_buffer.clear();
+    m_text.clear();
+    m_captures.clear();
+    m_hasOpened = false;
+    m_state = STATE::DATA;
+}
+
+void html::Scanner::feed(const QByteArray &chunk){
+    if(m_stopped)
+        return;
+
+    m_buffer.append(chunk);
+
+    const char *data = m_buffer.constData();
+    const int length = m_buffer.size();
+    int pos = 0;
+
+    while(pos < length && !m_stopped)
+    {
+        ///
+        /// skipping <script> & <style> contents up to their closing tag...
+        ///
+        if(m_state == STATE::RAWTEXT){
+            int lt = m_buffer.indexOf("</", pos);
+            if(lt == -1){
+                /* keep only what might be the start of the closing tag */
+                pos = qMax(pos, length-m_rawTag.size()-2);
+                break;
+            }
+            if(length-lt < m_rawTag.size()+3)
+                break; // need more data
+
+            if(qstrnicmp(data+lt+2, m_rawTag.constData(), static_cast<uint>(m_rawTag.size())) != 0){
+                pos = lt+2;
+                continue;
+            }
+            int gt = m_buffer.indexOf('>', lt+2);
+            if(gt == -1)
+                break; // need more data
+
+            pos = gt+1;
+            m_state = STATE::DATA;
+            continue;
+        }
+
+        ///
+        /// text up to the next markup...
+        ///
+        int lt = m_buffer.indexOf('<', pos);
+        if(lt == -1){
+            if(!m_captures.isEmpty())
+                m_text.append(data+pos, length-pos);
+            pos = length;
+            break;
+        }
+        if(!m_captures.isEmpty())
+            m_text.append(data+pos, lt-pos);
+        pos = lt;
+
+        if(lt+1 >= length)
+            break; // need more data
+
+        const char next = data[lt+1];
+
+        /* comments, doctype & processing instructions */
+        if(next == '!' || next == '?'){
+            if(length-lt < 4)
+                break; // need more data
+
+            int end;
+            if(qstrncmp(data+lt, "<!--", 4) == 0){
+                end = m_buffer.indexOf("-->", lt+4);
+                if(end == -1)
+                    break; // need more data
+                pos = end+3;
+            }
+            else{
+                end = m_buffer.indexOf('>', lt+2);
+                if(end == -1)
+                    break; // need more data
+                pos = end+1;
+            }
+            continue;
+        }
+
+        /* a '<' that does not open a tag is just text */
+        if(next != '/' && !std::isalpha(static_cast<unsigned char>(next))){
+            if(!m_captures.isEmpty())
+                m_text.append('<');
+            pos = lt+1;
+            continue;
+        }
+
+        /* find the end of the tag, '>' inside quoted attribute values is not an end */
+        int gt = -1;
+        char quote = 0;
+        char previous = 0;
+        for(int i = lt+1; i < length; i++){
+            const char c = data[i];
+            if(quote){
+                if(c == quote)
+                    quote = 0;
+            }
+            else if((c == '"' || c == '\'') && previous == '=')
+                quote = c;
+            else if(c == '>'){
+                gt = i;
+                break;
+            }
+            if(!std::isspace(static_cast<unsigned char>(c)))
+                previous = c;
+        }
+        if(gt == -1)
+            break; // need more data
+
+        Tag tag = parseTag(data+lt+1, data+gt);
+        pos = gt+1;
+
+        this->flushText();
+        this->onTag(tag);
+
+        if(!tag.closing && !tag.selfClosing && (tag.name == "script" || tag.name == "style")){
+            m_rawTag = tag.name;
+            m_state = STATE::RAWTEXT;
+        }
+    }
+
+    /* keep the unprocessed tail for the next chunk */
+    m_buffer.remove(0, pos);
+}
+
+void html::Scanner::onTag(const Tag &tag){
+    if(tag.name.isEmpty())
+        return;
+
+    ///
+    /// closing tags end the captures they belong to...
+    ///
+    if(tag.closing){
+        for(int i = m_captures.size()-1; i >= 0; i--){
+            Capture &capture = m_captures[i];
+            if(capture.depth == 0){
+                if(capture.tag == tag.name)
+                    m_captures.removeAt(i);
+            }
+            else
+                capture.depth--;
+        }
+        m_hasOpened = false;
+        return;
+    }
+
+    const bool opens = !tag.selfClosing && !isVoidElement(tag.name);
+
+    /* an unclosed sibling eg. <td>a<td>b implicitly closes the previous one */
+    for(int i = m_captures.size()-1; i >= 0; i--){
+        Capture &capture = m_captures[i];
+        if(capture.depth == 0 && capture.tag == tag.name)
+            m_captures.removeAt(i);
+        else if(opens)
+            capture.depth++;
+    }
+
+    ///
+    /// matching the rules...
+    ///
+    for(int i = 0; i < m_rules.size() && !m_stopped; i++)
+    {
+        const html::Rule &rule = m_rules.at(i);
+        if(!this->matches(rule, tag))
+            continue;
+
+        if(rule.extract == EXTRACT::ATTRIBUTE){
+            for(int j = 0; j < tag.attributes.size(); j++){
+                if(tag.attributes.at(j).first == rule.attribute){
+                    m_callback(i, decodeEntities(tag.attributes.at(j).second));
+                    break;
+                }
+            }
+        }
+        else if(opens){
+            Capture capture;
+            capture.rule = i;
+            capture.tag = tag.name;
+            capture.depth = 0;
+            m_captures.append(capture);
+        }
+    }
+
+    m_opened = tag;
+    m_hasOpened = opens;
+}
+
+void html::Scanner::flushText(){
+    if(m_text.isEmpty())
+        return;
+
+    QString text = decodeEntities(m_text).trimmed();
+    m_text.clear();
+    if(text.isEmpty())
+        return;
+
+    /* only text directly inside a captured element is extracted */
+    foreach(const Capture &capture, m_captures){
+        if(m_stopped)
+            break;
+        if(capture.depth == 0)
+            m_callback(capture.rule, text);
+    }
+}
+
+bool html::Scanner::matches(const html::Rule &rule, const Tag &tag) const {
+    if(rule.tag != tag.name)
+        return false;
+
+    if(rule.noAttributes && !tag.attributes.isEmpty())
+        return false;
+
+    if(!rule.matchAttribute.isEmpty() && !hasAttribute(tag, rule.matchAttribute, rule.matchValue))
+        return false;
+
+    /* a first child has no tag between it & its parent's opening tag */
+    if(!rule.firstChildOf.isEmpty()){
+        if(!m_hasOpened || m_opened.name != rule.firstChildOf)
+            return false;
+        if(!rule.parentAttribute.isEmpty() && !hasAttribute(m_opened, rule.parentAttribute, rule.parentValue))
+            return false;
+    }
+
+    return true;
+}
+
+bool html::Scanner::hasAttribute(const Tag &tag, const QByteArray &attribute, const QByteArray &value){
+    for(int i = 0; i < tag.attributes.size(); i++){
+        if(tag.attributes.at(i).first != attribute)
+            continue;
+        return value.isEmpty() || tag.attributes.at(i).second == value;
+    }
+    return false;
+}
+
+html::Scanner::Tag html::Scanner::parseTag(const char *begin, const char *end){
+    Tag tag;
+    const char *p = begin;
+
+    if(p < end && *p == '/'){
+        tag.closing = true;
+        p++;
+    }
+
+    /* tag name */
+    const char *name = p;
+    while(p < end && !std::isspace(static_cast<unsigned char>(*p)) && *p != '/')
+        p++;
+    tag.name = QByteArray(name, static_cast<int>(p-name)).toLower();
+
+    if(end > begin && *(end-1) == '/')
+        tag.selfClosing = true;
+
+    if(tag.closing)
+        return tag;
+
+    /* attributes */
+    while(p < end)
+    {
+        while(p < end && (std::isspace(static_cast<unsigned char>(*p)) || *p == '/'))
+            p++;
+        if(p >= end)
+            break;
+
+        const char *attributeName = p;
+        while(p < end && !std::isspace(static_cast<unsigned char>(*p)) && *p != '=' && *p != '/')
+            p++;
+        QByteArray attribute = QByteArray(attributeName, static_cast<int>(p-attributeName)).toLower();
+
+        while(p < end && std::isspace(static_cast<unsigned char>(*p)))
+            p++;
+
+        QByteArray value;
+        if(p < end && *p == '='){
+            p++;
+            while(p < end && std::isspace(static_cast<unsigned char>(*p)))
+                p++;
+
+            if(p < end && (*p == '"' || *p == '\'')){
+                const char quote = *p++;
+                const char *valueBegin = p;
+                while(p < end && *p != quote)
+                    p++;
+                value = QByteArray(valueBegin, static_cast<int>(p-valueBegin));
+                if(p < end)
+                    p++;
+            }
+            else{
+                const char *valueBegin = p;
+                while(p < end && !std::isspace(static_cast<unsigned char>(*p)))
+                    p++;
+                value = QByteArray(valueBegin, static_cast<int>(p-valueBegin));
+            }
+        }
+
+        if(!attribute.isEmpty())
+            tag.attributes.append(qMakePair(attribute, value));
+    }
+
+    return tag;
+}
+
+bool html::Scanner::isVoidElement(const QByteArray &name){
+    static const QList<QByteArray> voidElements = {"area", "base", "br", "col", "embed", "hr", "img",
+                                                   "input", "link", "meta", "param", "source", "track", "wbr"};
+    return voidElements.contains(name);
+}
+
+QString html::Scanner::decodeEntities(const QByteArray &value){
+    if(value.indexOf('&') == -1)
+        return QString::fromUtf8(value);
+
+    QString decoded;
+    int pos = 0;
+    while(pos < value.size())
+    {
+        int amp = value.indexOf('&', pos);
+        if(amp == -1){
+            decoded += QString::fromUtf8(value.mid(pos));
+            break;
+        }
+        decoded += QString::fromUtf8(value.mid(pos, amp-pos));
+
+        int semicolon = value.indexOf(';', amp);
+        if(semicolon == -1 || semicolon-amp > 10){
+            decoded += '&';
+            pos = amp+1;
+            continue;
+        }
+
+        QByteArray entity = value.mid(amp+1, semicolon-amp-1);
+        if(entity == "amp")
+            decoded += '&';
+        else if(entity == "lt")
+            decoded += '<';
+        else if(entity == "gt")
+            decoded += '>';
+        else if(entity == "quot")
+            decoded += '"';
+        else if(entity == "apos")
+            decoded += '\'';
+        else if(entity == "nbsp")
+            decoded += ' ';
+        else if(entity.startsWith('#')){
+            bool ok = false;
+            uint code;
+            if(entity.startsWith("#x") || entity.startsWith("#X"))
+                code = entity.mid(2).toUInt(&ok, 16);
+            else
+                code = entity.mid(1).toUInt(&ok, 10);
+
+            if(ok && code)
+                decoded += QString::fromUcs4(&code, 1);
+            else
+                decoded += QString::fromUtf8(value.mid(amp, semicolon-amp+1));
+        }
+        else
+            decoded += QString::fromUtf8(value.mid(amp, semicolon-amp+1));
+
+        pos = semicolon+1;
+    }
+    return decoded;
+}
@@ -0,0 +1,126 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : a lightweight streaming html scanner, extracts values from html documents using
+          declarative rules at the tokenizer level without building a DOM tree.
+*/
+
+#ifndef HTMLSCANNER_H
+#define HTMLSCANNER_H
+
+#include <functional>
+
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QByteArray>
+#include <QIODevice>
+
+
+namespace html {
+
+enum class EXTRACT {
+    TEXT,       // text runs directly inside the element
+    ATTRIBUTE   // value of an attribute of the element
+};
+
+///
+/// an extraction rule eg. "text of every <td> with no attributes" or "href of every <a>"
+///
+struct Rule {
+    QByteArray tag;                     // lowercase tag name
+    EXTRACT extract = EXTRACT::TEXT;
+    QByteArray attribute;               // attribute to extract for EXTRACT::ATTRIBUTE
+
+    bool noAttributes = false;          // element must have no attributes
+    QByteArray matchAttribute;          // element must have this attribute...
+    QByteArray matchValue;              // ...with this exact value (empty to only require presence)
+
+    QByteArray firstChildOf;            // element must be the first child element of this tag...
+    QByteArray parentAttribute;         // ...having this attribute...
+    QByteArray parentValue;             // ...with this exact value (empty to only require presence)
+
+    static Rule text(const QByteArray &tag){
+        Rule rule;
+        rule.tag = tag;
+        rule.extract = EXTRACT::TEXT;
+        return rule;
+    }
+    static Rule attributeOf(const QByteArray &tag, const QByteArray &attribute){
+        Rule rule;
+        rule.tag = tag;
+        rule.extract = EXTRACT::ATTRIBUTE;
+        rule.attribute = attribute;
+        return rule;
+    }
+};
+
+///
+/// \brief The Scanner class, feed it the document in chunks as they arrive, each value
+/// matched by a rule is passed to the callback together with the index of the rule.
+///
+class Scanner {
+    public:
+        typedef std::function<void(int rule, const QString &value)> Callback;
+
+        Scanner(const QList<html::Rule> &rules, Callback callback);
+
+        /* scan the next chunk of the document */
+        void feed(const QByteArray &chunk);
+        /* flush what is left at the end of the document */
+        void finish();
+        /* scan the whole device in fixed size chunks */
+        void scan(QIODevice *device);
+
+        /* stop scanning, the rest of the document is ignored */
+        void stop(){ m_stopped = true; }
+        bool isStopped() const { return m_stopped; }
+
+    private:
+        enum class STATE {
+            DATA,       // text between tags
+            RAWTEXT     // content of <script> & <style>, skipped
+        };
+
+        struct Tag {
+            QByteArray name;
+            QList<QPair<QByteArray, QByteArray>> attributes;
+            bool closing = false;
+            bool selfClosing = false;
+        };
+
+        struct Capture {   // an open element whose text is being extracted
+            int rule;
+            QByteArray tag;
+            int depth;
+        };
+
+        QList<html::Rule> m_rules;
+        Callback m_callback;
+        QList<Capture> m_captures;
+
+        STATE m_state = STATE::DATA;
+        QByteArray m_rawTag;
+        QByteArray m_buffer;
+        QByteArray m_text;
+        bool m_stopped = false;
+
+        /* the last tag if it opened an element with no tag after it, the parent of a first child */
+        Tag m_opened;
+        bool m_hasOpened = false;
+
+        void onTag(const Tag &tag);
+        void flushText();
+        bool matches(const html::Rule &rule, const Tag &tag) const;
+
+        static bool hasAttribute(const Tag &tag, const QByteArray &attribute, const QByteArray &value);
+
+        static Tag parseTag(const char *begin, const char *end);
+        static bool isVoidElement(const QByteArray &name);
+        static QString decodeEntities(const QByteArray &value);
+};
+
+}
+
+#endif // HTMLSCANNER_H
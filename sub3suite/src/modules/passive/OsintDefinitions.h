@@ -88,6 +88,7 @@
 #define OSINT_MODULE_APNIC "Apnic"
 #define OSINT_MODULE_ARIN "Arin"
 #define OSINT_MODULE_RIPE "Ripe"
+#define OSINT_MODULE_RDAP "RDAP"
 
 /* mal */
 #define OSINT_MODULE_ABUSEIPDB "AbuseIPDB"
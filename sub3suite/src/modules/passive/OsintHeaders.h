@@ -64,6 +64,7 @@
 #include "src/modules/passive/iana/Afrinic.h"
 #include "src/modules/passive/iana/Ripe.h"
 #include "src/modules/passive/iana/Apnic.h"
+#include "src/modules/passive/iana/Rdap.h"
 ///
 /// cert...
 ///
@@ -3,21 +3,60 @@
 #include <QJsonObject>
 #include <QJsonArray>
 
+/* number of index collections queried at once */
+#define INDEX_CONCURRENCY 8
+
+/* hours before the cached collinfo.json is requested again */
+#define INDEX_CACHE_HOURS 24
+
+QMutex CommonCrawl::m_indexCacheMutex;
+QStringList CommonCrawl::m_indexCache;
+QDateTime CommonCrawl::m_indexCacheTime;
+
 /*
- * for now only use the first index url to obtain crawled urls...
+ * each index collection is a page, the collections are listed most recent first so the max
+ * pages is the number of most recent collections queried, the collections are queried in
+ * parallel and their results merged...
  */
 CommonCrawl::CommonCrawl(ScanArgs args): AbstractOsintModule(args)
 {
     manager = new s3sNetworkAccessManager(this, args.config->timeout, args.config->setTimeout);
     log.moduleName = OSINT_MODULE_COMMONCRAWL;
+    paging = PAGING::INDEX;
+    pagingConcurrency = INDEX_CONCURRENCY;
+
+    /* make new manager connection depending on user output */
+    if(args.output_URL)
+        connect(manager, &s3sNetworkAccessManager::finished, this, &CommonCrawl::replyFinishedUrl);
+    if(args.output_Hostname)
+        connect(manager, &s3sNetworkAccessManager::finished, this, &CommonCrawl::replyFinishedSubdomain);
 }
 CommonCrawl::~CommonCrawl(){
     delete manager;
 }
 
 void CommonCrawl::start(){
+    m_results.clear();
+
+    /* the index urls are obtained once for all targets */
+    if(urlList.isEmpty()){
+        QMutexLocker locker(&m_indexCacheMutex);
+        if(!m_indexCache.isEmpty() && m_indexCacheTime.secsTo(QDateTime::currentDateTime()) < INDEX_CACHE_HOURS*3600)
+            urlList = m_indexCache;
+    }
+
+    if(!urlList.isEmpty()){
+        pagingCount = urlList.size();
+        this->startPaging();
+        return;
+    }
+
+    /* disconnect the results connections while obtaining the index urls */
+    disconnect(manager, &s3sNetworkAccessManager::finished, this, &CommonCrawl::replyFinishedUrl);
+    disconnect(manager, &s3sNetworkAccessManager::finished, this, &CommonCrawl::replyFinishedSubdomain);
+
     /* first temporary connection to index */
-    connect(manager, &s3sNetworkAccessManager::finished, this, &CommonCrawl::replyFinishedIndex);
+    connect(manager, &s3sNetworkAccessManager::finished, this, &CommonCrawl::replyFinishedIndex, Qt::UniqueConnection);
 
     /* request to obtain the index url */
     QNetworkRequest request;
@@ -26,6 +65,28 @@ void CommonCrawl::start(){
     manager->get(request);
 }
 
+QNetworkRequest CommonCrawl::pageRequest(int page, const QString &cursor){
+    Q_UNUSED(cursor);
+
+    QNetworkRequest request;
+    QUrl url;
+
+    if(args.input_Domain){
+        if(args.output_Hostname){
+            url.setUrl(urlList.at(page)+"?url=*."+target+"&output=json&fl=url");
+            request.setUrl(url);
+            return request;
+        }
+        if(args.output_URL){
+            url.setUrl(urlList.at(page)+"?url="+target+"/*&output=json&fl=url");
+            request.setUrl(url);
+            return request;
+        }
+    }
+
+    return request;
+}
+
 void CommonCrawl::replyFinishedIndex(QNetworkReply *reply){
     if(reply->error()){
         this->onError(reply);
@@ -40,46 +101,29 @@ void CommonCrawl::replyFinishedIndex(QNetworkReply *reply){
         QJsonObject aaa = value.toObject();
         urlList.append(aaa["cdx-api"].toString());
     }
+    pagingCount = urlList.size();
+
+    /* cache the index urls for the other scans */
+    if(!urlList.isEmpty()){
+        QMutexLocker locker(&m_indexCacheMutex);
+        m_indexCache = urlList;
+        m_indexCacheTime = QDateTime::currentDateTime();
+    }
 
     /* disconnect the first manager connection */
     disconnect(manager, &s3sNetworkAccessManager::finished, this, &CommonCrawl::replyFinishedIndex);
 
-    /* make new manager connection depending on user output */
+    /* reconnect the results connections depending on user output */
     if(args.output_URL)
-        connect(manager, &s3sNetworkAccessManager::finished, this, &CommonCrawl::replyFinishedUrl);
+        connect(manager, &s3sNetworkAccessManager::finished, this, &CommonCrawl::replyFinishedUrl, Qt::UniqueConnection);
     if(args.output_Hostname)
-        connect(manager, &s3sNetworkAccessManager::finished, this, &CommonCrawl::replyFinishedSubdomain);
+        connect(manager, &s3sNetworkAccessManager::finished, this, &CommonCrawl::replyFinishedSubdomain, Qt::UniqueConnection);
 
-    QNetworkRequest request;
-    QUrl url;
-
-    if(args.input_Domain){
-        if(args.output_Hostname){
-            url.setUrl(urlList.at(0)+"?url=*."+target+"&output=json&fl=url");
-            request.setUrl(url);
-            manager->get(request);
-        }
-        if(args.output_URL){
-            url.setUrl(urlList.at(0)+"?url="+target+"/*&output=json&fl=url");
-            request.setUrl(url);
-            manager->get(request);
-        }
-    }
+    reply->close();
+    reply->deleteLater();
 
-    if(args.input_Domain){
-        if(args.output_Hostname){
-            url.setUrl(urlList.at(0)+"?url="+target+"&output=json&fl=url");
-            request.setUrl(url);
-            manager->get(request);
-        }
-        if(args.output_URL){
-            url.setUrl(urlList.at(0)+"?url="+target+"/*&output=json&fl=url");
-            request.setUrl(url);
-            manager->get(request);
-        }
-    }
-
-    this->end(reply);
+    /* query the index urls */
+    this->startPaging();
 }
 
 void CommonCrawl::replyFinishedUrl(QNetworkReply *reply){
@@ -93,9 +137,20 @@ void CommonCrawl::replyFinishedUrl(QNetworkReply *reply){
 
     foreach(const QString &value, urlList)
     {
+        /* {"url": "..."} */
+        if(value.length() < 12)
+            continue;
+
         QString urlValue = value;
         urlValue.chop(2);
-        emit resultURL(urlValue.remove(0, 9));
+        urlValue.remove(0, 9);
+
+        /* merging results from all the indexes */
+        if(m_results.contains(urlValue))
+            continue;
+        m_results.insert(urlValue);
+
+        emit resultURL(urlValue);
         log.resultsCount++;
     }
 
@@ -113,6 +168,10 @@ void CommonCrawl::replyFinishedSubdomain(QNetworkReply *reply){
 
     foreach(const QString &value, urlList)
     {
+        /* {"url": "..."} */
+        if(value.length() < 12)
+            continue;
+
         /* obtaining the url */
         QString urlValue = value;
         urlValue.chop(2);
@@ -123,10 +182,14 @@ void CommonCrawl::replyFinishedSubdomain(QNetworkReply *reply){
         domainUrl.remove("https://");
         domainUrl = domainUrl.split("/").at(0);
 
+        /* merging results from all the indexes */
+        if(m_results.contains(domainUrl))
+            continue;
+        m_results.insert(domainUrl);
+
         /*  emiting subdomain... */
         emit resultSubdomain(domainUrl);
         log.resultsCount++;
-
     }
 
     this->end(reply);
@@ -3,6 +3,9 @@
 
 #include "../AbstractOsintModule.h"
 
+#include <QMutex>
+#include <QDateTime>
+
 
 namespace ModuleInfo {
 struct CommonCrawl{
@@ -36,8 +39,17 @@ class CommonCrawl: public AbstractOsintModule{
         void replyFinishedUrl(QNetworkReply *reply) override;
         void replyFinishedSubdomain(QNetworkReply *reply) override;
 
+    protected:
+        QNetworkRequest pageRequest(int page, const QString &cursor) override;
+
     private:
         QStringList urlList;
+        QSet<QString> m_results; // merged results of all the indexes for the current target
+
+        /* the index urls from collinfo.json, shared by all scans */
+        static QMutex m_indexCacheMutex;
+        static QStringList m_indexCache;
+        static QDateTime m_indexCacheTime;
 };
 
 #endif // COMMONCRAWL_H
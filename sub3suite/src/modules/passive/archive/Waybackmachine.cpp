@@ -116,21 +116,13 @@ void Waybackmachine::replyFinishedSubdomain(QNetworkReply *reply){
     mainArray.removeFirst();
     foreach(const QJsonValue &value, mainArray)
     {
-        /* getting url */
-        QString domainUrl = value.toArray()[0].toString();
-
-        /* extracting subdomain from url...*/
-        domainUrl.remove("http://");
-        domainUrl.remove("https://");
-        domainUrl = domainUrl.split("/").at(0);
-
-        /* remove port number if available */
-        if(domainUrl.contains(":")){
-            domainUrl = domainUrl.split(":").at(0);
-        }
+        /* extracting the subdomain from the url, without its scheme, port & path */
+        QString subdomain = s3s_Hostname::normalize(value.toArray()[0].toString());
+        if(subdomain.isNull())
+            continue;
 
         /*  emiting subdomain... */
-        emit resultSubdomain(domainUrl);
+        emit resultSubdomain(subdomain);
         log.resultsCount++;
     }
 
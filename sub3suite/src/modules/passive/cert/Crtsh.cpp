@@ -15,8 +15,18 @@ Crtsh::Crtsh(ScanArgs args): AbstractOsintModule(args)
         connect(manager, &s3sNetworkAccessManager::finished, this, &Crtsh::replyFinishedEnumSSL);
     if(args.output_Hostname)
         connect(manager, &s3sNetworkAccessManager::finished, this, &Crtsh::replyFinishedSubdomain);
+
+    /* the certificate names are the text of the <td> elements with no attributes... */
+    html::Rule names = html::Rule::text("td");
+    names.noAttributes = true;
+
+    m_names = new html::Scanner({names}, [this](int, const QString &domain){
+        emit resultSubdomain(domain);
+        log.resultsCount++;
+    });
 }
 Crtsh::~Crtsh(){
+    delete m_names;
     delete manager;
 }
 
@@ -24,50 +34,38 @@ void Crtsh::start(){
     QNetworkRequest request;
     QUrl url("https://crt.sh/?q="+target);
     request.setUrl(url);
-    manager->get(request);
+    QNetworkReply *reply = manager->get(request);
+
+    /* a domain's page can be megabytes, its names are emitted as the chunks arrive */
+    if(args.input_Domain && args.output_Hostname){
+        m_namesReply = reply;
+        connect(reply, &QNetworkReply::readyRead, this, [this, reply](){
+            if(reply != m_namesReply || reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 200)
+                return;
+            m_names->feed(reply->readAll());
+        });
+    }
 }
 
 void Crtsh::replyFinishedSubdomain(QNetworkReply *reply){
     if(reply->error()){
+        if(reply == m_namesReply){
+            m_names->finish();
+            m_namesReply = nullptr;
+        }
         this->onError(reply);
         return;
     }
 
     if(args.input_Domain){
-        /* a stack for storing the GumboNodes for parsing by backtracking... */
-        QStack<GumboNode*> m_nodes;
-        /* getting the body node... */
-        GumboOutput *output = gumbo_parse(reply->readAll());
-        m_nodes.push(GumboMethods::getBody(output->root));
-
-        /* loop to parse and obtain subdomains from the body node... */
-        while(!m_nodes.isEmpty()){
-            GumboNode *node = m_nodes.pop();
-
-            if(node->type != GUMBO_NODE_ELEMENT)
-                continue;
-
-            if (node->v.element.tag == GUMBO_TAG_TD && node->v.element.attributes.length == 0) {
-                  GumboVector tdChildren = node->v.element.children;
-                  for(unsigned int i = 0; i < tdChildren.length; i++)
-                  {
-                      GumboNode *td = static_cast<GumboNode*>(tdChildren.data[i]);
-                      if(td->type == GUMBO_NODE_TEXT){
-                          QString domain = QString::fromUtf8(td->v.text.text);
-                          emit resultSubdomain(domain);
-                          log.resultsCount++;
-                      }
-                  }
-                  continue;
-            }
-
-            /* push the children m_nodes to the m_nodes Stack and continue the loop */
-            GumboVector *children = &node->v.element.children;
-            for(unsigned int i = 0; i < children->length; i++)
-                m_nodes.push(static_cast<GumboNode*>(children->data[i]));
+        /* the rest of a streamed page, a retried page is scanned whole */
+        if(reply == m_namesReply){
+            m_names->feed(reply->readAll());
+            m_names->finish();
+            m_namesReply = nullptr;
         }
-        /* finilizing... */
-        gumbo_destroy_output(&kGumboDefaultOptions, output);
+        else
+            m_names->scan(reply);
     }
 
     if(args.input_SSL)
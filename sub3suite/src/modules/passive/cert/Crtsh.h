@@ -35,6 +35,10 @@ class Crtsh: public AbstractOsintModule{
     private:
         void m_getCertId(QNetworkReply *reply);
         bool m_queryToGetId = true;
+
+        /* the certificate names of a domain's page, scanned as the page arrives */
+        html::Scanner *m_names = nullptr;
+        QNetworkReply *m_namesReply = nullptr;
 };
 
 
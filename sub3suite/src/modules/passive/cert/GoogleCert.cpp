@@ -3,16 +3,15 @@
 #include <QJsonArray>
 #include <QJsonObject>
 
-#define MAX_PAGE 10
-
 /*
- * for now it goes request after request, later implement concurrent requests...
+ * pages are obtained by a token from the previous page, so they go request after request...
  * fix and cert output...
  */
 GoogleCert::GoogleCert(ScanArgs args): AbstractOsintModule(args)
 {
     manager = new s3sNetworkAccessManager(this, args.config->timeout, args.config->setTimeout);
     log.moduleName = OSINT_MODULE_GOOGLECERT;
+    paging = PAGING::CURSOR;
 
     if(args.output_Raw)
         connect(manager, &s3sNetworkAccessManager::finished, this, &GoogleCert::replyFinishedRawJson);
@@ -26,12 +25,30 @@ GoogleCert::~GoogleCert(){
 }
 
 void GoogleCert::start(){
+    if(args.output_Raw){
+        manager->get(this->pageRequest(0, QString()));
+        return;
+    }
+
+    this->startPaging();
+}
+
+QNetworkRequest GoogleCert::pageRequest(int page, const QString &cursor){
     QNetworkRequest request;
-    QUrl url("https://www.google.com/transparencyreport/api/v3/httpsreport/ct/certsearch?include_subdomains=true&domain="+target);
-    request.setUrl(url);
     request.setRawHeader("Connection", "close");
-    request.setRawHeader("Referer", "https://transparencyreport.google.com/https/certificates");
-    manager->get(request);
+
+    /* first page */
+    if(page == 0){
+        QUrl url("https://www.google.com/transparencyreport/api/v3/httpsreport/ct/certsearch?include_subdomains=true&domain="+target);
+        request.setUrl(url);
+        request.setRawHeader("Referer", "https://transparencyreport.google.com/https/certificates");
+        return request;
+    }
+
+    /* next pages from the token */
+    QUrl url("https://www.google.com/transparencyreport/api/v3/httpsreport/ct/certsearch/page?p="+cursor);
+    request.setUrl(url);
+    return request;
 }
 
 void GoogleCert::replyFinishedSubdomain(QNetworkReply *reply){
@@ -96,12 +113,7 @@ void GoogleCert::m_getToken(QJsonArray tokenArray){
     int currentPage = tokenArray[3].toInt();
     int lastPage = tokenArray[4].toInt();
 
-    /* send another requests for nextpage */
-    if((lastPage > currentPage) && (currentPage < MAX_PAGE)){
-        QNetworkRequest request;
-        QUrl url("https://www.google.com/transparencyreport/api/v3/httpsreport/ct/certsearch/page?p="+token);
-        request.setUrl(url);
-        request.setRawHeader("Connection", "close");
-        manager->get(request);
-    }
+    /* the paging requests the next page, up to the max pages */
+    if(lastPage > currentPage)
+        this->setNextCursor(token);
 }
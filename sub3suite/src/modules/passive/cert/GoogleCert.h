@@ -31,6 +31,9 @@ class GoogleCert: public AbstractOsintModule{
         void replyFinishedSubdomain(QNetworkReply *reply) override;
         void replyFinishedSSL(QNetworkReply *reply) override;
 
+    protected:
+        QNetworkRequest pageRequest(int page, const QString &cursor) override;
+
     private:
         void m_getToken(QJsonArray tokenArray);
 };
@@ -1,5 +1,8 @@
 #include "EmailFormat.h"
 #include "src/utils/Config.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
 
 #define BEST_FORMATS 0
 #define FORMATS 1
@@ -13,6 +16,8 @@ EmailFormat::EmailFormat(ScanArgs args): AbstractOsintModule(args)
 
     if(args.output_Raw)
         connect(manager, &s3sNetworkAccessManager::finished, this, &EmailFormat::replyFinishedRawJson);
+    if(args.output_EmailPattern)
+        connect(manager, &s3sNetworkAccessManager::finished, this, &EmailFormat::replyFinishedEmailPattern);
 
     /* getting api-key */
     m_key = APIKEY.value(OSINT_MODULE_EMAILFORMAT).toString();
@@ -43,5 +48,47 @@ void EmailFormat::start(){
         }
         request.setUrl(url);
         manager->get(request);
+        return;
     }
+
+    if(args.input_Domain && args.output_EmailPattern){
+        url.setUrl("https://www.email-format.com/api/v2/get_formats?domain="+target);
+        request.setAttribute(QNetworkRequest::User, FORMATS);
+        request.setUrl(url);
+        manager->get(request);
+    }
+}
+
+/* the api's format eg. "first_initial.last_name" in the placeholders of the permutations eg. "{f}.{last}" */
+static QString permutationPattern(QString format){
+    format.replace("first_name", "{first}");
+    format.replace("last_name", "{last}");
+    format.replace("middle_name", "{middle}");
+    format.replace("first_initial", "{f}");
+    format.replace("last_initial", "{l}");
+    format.replace("middle_initial", "{m}");
+    return format;
+}
+
+void EmailFormat::replyFinishedEmailPattern(QNetworkReply *reply){
+    if(reply->error()){
+        this->onError(reply);
+        return;
+    }
+
+    QJsonDocument document = QJsonDocument::fromJson(reply->readAll());
+
+    if(reply->property(REQUEST_TYPE).toInt() == FORMATS)
+    {
+        /* the formats of the domain, the most used first */
+        foreach(const QJsonValue &value, document["formats"].toArray()){
+            QString pattern = permutationPattern(value["format"].toString());
+            if(pattern.contains('{')){
+                emit resultEmailPattern(target, pattern);
+                log.resultsCount++;
+            }
+        }
+    }
+
+    this->end(reply);
 }
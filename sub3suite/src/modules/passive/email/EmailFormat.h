@@ -33,6 +33,7 @@ class EmailFormat: public AbstractOsintModule{
 
     public slots:
         void start() override;
+        void replyFinishedEmailPattern(QNetworkReply *) override;
 
     private:
         QString m_key;
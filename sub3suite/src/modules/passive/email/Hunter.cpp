@@ -20,6 +20,8 @@ Hunter::Hunter(ScanArgs args): AbstractOsintModule(args)
         connect(manager, &s3sNetworkAccessManager::finished, this, &Hunter::replyFinishedRawJson);
     if(args.output_Email)
         connect(manager, &s3sNetworkAccessManager::finished, this, &Hunter::replyFinishedEmail);
+    if(args.output_EmailPattern)
+        connect(manager, &s3sNetworkAccessManager::finished, this, &Hunter::replyFinishedEmailPattern);
 
     /* getting api-key */
     m_key = APIKEY.value(OSINT_MODULE_HUNTER).toString();
@@ -61,7 +63,7 @@ void Hunter::start(){
     }
 
     if(args.input_Domain){
-        if(args.output_Email){
+        if(args.output_Email || args.output_EmailPattern){
             url.setUrl("https://api.hunter.io/v2/domain-search?domain="+target+"&api_key="+m_key);
             request.setAttribute(QNetworkRequest::User, DOMAIN_SEARCH);
             request.setUrl(url);
@@ -90,3 +92,32 @@ void Hunter::replyFinishedEmail(QNetworkReply *reply){
 
     this->end(reply);
 }
+
+void Hunter::replyFinishedEmailPattern(QNetworkReply *reply){
+    if(reply->error()){
+        this->onError(reply);
+        return;
+    }
+
+    QJsonDocument document = QJsonDocument::fromJson(reply->readAll());
+    QJsonObject data = document["data"].toObject();
+
+    if(reply->property(REQUEST_TYPE).toInt() == DOMAIN_SEARCH)
+    {
+        /* the domain's pattern is in the placeholders of the permutations eg. "{first}.{last}" */
+        QString pattern = data["pattern"].toString();
+        if(!pattern.isEmpty()){
+            emit resultEmailPattern(target, pattern);
+            log.resultsCount++;
+        }
+        foreach(const QJsonValue &value, data["emails"].toArray()){
+            QString name = (value["first_name"].toString()+" "+value["last_name"].toString()).trimmed();
+            if(!name.isEmpty()){
+                emit resultEmailName(target, name);
+                log.resultsCount++;
+            }
+        }
+    }
+
+    this->end(reply);
+}
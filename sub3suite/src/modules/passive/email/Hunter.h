@@ -38,6 +38,7 @@ class Hunter: public AbstractOsintModule{
     public slots:
         void start() override;
         void replyFinishedEmail(QNetworkReply *) override;
+        void replyFinishedEmailPattern(QNetworkReply *) override;
 
     private:
         QString m_key;
@@ -0,0 +1,520 @@
+#include "Rdap.h"
+#include "src/utils/Config.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QRegularExpression>
+
+#define RAW_ASN 0
+#define RAW_DOMAIN 1
+#define RAW_IP 2
+#define RAW_WHOIS 3
+
+/* request types */
+#define BOOTSTRAP 0
+#define RECORD 1
+
+/* the referrals followed from the first registry's record */
+#define RDAP_MAX_REFERRALS 2
+#define WHOIS_MAX_REFERRALS 3
+
+#define WHOIS_IANA "whois.iana.org"
+#define WHOIS_PORT 43
+
+/* the referrals followed to get to a request */
+#define REFERRAL_ATTRIBUTE static_cast<QNetworkRequest::Attribute>(QNetworkRequest::User+12)
+
+/* properties of a whois lookup */
+#define WHOIS_SERVER "whois_server"
+#define WHOIS_DEPTH "whois_depth"
+#define WHOIS_DONE "whois_done"
+
+
+///
+/// parsing the records...
+///
+
+/* the emails & the address of the entities of a record, the entities can have entities of their own */
+static void entityContacts(const QJsonArray &entities, QSet<QString> &emails, QSet<QString> &abuse, QString &address){
+    foreach(const QJsonValue &value, entities)
+    {
+        QJsonObject entity = value.toObject();
+        QVariantList roles = entity["roles"].toArray().toVariantList();
+        bool isAbuse = roles.contains("abuse");
+
+        foreach(const QJsonValue &property, entity["vcardArray"].toArray().at(1).toArray())
+        {
+            QJsonArray field = property.toArray();
+            QString name = field.at(0).toString();
+
+            if(name == "email"){
+                if(isAbuse)
+                    abuse.insert(field.at(3).toString());
+                else
+                    emails.insert(field.at(3).toString());
+            }
+            if(name == "adr" && address.isEmpty() && roles.contains("registrant"))
+                address = field.at(1).toObject()["label"].toString().replace('\n', ", ");
+        }
+        entityContacts(entity["entities"].toArray(), emails, abuse, address);
+    }
+}
+
+static QString eventDate(const QJsonObject &record, const QString &action){
+    foreach(const QJsonValue &value, record["events"].toArray()){
+        if(value.toObject()["eventAction"].toString() == action)
+            return value.toObject()["eventDate"].toString();
+    }
+    return QString();
+}
+
+static QString description(const QJsonObject &record){
+    QStringList lines;
+    foreach(const QJsonValue &value, record["remarks"].toArray()){
+        foreach(const QJsonValue &line, value.toObject()["description"].toArray())
+            lines.append(line.toString());
+    }
+    return lines.join(" ");
+}
+
+/* the cidrs of a network's record, rdap's cidr0 extension */
+static QStringList networkCidrs(const QJsonObject &record){
+    QStringList cidrs;
+    foreach(const QJsonValue &value, record["cidr0_cidrs"].toArray()){
+        QJsonObject cidr = value.toObject();
+        QString prefix = cidr.contains("v4prefix")? cidr["v4prefix"].toString() : cidr["v6prefix"].toString();
+        cidrs.append(prefix+"/"+QString::number(cidr["length"].toInt()));
+    }
+    return cidrs;
+}
+
+/* the referral of a domain's registry to the registrar's rdap server */
+static QUrl referral(const QJsonObject &record, const QUrl &url){
+    foreach(const QJsonValue &value, record["links"].toArray())
+    {
+        QJsonObject link = value.toObject();
+        if(link["rel"].toString() != "related" || link["type"].toString() != "application/rdap+json")
+            continue;
+
+        QUrl href(link["href"].toString());
+        if(href.isValid() && href.host() != url.host())
+            return href;
+    }
+    return QUrl();
+}
+
+///
+/// the module...
+///
+
+Rdap::Rdap(ScanArgs args): AbstractOsintModule(args)
+{
+    manager = new s3sNetworkAccessManager(this, args.config->timeout, args.config->setTimeout);
+    log.moduleName = OSINT_MODULE_RDAP;
+
+    m_interval = CONFIG.value(CFG_VAL_RDAP_INTERVAL, RDAP_INTERVAL).toInt();
+    s3s_RdapRegistry::instance().setCacheSize(CONFIG.value(CFG_VAL_RDAP_CACHE, RDAP_CACHE_SIZE).toInt());
+
+    connect(manager, &s3sNetworkAccessManager::finished, this, &Rdap::replyFinished);
+}
+Rdap::~Rdap(){
+    delete manager;
+}
+
+void Rdap::start(){
+    if(args.output_Raw){
+        switch (args.raw_query_id) {
+        case RAW_ASN:
+            m_type = rdap::TYPE::ASN;
+            break;
+        case RAW_DOMAIN:
+            m_type = rdap::TYPE::DOMAIN;
+            break;
+        case RAW_IP:
+            m_type = rdap::TYPE::IP;
+            break;
+        case RAW_WHOIS:
+            this->whois(WHOIS_IANA, 0);
+            return;
+        }
+    }
+    else if(args.input_ASN || args.output_EnumASN)
+        m_type = rdap::TYPE::ASN;
+    else if(args.input_Domain)
+        m_type = rdap::TYPE::DOMAIN;
+    else
+        m_type = rdap::TYPE::IP;
+
+    /* the record of an earlier lookup */
+    QJsonObject record;
+    if(s3s_RdapRegistry::instance().cached(this->cacheKey(), record)){
+        this->onRecord(record);
+        this->done();
+        return;
+    }
+
+    /* the registries of the lookup's type, loaded once for all the modules */
+    if(!s3s_RdapRegistry::instance().isBootstrapped(m_type)){
+        m_bootstrapFailed = false;
+        foreach(const QUrl &url, s3s_RdapRegistry::bootstrapUrls(m_type)){
+            QNetworkRequest request(url);
+            request.setAttribute(QNetworkRequest::User, BOOTSTRAP);
+            m_bootstrapping++;
+            manager->get(request);
+        }
+        return;
+    }
+
+    QString server = s3s_RdapRegistry::instance().server(m_type, target);
+    if(server.isEmpty()){
+        /* a registry without an rdap server */
+        this->whois(WHOIS_IANA, 0);
+        return;
+    }
+
+    QString number = target;
+    switch(m_type){
+    case rdap::TYPE::ASN:
+        if(number.startsWith("as", Qt::CaseInsensitive))
+            number.remove(0, 2);
+        this->request(QUrl(server+"autnum/"+number), 0);
+        break;
+    case rdap::TYPE::IP:
+        this->request(QUrl(server+"ip/"+target), 0);
+        break;
+    case rdap::TYPE::DOMAIN:
+        this->request(QUrl(server+"domain/"+target), 0);
+        break;
+    }
+}
+
+QString Rdap::cacheKey() const {
+    return QString::number(static_cast<int>(m_type))+":"+target.trimmed().toLower();
+}
+
+void Rdap::request(const QUrl &url, int depth){
+    QNetworkRequest request(url);
+    request.setRawHeader("Accept", "application/rdap+json");
+    request.setAttribute(QNetworkRequest::User, RECORD);
+    request.setAttribute(REFERRAL_ATTRIBUTE, depth);
+    request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+
+    /* the requests to a registry are spaced by the interval, across all the modules' threads */
+    QTimer::singleShot(s3s_RdapRegistry::instance().reserve(url.host(), m_interval), this, [=](){
+        manager->get(request);
+    });
+}
+
+void Rdap::replyFinished(QNetworkReply *reply){
+    if(reply->property(REQUEST_TYPE).toInt() == BOOTSTRAP)
+    {
+        if(reply->error()){
+            if(this->retryRequest(reply))
+                return;
+            log.message = "IANA bootstrap: "+reply->errorString();
+            m_bootstrapFailed = true;
+        }
+        else
+            s3s_RdapRegistry::instance().loadBootstrap(m_type, reply->request().url(), reply->readAll());
+
+        reply->close();
+        reply->deleteLater();
+
+        /* the lookup goes on once all the bootstrap registries are in */
+        if(--m_bootstrapping)
+            return;
+        if(!m_bootstrapFailed){
+            this->start();
+            return;
+        }
+        log.statusCode = 0;
+        log.error = true;
+        log.target = target;
+        emit scanLog(log);
+        log.error = false;
+        this->next();
+        return;
+    }
+
+    int depth = reply->request().attribute(REFERRAL_ATTRIBUTE).toInt();
+    if(reply->error()){
+        /* a failed referral, the registry's record is used */
+        if(depth && !this->retryRequest(reply)){
+            if(!args.output_Raw)
+                this->onRecord(m_referrer);
+            s3s_RdapRegistry::instance().cache(this->cacheKey(), m_referrer);
+            m_referrer = QJsonObject();
+            this->end(reply);
+            return;
+        }
+        if(!depth)
+            this->onError(reply);
+        return;
+    }
+
+    QJsonObject record = QJsonDocument::fromJson(reply->readAll()).object();
+
+    /* each record of the referrals for the raw results */
+    if(args.output_Raw){
+        s3s_struct::RAW raw;
+        raw.module = log.moduleName;
+        raw.query_option = args.raw_query_name;
+        raw.target = target;
+        raw.results = QJsonDocument(record).toJson();
+        emit resultRawJSON(raw);
+    }
+
+    /* the registry refers to the registrar's record */
+    QUrl url = referral(record, reply->url());
+    if(url.isValid() && depth < RDAP_MAX_REFERRALS){
+        m_referrer = record;
+        reply->close();
+        reply->deleteLater();
+        this->request(url, depth+1);
+        return;
+    }
+
+    if(!args.output_Raw)
+        this->onRecord(record);
+    s3s_RdapRegistry::instance().cache(this->cacheKey(), record);
+    m_referrer = QJsonObject();
+
+    this->end(reply);
+}
+
+void Rdap::onRecord(const QJsonObject &record){
+    QSet<QString> emails, abuse;
+    QString address;
+    entityContacts(record["entities"].toArray(), emails, abuse, address);
+
+    if(args.output_Raw){
+        /* a cached record */
+        s3s_struct::RAW raw;
+        raw.module = log.moduleName;
+        raw.query_option = args.raw_query_name;
+        raw.target = target;
+        raw.results = QJsonDocument(record).toJson();
+        emit resultRawJSON(raw);
+        return;
+    }
+
+    if(args.output_EnumASN){
+        s3s_struct::ASN asn;
+        asn.asn = target;
+        asn.info_asn = QString::number(record["startAutnum"].toInt());
+        asn.info_name = record["name"].toString();
+        asn.info_description = description(record);
+        asn.info_country = record["country"].toString();
+        asn.info_ownerAddress = address;
+        asn.emailcontacts = emails;
+        asn.abusecontacts = abuse;
+        asn.rir_name = record["port43"].toString();
+        asn.rir_country = record["country"].toString();
+        asn.rir_dateallocated = eventDate(record, "registration");
+        emit resultEnumASN(asn);
+        return;
+    }
+
+    if(args.output_EnumCIDR){
+        s3s_struct::CIDR cidr;
+        cidr.cidr = target;
+        QStringList cidrs = networkCidrs(record);
+        cidr.info_prefix = cidrs.isEmpty()? record["startAddress"].toString()+" - "+record["endAddress"].toString() : cidrs.first();
+        cidr.info_ip = record["startAddress"].toString();
+        cidr.info_cidr = cidrs.isEmpty()? QString() : cidrs.first().section('/', 1);
+        cidr.info_name = record["name"].toString();
+        cidr.info_description = description(record);
+        cidr.info_country = record["country"].toString();
+        cidr.info_ownerAddress = address;
+        cidr.emailcontacts = emails;
+        cidr.abusecontacts = abuse;
+        cidr.rir_name = record["port43"].toString();
+        cidr.rir_country = record["country"].toString();
+        cidr.rir_prefix = record["handle"].toString();
+        cidr.rir_dateallocated = eventDate(record, "registration");
+        foreach(const QJsonValue &value, record["arin_originas0_originautnums"].toArray())
+            cidr.asns.insert(QString::number(value.toInt()));
+        emit resultEnumCIDR(cidr);
+        return;
+    }
+
+    if(args.output_Email){
+        foreach(const QString &email, emails+abuse){
+            emit resultEmail(email);
+            log.resultsCount++;
+        }
+    }
+
+    if(args.output_CIDR){
+        foreach(const QString &cidr, networkCidrs(record)){
+            emit resultCIDR(cidr);
+            log.resultsCount++;
+        }
+    }
+}
+
+void Rdap::done(){
+    log.target = target;
+    log.statusCode = 0;
+    emit scanLog(log);
+    this->next();
+}
+
+///
+/// whois...
+///
+
+void Rdap::whois(const QString &server, int depth){
+    QTcpSocket *socket = new QTcpSocket(this);
+    socket->setProperty(WHOIS_SERVER, server);
+    socket->setProperty(WHOIS_DEPTH, depth);
+
+    connect(socket, &QTcpSocket::connected, this, [=](){
+        socket->write(this->whoisQuery(server).toUtf8()+"\r\n");
+    });
+    /* the server closes the connection after the record */
+    connect(socket, &QTcpSocket::disconnected, this, [=](){
+        this->whoisFinished(socket, false);
+    });
+    connect(socket, static_cast<void (QAbstractSocket::*)(QAbstractSocket::SocketError)>(&QAbstractSocket::error), this,
+            [=](QAbstractSocket::SocketError error){
+        if(error != QAbstractSocket::RemoteHostClosedError)
+            this->whoisFinished(socket, true);
+    });
+
+    QTimer::singleShot(s3s_RdapRegistry::instance().reserve(server, m_interval), socket, [=](){
+        socket->connectToHost(server, WHOIS_PORT);
+        if(args.config->setTimeout)
+            QTimer::singleShot(args.config->timeout, socket, [=](){
+                this->whoisFinished(socket, true);
+                socket->abort();
+            });
+    });
+}
+
+void Rdap::whoisFinished(QTcpSocket *socket, bool failed){
+    if(socket->property(WHOIS_DONE).toBool())
+        return;
+    socket->setProperty(WHOIS_DONE, true);
+    socket->deleteLater();
+
+    QString server = socket->property(WHOIS_SERVER).toString();
+    int depth = socket->property(WHOIS_DEPTH).toInt();
+
+    if(failed){
+        /* a failed referral, the referring server's record is used */
+        if(depth && !m_whois.isEmpty()){
+            if(!args.output_Raw)
+                this->onRecord(this->whoisRecord(server, m_whois));
+            m_whois.clear();
+            this->done();
+            return;
+        }
+        log.message = server+": "+socket->errorString();
+        log.statusCode = 0;
+        log.error = true;
+        log.target = target;
+        emit scanLog(log);
+        log.error = false;
+        this->next();
+        return;
+    }
+
+    QString text = QString::fromUtf8(socket->readAll());
+    if(args.output_Raw){
+        s3s_struct::RAW raw;
+        raw.module = log.moduleName;
+        raw.query_option = args.raw_query_name;
+        raw.target = target+" ("+server+")";
+        raw.results = text.toUtf8();
+        emit resultRawTXT(raw);
+    }
+
+    /* the referral to the registry's or the registrar's whois server */
+    static const QRegularExpression refer("^\\s*(refer|whois|ReferralServer|Registrar WHOIS Server):\\s*(\\S+)",
+                                          QRegularExpression::MultilineOption | QRegularExpression::CaseInsensitiveOption);
+    QRegularExpressionMatch match = refer.match(text);
+    if(match.hasMatch() && depth < WHOIS_MAX_REFERRALS){
+        QString referral = match.captured(2).toLower();
+        if(referral.startsWith("whois://"))
+            referral.remove(0, 8);
+        referral = referral.section(':', 0, 0).section('/', 0, 0);
+
+        if(!referral.isEmpty() && referral != server && !match.captured(2).startsWith("rwhois", Qt::CaseInsensitive)){
+            m_whois = text;
+            this->whois(referral, depth+1);
+            return;
+        }
+    }
+    m_whois.clear();
+
+    if(!args.output_Raw){
+        QJsonObject record = this->whoisRecord(server, text);
+        this->onRecord(record);
+        s3s_RdapRegistry::instance().cache(this->cacheKey(), record);
+    }
+    this->done();
+}
+
+QString Rdap::whoisQuery(const QString &server) const {
+    QString query = target.trimmed();
+    bool asn = args.output_Raw? query.startsWith("as", Qt::CaseInsensitive) : m_type == rdap::TYPE::ASN;
+    if(asn && query.startsWith("as", Qt::CaseInsensitive))
+        query.remove(0, 2);
+
+    /* arin's flags for an asn & a network */
+    if(server == "whois.arin.net")
+        return asn? "a "+query : "n "+query.section('/', 0, 0);
+    if(asn)
+        return "AS"+query;
+    if(server == WHOIS_IANA)
+        return query.section('/', 0, 0);
+    return query;
+}
+
+/* a whois record as an rdap record, for the same parsing & cache */
+QJsonObject Rdap::whoisRecord(const QString &server, const QString &text) const {
+    static const QRegularExpression field("^\\s*([A-Za-z][A-Za-z0-9 -]*):\\s*(.+)$", QRegularExpression::MultilineOption);
+    static const QRegularExpression email("[A-Za-z0-9._%+-]+@[A-Za-z0-9.-]+\\.[A-Za-z]{2,}");
+
+    QJsonObject record;
+    record["port43"] = server;
+
+    QJsonArray contacts, abuseContacts;
+    QRegularExpressionMatchIterator i = field.globalMatch(text);
+    while(i.hasNext())
+    {
+        QRegularExpressionMatch match = i.next();
+        QString key = match.captured(1).trimmed().toLower();
+        QString value = match.captured(2).trimmed();
+
+        if((key == "orgname" || key == "org-name" || key == "netname" || key == "as-name" || key == "asname" ||
+            key == "registrant organization") && !record.contains("name"))
+            record["name"] = value;
+        else if(key == "country" || key == "registrant country")
+            record["country"] = value.toUpper();
+        else if(key == "cidr" && !record.contains("cidr0_cidrs")){
+            QJsonArray cidrs;
+            foreach(const QString &cidr, value.split(',', QString::SkipEmptyParts)){
+                QString prefix = cidr.trimmed().section('/', 0, 0);
+                cidrs.append(QJsonObject{{prefix.contains(':')? "v6prefix" : "v4prefix", prefix},
+                                         {"length", cidr.section('/', 1).toInt()}});
+            }
+            record["cidr0_cidrs"] = cidrs;
+        }
+
+        QRegularExpressionMatch address = email.match(value);
+        if(address.hasMatch()){
+            QJsonArray vcard{"email", QJsonObject(), "text", address.captured(0)};
+            if(key.contains("abuse"))
+                abuseContacts.append(vcard);
+            else
+                contacts.append(vcard);
+        }
+    }
+
+    record["entities"] = QJsonArray{QJsonObject{{"roles", QJsonArray{"registrant"}}, {"vcardArray", QJsonArray{"vcard", contacts}}},
+                                    QJsonObject{{"roles", QJsonArray{"abuse"}}, {"vcardArray", QJsonArray{"vcard", abuseContacts}}}};
+    return record;
+}
@@ -0,0 +1,71 @@
+#ifndef RDAP_MODULE_H
+#define RDAP_MODULE_H
+
+#include "../AbstractOsintModule.h"
+#include "src/utils/RdapRegistry.h"
+
+#include <QTcpSocket>
+
+
+namespace ModuleInfo {
+struct Rdap{
+    QString name = OSINT_MODULE_RDAP;
+    QString url = "https://www.iana.org/";
+    QString url_apiDoc = "https://data.iana.org/rdap/";
+    QString summary = "Registration data of asns, networks & domains from the RDAP servers of their registries, "
+                      "selected from the IANA bootstrap registries. The registries without an RDAP server are "
+                      "queried on their WHOIS servers, following the referrals from whois.iana.org";
+
+    QMap<QString, QStringList> flags = {{"asn",
+                                         {PLACEHOLDERTEXT_ASN, "RDAP record of an asn"}},
+                                        {"domain",
+                                         {PLACEHOLDERTEXT_DOMAIN, "RDAP record of a domain, from its registrar if the registry refers to one"}},
+                                        {"ip",
+                                         {PLACEHOLDERTEXT_IP_OR_CIDR, "RDAP record of the network of an ip-address or a cidr"}},
+                                        {"whois",
+                                         {PLACEHOLDERTEXT_DOMAIN_OR_IP, "WHOIS records of a domain, an ip-address or an asn e.g. AS12345, "
+                                                                        "from whois.iana.org to the referred WHOIS servers"}}};
+
+    QMap<int, QList<int>> input_output = {{IN_IP,
+                                           {OUT_CIDR, OUT_EMAIL}},
+                                          {IN_CIDR,
+                                           {OUT_CIDR, OUT_EMAIL}},
+                                          {IN_ASN,
+                                           {OUT_EMAIL}},
+                                          {IN_DOMAIN,
+                                           {OUT_EMAIL}}};
+};
+}
+
+class Rdap: public AbstractOsintModule{
+
+    public:
+        explicit Rdap(ScanArgs args);
+        ~Rdap() override;
+
+    public slots:
+        void start() override;
+
+        void replyFinished(QNetworkReply *reply);
+
+    private:
+        rdap::TYPE m_type = rdap::TYPE::IP;
+        QJsonObject m_referrer; // the registry's record while its referral is looked up
+        QString m_whois;        // the whois record while its referral is looked up
+        int m_bootstrapping = 0;
+        bool m_bootstrapFailed = false;
+        int m_interval;
+
+        QString cacheKey() const;
+        void request(const QUrl &url, int depth);
+        void onRecord(const QJsonObject &record);
+        void done();
+
+        /* whois on port 43 */
+        void whois(const QString &server, int depth);
+        void whoisFinished(QTcpSocket *socket, bool failed);
+        QString whoisQuery(const QString &server) const;
+        QJsonObject whoisRecord(const QString &server, const QString &text) const;
+};
+
+#endif // RDAP_MODULE_H
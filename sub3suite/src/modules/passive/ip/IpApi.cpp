@@ -8,6 +8,9 @@
 #define ORIGIN_LOOKUP 1
 #define STANDARD_LOOKUP 2
 
+/* addresses per bulk lookup */
+#define BULK_SIZE 50
+
 /*
  * 1,000 per month for free-user...
  */
@@ -23,6 +26,8 @@ IpApi::IpApi(ScanArgs args): AbstractOsintModule(args)
 
     /* get api key */
     m_key = APIKEY.value(OSINT_MODULE_IPAPI).toString();
+
+    batchSize = BULK_SIZE;
 }
 IpApi::~IpApi(){
     delete manager;
@@ -52,12 +57,21 @@ void IpApi::start(){
     }
 
     if(args.output_EnumIP){
+        if(args.batch){
+            this->startBatching();
+            return;
+        }
         url.setUrl("http://api.ipapi.com/api/"+target+"?access_key="+m_key);
         request.setUrl(url);
         manager->get(request);
     }
 }
 
+QNetworkRequest IpApi::batchRequest(const QStringList &targets, QByteArray &body){
+    Q_UNUSED(body);
+    return QNetworkRequest(QUrl("http://api.ipapi.com/api/"+targets.join(",")+"?access_key="+m_key));
+}
+
 void IpApi::replyFinishedEnumIP(QNetworkReply *reply){
     if(reply->error()){
         this->onError(reply);
@@ -65,10 +79,23 @@ void IpApi::replyFinishedEnumIP(QNetworkReply *reply){
     }
 
     QJsonDocument document = QJsonDocument::fromJson(reply->readAll());
-    QJsonObject mainObj = document.object();
 
+    /* a bulk lookup returns an array of the addresses' objects */
+    if(m_batching.active){
+        foreach(const QJsonValue &value, document.array()){
+            QJsonObject mainObj = value.toObject();
+            emit resultEnumIP(this->enumIP(mainObj["ip"].toString(), mainObj));
+        }
+    }
+    else
+        emit resultEnumIP(this->enumIP(target, document.object()));
+
+    this->end(reply);
+}
+
+s3s_struct::IP IpApi::enumIP(const QString &address, const QJsonObject &mainObj){
     s3s_struct::IP ip;
-    ip.ip = target;
+    ip.ip = address;
 
     ip.info_ip = mainObj["ip"].toString();
     ip.info_type = mainObj["type"].toString();
@@ -95,8 +122,5 @@ void IpApi::replyFinishedEnumIP(QNetworkReply *reply){
     QJsonObject security = mainObj["security"].toObject();
     ip.privacyInfo_proxy = security["is_proxy"].toBool();
     ip.privacyInfo_tor = security["is_tor"].toBool();
-
-    emit resultEnumIP(ip);
-
-    this->end(reply);
+    return ip;
 }
@@ -2,6 +2,7 @@
 #define IPAPI_H
 
 #include "../AbstractOsintModule.h"
+#include <QJsonObject>
 
 
 namespace ModuleInfo {
@@ -35,6 +36,8 @@ class IpApi: public AbstractOsintModule{
 
     private:
         QString m_key;
+        QNetworkRequest batchRequest(const QStringList &targets, QByteArray &body) override;
+        s3s_struct::IP enumIP(const QString &address, const QJsonObject &mainObj);
 };
 
 #endif // IPAPI_H
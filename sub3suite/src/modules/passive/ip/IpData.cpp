@@ -1,5 +1,7 @@
 #include "IpData.h"
 #include "src/utils/Config.h"
+#include <QJsonDocument>
+#include <QJsonArray>
 
 #define ASN_API 0
 #define ASN_DATA 1
@@ -8,6 +10,9 @@
 #define PROXY_TOR_THREAT_DETECTION 4
 #define TIMEZONE_DETECTION 5
 
+/* addresses per bulk lookup */
+#define BULK_SIZE 100
+
 /*
  * 1,500/day for free-tier...
  */
@@ -29,6 +34,8 @@ IpData::IpData(ScanArgs args): AbstractOsintModule(args)
 
     /* get api key */
     m_key = APIKEY.value(OSINT_MODULE_IPDATA).toString();
+
+    batchSize = BULK_SIZE;
 }
 IpData::~IpData(){
     delete manager;
@@ -67,6 +74,10 @@ void IpData::start(){
     }
 
     if(args.output_EnumIP){
+        if(args.batch){
+            this->startBatching();
+            return;
+        }
         url.setUrl("https://api.ipdata.co/"+target+"?api-key="+m_key);
         request.setUrl(url);
         manager->get(request);
@@ -81,6 +92,14 @@ void IpData::start(){
     }
 }
 
+QNetworkRequest IpData::batchRequest(const QStringList &targets, QByteArray &body){
+    body = QJsonDocument(QJsonArray::fromStringList(targets)).toJson(QJsonDocument::Compact);
+
+    QNetworkRequest request(QUrl("https://api.ipdata.co/bulk?api-key="+m_key));
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    return request;
+}
+
 void IpData::replyFinishedEnumIP(QNetworkReply *reply){
     if(reply->error()){
         this->onError(reply);
@@ -88,10 +107,23 @@ void IpData::replyFinishedEnumIP(QNetworkReply *reply){
     }
 
     QJsonDocument document = QJsonDocument::fromJson(reply->readAll());
-    QJsonObject mainObj = document.object();
 
+    /* a bulk lookup returns an array of the addresses' objects */
+    if(m_batching.active){
+        foreach(const QJsonValue &value, document.array()){
+            QJsonObject mainObj = value.toObject();
+            emit resultEnumIP(this->enumIP(mainObj["ip"].toString(), mainObj));
+        }
+    }
+    else
+        emit resultEnumIP(this->enumIP(target, document.object()));
+
+    this->end(reply);
+}
+
+s3s_struct::IP IpData::enumIP(const QString &address, const QJsonObject &mainObj){
     s3s_struct::IP ip;
-    ip.ip = target;
+    ip.ip = address;
 
     ip.info_ip = mainObj["ip"].toString();
     ip.info_region = mainObj["region"].toString();
@@ -119,9 +151,7 @@ void IpData::replyFinishedEnumIP(QNetworkReply *reply){
     ip.privacyInfo_attacker = privacy["is_known_attacker"].toBool();
     ip.privacyInfo_abuser = privacy["is_known_abuser"].toBool();
     ip.privacyInfo_threat = privacy["is_threat"].toBool();
-    emit resultEnumIP(ip);
-
-    end(reply);
+    return ip;
 }
 
 void IpData::replyFinishedEnumASN(QNetworkReply *reply){
@@ -2,6 +2,7 @@
 #define IPDATA_H
 
 #include "../AbstractOsintModule.h"
+#include <QJsonObject>
 
 
 namespace ModuleInfo {
@@ -44,6 +45,8 @@ class IpData: public AbstractOsintModule{
 
     private:
         QString m_key;
+        QNetworkRequest batchRequest(const QStringList &targets, QByteArray &body) override;
+        s3s_struct::IP enumIP(const QString &address, const QJsonObject &mainObj);
 };
 
 #endif // IPDATA_H
@@ -9,6 +9,9 @@
 #define IPINFO 2
 #define RANGES 3
 
+/* addresses per batch request */
+#define BATCH_SIZE 1000
+
 /*
  * 50,000 requests per month...
  * has different plans and different response for each plan...
@@ -27,6 +30,8 @@ IpInfo::IpInfo(ScanArgs args): AbstractOsintModule(args)
 
     /* getting the api key */
     m_key = APIKEY.value(OSINT_MODULE_IPINFO).toString();
+
+    batchSize = BATCH_SIZE;
 }
 IpInfo::~IpInfo(){
     delete manager;
@@ -60,6 +65,10 @@ void IpInfo::start(){
     }
 
     if(args.output_EnumIP){
+        if(args.batch){
+            this->startBatching();
+            return;
+        }
         url.setUrl("https://ipinfo.io/"+target+"/json?token="+m_key);
         request.setUrl(url);
         manager->get(request);
@@ -98,6 +107,15 @@ void IpInfo::replyFinishedSubdomain(QNetworkReply *reply){
     this->end(reply);
 }
 
+QNetworkRequest IpInfo::batchRequest(const QStringList &targets, QByteArray &body){
+    body = QJsonDocument(QJsonArray::fromStringList(targets)).toJson(QJsonDocument::Compact);
+
+    QNetworkRequest request(QUrl("https://ipinfo.io/batch?token="+m_key));
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    request.setRawHeader("Accept", "application/json");
+    return request;
+}
+
 void IpInfo::replyFinishedEnumIP(QNetworkReply *reply){
     if(reply->error()){
         this->onError(reply);
@@ -107,8 +125,20 @@ void IpInfo::replyFinishedEnumIP(QNetworkReply *reply){
     QJsonDocument document = QJsonDocument::fromJson(reply->readAll());
     QJsonObject mainObj = document.object();
 
+    /* a batch returns an object with each address' object */
+    if(m_batching.active){
+        foreach(const QString &address, mainObj.keys())
+            emit resultEnumIP(this->enumIP(address, mainObj[address].toObject()));
+    }
+    else
+        emit resultEnumIP(this->enumIP(target, mainObj));
+
+    this->end(reply);
+}
+
+s3s_struct::IP IpInfo::enumIP(const QString &address, const QJsonObject &mainObj){
     s3s_struct::IP ip;
-    ip.ip = target;
+    ip.ip = address;
 
     ip.info_ip = mainObj["ip"].toString();
     ip.info_city = mainObj["city"].toString();
@@ -132,7 +162,5 @@ void IpInfo::replyFinishedEnumIP(QNetworkReply *reply){
     QJsonObject privacy = mainObj["privacy"].toObject();
     ip.privacyInfo_proxy = privacy["proxy"].toBool();
     ip.privacyInfo_tor = privacy["tor"].toBool();
-    emit resultEnumIP(ip);
-
-    end(reply);
+    return ip;
 }
@@ -2,6 +2,7 @@
 #define IPINFO_H
 
 #include "../AbstractOsintModule.h"
+#include <QJsonObject>
 
 
 namespace ModuleInfo {
@@ -39,6 +40,8 @@ class IpInfo: public AbstractOsintModule{
 
     private:
         QString m_key;
+        QNetworkRequest batchRequest(const QStringList &targets, QByteArray &body) override;
+        s3s_struct::IP enumIP(const QString &address, const QJsonObject &mainObj);
 };
 
 #endif // IPINFO_H
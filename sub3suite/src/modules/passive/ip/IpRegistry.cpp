@@ -1,10 +1,15 @@
 #include "IpRegistry.h"
 #include "src/utils/Config.h"
+#include <QJsonDocument>
+#include <QJsonArray>
 
 #define BATCH_IP_LOOKUP 0
 #define ORIGIN_IP_LOOKUP 1
 #define SINGLE_IP_LOOKUP 2
 
+/* addresses per batch lookup, up to 1024 are allowed but they are sent in the url */
+#define BATCH_SIZE 256
+
 /*
  * starts with 100,000 free lookups...
  */
@@ -20,6 +25,8 @@ IpRegistry::IpRegistry(ScanArgs args): AbstractOsintModule(args)
 
     /* get api key */
     m_key = APIKEY.value(OSINT_MODULE_IPREGISTRY).toString();
+
+    batchSize = BATCH_SIZE;
 }
 IpRegistry::~IpRegistry(){
     delete manager;
@@ -49,6 +56,10 @@ void IpRegistry::start(){
     }
 
     if(args.output_EnumIP) {
+        if(args.batch){
+            this->startBatching();
+            return;
+        }
         url.setUrl("https://api.ipregistry.co/"+target+"?key="+m_key);
         request.setUrl(url);
         manager->get(request);
@@ -56,6 +67,11 @@ void IpRegistry::start(){
     }
 }
 
+QNetworkRequest IpRegistry::batchRequest(const QStringList &targets, QByteArray &body){
+    Q_UNUSED(body);
+    return QNetworkRequest(QUrl("https://api.ipregistry.co/"+targets.join(",")+"?key="+m_key));
+}
+
 void IpRegistry::replyFinishedEnumIP(QNetworkReply *reply){
     if(reply->error()){
         this->onError(reply);
@@ -65,8 +81,23 @@ void IpRegistry::replyFinishedEnumIP(QNetworkReply *reply){
     QJsonDocument document = QJsonDocument::fromJson(reply->readAll());
     QJsonObject mainObj = document.object();
 
+    /* a batch lookup returns the addresses' objects in results, a failed lookup has no ip */
+    if(m_batching.active){
+        foreach(const QJsonValue &value, mainObj["results"].toArray()){
+            QJsonObject result = value.toObject();
+            if(result.contains("ip"))
+                emit resultEnumIP(this->enumIP(result["ip"].toString(), result));
+        }
+    }
+    else
+        emit resultEnumIP(this->enumIP(target, mainObj));
+
+    this->end(reply);
+}
+
+s3s_struct::IP IpRegistry::enumIP(const QString &address, const QJsonObject &mainObj){
     s3s_struct::IP ip;
-    ip.ip = target;
+    ip.ip = address;
 
     ip.info_ip = mainObj["ip"].toString();
 
@@ -103,8 +134,5 @@ void IpRegistry::replyFinishedEnumIP(QNetworkReply *reply){
     ip.privacyInfo_attacker = privacy["is_known_attacker"].toBool();
     ip.privacyInfo_abuser = privacy["is_known_abuser"].toBool();
     ip.privacyInfo_threat = privacy["is_threat"].toBool();
-
-    emit resultEnumIP(ip);
-
-    end(reply);
+    return ip;
 }
@@ -2,6 +2,7 @@
 #define IPREGISTRY_H
 
 #include "../AbstractOsintModule.h"
+#include <QJsonObject>
 
 
 namespace ModuleInfo {
@@ -36,6 +37,8 @@ class IpRegistry: public AbstractOsintModule{
 
     private:
         QString m_key;
+        QNetworkRequest batchRequest(const QStringList &targets, QByteArray &body) override;
+        s3s_struct::IP enumIP(const QString &address, const QJsonObject &mainObj);
 };
 
 #endif // IPREGISTRY_H
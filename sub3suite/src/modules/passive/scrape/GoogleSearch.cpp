@@ -1,5 +1,4 @@
 #include "GoogleSearch.h"
-#include <QStack>
 
 
 /*
@@ -9,6 +8,7 @@ GoogleSearch::GoogleSearch(ScanArgs args): AbstractOsintModule(args)
 {
     manager = new s3sNetworkAccessManager(this, args.config->timeout, args.config->setTimeout);
     log.moduleName = OSINT_MODULE_GOOGLESEARCH;
+    paging = PAGING::OFFSET;
 
     if(args.output_Hostname)
         connect(manager, &s3sNetworkAccessManager::finished, this, &GoogleSearch::replyFinishedSubdomain);
@@ -20,43 +20,50 @@ GoogleSearch::~GoogleSearch(){
 }
 
 void GoogleSearch::start(){
+    this->startPaging();
+}
+
+QNetworkRequest GoogleSearch::pageRequest(int page, const QString &cursor){
+    Q_UNUSED(cursor);
+
     QNetworkRequest request;
     request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
     QUrl url;
 
+    /* 100 results per page */
+    QString offset = QString::number(page*100);
+
     if(args.input_Domain) {
         if(args.output_Hostname) {
-            url.setUrl("https://google.com/search?q=site:*."+target+"&btnG=Search&hl=en-US&biw=&bih=&gbv=1&start="+QString::number(m_offset)+"&filter=0&num=100");
+            url.setUrl("https://google.com/search?q=site:*."+target+"&btnG=Search&hl=en-US&biw=&bih=&gbv=1&start="+offset+"&filter=0&num=100");
             request.setUrl(url);
-            manager->get(request);
-            return;
+            return request;
         }
 
         if(args.output_URL) {
-            url.setUrl("https://google.com/search?q=site:"+target+"/*&btnG=Search&hl=en-US&biw=&bih=&gbv=1&start="+QString::number(m_offset)+"&filter=0&num=100");
+            url.setUrl("https://google.com/search?q=site:"+target+"/*&btnG=Search&hl=en-US&biw=&bih=&gbv=1&start="+offset+"&filter=0&num=100");
             request.setUrl(url);
-            manager->get(request);
-            return;
+            return request;
         }
     }
 
     if(args.input_Email) {
         if(args.output_URL) {
-            url.setUrl("https://google.com/search?q=intext:\""+target+"\"&btnG=Search&hl=en-US&biw=&bih=&gbv=1&start="+QString::number(m_offset)+"&filter=0&num=100");
+            url.setUrl("https://google.com/search?q=intext:\""+target+"\"&btnG=Search&hl=en-US&biw=&bih=&gbv=1&start="+offset+"&filter=0&num=100");
             request.setUrl(url);
-            manager->get(request);
-            return;
+            return request;
         }
     }
 
     if(args.input_Search) {
         if(args.output_URL || args.output_Hostname) {
-            url.setUrl("https://google.com/search?q=site:*"+target+".*+OR+site:*"+target+".*.*&btnG=Search&hl=en-US&biw=&bih=&gbv=1&start="+QString::number(m_offset)+"&filter=0&num=100");
+            url.setUrl("https://google.com/search?q=site:*"+target+".*+OR+site:*"+target+".*.*&btnG=Search&hl=en-US&biw=&bih=&gbv=1&start="+offset+"&filter=0&num=100");
             request.setUrl(url);
-            manager->get(request);
-            return;
+            return request;
         }
     }
+
+    return request;
 }
 
 void GoogleSearch::replyFinishedSubdomain(QNetworkReply *reply){
@@ -65,38 +72,18 @@ void GoogleSearch::replyFinishedSubdomain(QNetworkReply *reply){
         return;
     }
 
-    QStack<GumboNode*> nodes;
-    GumboOutput *output = gumbo_parse(reply->readAll());
-    nodes.push(GumboMethods::getBody(output->root));
-
-    GumboNode *node;
-    while(!nodes.isEmpty()) // backtrack loop
-    {
-        node = nodes.pop();
-        if(node->type != GUMBO_NODE_ELEMENT)
-            continue;
-
-        if(node->v.element.tag == GUMBO_TAG_DIV && node->v.element.attributes.length == 1 && node->v.element.children.length == 1)
-        {
-            GumboAttribute *classAttribute = static_cast<GumboAttribute*>(node->v.element.attributes.data[0]);
-            if(QString::fromUtf8(classAttribute->value) == "BNeawe UPmit AP7Wnd")
-            {
-                GumboNode *child = static_cast<GumboNode*>(node->v.element.children.data[0]);
-                /* trim the results and send */
-                QString subdomain(child->v.text.text);
-                subdomain = subdomain.split(" ").at(0);
-                emit resultSubdomain(subdomain);
-                log.resultsCount++;
-                continue;
-            }
-        }
-
-        GumboVector *children = &node->v.element.children;
-        for(unsigned int i = 0; i < children->length; i++)
-            nodes.push(static_cast<GumboNode*>(children->data[i]));
-    }
+    /* the hostnames are the text of the <div class="BNeawe UPmit AP7Wnd"> elements */
+    html::Rule hostnames = html::Rule::text("div");
+    hostnames.matchAttribute = "class";
+    hostnames.matchValue = "BNeawe UPmit AP7Wnd";
 
-    gumbo_destroy_output(&kGumboDefaultOptions, output);
+    html::Scanner scanner({hostnames}, [this](int, const QString &value){
+        /* trim the results and send */
+        QString subdomain = value.split(" ").at(0);
+        emit resultSubdomain(subdomain);
+        log.resultsCount++;
+    });
+    scanner.scan(reply);
 
     this->end(reply);
 }
@@ -107,41 +94,23 @@ void GoogleSearch::replyFinishedUrl(QNetworkReply *reply){
         return;
     }
 
-    QStack<GumboNode*> nodes;
-    GumboOutput *output = gumbo_parse(reply->readAll());
-    nodes.push(GumboMethods::getBody(output->root));
-
-    GumboNode *node;
-    while(!nodes.isEmpty()) // backtrack loop
-    {
-        node = nodes.pop();
-        if(node->type != GUMBO_NODE_ELEMENT)
-            continue;
-
-        if(node->v.element.tag == GUMBO_TAG_DIV && node->v.element.attributes.length == 1 && node->v.element.children.length > 0)
-        {
-            GumboAttribute *classAttribute = static_cast<GumboAttribute*>(node->v.element.attributes.data[0]);
-            if(QString::fromUtf8(classAttribute->value) == "egMi0 kCrYT")
-            {
-                GumboNode *child = static_cast<GumboNode*>(node->v.element.children.data[0]);
-                if(child->v.element.tag == GUMBO_TAG_A && child->v.element.attributes.length == 1)
-                {
-                    GumboAttribute *hrefAttribute = static_cast<GumboAttribute*>(child->v.element.attributes.data[0]);
-                    QString url(hrefAttribute->value);
-                    url = url.remove(0, 7);
-                    url = url.split("&")[0];
-                    emit resultURL(url);
-                    continue;
-                }
-            }
-        }
+    /* the results links are the first child <a> of the <div class="egMi0 kCrYT"> elements, /url?q=<url>&sa=... */
+    html::Rule links = html::Rule::attributeOf("a", "href");
+    links.firstChildOf = "div";
+    links.parentAttribute = "class";
+    links.parentValue = "egMi0 kCrYT";
 
-        GumboVector *children = &node->v.element.children;
-        for(unsigned int i = 0; i < children->length; i++)
-            nodes.push(static_cast<GumboNode*>(children->data[i]));
-    }
+    html::Scanner scanner({links}, [this](int, const QString &href){
+        if(!href.startsWith("/url?q="))
+            return;
 
-    gumbo_destroy_output(&kGumboDefaultOptions, output);
+        QString url = href;
+        url = url.remove(0, 7);
+        url = url.split("&")[0];
+        emit resultURL(url);
+        log.resultsCount++;
+    });
+    scanner.scan(reply);
 
     this->end(reply);
 }
@@ -31,8 +31,8 @@ class GoogleSearch: public AbstractOsintModule{
         void replyFinishedSubdomain(QNetworkReply *reply) override;
         void replyFinishedUrl(QNetworkReply *reply) override;
 
-    private:
-        int m_offset = 0;
+    protected:
+        QNetworkRequest pageRequest(int page, const QString &cursor) override;
 };
 
 #endif // GOOGLESEARCH_H
@@ -4,6 +4,7 @@
 #include <QDesktopServices>
 #include <QFileDialog>
 #include <QClipboard>
+#include "src/utils/Hostname.h"
 
 /*
  * TODO:
@@ -204,15 +205,7 @@ void Project::action_remove_duplicates(){
         return;
     }
 
-    QSet<QString> set;
-    for(int i = 0; i < choosen_model->rowCount(); i++){
-        if(set.contains(choosen_model->item(i,0)->text())){
-            choosen_model->removeRow(i);
-            i--;
-        }
-        else
-            set.insert(choosen_model->item(i,0)->text());
-    }
+    ProjectModel::removeDuplicates(choosen_model);
     ui->labelCount->setNum(proxyModel->rowCount());
     model->modified = true;
 }
@@ -1282,6 +1275,10 @@ void Project::action_send_cidr(const ENGINE &engine){
         emit sendToRaw(cidr, RESULT_TYPE::CIDR);
         emit changeTabToRaw();
         break;
+    case ENGINE::ACTIVE:
+        emit sendToActive(cidr, RESULT_TYPE::CIDR);
+        emit changeTabToActive();
+        break;
     default:
         break;
     }
@@ -1921,6 +1918,32 @@ void Project::action_remove_selected(){
     model->modified = true;
 }
 
+/*
+ * the hostnames of the items, urls included, are normalized first. the subdomain is the first label
+ * of a hostname under its registrable domain & the tld is the public suffix eg. "co.uk".
+ */
+static QSet<QString> extract(const QSet<QString> &items, bool subdomain, bool tld, bool url){
+    const s3s_SuffixList &suffixList = s3s_SuffixList::instance();
+
+    QSet<QString> extracts;
+    foreach(const QString &item, items){
+        QByteArray hostname = item.toUtf8();
+        if(!s3s_Hostname::normalize(hostname))
+            continue;
+
+        if(subdomain){
+            QByteArray domain = suffixList.registrableDomain(hostname);
+            if(!domain.isEmpty() && domain.size() < hostname.size())
+                extracts.insert(QString::fromLatin1(hostname.left(hostname.indexOf('.'))));
+        }
+        if(tld)
+            extracts.insert(QString::fromLatin1(suffixList.publicSuffix(hostname)));
+        if(url)
+            extracts.insert(QString::fromLatin1(hostname));
+    }
+    return extracts;
+}
+
 void Project::action_extract(bool subdomain, bool tld, bool url){
     QSet<QString> items;
 
@@ -1994,17 +2017,7 @@ void Project::action_extract(bool subdomain, bool tld, bool url){
     }
 
     /* extracting and saving to a set to avoid repeatition */
-    QSet<QString> extracts;
-    foreach(const QString &item, items){
-        if(subdomain)
-            extracts.insert(item.split(".").at(0));
-        if(tld)
-            extracts.insert(item.split(".").last());
-        if(url){
-            QString _url = item;
-            extracts.insert(_url.remove("https://").remove("http://").split("/").at(0));
-        }
-    }
+    QSet<QString> extracts = extract(items, subdomain, tld, url);
 
     /* setting the data to clipboard */
     QString data;
@@ -2021,17 +2034,7 @@ void Project::action_extract_selected(bool subdomain, bool tld, bool url){
         items.insert(proxyIndex.data().toString());
 
     /* extracting and saving to a set to avoid repeatition */
-    QSet<QString> extracts;
-    foreach(const QString &item, items){
-        if(subdomain)
-            extracts.insert(item.split(".").at(0));
-        if(tld)
-            extracts.insert(item.split(".").last());
-        if(url){
-            QString _url = item;
-            extracts.insert(_url.remove("https://").remove("http://").split("/").at(0));
-        }
-    }
+    QSet<QString> extracts = extract(items, subdomain, tld, url);
 
     /* setting the data to clipboard */
     QString data;
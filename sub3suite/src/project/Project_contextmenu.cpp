@@ -59,6 +59,7 @@ void Project::on_treeViewTree_customContextMenuRequested(const QPoint &pos){
     send_cidr_menu.setIcon(QIcon(":/img/res/icons/cidr.png"));
     send_cidr_menu.addAction(tr("Send CIDR to OSINT"), this, [=](){this->action_sendToEngine(ENGINE::OSINT, RESULT_TYPE::CIDR);});
     send_cidr_menu.addAction(tr("Send CIDR to RAW"), this, [=](){this->action_sendToEngine(ENGINE::RAW, RESULT_TYPE::CIDR);});
+    send_cidr_menu.addAction(tr("Send CIDR to ACTIVE"), this, [=](){this->action_sendToEngine(ENGINE::ACTIVE, RESULT_TYPE::CIDR);});
     send_cidr_menu.addSeparator();
     send_cidr_menu.addAction(tr("Send CIDR to CIDR-Enum"), this, [=](){this->action_sendToEnum(ENUMERATOR::CIDR, RESULT_TYPE::CIDR);});
 
@@ -408,6 +409,7 @@ void Project::init_action_send(){
     case ExplorerType::enum_CIDR:
         menu_send->addAction(tr("Send CIDR to OSINT"), this, [=](){this->action_send_cidr(ENGINE::OSINT);})->setIcon(QIcon(":/img/res/icons/cidr.png"));
         menu_send->addAction(tr("Send CIDR to RAW"), this, [=](){this->action_send_cidr(ENGINE::RAW);})->setIcon(QIcon(":/img/res/icons/cidr.png"));
+        menu_send->addAction(tr("Send CIDR to ACTIVE"), this, [=](){this->action_send_cidr(ENGINE::ACTIVE);})->setIcon(QIcon(":/img/res/icons/cidr.png"));
         menu_send->addSeparator();
         menu_send->addAction(tr("Send CIDR to CIDR-Enum"), this, [=](){this->action_send_cidr();})->setIcon(QIcon(":/img/res/icons/cidr.png"));
         break;
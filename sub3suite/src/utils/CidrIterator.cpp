@@ -0,0 +1,193 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief :
+*/
+
+#include "CidrIterator.h"
+
+#include <algorithm>
+
+
+bool s3s_CidrIterator::add(const QString &target, int stride){
+    QString text = target.trimmed();
+    QHostAddress address;
+    int length;
+
+    if(text.contains('/')){
+        QPair<QHostAddress, int> subnet = QHostAddress::parseSubnet(text);
+        if(subnet.second < 0)
+            return false;
+        address = subnet.first;
+        length = subnet.second;
+    }else {
+        if(!address.setAddress(text))
+            return false;
+        length = address.protocol() == QAbstractSocket::IPv4Protocol? 32 : 128;
+    }
+
+    Range range;
+    range.ipv4 = address.protocol() == QAbstractSocket::IPv4Protocol;
+    int hostBits = (range.ipv4? 32 : 128) - length;
+    if(hostBits > CIDR_MAX_HOST_BITS)
+        return false;
+
+    /* the host bits all lie in the last 32 bits */
+    quint32 mask = hostBits == 32? 0 : ~((quint32(1) << hostBits) - 1);
+    if(range.ipv4)
+        range.low = address.toIPv4Address() & mask;
+    else{
+        range.base = address.toIPv6Address();
+        for(int i = 12; i < 16; i++){
+            range.low = (range.low << 8) | range.base[i];
+            range.base[i] = 0;
+        }
+        range.low &= mask;
+    }
+    range.size = quint64(1) << hostBits;
+
+    /* a sampled range skips the network address */
+    if(stride > 1 && range.size > 2){
+        range.low++;
+        range.size--;
+        range.step = static_cast<quint32>(stride);
+        range.size = (range.size + range.step - 1) / range.step;
+    }
+
+    m_ranges.append(range);
+    m_total += range.size;
+    return true;
+}
+
+bool s3s_CidrIterator::next(QHostAddress &address){
+    if(m_range == m_ranges.size())
+        return false;
+
+    const Range &range = m_ranges.at(m_range);
+    quint32 low = range.low + static_cast<quint32>(m_offset * range.step);
+
+    if(range.ipv4)
+        address.setAddress(low);
+    else{
+        Q_IPV6ADDR ipv6 = range.base;
+        for(int i = 15; i >= 12; i--){
+            ipv6[i] = static_cast<quint8>(low);
+            low >>= 8;
+        }
+        address.setAddress(ipv6);
+    }
+
+    if(++m_offset == range.size){
+        m_range++;
+        m_offset = 0;
+    }
+    m_taken++;
+    return true;
+}
+
+void s3s_CidrIterator::clear(){
+    m_ranges.clear();
+    m_range = 0;
+    m_offset = 0;
+    m_total = 0;
+    m_taken = 0;
+}
+
+///
+/// aggregation...
+///
+
+struct CidrPrefix {
+    QByteArray bytes;   // 4 bytes for ipv4, 16 for ipv6
+    int length;
+};
+
+/* clears the bits after the first length bits */
+static QByteArray masked(QByteArray bytes, int length){
+    for(int i = 0; i < bytes.size(); i++){
+        int bits = qBound(0, length - i*8, 8);
+        bytes[i] = static_cast<char>(static_cast<quint8>(bytes.at(i)) & static_cast<quint8>(0xff << (8 - bits)));
+    }
+    return bytes;
+}
+
+static bool covers(const CidrPrefix &outer, const CidrPrefix &inner){
+    return outer.bytes.size() == inner.bytes.size() &&
+           outer.length <= inner.length &&
+           masked(inner.bytes, outer.length) == outer.bytes;
+}
+
+QStringList s3s_CidrIterator::aggregate(const QStringList &targets){
+    QVector<CidrPrefix> prefixes;
+
+    foreach(const QString &target, targets){
+        QPair<QHostAddress, int> subnet = QHostAddress::parseSubnet(target.trimmed());
+        if(subnet.second < 0){
+            /* a single address */
+            if(!subnet.first.setAddress(target.trimmed()))
+                continue;
+            subnet.second = subnet.first.protocol() == QAbstractSocket::IPv4Protocol? 32 : 128;
+        }
+
+        CidrPrefix prefix;
+        if(subnet.first.protocol() == QAbstractSocket::IPv4Protocol){
+            quint32 ipv4 = subnet.first.toIPv4Address();
+            for(int i = 3; i >= 0; i--)
+                prefix.bytes.append(static_cast<char>(ipv4 >> (i*8)));
+        }else {
+            Q_IPV6ADDR ipv6 = subnet.first.toIPv6Address();
+            prefix.bytes = QByteArray(reinterpret_cast<const char*>(ipv6.c), 16);
+        }
+        prefix.length = subnet.second;
+        prefix.bytes = masked(prefix.bytes, prefix.length);
+        prefixes.append(prefix);
+    }
+
+    /* ipv4 first, then by address, a prefix comes before the smaller ones it covers */
+    std::sort(prefixes.begin(), prefixes.end(), [](const CidrPrefix &a, const CidrPrefix &b){
+        if(a.bytes.size() != b.bytes.size())
+            return a.bytes.size() < b.bytes.size();
+        if(a.bytes != b.bytes)
+            return a.bytes < b.bytes;
+        return a.length < b.length;
+    });
+
+    QVector<CidrPrefix> stack;
+    foreach(const CidrPrefix &prefix, prefixes){
+        if(!stack.isEmpty() && covers(stack.last(), prefix))
+            continue;
+        stack.append(prefix);
+
+        /* merges the two halves of a larger prefix, as long as there are */
+        while(stack.size() > 1){
+            const CidrPrefix &high = stack.at(stack.size()-1);
+            const CidrPrefix &low = stack.at(stack.size()-2);
+            if(high.length != low.length || low.bytes.size() != high.bytes.size() || !high.length)
+                break;
+            QByteArray parent = masked(low.bytes, low.length-1);
+            if(parent != masked(high.bytes, high.length-1))
+                break;
+
+            CidrPrefix merged;
+            merged.bytes = parent;
+            merged.length = low.length-1;
+            stack.removeLast();
+            stack.last() = merged;
+        }
+    }
+
+    QStringList cidrs;
+    foreach(const CidrPrefix &prefix, stack){
+        QHostAddress address;
+        if(prefix.bytes.size() == 4){
+            quint32 ipv4 = 0;
+            for(int i = 0; i < 4; i++)
+                ipv4 = (ipv4 << 8) | static_cast<quint8>(prefix.bytes.at(i));
+            address.setAddress(ipv4);
+        }else
+            address.setAddress(reinterpret_cast<const quint8*>(prefix.bytes.constData()));
+        cidrs << address.toString()+"/"+QString::number(prefix.length);
+    }
+    return cidrs;
+}
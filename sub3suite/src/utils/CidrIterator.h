@@ -0,0 +1,56 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : lazy iteration over the addresses of cidr ranges & single addresses, the ranges are
+          kept as a base address & a size, an address is only made when it is taken.
+*/
+
+#ifndef CIDRITERATOR_H
+#define CIDRITERATOR_H
+
+#include <QVector>
+#include <QStringList>
+#include <QHostAddress>
+
+/* the largest range accepted, 2^32 addresses, a whole ipv4 space or an ipv6 /96 */
+#define CIDR_MAX_HOST_BITS 32
+
+
+class s3s_CidrIterator {
+    public:
+        /*
+         adds a cidr range or a single address, false if invalid or larger than the maximum.
+         with a stride greater than 1 only every stride-th address of the range is taken,
+         starting after the network address...
+        */
+        bool add(const QString &target, int stride = 1);
+
+        /* the smallest set of cidr ranges covering the targets, overlaps & adjacent halves are merged */
+        static QStringList aggregate(const QStringList &targets);
+
+        /* the next address, false once all the ranges are done */
+        bool next(QHostAddress &address);
+
+        quint64 total() const { return m_total; }
+        quint64 taken() const { return m_taken; }
+        bool isEmpty() const { return m_taken == m_total; }
+        void clear();
+
+    private:
+        struct Range {
+            Q_IPV6ADDR base;    // ipv6 address with the last 32 bits cleared, unused for ipv4
+            quint32 low = 0;    // ipv4 address or the last 32 bits of the ipv6 address
+            quint64 size = 0;   // the number of addresses taken from the range
+            quint32 step = 1;
+            bool ipv4 = true;
+        };
+
+        QVector<Range> m_ranges;
+        int m_range = 0;        // the range being iterated
+        quint64 m_offset = 0;   // the next address' offset in that range
+        quint64 m_total = 0;
+        quint64 m_taken = 0;
+};
+
+#endif // CIDRITERATOR_H
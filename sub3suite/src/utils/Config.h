@@ -11,6 +11,7 @@
 #ifndef CONFIG_H
 #define CONFIG_H
 
+#include <QQueue>
 #include <QSettings>
 #include <QDebug>
 
@@ -30,6 +31,7 @@
 #define CFG_SSL "ssl"
 #define CFG_URL "url"
 #define CFG_ENUM "enums"
+#define CFG_SMTP "smtp"
 
 /* general group values */
 #define CFG_VAL_THREADS "threads"
@@ -42,10 +44,30 @@
 #define CFG_VAL_BUILDDATE "build_date"
 #define CFG_VAL_MAXPAGES "max_pages"
 #define CFG_VAL_SETTIMEOUT "set_timeout"
+#define CFG_VAL_MAXRETRIES "max_retries"
+#define CFG_VAL_BACKOFF "retry_backoff"
+#define CFG_VAL_INFLIGHT "lookups_in_flight"
+#define CFG_VAL_RECURSIVE_DEPTH "recursive_depth"
+#define CFG_VAL_RECURSIVE_WORDLIST "recursive_wordlist"
+#define CFG_VAL_LOG_FORMAT "log_format"
+#define CFG_VAL_LOG_MAXSIZE "log_max_size"
+#define CFG_VAL_LOG_MAXFILES "log_max_files"
+#define CFG_VAL_IPDB_ROUTES "ipdb_routes"
+#define CFG_VAL_IPDB_NAMES "ipdb_asn_names"
+#define CFG_VAL_IPDB_GEO "ipdb_geo"
+#define CFG_VAL_RDAP_INTERVAL "rdap_interval"
+#define CFG_VAL_RDAP_CACHE "rdap_cache_size"
+#define CFG_VAL_PUBLIC_SUFFIX "public_suffix_list"
+#define CFG_VAL_REVERSE_INDEX "reverse_index"
+#define CFG_VAL_HELO "helo"
+#define CFG_VAL_SENDER "sender"
+#define CFG_VAL_MX_CONNECTIONS "mx_connections"
+#define CFG_VAL_PIPELINE "pipeline"
 
 /* groups */
 #define CFG_GRP_RECENT "recent_projects"
 #define CFG_GRP_DEFAULT_NS "default_nameservers"
+#define CFG_GRP_CT_LOGS "ct_logs"
 
 /* wordlist */
 #define CFG_WL_SUBDOMAIN "subdomain_wordlist"
@@ -78,6 +100,18 @@ class Config
             return settings;
         }
 
+        /* the configured nameservers of an engine, eg. "nameservers_dns" */
+        static QQueue<QString> nameservers(const QString &array){
+            QQueue<QString> nameservers;
+            int size = general().beginReadArray(array);
+            for(int i = 0; i < size; ++i){
+                general().setArrayIndex(i);
+                nameservers.enqueue(general().value("value").toString());
+            }
+            general().endArray();
+            return nameservers;
+        }
+
     private:
         Config(Config const&) = delete;
         Config(Config &&) = delete;
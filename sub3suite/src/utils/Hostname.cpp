@@ -0,0 +1,464 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief :
+*/
+
+#include "Hostname.h"
+#include "Config.h"
+
+#include <QUrl>
+#include <QFile>
+#include <cstring>
+
+/* 16 bytes at once, on the x86 cpus that all have sse2 */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HOSTNAME_SSE2
+#include <emmintrin.h>
+#endif
+
+/* flags of the suffix list's nodes */
+#define SUFFIX_RULE 0x1
+#define SUFFIX_WILDCARD 0x2  // "*.ck", set on "ck"
+#define SUFFIX_EXCEPTION 0x4 // "!www.ck"
+
+/* flags of the scope's nodes */
+#define SCOPE_APEX 0x1       // "example.com", the apex & its subdomains
+#define SCOPE_SUBDOMAINS 0x2 // "*.example.com", only the subdomains
+
+
+namespace {
+
+/* the bytes of a hostname once lowercased, letters, digits, '-', '_' & the '.' separator */
+struct ByteClasses {
+    bool valid[256];
+
+    ByteClasses(){
+        for(int c = 0; c < 256; c++)
+            valid[c] = (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '-' || c == '_' || c == '.';
+    }
+};
+const ByteClasses classes;
+
+inline bool isSpace(char c){
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+/* start of the name's last labels, -1 if the name has fewer labels */
+int labelsStart(const char *data, int size, int labels){
+    for(int i = size-1; i >= 0; i--){
+        if(data[i] == '.' && --labels == 0)
+            return i+1;
+    }
+    return labels == 1? 0 : -1;
+}
+
+/* the rules used without a configured list, the common multi-label suffixes & hosting suffixes */
+const char *const BUILTIN_SUFFIXES[] = {
+    "ac.uk", "co.uk", "gov.uk", "ltd.uk", "me.uk", "net.uk", "nhs.uk", "org.uk", "plc.uk", "police.uk", "sch.uk",
+    "asn.au", "com.au", "edu.au", "gov.au", "id.au", "net.au", "org.au",
+    "ac.nz", "co.nz", "geek.nz", "govt.nz", "net.nz", "org.nz", "school.nz",
+    "ac.za", "co.za", "gov.za", "net.za", "org.za", "web.za",
+    "ac.jp", "ad.jp", "co.jp", "ed.jp", "go.jp", "gr.jp", "lg.jp", "ne.jp", "or.jp", "*.kawasaki.jp", "!city.kawasaki.jp",
+    "ac.kr", "co.kr", "go.kr", "ne.kr", "or.kr", "re.kr",
+    "com.cn", "edu.cn", "gov.cn", "net.cn", "org.cn", "ac.cn",
+    "com.hk", "edu.hk", "gov.hk", "net.hk", "org.hk",
+    "com.tw", "edu.tw", "gov.tw", "idv.tw", "net.tw", "org.tw",
+    "com.sg", "edu.sg", "gov.sg", "net.sg", "org.sg",
+    "com.my", "edu.my", "gov.my", "net.my", "org.my",
+    "ac.in", "co.in", "edu.in", "firm.in", "gen.in", "gov.in", "ind.in", "net.in", "org.in", "res.in",
+    "ac.id", "co.id", "go.id", "my.id", "or.id", "web.id",
+    "com.ph", "edu.ph", "gov.ph", "net.ph", "org.ph",
+    "com.vn", "edu.vn", "gov.vn", "net.vn", "org.vn",
+    "ac.th", "co.th", "go.th", "in.th", "net.th", "or.th",
+    "com.pk", "edu.pk", "gov.pk", "net.pk", "org.pk",
+    "ac.il", "co.il", "gov.il", "net.il", "org.il",
+    "com.tr", "edu.tr", "gov.tr", "net.tr", "org.tr",
+    "com.sa", "edu.sa", "gov.sa", "net.sa", "org.sa",
+    "com.eg", "edu.eg", "gov.eg",
+    "com.ng", "edu.ng", "gov.ng", "net.ng", "org.ng",
+    "ac.ke", "co.ke", "go.ke", "ne.ke", "or.ke",
+    "ac.tz", "co.tz", "go.tz", "ne.tz", "or.tz",
+    "ac.ug", "co.ug", "go.ug", "or.ug",
+    "com.br", "edu.br", "gov.br", "net.br", "org.br",
+    "com.ar", "edu.ar", "gob.ar", "net.ar", "org.ar",
+    "com.mx", "edu.mx", "gob.mx", "net.mx", "org.mx",
+    "com.co", "edu.co", "gov.co", "net.co", "org.co",
+    "ac.at", "co.at", "gv.at", "or.at",
+    "com.es", "edu.es", "gob.es", "nom.es", "org.es",
+    "com.gr", "edu.gr", "gov.gr", "net.gr", "org.gr",
+    "com.pl", "gov.pl", "net.pl", "org.pl",
+    "com.pt", "edu.pt", "gov.pt", "org.pt",
+    "com.ua", "edu.ua", "gov.ua", "net.ua", "org.ua",
+    "*.bd", "*.ck", "!www.ck", "*.er", "*.fk", "*.jm", "*.kh", "*.mm", "*.np", "*.pg",
+    "appspot.com", "azurewebsites.net", "blogspot.com", "cloudapp.net", "cloudfront.net", "firebaseapp.com",
+    "github.io", "gitlab.io", "herokuapp.com", "netlify.app", "pages.dev", "vercel.app", "web.app", "workers.dev",
+    "s3.amazonaws.com", "*.compute.amazonaws.com", "*.elb.amazonaws.com"
+};
+
+}
+
+///
+/// normalization...
+///
+
+bool s3s_Hostname::normalize(QByteArray &name){
+    const char *data = name.constData();
+    int start = 0;
+    int end = name.size();
+
+    /* the surrounding whitespaces */
+    while(start < end && isSpace(data[start]))
+        start++;
+    while(end > start && isSpace(data[end-1]))
+        end--;
+
+    /* the scheme, "https://" */
+    for(int i = start; i < end; i++){
+        char c = data[i];
+        if(c == ':'){
+            if(i+2 < end && data[i+1] == '/' && data[i+2] == '/')
+                start = i+3;
+            break;
+        }
+        if(!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '+' || c == '-' || c == '.'))
+            break;
+    }
+
+    /* the path, query & fragment */
+    for(int i = start; i < end; i++){
+        if(data[i] == '/' || data[i] == '?' || data[i] == '#'){
+            end = i;
+            break;
+        }
+    }
+
+    /* the user info */
+    for(int i = end-1; i >= start; i--){
+        if(data[i] == '@'){
+            start = i+1;
+            break;
+        }
+    }
+
+    /* the port */
+    for(int i = end-1; i >= start; i--){
+        if(data[i] == ':'){
+            end = i;
+            break;
+        }
+        if(data[i] < '0' || data[i] > '9')
+            break;
+    }
+
+    /* the wildcard labels, the leading dots & the trailing dot of a fully qualified name */
+    while(end-start >= 2 && data[start] == '*' && data[start+1] == '.')
+        start += 2;
+    while(start < end && data[start] == '.')
+        start++;
+    if(end > start && data[end-1] == '.')
+        end--;
+
+    if(start == end)
+        return false;
+    name.truncate(end);
+    name.remove(0, start);
+
+    if(!lowercase(name.data(), name.size()))
+    {
+        /* internationalized names are converted to punycode, any other byte is invalid */
+        bool ascii = true;
+        for(int i = 0; i < name.size() && ascii; i++)
+            ascii = static_cast<uchar>(name.at(i)) < 0x80;
+        if(ascii)
+            return false;
+
+        name = QUrl::toAce(QString::fromUtf8(name));
+        if(name.isEmpty() || !lowercase(name.data(), name.size()))
+            return false;
+    }
+
+    return validate(name.constData(), name.size());
+}
+
+QString s3s_Hostname::normalize(const QString &name){
+    QByteArray hostname = name.toUtf8();
+    if(!normalize(hostname))
+        return QString();
+    return QString::fromLatin1(hostname);
+}
+
+bool s3s_Hostname::lowercase(char *data, int size){
+    int i = 0;
+
+#ifdef HOSTNAME_SSE2
+    /* the bytes from 0x80 are negative in the signed compares, so they fail the validation */
+    const __m128i beforeA = _mm_set1_epi8('A'-1), afterZ = _mm_set1_epi8('Z'+1);
+    const __m128i beforea = _mm_set1_epi8('a'-1), afterz = _mm_set1_epi8('z'+1);
+    const __m128i before0 = _mm_set1_epi8('0'-1), after9 = _mm_set1_epi8('9'+1);
+    const __m128i hyphen = _mm_set1_epi8('-'), dot = _mm_set1_epi8('.'), underscore = _mm_set1_epi8('_');
+    const __m128i caseBit = _mm_set1_epi8(0x20);
+
+    for(; i+16 <= size; i += 16){
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data+i));
+
+        __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(bytes, beforeA), _mm_cmplt_epi8(bytes, afterZ));
+        bytes = _mm_or_si128(bytes, _mm_and_si128(upper, caseBit));
+
+        __m128i valid = _mm_and_si128(_mm_cmpgt_epi8(bytes, beforea), _mm_cmplt_epi8(bytes, afterz));
+        valid = _mm_or_si128(valid, _mm_and_si128(_mm_cmpgt_epi8(bytes, before0), _mm_cmplt_epi8(bytes, after9)));
+        valid = _mm_or_si128(valid, _mm_cmpeq_epi8(bytes, hyphen));
+        valid = _mm_or_si128(valid, _mm_cmpeq_epi8(bytes, dot));
+        valid = _mm_or_si128(valid, _mm_cmpeq_epi8(bytes, underscore));
+        if(_mm_movemask_epi8(valid) != 0xFFFF)
+            return false;
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data+i), bytes);
+    }
+#endif
+
+    for(; i < size; i++){
+        uchar c = static_cast<uchar>(data[i]);
+        if(c >= 'A' && c <= 'Z')
+            c |= 0x20;
+        if(!classes.valid[c])
+            return false;
+        data[i] = static_cast<char>(c);
+    }
+    return true;
+}
+
+bool s3s_Hostname::validate(const char *data, int size){
+    if(size > HOSTNAME_MAX_LENGTH)
+        return false;
+
+    int labels = 0;
+    int start = 0;
+    while(start <= size){
+        const char *dot = static_cast<const char*>(std::memchr(data+start, '.', static_cast<size_t>(size-start)));
+        int end = dot? static_cast<int>(dot-data) : size;
+
+        int length = end-start;
+        if(length < 1 || length > HOSTNAME_MAX_LABEL || data[start] == '-' || data[end-1] == '-')
+            return false;
+
+        labels++;
+        start = end+1;
+    }
+    if(labels < 2)
+        return false;
+
+    /* the top level domain is not numeric, which also leaves out the ipv4 addresses */
+    for(int i = size-1; i >= 0 && data[i] != '.'; i--){
+        if(data[i] < '0' || data[i] > '9')
+            return true;
+    }
+    return false;
+}
+
+///
+/// label trie...
+///
+
+int s3s_LabelTrie::insert(const QByteArray &name){
+    int node = 0;
+    int end = name.size();
+    while(end > 0){
+        int dot = name.lastIndexOf('.', end-1);
+        QByteArray label = name.mid(dot+1, end-dot-1);
+
+        int next = m_nodes.at(node).children.value(label, -1);
+        if(next == -1){
+            next = m_nodes.size();
+            m_nodes[node].children.insert(label, next);
+            m_nodes.append(Node());
+        }
+        node = next;
+        end = dot;
+    }
+    return node;
+}
+
+int s3s_LabelTrie::child(int node, const char *label, int size) const {
+    const QHash<QByteArray, int> &children = m_nodes.at(node).children;
+    if(children.isEmpty())
+        return -1;
+
+    /* the label is looked up in place, without copying it */
+    return children.value(QByteArray::fromRawData(label, size), -1);
+}
+
+///
+/// public suffix list...
+///
+
+s3s_SuffixList::s3s_SuffixList()
+{
+    for(const char *rule : BUILTIN_SUFFIXES)
+        this->insert(QByteArray(rule));
+
+    QString path = CONFIG.value(CFG_VAL_PUBLIC_SUFFIX).toString();
+    if(!path.isEmpty())
+        this->load(path);
+
+    m_trie.squeeze();
+}
+
+s3s_SuffixList &s3s_SuffixList::instance(){
+    static s3s_SuffixList suffixList;
+    return suffixList;
+}
+
+bool s3s_SuffixList::load(const QString &path){
+    QFile file(path);
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text)){
+        qWarning() << "[PSL] Failed to open" << path << ":" << file.errorString();
+        return false;
+    }
+
+    int count = 0;
+    while(!file.atEnd())
+    {
+        /* a rule is the line's first word, the comments start with "//" */
+        QByteArray line = file.readLine().trimmed();
+        if(line.isEmpty() || line.startsWith("//"))
+            continue;
+        int space = line.indexOf(' ');
+        if(space > 0)
+            line.truncate(space);
+
+        this->insert(line);
+        count++;
+    }
+
+    qInfo() << "[PSL] Loaded" << count << "rules from" << path;
+    return true;
+}
+
+void s3s_SuffixList::insert(QByteArray rule){
+    quint8 flag = SUFFIX_RULE;
+    if(rule.startsWith('!')){
+        flag = SUFFIX_EXCEPTION;
+        rule.remove(0, 1);
+    }
+    else if(rule.startsWith("*.")){
+        flag = SUFFIX_WILDCARD;
+        rule.remove(0, 2);
+    }
+
+    /* the internationalized rules, as punycode like the normalized names */
+    for(int i = 0; i < rule.size(); i++){
+        if(static_cast<uchar>(rule.at(i)) >= 0x80){
+            rule = QUrl::toAce(QString::fromUtf8(rule));
+            break;
+        }
+    }
+    if(rule.isEmpty())
+        return;
+
+    m_trie.flags(m_trie.insert(rule.toLower())) |= flag;
+    m_rules++;
+}
+
+int s3s_SuffixList::suffixLabels(const char *data, int size) const {
+    int node = 0;
+    int matched = 0;
+    int suffix = 1; // the implicit "*" rule
+
+    int end = size;
+    while(end > 0){
+        int dot = end-1;
+        while(dot >= 0 && data[dot] != '.')
+            dot--;
+
+        int next = m_trie.child(node, data+dot+1, end-dot-1);
+
+        /* an exception rule wins, its suffix is the rule without its first label */
+        if(next != -1 && (m_trie.flags(next) & SUFFIX_EXCEPTION))
+            return matched;
+        if(m_trie.flags(node) & SUFFIX_WILDCARD)
+            suffix = qMax(suffix, matched+1);
+        if(next == -1)
+            break;
+
+        node = next;
+        matched++;
+        if(m_trie.flags(node) & SUFFIX_RULE)
+            suffix = qMax(suffix, matched);
+        end = dot;
+    }
+    return suffix;
+}
+
+QByteArray s3s_SuffixList::registrableDomain(const QByteArray &name) const {
+    int start = labelsStart(name.constData(), name.size(), this->suffixLabels(name.constData(), name.size())+1);
+    if(start < 0)
+        return QByteArray();
+    return name.mid(start);
+}
+
+QString s3s_SuffixList::registrableDomain(const QString &name) const {
+    QByteArray hostname = name.toUtf8();
+    if(!s3s_Hostname::normalize(hostname))
+        return QString();
+    return QString::fromLatin1(this->registrableDomain(hostname));
+}
+
+QByteArray s3s_SuffixList::publicSuffix(const QByteArray &name) const {
+    return name.mid(qMax(0, labelsStart(name.constData(), name.size(), this->suffixLabels(name.constData(), name.size()))));
+}
+
+QString s3s_SuffixList::publicSuffix(const QString &name) const {
+    QByteArray hostname = name.toUtf8();
+    if(!s3s_Hostname::normalize(hostname))
+        return QString();
+    return QString::fromLatin1(this->publicSuffix(hostname));
+}
+
+///
+/// scope...
+///
+
+bool s3s_Scope::insert(const QString &pattern){
+    QByteArray name = pattern.trimmed().toUtf8();
+    bool wildcard = name.startsWith("*.");
+    if(!s3s_Hostname::normalize(name))
+        return false;
+
+    m_trie.flags(m_trie.insert(name)) |= wildcard? SCOPE_SUBDOMAINS : SCOPE_APEX;
+    m_patterns++;
+    return true;
+}
+
+bool s3s_Scope::contains(const char *data, int size) const {
+    if(m_patterns == 0)
+        return true;
+
+    int node = 0;
+    int end = size;
+    while(end > 0){
+        int dot = end-1;
+        while(dot >= 0 && data[dot] != '.')
+            dot--;
+
+        node = m_trie.child(node, data+dot+1, end-dot-1);
+        if(node == -1)
+            return false;
+
+        quint8 flags = m_trie.flags(node);
+        if(flags & SCOPE_APEX)
+            return true;
+        if((flags & SCOPE_SUBDOMAINS) && dot >= 0)
+            return true;
+        end = dot;
+    }
+    return false;
+}
+
+QString s3s_Scope::match(const QString &name) const {
+    QByteArray hostname = name.toUtf8();
+    if(!s3s_Hostname::normalize(hostname) || !this->contains(hostname))
+        return QString();
+    return QString::fromLatin1(hostname);
+}
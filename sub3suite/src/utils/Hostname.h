@@ -0,0 +1,122 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : hostname processing on utf-8 bytes, the normalization & validation of the names found by
+          the modules, the registrable domains from the public suffix list & the scope of a scan.
+          the suffix list & the scope are tries of reversed labels, "www.example.co.uk" is looked
+          up as "uk", "co", "example", "www".
+*/
+
+#ifndef HOSTNAME_H
+#define HOSTNAME_H
+
+#include <QHash>
+#include <QVector>
+#include <QString>
+#include <QByteArray>
+
+/* limits of a hostname in its text form */
+#define HOSTNAME_MAX_LENGTH 253
+#define HOSTNAME_MAX_LABEL 63
+
+
+class s3s_Hostname {
+    public:
+        /*
+         * normalizes the name in place: the scheme, user info, path, port, wildcard labels & the
+         * trailing dot are stripped, internationalized names are converted to punycode & the name
+         * is lowercased. returns false if the result is not a hostname of at least two labels.
+         */
+        static bool normalize(QByteArray &name);
+
+        /* the normalized name, a null string if it is not a hostname */
+        static QString normalize(const QString &name);
+
+    private:
+        /* lowercases the bytes & checks they are letters, digits, '-', '_' or '.' */
+        static bool lowercase(char *data, int size);
+
+        /* checks the labels' lengths & hyphens, the name is lowercased */
+        static bool validate(const char *data, int size);
+};
+
+class s3s_LabelTrie {
+    public:
+        /* the node of the name's labels, created if missing */
+        int insert(const QByteArray &name);
+
+        /* the child of the node with the label, -1 if none */
+        int child(int node, const char *label, int size) const;
+
+        quint8 &flags(int node) { return m_nodes[node].flags; }
+        quint8 flags(int node) const { return m_nodes.at(node).flags; }
+
+        bool isEmpty() const { return m_nodes.size() < 2; }
+        void squeeze() { m_nodes.squeeze(); }
+
+    private:
+        struct Node {
+            QHash<QByteArray, int> children;
+            quint8 flags = 0;
+        };
+        QVector<Node> m_nodes = QVector<Node>(1); // the root, the empty name, is the first node
+};
+
+class s3s_SuffixList {
+    public:
+        /*
+         * the application's list, the built-in rules & the list configured in the [General]
+         * section. first used on the main thread, then only read by the scanning threads.
+         */
+        static s3s_SuffixList &instance();
+
+        /* rules in the format of publicsuffix.org's public_suffix_list.dat */
+        bool load(const QString &path);
+
+        /* number of labels of the public suffix of a normalized name, the last label if no rule matches */
+        int suffixLabels(const char *data, int size) const;
+
+        /* "example.co.uk" of "www.example.co.uk", empty if the name is a public suffix */
+        QByteArray registrableDomain(const QByteArray &name) const;
+        QString registrableDomain(const QString &name) const;
+
+        /* "co.uk" of "www.example.co.uk" */
+        QByteArray publicSuffix(const QByteArray &name) const;
+        QString publicSuffix(const QString &name) const;
+
+        int rules() const { return m_rules; }
+
+    private:
+        s3s_SuffixList();
+
+        s3s_LabelTrie m_trie;
+        int m_rules = 0;
+
+        void insert(QByteArray rule);
+};
+
+class s3s_Scope {
+    public:
+        /*
+         * "example.com" matches the apex & all its subdomains, "*.example.com" only the subdomains.
+         * returns false if the pattern is not a hostname.
+         */
+        bool insert(const QString &pattern);
+
+        /* a normalized name, an empty scope contains every name */
+        bool contains(const char *data, int size) const;
+        bool contains(const QByteArray &name) const { return this->contains(name.constData(), name.size()); }
+
+        /* the normalized name if it is a hostname in the scope, a null string otherwise */
+        QString match(const QString &name) const;
+
+        bool isEmpty() const { return m_patterns == 0; }
+        int size() const { return m_patterns; }
+
+    private:
+        s3s_LabelTrie m_trie;
+        int m_patterns = 0;
+};
+
+#endif // HOSTNAME_H
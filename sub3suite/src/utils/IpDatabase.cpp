@@ -0,0 +1,526 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : offline ip enrichment, a routing table dump & a geo database loaded into path-compressed
+          radix tries answering longest prefix matches with the ip's asn, route & country.
+          ipv4 addresses are kept as ipv4-mapped ipv6 addresses, so one trie holds both families.
+*/
+
+#include "IpDatabase.h"
+#include "Config.h"
+
+#include <QFile>
+#include <QDebug>
+#include <QTextStream>
+#include <QtAlgorithms>
+
+
+///
+/// 128 bit keys, the address's bits as two integers, the first holds the high bits...
+///
+
+static void toKey(const Q_IPV6ADDR &address, quint64 key[2]){
+    key[0] = 0;
+    key[1] = 0;
+    for(int i = 0; i < 8; i++){
+        key[0] = (key[0] << 8) | address[i];
+        key[1] = (key[1] << 8) | address[i+8];
+    }
+}
+
+static Q_IPV6ADDR toAddress(const quint64 key[2]){
+    Q_IPV6ADDR address;
+    for(int i = 0; i < 8; i++){
+        address[i] = static_cast<quint8>(key[0] >> (56-8*i));
+        address[i+8] = static_cast<quint8>(key[1] >> (56-8*i));
+    }
+    return address;
+}
+
+static int bitAt(const quint64 key[2], int bit){
+    if(bit < 64)
+        return static_cast<int>((key[0] >> (63-bit)) & 1);
+    return static_cast<int>((key[1] >> (127-bit)) & 1);
+}
+
+/* zeroes the bits after the length */
+static void maskKey(quint64 key[2], int length){
+    if(length <= 0){
+        key[0] = 0;
+        key[1] = 0;
+    }
+    else if(length < 64){
+        key[0] &= ~(~Q_UINT64_C(0) >> length);
+        key[1] = 0;
+    }
+    else if(length == 64)
+        key[1] = 0;
+    else if(length < 128)
+        key[1] &= ~(~Q_UINT64_C(0) >> (length-64));
+}
+
+/* the leading bits the keys share, not more than max */
+static int commonBits(const quint64 a[2], const quint64 b[2], int max){
+    int bits;
+    if(a[0] != b[0])
+        bits = static_cast<int>(qCountLeadingZeroBits(a[0] ^ b[0]));
+    else if(a[1] != b[1])
+        bits = 64+static_cast<int>(qCountLeadingZeroBits(a[1] ^ b[1]));
+    else
+        bits = 128;
+    return qMin(bits, max);
+}
+
+static int trailingZeros(const quint64 key[2]){
+    if(key[1])
+        return static_cast<int>(qCountTrailingZeroBits(key[1]));
+    if(key[0])
+        return 64+static_cast<int>(qCountTrailingZeroBits(key[0]));
+    return 128;
+}
+
+static bool greater(const quint64 a[2], const quint64 b[2]){
+    return a[0] > b[0] || (a[0] == b[0] && a[1] > b[1]);
+}
+
+/* the last key of the block of 2^size keys starting at the key */
+static void blockLast(const quint64 key[2], int size, quint64 last[2]){
+    last[0] = key[0];
+    last[1] = key[1];
+    if(size >= 64){
+        last[1] = ~Q_UINT64_C(0);
+        last[0] |= (size == 128)? ~Q_UINT64_C(0) : (Q_UINT64_C(1) << (size-64))-1;
+    }
+    else if(size > 0)
+        last[1] |= (Q_UINT64_C(1) << size)-1;
+}
+
+bool s3s_mappedAddress(const QString &text, Q_IPV6ADDR &address, int &offset, bool integers){
+    QHostAddress host;
+    bool isInteger = false;
+    quint32 integer = integers? text.toUInt(&isInteger) : 0;
+    if(isInteger)
+        host.setAddress(integer);
+    else if(!host.setAddress(text))
+        return false;
+
+    if(host.protocol() == QAbstractSocket::IPv4Protocol){
+        quint32 ipv4 = host.toIPv4Address();
+        for(int i = 0; i < 10; i++)
+            address[i] = 0;
+        address[10] = 0xff;
+        address[11] = 0xff;
+        address[12] = static_cast<quint8>(ipv4 >> 24);
+        address[13] = static_cast<quint8>(ipv4 >> 16);
+        address[14] = static_cast<quint8>(ipv4 >> 8);
+        address[15] = static_cast<quint8>(ipv4);
+        offset = IPV4_OFFSET;
+        return true;
+    }
+    if(host.protocol() == QAbstractSocket::IPv6Protocol){
+        address = host.toIPv6Address();
+        offset = 0;
+        return true;
+    }
+    return false;
+}
+
+/* a cidr, or an address & a separate length */
+static bool parsePrefix(const QString &text, int length, Q_IPV6ADDR &address, int &bits){
+    QString prefix = text;
+    if(length == -1){
+        int slash = text.indexOf('/');
+        if(slash == -1)
+            return false;
+        bool ok;
+        length = text.mid(slash+1).toInt(&ok);
+        if(!ok)
+            return false;
+        prefix = text.left(slash);
+    }
+
+    int offset;
+    if(!s3s_mappedAddress(prefix, address, offset) || length < 0 || length > 128-offset)
+        return false;
+    bits = offset+length;
+    return true;
+}
+
+///
+/// the prefix trie...
+///
+
+qint32 s3s_PrefixTrie::newNode(const quint64 key[2], int length){
+    Node node;
+    node.key[0] = key[0];
+    node.key[1] = key[1];
+    node.length = static_cast<quint8>(length);
+    m_nodes.append(node);
+    return m_nodes.size()-1;
+}
+
+void s3s_PrefixTrie::insert(const Q_IPV6ADDR &prefix, int length, quint32 value){
+    quint64 key[2];
+    toKey(prefix, key);
+    maskKey(key, length);
+
+    auto setValue = [&](qint32 node){
+        if(!m_nodes[node].hasValue)
+            m_values++;
+        m_nodes[node].hasValue = true;
+        m_nodes[node].value = value;
+    };
+
+    if(m_nodes.isEmpty()){
+        const quint64 root[2] = {0, 0};
+        this->newNode(root, 0);
+    }
+
+    /* the nodes on the way share the prefix's leading bits */
+    qint32 node = 0;
+    forever {
+        if(m_nodes.at(node).length == length){
+            setValue(node);
+            return;
+        }
+
+        int branch = bitAt(key, m_nodes.at(node).length);
+        qint32 child = m_nodes.at(node).child[branch];
+        if(child == -1){
+            qint32 leaf = this->newNode(key, length);
+            setValue(leaf);
+            m_nodes[node].child[branch] = leaf;
+            return;
+        }
+
+        int childLength = m_nodes.at(child).length;
+        int common = commonBits(key, m_nodes.at(child).key, qMin(length, childLength));
+        if(common == childLength){
+            node = child;
+            continue;
+        }
+
+        /* the prefix splits the child's path, at its end or at a new branching node */
+        qint32 split;
+        if(common == length){
+            split = this->newNode(key, length);
+            setValue(split);
+        }
+        else {
+            quint64 splitKey[2] = {key[0], key[1]};
+            maskKey(splitKey, common);
+            split = this->newNode(splitKey, common);
+            qint32 leaf = this->newNode(key, length);
+            setValue(leaf);
+            m_nodes[split].child[bitAt(key, common)] = leaf;
+        }
+        m_nodes[split].child[bitAt(m_nodes.at(child).key, common)] = child;
+        m_nodes[node].child[branch] = split;
+        return;
+    }
+}
+
+bool s3s_PrefixTrie::lookup(const Q_IPV6ADDR &address, quint32 &value, int &length) const {
+    if(m_nodes.isEmpty())
+        return false;
+
+    quint64 key[2];
+    toKey(address, key);
+
+    bool found = false;
+    qint32 node = 0;
+    while(node != -1)
+    {
+        const Node &current = m_nodes.at(node);
+        if(commonBits(key, current.key, current.length) < current.length)
+            break;
+
+        /* the deeper the node the longer the match */
+        if(current.hasValue){
+            value = current.value;
+            length = current.length;
+            found = true;
+        }
+        if(current.length == 128)
+            break;
+        node = current.child[bitAt(key, current.length)];
+    }
+    return found;
+}
+
+void s3s_PrefixTrie::clear(){
+    m_nodes.clear();
+    m_values = 0;
+}
+
+///
+/// the database...
+///
+
+s3s_IpDatabase &s3s_IpDatabase::instance(){
+    static s3s_IpDatabase database;
+    return database;
+}
+
+bool s3s_IpDatabase::loadRoutes(const QString &path){
+    QFile file(path);
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text)){
+        m_error = "cannot open "+path;
+        return false;
+    }
+
+    int count = 0;
+    QTextStream in(&file);
+    while(!in.atEnd())
+    {
+        QString line = in.readLine().trimmed();
+        if(line.isEmpty() || line.startsWith('#'))
+            continue;
+
+        QString prefix, origin;
+        int length = -1;
+        if(line.contains('|')){
+            /* bgpdump -m, the prefix then the as path, the origin is the path's last asn */
+            QStringList fields = line.split('|');
+            if(fields.size() < 7)
+                continue;
+            QStringList path = fields.at(6).split(' ', QString::SkipEmptyParts);
+            if(path.isEmpty())
+                continue;
+            prefix = fields.at(5);
+            origin = path.last();
+        }
+        else {
+            QStringList fields = line.simplified().split(' ');
+            if(fields.size() >= 3 && !fields.at(0).contains('/')){
+                prefix = fields.at(0);
+                length = fields.at(1).toInt();
+                origin = fields.at(2);
+            }
+            else if(fields.size() >= 2){
+                prefix = fields.at(0);
+                origin = fields.at(1);
+            }
+            else
+                continue;
+        }
+
+        /* multi-origin "asn_asn" & as-sets "{asn,asn}" take their first asn */
+        origin.remove('{').remove('}');
+        if(origin.startsWith("AS", Qt::CaseInsensitive))
+            origin.remove(0, 2);
+        bool ok;
+        quint32 asn = origin.section(QRegExp("[_,]"), 0, 0).toUInt(&ok);
+
+        Q_IPV6ADDR address;
+        int bits;
+        if(!ok || !parsePrefix(prefix, length, address, bits))
+            continue;
+
+        m_routes.insert(address, bits, asn);
+        count++;
+    }
+    m_routes.squeeze();
+
+    qInfo() << "[IP-DB] Loaded" << count << "routes from" << path;
+    return true;
+}
+
+bool s3s_IpDatabase::loadNames(const QString &path){
+    QFile file(path);
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text)){
+        m_error = "cannot open "+path;
+        return false;
+    }
+
+    QRegExp separator("[\\s,]");
+    QTextStream in(&file);
+    while(!in.atEnd())
+    {
+        QString line = in.readLine().trimmed();
+        if(line.isEmpty() || line.startsWith('#'))
+            continue;
+
+        int index = line.indexOf(separator);
+        if(index == -1)
+            continue;
+
+        QString asn = line.left(index);
+        if(asn.startsWith("AS", Qt::CaseInsensitive))
+            asn.remove(0, 2);
+        bool ok;
+        quint32 number = asn.toUInt(&ok);
+        if(ok)
+            m_names.insert(number, line.mid(index+1).remove('"').trimmed());
+    }
+
+    qInfo() << "[IP-DB] Loaded" << m_names.size() << "asn names from" << path;
+    return true;
+}
+
+bool s3s_IpDatabase::loadGeo(const QString &path){
+    QFile file(path);
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text)){
+        m_error = "cannot open "+path;
+        return false;
+    }
+
+    int count = 0;
+    QTextStream in(&file);
+    while(!in.atEnd())
+    {
+        QString line = in.readLine().trimmed();
+        if(line.isEmpty() || line.startsWith('#'))
+            continue;
+
+        QStringList fields = line.remove('"').split(',');
+        if(fields.size() < 2)
+            continue;
+
+        if(fields.at(0).contains('/')){
+            /* cidr, code & name, the name may have commas */
+            Q_IPV6ADDR address;
+            int bits;
+            QString code = fields.at(1).trimmed();
+            if(code.isEmpty() || code == "-" || !parsePrefix(fields.at(0).trimmed(), -1, address, bits))
+                continue;
+            m_geo.insert(address, bits, this->country(code, fields.mid(2).join(",").trimmed()));
+        }
+        else {
+            /* first & last addresses, code & name */
+            Q_IPV6ADDR first, last;
+            int firstOffset, lastOffset;
+            QString code = fields.value(2).trimmed();
+            if(code.isEmpty() || code == "-" ||
+               !s3s_mappedAddress(fields.at(0).trimmed(), first, firstOffset, true) ||
+               !s3s_mappedAddress(fields.at(1).trimmed(), last, lastOffset, true) || firstOffset != lastOffset)
+                continue;
+            this->insertRange(first, last, this->country(code, fields.mid(3).join(",").trimmed()));
+        }
+        count++;
+    }
+    m_geo.squeeze();
+
+    qInfo() << "[IP-DB] Loaded" << count << "geo ranges from" << path;
+    return true;
+}
+
+void s3s_IpDatabase::configuredPaths(QString &routes, QString &names, QString &geo){
+    routes = CONFIG.value(CFG_VAL_IPDB_ROUTES).toString();
+    names = CONFIG.value(CFG_VAL_IPDB_NAMES).toString();
+    geo = CONFIG.value(CFG_VAL_IPDB_GEO).toString();
+}
+
+bool s3s_IpDatabase::load(const QString &routes, const QString &names, const QString &geo){
+    QWriteLocker locker(&m_lock);
+
+    const QList<QPair<QString, bool (s3s_IpDatabase::*)(const QString&)>> files = {
+        {routes, &s3s_IpDatabase::loadRoutes},
+        {names, &s3s_IpDatabase::loadNames},
+        {geo, &s3s_IpDatabase::loadGeo}
+    };
+
+    bool loaded = true;
+    for(const auto &file : files){
+        if(file.first.isEmpty() || m_loaded.contains(file.first))
+            continue;
+        if((this->*file.second)(file.first))
+            m_loaded.append(file.first);
+        else
+            loaded = false;
+    }
+
+    if(loaded && !m_routes.size() && !m_geo.size()){
+        m_error = "no routing table or geo database is configured";
+        return false;
+    }
+    return loaded;
+}
+
+bool s3s_IpDatabase::isLoaded() const {
+    QReadLocker locker(&m_lock);
+    return m_routes.size() || m_geo.size();
+}
+
+int s3s_IpDatabase::routes() const {
+    QReadLocker locker(&m_lock);
+    return m_routes.size();
+}
+
+int s3s_IpDatabase::ranges() const {
+    QReadLocker locker(&m_lock);
+    return m_geo.size();
+}
+
+QString s3s_IpDatabase::error() const {
+    QReadLocker locker(&m_lock);
+    return m_error;
+}
+
+bool s3s_IpDatabase::lookup(const QString &text, s3s_struct::IP &ip) const {
+    Q_IPV6ADDR address;
+    int offset;
+    if(!s3s_mappedAddress(text.trimmed(), address, offset))
+        return false;
+
+    QReadLocker locker(&m_lock);
+
+    bool found = false;
+    quint32 value;
+    int length;
+    if(m_routes.lookup(address, value, length)){
+        ip.asnInfo_asn = QString::number(value);
+        ip.asnInfo_name = m_names.value(value);
+
+        quint64 key[2];
+        toKey(address, key);
+        maskKey(key, length);
+        QHostAddress route(toAddress(key));
+        if(offset == IPV4_OFFSET && length >= IPV4_OFFSET)
+            ip.asnInfo_route = QHostAddress(route.toIPv4Address()).toString()+"/"+QString::number(length-IPV4_OFFSET);
+        else
+            ip.asnInfo_route = route.toString()+"/"+QString::number(length);
+        found = true;
+    }
+    if(m_geo.lookup(address, value, length)){
+        ip.info_countryCode = m_countries.at(static_cast<int>(value)).first;
+        ip.info_countryName = m_countries.at(static_cast<int>(value)).second;
+        found = true;
+    }
+    return found;
+}
+
+void s3s_IpDatabase::insertRange(const Q_IPV6ADDR &first, const Q_IPV6ADDR &last, quint32 country){
+    quint64 start[2], end[2];
+    toKey(first, start);
+    toKey(last, end);
+    if(greater(start, end))
+        return;
+
+    /* the range as the fewest aligned blocks, each one a prefix */
+    forever {
+        int size = trailingZeros(start);
+        quint64 blockEnd[2];
+        blockLast(start, size, blockEnd);
+        while(size > 0 && greater(blockEnd, end))
+            blockLast(start, --size, blockEnd);
+
+        m_geo.insert(toAddress(start), 128-size, country);
+        if(blockEnd[0] == end[0] && blockEnd[1] == end[1])
+            return;
+
+        /* the block after, the end was not reached so this does not overflow */
+        start[1] = blockEnd[1]+1;
+        start[0] = blockEnd[0]+(start[1] == 0? 1 : 0);
+    }
+}
+
+quint32 s3s_IpDatabase::country(const QString &code, const QString &name){
+    QString key = code.toUpper();
+    if(!m_countryIndex.contains(key)){
+        m_countryIndex.insert(key, static_cast<quint32>(m_countries.size()));
+        m_countries.append(qMakePair(key, name));
+    }
+    return m_countryIndex.value(key);
+}
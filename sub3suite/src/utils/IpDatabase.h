@@ -0,0 +1,105 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : offline ip enrichment, a routing table dump & a geo database loaded into path-compressed
+          radix tries answering longest prefix matches with the ip's asn, route & country.
+          ipv4 addresses are kept as ipv4-mapped ipv6 addresses, so one trie holds both families.
+*/
+
+#ifndef IPDATABASE_H
+#define IPDATABASE_H
+
+#include <QHash>
+#include <QVector>
+#include <QString>
+#include <QHostAddress>
+#include <QReadWriteLock>
+
+#include "src/items/IPItem.h"
+
+/* bits before the ipv4 address in an ipv4-mapped address */
+#define IPV4_OFFSET 96
+
+/*
+ * an address as an ipv6 address, ipv4 as ipv4-mapped. the offset is the bits before the address,
+ * 96 for ipv4 & 0 for ipv6. ipv4 integers are accepted for the geo databases' ranges.
+ */
+bool s3s_mappedAddress(const QString &text, Q_IPV6ADDR &address, int &offset, bool integers = false);
+
+
+class s3s_PrefixTrie {
+    public:
+        /* a prefix of an ipv6 address or of an ipv4-mapped address, longer prefixes override */
+        void insert(const Q_IPV6ADDR &prefix, int length, quint32 value);
+
+        /* longest prefix match, returns false if no prefix contains the address */
+        bool lookup(const Q_IPV6ADDR &address, quint32 &value, int &length) const;
+
+        int size() const { return m_values; }
+        void clear();
+        void squeeze() { m_nodes.squeeze(); }
+
+    private:
+        struct Node {
+            quint64 key[2] = {0, 0}; // the prefix's bits, the bits after its length are zero
+            qint32 child[2] = {-1, -1};
+            quint32 value = 0;
+            quint8 length = 0;
+            bool hasValue = false;
+        };
+        QVector<Node> m_nodes; // the root, the empty prefix, is the first node
+        int m_values = 0;
+
+        qint32 newNode(const quint64 key[2], int length);
+};
+
+class s3s_IpDatabase {
+    public:
+        /* the application's database, loaded & looked up on the scanners' threads */
+        static s3s_IpDatabase &instance();
+
+        /*
+         * routes, a caida pfx2as file (prefix, length & asn), "bgpdump -m" lines of a rib dump
+         * or "cidr asn" lines. multi-origin asns & as-sets take their first asn.
+         */
+        bool loadRoutes(const QString &path);
+
+        /* asn names, "asn name" or "asn,name" lines, eg. the ripe asn.txt */
+        bool loadNames(const QString &path);
+
+        /* countries, "start,end,code[,name]" ip ranges as addresses or ipv4 integers, or "cidr,code[,name]" */
+        bool loadGeo(const QString &path);
+
+        /*
+         * loads the files not loaded yet, an empty path is skipped. the loads & the lookups are
+         * locked, the lookups of other threads wait for a load.
+         */
+        bool load(const QString &routes, const QString &names, const QString &geo);
+
+        /* the files configured in the [General] section, read on the gui thread */
+        static void configuredPaths(QString &routes, QString &names, QString &geo);
+
+        /* fills the ip's asn, route & country, returns false if nothing is known of it */
+        bool lookup(const QString &address, s3s_struct::IP &ip) const;
+
+        bool isLoaded() const;
+        int routes() const;
+        int ranges() const;
+        QString error() const;
+
+    private:
+        mutable QReadWriteLock m_lock;
+        s3s_PrefixTrie m_routes; // values are asns
+        s3s_PrefixTrie m_geo;    // values are indexes of m_countries
+        QHash<quint32, QString> m_names;
+        QVector<QPair<QString, QString>> m_countries; // code & name
+        QHash<QString, quint32> m_countryIndex;
+        QStringList m_loaded;
+        QString m_error;
+
+        void insertRange(const Q_IPV6ADDR &first, const Q_IPV6ADDR &last, quint32 country);
+        quint32 country(const QString &code, const QString &name);
+};
+
+#endif // IPDATABASE_H
@@ -0,0 +1,237 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : the application's logger, the messages are queued without locking & written in batches
+          to the day's log file by a writer thread. the log file is rotated by size, its lines are
+          either text or json.
+*/
+
+#include "Logger.h"
+#include "Config.h"
+
+#include <QDir>
+#include <QDateTime>
+#include <QJsonObject>
+#include <QJsonDocument>
+
+/* milliseconds the writer sleeps when there are no messages */
+#define LOG_WRITE_INTERVAL 100
+
+/* milliseconds a fatal message waits for the writer, before the application aborts */
+#define LOG_FATAL_WAIT 2000
+
+
+/* the running logger, messages are written to stderr when there is none */
+static QAtomicPointer<s3s_Logger> s_logger;
+
+/* the threads in the message handler, the logger is freed once they have left it */
+static QAtomicInt s_producers;
+
+s3s_Logger::s3s_Logger(const QString &directory): QThread(nullptr),
+    m_head(new Node),
+    m_directory(directory),
+    m_maxSize(CONFIG.value(CFG_VAL_LOG_MAXSIZE, LOG_MAX_SIZE).toLongLong()*1024*1024),
+    m_maxFiles(qMax(0, CONFIG.value(CFG_VAL_LOG_MAXFILES, LOG_MAX_FILES).toInt())),
+    m_json(CONFIG.value(CFG_VAL_LOG_FORMAT, "text").toString() == "json")
+{
+    m_tail = m_head.loadAcquire();
+    QDir().mkpath(m_directory);
+
+    this->start(QThread::LowPriority);
+    s_logger.storeRelease(this);
+    qInstallMessageHandler(s3s_Logger::messageHandler);
+}
+s3s_Logger::~s3s_Logger(){
+    qInstallMessageHandler(nullptr);
+    s_logger.fetchAndStoreOrdered(nullptr);
+
+    /* a thread that loaded the logger before it was cleared may still be queueing a message */
+    while(s_producers.loadAcquire() > 0)
+        QThread::yieldCurrentThread();
+
+    /* the writer writes the messages left before it ends */
+    m_stop.storeRelease(1);
+    this->wait();
+
+    /* messages queued by threads that were logging while the handler was uninstalled */
+    QByteArray batch, line;
+    while(this->dequeue(line))
+        batch.append(line);
+    if(!batch.isEmpty())
+        this->write(batch);
+    m_file.close();
+
+    delete m_tail;
+}
+
+QString s3s_Logger::currentFile(const QString &directory){
+    return directory+"/"+QDateTime::currentDateTime().toString("dd-MM-yyyy")+".log";
+}
+
+///
+/// producers...
+///
+
+void s3s_Logger::messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg){
+    s_producers.ref();
+    s3s_Logger *logger = s_logger.loadAcquire();
+    if(!logger){
+        s_producers.deref();
+        fprintf(stderr, "%s\n", qPrintable(msg));
+        return;
+    }
+
+    logger->enqueue(logger->format(type, context, msg));
+
+    /* the application aborts after a fatal message, it is written first */
+    if(type == QtFatalMsg)
+        logger->flush();
+    s_producers.deref();
+}
+
+QByteArray s3s_Logger::format(QtMsgType type, const QMessageLogContext &context, const QString &msg) const {
+    QString level;
+    switch (type) {
+    case QtInfoMsg:
+        level = "INFO";
+        break;
+    case QtDebugMsg:
+        level = "DEBUG";
+        break;
+    case QtWarningMsg:
+        level = "WARNING";
+        break;
+    case QtCriticalMsg:
+    case QtFatalMsg:
+        level = "ERROR";
+        break;
+    }
+
+    if(!m_json)
+        return QString("[%1] %2: %3\n").arg(QTime::currentTime().toString("hh:mm:ss")).arg(level).arg(msg).toUtf8();
+
+    QJsonObject line;
+    line.insert("time", QDateTime::currentDateTime().toString(Qt::ISODateWithMs));
+    line.insert("level", level);
+    line.insert("message", msg);
+    line.insert("thread", QString::number(reinterpret_cast<quintptr>(QThread::currentThreadId()), 16));
+    if(context.file){
+        line.insert("file", QString(context.file));
+        line.insert("line", context.line);
+    }
+    if(context.function)
+        line.insert("function", QString(context.function));
+    return QJsonDocument(line).toJson(QJsonDocument::Compact)+"\n";
+}
+
+void s3s_Logger::enqueue(const QByteArray &line){
+    if(m_pending.fetchAndAddRelaxed(1) >= LOG_MAX_PENDING){
+        m_pending.fetchAndAddRelaxed(-1);
+        m_dropped.fetchAndAddRelaxed(1);
+        return;
+    }
+
+    Node *node = new Node;
+    node->line = line;
+
+    /* swap the head, then link the previous head to the node */
+    Node *previous = m_head.fetchAndStoreAcquire(node);
+    previous->next.storeRelease(node);
+}
+
+void s3s_Logger::flush(){
+    if(QThread::currentThread() == this)
+        return;
+
+    for(int i = 0; i < LOG_FATAL_WAIT && m_pending.loadAcquire() > 0; i++)
+        QThread::msleep(1);
+}
+
+///
+/// the writer...
+///
+
+bool s3s_Logger::dequeue(QByteArray &line){
+    Node *next = m_tail->next.loadAcquire();
+    if(!next)
+        return false;
+
+    /* the next node becomes the consumed node */
+    line.swap(next->line);
+    delete m_tail;
+    m_tail = next;
+    return true;
+}
+
+void s3s_Logger::run(){
+    QByteArray batch;
+    QByteArray line;
+
+    forever
+    {
+        bool stop = m_stop.loadAcquire();
+
+        int count = 0;
+        while(this->dequeue(line)){
+            batch.append(line);
+            count++;
+        }
+
+        int dropped = m_dropped.fetchAndStoreRelaxed(0);
+        if(dropped)
+            batch.append(QString("[%1] WARNING: %2 log messages dropped, the logger could not keep up\n")
+                         .arg(QTime::currentTime().toString("hh:mm:ss")).arg(dropped).toUtf8());
+
+        if(!batch.isEmpty()){
+            this->write(batch);
+            batch.clear();
+            m_pending.fetchAndAddRelaxed(-count);
+        }
+
+        /* the queue was emptied after the stop, nothing is left */
+        if(stop)
+            break;
+        if(!count)
+            QThread::msleep(LOG_WRITE_INTERVAL);
+    }
+    m_file.close();
+}
+
+void s3s_Logger::write(const QByteArray &batch){
+    /* a new file each day */
+    QString date = QDateTime::currentDateTime().toString("dd-MM-yyyy");
+    if(date != m_date || !m_file.isOpen()){
+        m_date = date;
+        this->open();
+    }
+
+    if(m_maxSize > 0 && m_file.size()+batch.size() > m_maxSize && m_file.size() > 0)
+        this->rotate();
+
+    m_file.write(batch);
+    m_file.flush();
+}
+
+void s3s_Logger::open(){
+    m_file.close();
+    m_file.setFileName(m_directory+"/"+m_date+".log");
+    if(!m_file.open(QIODevice::WriteOnly | QIODevice::Append))
+        fprintf(stderr, "failed to open the log file %s\n", qPrintable(m_file.fileName()));
+}
+
+void s3s_Logger::rotate(){
+    m_file.close();
+
+    /* <date>.log becomes <date>.1.log, <date>.1.log becomes <date>.2.log, the last one is removed */
+    QString base = m_directory+"/"+m_date;
+    QFile::remove(QString("%1.%2.log").arg(base).arg(m_maxFiles));
+    for(int i = m_maxFiles-1; i > 0; i--)
+        QFile::rename(QString("%1.%2.log").arg(base).arg(i), QString("%1.%2.log").arg(base).arg(i+1));
+    if(m_maxFiles)
+        QFile::rename(base+".log", base+".1.log");
+    else
+        QFile::remove(base+".log");
+
+    this->open();
+}
@@ -0,0 +1,76 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : the application's logger, the messages are queued without locking & written in batches
+          to the day's log file by a writer thread. the log file is rotated by size, its lines are
+          either text or json.
+*/
+
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <QFile>
+#include <QThread>
+#include <QString>
+#include <QAtomicInt>
+#include <QAtomicPointer>
+
+/* log files are rotated at this size in megabytes, and this many rotated files are kept for a day */
+#define LOG_MAX_SIZE 10
+#define LOG_MAX_FILES 5
+
+/* messages waiting for the writer beyond which new messages are dropped */
+#define LOG_MAX_PENDING 100000
+
+
+class s3s_Logger : public QThread {
+    public:
+        /* starts the writer thread & installs the message handler */
+        explicit s3s_Logger(const QString &directory);
+
+        /* uninstalls the message handler & writes the messages left */
+        ~s3s_Logger() override;
+
+        /* the qt message handler, formats the message & queues it for the writer */
+        static void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg);
+
+        /* path of the day's log file, the file being written */
+        static QString currentFile(const QString &directory);
+
+    protected:
+        void run() override;
+
+    private:
+        struct Node {
+            QByteArray line;
+            QAtomicPointer<Node> next;
+        };
+
+        /* multiple producers & a single consumer, the writer thread */
+        QAtomicPointer<Node> m_head; // the last queued node, producers swap it
+        Node *m_tail; // the consumed node, only used by the writer
+        QAtomicInt m_pending;
+        QAtomicInt m_dropped;
+        QAtomicInt m_stop;
+
+        QString m_directory;
+        QFile m_file;
+        QString m_date;
+        qint64 m_maxSize;
+        int m_maxFiles;
+        bool m_json;
+
+        void enqueue(const QByteArray &line);
+        bool dequeue(QByteArray &line);
+        void flush(); // waits for the writer to write the queued messages
+
+        QByteArray format(QtMsgType type, const QMessageLogContext &context, const QString &msg) const;
+        void write(const QByteArray &batch);
+        void rotate();
+        void open();
+
+        Q_DISABLE_COPY(s3s_Logger)
+};
+
+#endif // LOGGER_H
@@ -0,0 +1,263 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : hot-path instrumentation of the scanners, lock-free histograms of the lookups' timings &
+          of the results' hand-off to the gui thread, exported as json or prometheus text.
+*/
+
+#include "Metrics.h"
+
+#include <QElapsedTimer>
+
+#define SCANNERS static_cast<int>(metrics::SCANNER::END)
+#define HISTOGRAMS static_cast<int>(metrics::HISTOGRAM::END)
+
+
+/* all the metrics are static, nothing is allocated or locked on the hot path */
+static metrics::Histogram s_histograms[SCANNERS][HISTOGRAMS];
+static QAtomicInteger<quint64> s_results[SCANNERS];
+static QAtomicInt s_backlog[SCANNERS];
+
+static QElapsedTimer startedClock(){
+    QElapsedTimer clock;
+    clock.start();
+    return clock;
+}
+
+qint64 metrics::now(){
+    static const QElapsedTimer clock = startedClock();
+    return clock.nsecsElapsed();
+}
+
+///
+/// histogram...
+///
+
+int metrics::Histogram::bucket(quint64 value){
+    if(value < HISTOGRAM_LINEAR)
+        return static_cast<int>(value);
+
+    /* the highest bit then the next 3 bits */
+    int exponent = 63;
+    while(!(value & (Q_UINT64_C(1) << exponent)))
+        exponent--;
+    int sub = static_cast<int>((value >> (exponent-3)) & (HISTOGRAM_SUBBUCKETS-1));
+    return HISTOGRAM_LINEAR+(exponent-4)*HISTOGRAM_SUBBUCKETS+sub;
+}
+
+quint64 metrics::Histogram::upperBound(int bucket){
+    if(bucket < HISTOGRAM_LINEAR)
+        return static_cast<quint64>(bucket);
+
+    int exponent = (bucket-HISTOGRAM_LINEAR)/HISTOGRAM_SUBBUCKETS+4;
+    quint64 sub = static_cast<quint64>((bucket-HISTOGRAM_LINEAR)%HISTOGRAM_SUBBUCKETS);
+    quint64 lower = (Q_UINT64_C(1) << exponent)+(sub << (exponent-3));
+    return lower+(Q_UINT64_C(1) << (exponent-3))-1;
+}
+
+void metrics::Histogram::record(quint64 value){
+    m_buckets[bucket(value)].fetchAndAddRelaxed(1);
+    m_sum.fetchAndAddRelaxed(value);
+
+    quint64 max = m_max.loadAcquire();
+    while(value > max && !m_max.testAndSetOrdered(max, value, max));
+}
+
+metrics::Snapshot metrics::Histogram::snapshot() const {
+    metrics::Snapshot snapshot;
+    quint64 counts[HISTOGRAM_BUCKETS];
+    for(int i = 0; i < HISTOGRAM_BUCKETS; i++){
+        counts[i] = m_buckets[i].loadAcquire();
+        snapshot.count += counts[i];
+    }
+    snapshot.sum = m_sum.loadAcquire();
+    snapshot.max = m_max.loadAcquire();
+    if(!snapshot.count)
+        return snapshot;
+
+    /* the percentiles are the upper bounds of their buckets, within 12.5% of the value */
+    const quint64 p50 = (snapshot.count*50+99)/100;
+    const quint64 p90 = (snapshot.count*90+99)/100;
+    const quint64 p99 = (snapshot.count*99+99)/100;
+    quint64 seen = 0;
+    for(int i = 0; i < HISTOGRAM_BUCKETS; i++){
+        if(!counts[i])
+            continue;
+        quint64 before = seen;
+        seen += counts[i];
+        quint64 bound = qMin(upperBound(i), snapshot.max);
+        if(before < p50 && seen >= p50)
+            snapshot.p50 = bound;
+        if(before < p90 && seen >= p90)
+            snapshot.p90 = bound;
+        if(before < p99 && seen >= p99)
+            snapshot.p99 = bound;
+    }
+    return snapshot;
+}
+
+QList<QPair<quint64, quint64>> metrics::Histogram::cumulative() const {
+    QList<QPair<quint64, quint64>> buckets;
+    quint64 seen = 0;
+    for(int i = 0; i < HISTOGRAM_BUCKETS; i++){
+        quint64 count = m_buckets[i].loadAcquire();
+        if(!count)
+            continue;
+        seen += count;
+        buckets.append(qMakePair(upperBound(i), seen));
+    }
+    return buckets;
+}
+
+void metrics::Histogram::reset(){
+    for(int i = 0; i < HISTOGRAM_BUCKETS; i++)
+        m_buckets[i].storeRelease(0);
+    m_sum.storeRelease(0);
+    m_max.storeRelease(0);
+}
+
+///
+/// the scanners' metrics...
+///
+
+void metrics::record(metrics::SCANNER scanner, metrics::HISTOGRAM histogram, quint64 value){
+    s_histograms[static_cast<int>(scanner)][static_cast<int>(histogram)].record(value);
+}
+
+const metrics::Histogram &metrics::histogram(metrics::SCANNER scanner, metrics::HISTOGRAM histogram){
+    return s_histograms[static_cast<int>(scanner)][static_cast<int>(histogram)];
+}
+
+quint64 metrics::results(metrics::SCANNER scanner){
+    return s_results[static_cast<int>(scanner)].loadAcquire();
+}
+
+int metrics::backlog(metrics::SCANNER scanner){
+    return s_backlog[static_cast<int>(scanner)].loadAcquire();
+}
+
+void metrics::internal::queued(metrics::SCANNER scanner, int &backlog){
+    backlog = s_backlog[static_cast<int>(scanner)].fetchAndAddRelaxed(1)+1;
+}
+
+void metrics::internal::delivered(metrics::SCANNER scanner){
+    s_backlog[static_cast<int>(scanner)].fetchAndAddRelaxed(-1);
+    s_results[static_cast<int>(scanner)].fetchAndAddRelaxed(1);
+}
+
+void metrics::reset(){
+    for(int i = 0; i < SCANNERS; i++){
+        for(int j = 0; j < HISTOGRAMS; j++)
+            s_histograms[i][j].reset();
+        s_results[i].storeRelease(0);
+    }
+}
+
+QString metrics::name(metrics::SCANNER scanner){
+    switch(scanner){
+    case metrics::SCANNER::BRUTE:
+        return "brute";
+    case metrics::SCANNER::ACTIVE:
+        return "active";
+    case metrics::SCANNER::DNS:
+        return "dns";
+    case metrics::SCANNER::SSL:
+        return "ssl";
+    case metrics::SCANNER::URL:
+        return "url";
+    case metrics::SCANNER::OSINT:
+        return "osint";
+    default:
+        return QString();
+    }
+}
+
+QString metrics::name(metrics::HISTOGRAM histogram){
+    switch(histogram){
+    case metrics::HISTOGRAM::QUERY_LATENCY:
+        return "query_latency_us";
+    case metrics::HISTOGRAM::RESOLVER_RTT:
+        return "resolver_rtt_us";
+    case metrics::HISTOGRAM::QUEUE_WAIT:
+        return "queue_wait_us";
+    case metrics::HISTOGRAM::EVENT_BACKLOG:
+        return "event_backlog";
+    case metrics::HISTOGRAM::GUI_SLOT:
+        return "gui_slot_us";
+    default:
+        return QString();
+    }
+}
+
+///
+/// exports...
+///
+
+QJsonObject metrics::toJson(){
+    QJsonObject scanners;
+    for(int i = 0; i < SCANNERS; i++)
+    {
+        metrics::SCANNER scanner = static_cast<metrics::SCANNER>(i);
+
+        QJsonObject object;
+        object.insert("results", static_cast<qint64>(metrics::results(scanner)));
+        object.insert("backlog", metrics::backlog(scanner));
+        for(int j = 0; j < HISTOGRAMS; j++){
+            metrics::HISTOGRAM histogram = static_cast<metrics::HISTOGRAM>(j);
+            metrics::Snapshot snapshot = metrics::histogram(scanner, histogram).snapshot();
+
+            QJsonObject values;
+            values.insert("count", static_cast<qint64>(snapshot.count));
+            values.insert("sum", static_cast<qint64>(snapshot.sum));
+            values.insert("max", static_cast<qint64>(snapshot.max));
+            values.insert("p50", static_cast<qint64>(snapshot.p50));
+            values.insert("p90", static_cast<qint64>(snapshot.p90));
+            values.insert("p99", static_cast<qint64>(snapshot.p99));
+            object.insert(metrics::name(histogram), values);
+        }
+        scanners.insert(metrics::name(scanner), object);
+    }
+    return scanners;
+}
+
+QString metrics::toPrometheus(){
+    QString text;
+
+    text.append("# HELP s3s_results_total results delivered to the gui thread.\n");
+    text.append("# TYPE s3s_results_total counter\n");
+    for(int i = 0; i < SCANNERS; i++){
+        metrics::SCANNER scanner = static_cast<metrics::SCANNER>(i);
+        text.append(QString("s3s_results_total{scanner=\"%1\"} %2\n").arg(metrics::name(scanner)).arg(metrics::results(scanner)));
+    }
+
+    text.append("# HELP s3s_event_backlog_current results waiting in the gui thread's event queue.\n");
+    text.append("# TYPE s3s_event_backlog_current gauge\n");
+    for(int i = 0; i < SCANNERS; i++){
+        metrics::SCANNER scanner = static_cast<metrics::SCANNER>(i);
+        text.append(QString("s3s_event_backlog_current{scanner=\"%1\"} %2\n").arg(metrics::name(scanner)).arg(metrics::backlog(scanner)));
+    }
+
+    for(int j = 0; j < HISTOGRAMS; j++)
+    {
+        metrics::HISTOGRAM histogram = static_cast<metrics::HISTOGRAM>(j);
+        QString name = "s3s_"+metrics::name(histogram);
+        text.append(QString("# TYPE %1 histogram\n").arg(name));
+
+        for(int i = 0; i < SCANNERS; i++){
+            metrics::SCANNER scanner = static_cast<metrics::SCANNER>(i);
+            const metrics::Histogram &values = metrics::histogram(scanner, histogram);
+            QString label = QString("scanner=\"%1\"").arg(metrics::name(scanner));
+
+            typedef QPair<quint64, quint64> Bucket;
+            foreach(const Bucket &bucket, values.cumulative())
+                text.append(QString("%1_bucket{%2,le=\"%3\"} %4\n").arg(name).arg(label).arg(bucket.first).arg(bucket.second));
+
+            metrics::Snapshot snapshot = values.snapshot();
+            text.append(QString("%1_bucket{%2,le=\"+Inf\"} %3\n").arg(name).arg(label).arg(snapshot.count));
+            text.append(QString("%1_sum{%2} %3\n").arg(name).arg(label).arg(snapshot.sum));
+            text.append(QString("%1_count{%2} %3\n").arg(name).arg(label).arg(snapshot.count));
+        }
+    }
+    return text;
+}
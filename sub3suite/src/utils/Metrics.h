@@ -0,0 +1,130 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : hot-path instrumentation of the scanners, lock-free histograms of the lookups' timings &
+          of the results' hand-off to the gui thread, exported as json or prometheus text.
+*/
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <QPair>
+#include <QObject>
+#include <QString>
+#include <QAtomicInteger>
+#include <QJsonObject>
+
+/* histogram buckets, 16 linear buckets then 8 buckets for each power of 2 */
+#define HISTOGRAM_LINEAR 16
+#define HISTOGRAM_SUBBUCKETS 8
+#define HISTOGRAM_BUCKETS (HISTOGRAM_LINEAR+(64-4)*HISTOGRAM_SUBBUCKETS)
+
+
+namespace metrics {
+
+enum class SCANNER {
+    BRUTE,
+    ACTIVE,
+    DNS,
+    SSL,
+    URL,
+    OSINT,
+    END
+};
+
+enum class HISTOGRAM {
+    QUERY_LATENCY,  // microseconds, a target's handling on the scanner thread, from taking it to its outcome
+    RESOLVER_RTT,   // microseconds, a lookup's round trip, from sending it to its reply or timeout
+    QUEUE_WAIT,     // microseconds, a result's wait in the gui thread's event queue
+    EVENT_BACKLOG,  // results waiting in the gui thread's event queue, sampled on each result
+    GUI_SLOT,       // microseconds, the gui thread's slot handling a result
+    END
+};
+
+struct Snapshot {
+    quint64 count = 0;
+    quint64 sum = 0;
+    quint64 max = 0;
+    quint64 p50 = 0;
+    quint64 p90 = 0;
+    quint64 p99 = 0;
+};
+
+class Histogram {
+    public:
+        void record(quint64 value);
+        metrics::Snapshot snapshot() const;
+        void reset();
+
+        /* the buckets' upper bounds & cumulative counts, for the prometheus export */
+        QList<QPair<quint64, quint64>> cumulative() const;
+
+        static int bucket(quint64 value);
+        static quint64 upperBound(int bucket);
+
+    private:
+        QAtomicInteger<quint64> m_buckets[HISTOGRAM_BUCKETS];
+        QAtomicInteger<quint64> m_sum;
+        QAtomicInteger<quint64> m_max;
+};
+
+/* nanoseconds on a monotonic clock */
+qint64 now();
+
+void record(metrics::SCANNER scanner, metrics::HISTOGRAM histogram, quint64 value);
+
+/* microseconds since a start time from now() */
+inline void recordSince(metrics::SCANNER scanner, metrics::HISTOGRAM histogram, qint64 start){
+    metrics::record(scanner, histogram, static_cast<quint64>(qMax<qint64>(0, metrics::now()-start)/1000));
+}
+
+const metrics::Histogram &histogram(metrics::SCANNER scanner, metrics::HISTOGRAM histogram);
+
+quint64 results(metrics::SCANNER scanner); // results delivered to the gui thread
+int backlog(metrics::SCANNER scanner);     // results waiting in the gui thread's event queue
+
+void reset();
+
+QString name(metrics::SCANNER scanner);
+QString name(metrics::HISTOGRAM histogram);
+
+QJsonObject toJson();
+QString toPrometheus();
+
+namespace internal {
+void queued(metrics::SCANNER scanner, int &backlog);
+void delivered(metrics::SCANNER scanner);
+}
+
+/*
+ * posts a result's slot to the receiver's thread, measuring the result's wait in the event queue,
+ * the backlog of the queue & the slot's time. called from the scanner's thread.
+ */
+template <typename Functor>
+void post(metrics::SCANNER scanner, QObject *receiver, Functor slot){
+    qint64 queued = metrics::now();
+    int backlog = 0;
+    metrics::internal::queued(scanner, backlog);
+    metrics::record(scanner, metrics::HISTOGRAM::EVENT_BACKLOG, static_cast<quint64>(backlog));
+
+    QMetaObject::invokeMethod(receiver, [=](){
+        qint64 start = metrics::now();
+        metrics::record(scanner, metrics::HISTOGRAM::QUEUE_WAIT, static_cast<quint64>((start-queued)/1000));
+        metrics::internal::delivered(scanner);
+        slot();
+        metrics::recordSince(scanner, metrics::HISTOGRAM::GUI_SLOT, start);
+    }, Qt::QueuedConnection);
+}
+
+/* connects a scanner's result signal to the engine's slot through metrics::post */
+template <typename Sender, typename Signal, typename Receiver, typename... Args>
+void connect(metrics::SCANNER scanner, Sender *sender, Signal signal, Receiver *receiver, void (Receiver::*slot)(Args...)){
+    QObject::connect(sender, signal, sender, [=](Args... args){
+        metrics::post(scanner, receiver, [=](){(receiver->*slot)(args...);});
+    }, Qt::DirectConnection);
+}
+
+}
+
+#endif // METRICS_H
@@ -0,0 +1,196 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief :
+*/
+
+#include "RdapRegistry.h"
+
+#include <QHostAddress>
+#include <QJsonDocument>
+#include <QMutexLocker>
+
+s3s_RdapRegistry::s3s_RdapRegistry(){
+    m_clock.start();
+    m_records.setMaxCost(RDAP_CACHE_SIZE);
+}
+
+s3s_RdapRegistry &s3s_RdapRegistry::instance(){
+    static s3s_RdapRegistry rdap;
+    return rdap;
+}
+
+QList<QUrl> s3s_RdapRegistry::bootstrapUrls(rdap::TYPE type){
+    switch(type){
+    case rdap::TYPE::ASN:
+        return {QUrl("https://data.iana.org/rdap/asn.json")};
+    case rdap::TYPE::IP:
+        return {QUrl("https://data.iana.org/rdap/ipv4.json"), QUrl("https://data.iana.org/rdap/ipv6.json")};
+    case rdap::TYPE::DOMAIN:
+        return {QUrl("https://data.iana.org/rdap/dns.json")};
+    }
+    return {};
+}
+
+///
+/// bootstrap...
+///
+
+bool s3s_RdapRegistry::isBootstrapped(rdap::TYPE type){
+    QMutexLocker locker(&m_mutex);
+    foreach(const QUrl &url, bootstrapUrls(type)){
+        if(!m_bootstraps.contains(url))
+            return false;
+    }
+    return true;
+}
+
+/* the https url of a service, the first url if none is https */
+int s3s_RdapRegistry::serverIndex(const QJsonArray &urls){
+    QString server;
+    foreach(const QJsonValue &value, urls){
+        if(server.isEmpty() || value.toString().startsWith("https://"))
+            server = value.toString();
+        if(server.startsWith("https://"))
+            break;
+    }
+    if(server.isEmpty())
+        return -1;
+    if(!server.endsWith('/'))
+        server.append('/');
+
+    int index = m_servers.indexOf(server);
+    if(index == -1){
+        m_servers.append(server);
+        index = m_servers.size()-1;
+    }
+    return index;
+}
+
+bool s3s_RdapRegistry::loadBootstrap(rdap::TYPE type, const QUrl &url, const QByteArray &json){
+    QJsonDocument document = QJsonDocument::fromJson(json);
+    if(!document.isObject())
+        return false;
+
+    QMutexLocker locker(&m_mutex);
+
+    /* loaded by an other module's thread meanwhile */
+    if(m_bootstraps.contains(url))
+        return true;
+
+    /* each service is a list of entries & the urls of the registry serving them */
+    foreach(const QJsonValue &value, document.object()["services"].toArray())
+    {
+        QJsonArray service = value.toArray();
+        int server = this->serverIndex(service.at(1).toArray());
+        if(server == -1)
+            continue;
+
+        foreach(const QJsonValue &entry, service.at(0).toArray())
+        {
+            QString text = entry.toString().trimmed().toLower();
+            switch(type){
+            case rdap::TYPE::ASN:
+            {
+                AsnRange range;
+                range.first = text.section('-', 0, 0).toUInt();
+                range.last = text.contains('-')? text.section('-', 1, 1).toUInt() : range.first;
+                range.server = server;
+                m_asns.append(range);
+                break;
+            }
+            case rdap::TYPE::IP:
+            {
+                Q_IPV6ADDR address;
+                int offset;
+                if(s3s_mappedAddress(text.section('/', 0, 0), address, offset))
+                    m_ips.insert(address, offset+text.section('/', 1, 1).toInt(), static_cast<quint32>(server));
+                break;
+            }
+            case rdap::TYPE::DOMAIN:
+                m_tlds.insert(text, server);
+                break;
+            }
+        }
+    }
+    m_bootstraps.insert(url);
+    return true;
+}
+
+QString s3s_RdapRegistry::server(rdap::TYPE type, const QString &target){
+    QMutexLocker locker(&m_mutex);
+
+    switch(type){
+    case rdap::TYPE::ASN:
+    {
+        QString number = target.trimmed();
+        if(number.startsWith("as", Qt::CaseInsensitive))
+            number.remove(0, 2);
+        quint32 asn = number.toUInt();
+        foreach(const AsnRange &range, m_asns){
+            if(asn >= range.first && asn <= range.last)
+                return m_servers.at(range.server);
+        }
+        break;
+    }
+    case rdap::TYPE::IP:
+    {
+        Q_IPV6ADDR address;
+        int offset, length;
+        quint32 server;
+        if(s3s_mappedAddress(target.trimmed().section('/', 0, 0), address, offset) && m_ips.lookup(address, server, length))
+            return m_servers.at(static_cast<int>(server));
+        break;
+    }
+    case rdap::TYPE::DOMAIN:
+    {
+        /* the longest suffix of the domain with a registry */
+        QStringList labels = target.trimmed().toLower().split('.', QString::SkipEmptyParts);
+        for(int i = 0; i < labels.size(); i++){
+            QString suffix = QStringList(labels.mid(i)).join('.');
+            if(m_tlds.contains(suffix))
+                return m_servers.at(m_tlds.value(suffix));
+        }
+        break;
+    }
+    }
+    return QString();
+}
+
+///
+/// rate limit...
+///
+
+int s3s_RdapRegistry::reserve(const QString &registry, int interval){
+    QMutexLocker locker(&m_mutex);
+
+    qint64 now = m_clock.elapsed();
+    qint64 slot = qMax(now, m_slots.value(registry, 0));
+    m_slots.insert(registry, slot+interval);
+    return static_cast<int>(slot-now);
+}
+
+///
+/// cache...
+///
+
+bool s3s_RdapRegistry::cached(const QString &key, QJsonObject &record){
+    QMutexLocker locker(&m_mutex);
+
+    QJsonObject *object = m_records.object(key);
+    if(!object)
+        return false;
+    record = *object;
+    return true;
+}
+
+void s3s_RdapRegistry::cache(const QString &key, const QJsonObject &record){
+    QMutexLocker locker(&m_mutex);
+    m_records.insert(key, new QJsonObject(record));
+}
+
+void s3s_RdapRegistry::setCacheSize(int size){
+    QMutexLocker locker(&m_mutex);
+    m_records.setMaxCost(size);
+}
@@ -0,0 +1,89 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : registry lookups shared by the rdap & whois modules' threads, the iana bootstrap
+          registries selecting the rdap server of an asn, an ip or a domain, a rate limit of
+          the requests to each registry & a cache of the parsed records.
+*/
+
+#ifndef RDAPREGISTRY_H
+#define RDAPREGISTRY_H
+
+#include <QUrl>
+#include <QSet>
+#include <QHash>
+#include <QMutex>
+#include <QCache>
+#include <QVector>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QElapsedTimer>
+
+#include "IpDatabase.h"
+
+/* parsed records kept, by default */
+#define RDAP_CACHE_SIZE 4096
+
+/* milliseconds between two requests to the same registry, by default */
+#define RDAP_INTERVAL 250
+
+
+namespace rdap {
+
+enum class TYPE {
+    ASN,
+    IP,
+    DOMAIN
+};
+
+}
+
+class s3s_RdapRegistry {
+    public:
+        /* the application's registries, used from the modules' threads */
+        static s3s_RdapRegistry &instance();
+
+        /* the iana bootstrap registries of a type of lookup, ipv4 & ipv6 for ips */
+        static QList<QUrl> bootstrapUrls(rdap::TYPE type);
+
+        /* true once all the bootstrap registries of the type are loaded */
+        bool isBootstrapped(rdap::TYPE type);
+        bool loadBootstrap(rdap::TYPE type, const QUrl &url, const QByteArray &json);
+
+        /* the base url of the rdap server of a target, empty if no registry has one */
+        QString server(rdap::TYPE type, const QString &target);
+
+        /* milliseconds to wait before the next request to a registry, the request's slot is then reserved */
+        int reserve(const QString &registry, int interval);
+
+        /* parsed records, by the lookup's type & target */
+        bool cached(const QString &key, QJsonObject &record);
+        void cache(const QString &key, const QJsonObject &record);
+        void setCacheSize(int size);
+
+    private:
+        s3s_RdapRegistry();
+
+        QMutex m_mutex;
+        QStringList m_servers; // the base urls, the bootstraps' values are their indexes
+        QSet<QUrl> m_bootstraps; // the loaded bootstrap registries
+
+        struct AsnRange {
+            quint32 first;
+            quint32 last;
+            int server;
+        };
+        QVector<AsnRange> m_asns;
+        s3s_PrefixTrie m_ips; // ipv4 as ipv4-mapped addresses
+        QHash<QString, int> m_tlds;
+
+        QElapsedTimer m_clock;
+        QHash<QString, qint64> m_slots; // the next free slot of each registry
+
+        QCache<QString, QJsonObject> m_records;
+
+        int serverIndex(const QJsonArray &urls);
+};
+
+#endif // RDAPREGISTRY_H
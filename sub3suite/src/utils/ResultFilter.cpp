@@ -0,0 +1,84 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : a thread-safe duplicates filter shared by the scanning threads of an engine, results are
+          checked in the scanning threads so only unique results are sent to the engine.
+*/
+
+#include "ResultFilter.h"
+
+#include <QHash>
+#include <QDebug>
+#include <new>
+
+/* bloom filter bits per expected result & number of hashes, for a 1 in 10000 false positive rate */
+#define BLOOM_BITS_PER_RESULT 20
+#define BLOOM_HASHES 13
+
+
+s3s_ResultFilter::s3s_ResultFilter(quint64 expectedResults)
+{
+    if(expectedResults < FILTER_BLOOM_THRESHOLD)
+        return;
+
+    /* the bit array is capped, the false positive rate grows past the cap */
+    quint64 bits = FILTER_BLOOM_MAX_BITS;
+    if(expectedResults < FILTER_BLOOM_MAX_BITS/BLOOM_BITS_PER_RESULT)
+        bits = expectedResults*BLOOM_BITS_PER_RESULT;
+
+    m_bloom = new(std::nothrow) QAtomicInteger<quint32>[(bits/32)+1];
+    if(!m_bloom){
+        qWarning() << "[ResultFilter] no memory for the bloom filter of" << expectedResults << "results, using the sets";
+        return;
+    }
+    m_bloomBits = bits;
+    m_bloomHashes = BLOOM_HASHES;
+    qInfo() << "[ResultFilter]" << expectedResults << "expected results, using a lossy bloom filter of" << bits << "bits";
+}
+s3s_ResultFilter::~s3s_ResultFilter(){
+    delete[] m_bloom;
+}
+
+bool s3s_ResultFilter::insert(const QString &result){
+    ///
+    /// bloom filter, test and set the bits without locking...
+    ///
+    if(m_bloom){
+        /* double hashing to obtain the bit positions */
+        const quint64 h1 = qHash(result, 0x5bd1e995);
+        const quint64 h2 = qHash(result, 0x9e3779b9) | 1;
+
+        bool isNew = false;
+        for(int i = 0; i < m_bloomHashes; i++){
+            const quint64 bit = (h1+i*h2) % m_bloomBits;
+            const quint32 mask = 1u << (bit % 32);
+            if(!(m_bloom[bit/32].fetchAndOrRelaxed(mask) & mask))
+                isNew = true;
+        }
+        return isNew;
+    }
+
+    ///
+    /// sharded sets...
+    ///
+    Shard &shard = m_shards[qHash(result) % FILTER_SHARDS];
+    QMutexLocker locker(&shard.mutex);
+
+    int size = shard.results.size();
+    shard.results.insert(result);
+    return shard.results.size() != size;
+}
+
+void s3s_ResultFilter::clear(){
+    if(m_bloom){
+        for(quint64 i = 0; i < (m_bloomBits/32)+1; i++)
+            m_bloom[i].store(0);
+        return;
+    }
+
+    for(int i = 0; i < FILTER_SHARDS; i++){
+        QMutexLocker locker(&m_shards[i].mutex);
+        m_shards[i].results.clear();
+    }
+}
@@ -0,0 +1,59 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : a thread-safe duplicates filter shared by the scanning threads of an engine, results are
+          checked in the scanning threads so only unique results are sent to the engine.
+*/
+
+#ifndef RESULTFILTER_H
+#define RESULTFILTER_H
+
+#include <QSet>
+#include <QMutex>
+#include <QString>
+#include <QAtomicInteger>
+
+/* number of independently locked sets */
+#define FILTER_SHARDS 64
+
+/* expected number of results from which the bloom filter is used instead of the sets */
+#define FILTER_BLOOM_THRESHOLD 5000000
+
+/* maximum size of the bloom filter's bit array, 2^30 bits (128 MiB) */
+#define FILTER_BLOOM_MAX_BITS (Q_UINT64_C(1) << 30)
+
+
+class s3s_ResultFilter {
+    public:
+        /*
+         * expectedResults is the number of unique results expected, not the number of candidates scanned.
+         * from FILTER_BLOOM_THRESHOLD a lock-free bloom filter is used, its memory is fixed & capped at
+         * FILTER_BLOOM_MAX_BITS but the filter is lossy: about 1 in 10000 unique results is dropped as a
+         * duplicate, more past the cap. the switch is logged, the sets are kept if the array can't be allocated.
+         */
+        explicit s3s_ResultFilter(quint64 expectedResults = 0);
+        ~s3s_ResultFilter();
+
+        /* returns true if the result was not seen before */
+        bool insert(const QString &result);
+        void clear();
+
+        bool isBloom() const { return m_bloom != nullptr; }
+
+    private:
+        struct Shard {
+            QMutex mutex;
+            QSet<QString> results;
+        };
+        Shard m_shards[FILTER_SHARDS];
+
+        /* bloom filter */
+        QAtomicInteger<quint32> *m_bloom = nullptr;
+        quint64 m_bloomBits = 0;
+        int m_bloomHashes = 0;
+
+        Q_DISABLE_COPY(s3s_ResultFilter)
+};
+
+#endif // RESULTFILTER_H
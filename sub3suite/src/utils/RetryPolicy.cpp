@@ -0,0 +1,152 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : automatic retry of failed targets inside the running scan, failures are classified
+          & retried with an exponential backoff with jitter up to a maximum number of retries.
+*/
+
+#include "RetryPolicy.h"
+
+#include <QDateTime>
+#include <QStringList>
+#include <QRandomGenerator>
+
+
+bool retry::Policy::retries(retry::ERROR error, int retry) const {
+    if(retry > maxRetries)
+        return false;
+
+    switch(error){
+    case retry::ERROR::TIMEOUT:
+        return onTimeout;
+    case retry::ERROR::REFUSED:
+        return onRefused;
+    case retry::ERROR::SERVFAIL:
+        return onServfail;
+    case retry::ERROR::RATELIMIT:
+        return onRateLimit;
+    default:
+        return false;
+    }
+}
+
+int retry::Policy::delay(int retry) const {
+    qint64 delay = backoff;
+    for(int i = 1; i < retry && delay < maxBackoff; i++)
+        delay *= 2;
+    delay = qMin<qint64>(delay, maxBackoff);
+
+    /* half of the backoff plus a random jitter up to the other half */
+    int half = static_cast<int>(delay/2);
+    if(half < 1)
+        return static_cast<int>(delay);
+    return half+QRandomGenerator::global()->bounded(half);
+}
+
+retry::ERROR retry::classify(QDnsLookup::Error error){
+    switch(error){
+    case QDnsLookup::OperationCancelledError: // aborted by the lookup timeout
+    case QDnsLookup::ResolverError:
+        return retry::ERROR::TIMEOUT;
+    case QDnsLookup::ServerRefusedError:
+        return retry::ERROR::REFUSED;
+    case QDnsLookup::ServerFailureError:
+    case QDnsLookup::InvalidReplyError:
+        return retry::ERROR::SERVFAIL;
+    default:
+        return retry::ERROR::NONE;
+    }
+}
+
+retry::ERROR retry::classify(QNetworkReply *reply){
+    int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if(statusCode == 429)
+        return retry::ERROR::RATELIMIT;
+    if(statusCode >= 500)
+        return retry::ERROR::SERVFAIL;
+
+    switch(reply->error()){
+    case QNetworkReply::OperationCanceledError: // aborted by the reply timeout
+    case QNetworkReply::TimeoutError:
+    case QNetworkReply::TemporaryNetworkFailureError:
+        return retry::ERROR::TIMEOUT;
+    case QNetworkReply::ConnectionRefusedError:
+    case QNetworkReply::RemoteHostClosedError:
+        return retry::ERROR::REFUSED;
+    default:
+        return retry::ERROR::NONE;
+    }
+}
+
+retry::ERROR retry::classify(QAbstractSocket::SocketError error){
+    switch(error){
+    case QAbstractSocket::SocketTimeoutError:
+        return retry::ERROR::TIMEOUT;
+    case QAbstractSocket::ConnectionRefusedError:
+    case QAbstractSocket::RemoteHostClosedError:
+        return retry::ERROR::REFUSED;
+    default:
+        return retry::ERROR::NONE;
+    }
+}
+
+QString retry::rotate(const QStringList &nameservers, const QString &current, int retry){
+    if(nameservers.size() < 2)
+        return current;
+
+    int index = nameservers.indexOf(current);
+    if(index == -1)
+        index = 0;
+    return nameservers.at((index+retry) % nameservers.size());
+}
+
+///
+/// retry queue...
+///
+
+void retry::Queue::schedule(const QString &target, int retry, int delay){
+    this->schedule(target, QString(), retry, delay);
+}
+
+void retry::Queue::schedule(const QString &target, const QString &context, int retry, int delay){
+    QMutexLocker locker(&m_mutex);
+
+    Target t;
+    t.target = target;
+    t.context = context;
+    t.retry = retry;
+    m_targets.insert(QDateTime::currentMSecsSinceEpoch()+delay, t);
+}
+
+bool retry::Queue::take(QString &target, int &retry){
+    QString context;
+    return this->take(target, context, retry);
+}
+
+bool retry::Queue::take(QString &target, QString &context, int &retry){
+    QMutexLocker locker(&m_mutex);
+
+    if(m_targets.isEmpty() || m_targets.firstKey() > QDateTime::currentMSecsSinceEpoch())
+        return false;
+
+    QMultiMap<qint64, Target>::iterator first = m_targets.begin();
+    target = first.value().target;
+    context = first.value().context;
+    retry = first.value().retry;
+    m_targets.erase(first);
+    return true;
+}
+
+int retry::Queue::nextDelay(){
+    QMutexLocker locker(&m_mutex);
+
+    if(m_targets.isEmpty())
+        return -1;
+    return static_cast<int>(qMax<qint64>(0, m_targets.firstKey()-QDateTime::currentMSecsSinceEpoch()));
+}
+
+void retry::Queue::clear(){
+    QMutexLocker locker(&m_mutex);
+    m_targets.clear();
+}
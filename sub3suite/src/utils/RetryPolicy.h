@@ -0,0 +1,88 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : automatic retry of failed targets inside the running scan, failures are classified
+          & retried with an exponential backoff with jitter up to a maximum number of retries.
+*/
+
+#ifndef RETRYPOLICY_H
+#define RETRYPOLICY_H
+
+#include <QMutex>
+#include <QString>
+#include <QMultiMap>
+#include <QDnsLookup>
+#include <QNetworkReply>
+#include <QAbstractSocket>
+
+/* network request attribute holding the retry count of a request */
+#define RETRY_ATTRIBUTE static_cast<QNetworkRequest::Attribute>(QNetworkRequest::User+9)
+
+namespace retry {
+
+enum class ERROR { // retry classes
+    NONE,       // not retried eg. NXDOMAIN, 404
+    TIMEOUT,
+    REFUSED,
+    SERVFAIL,   // SERVFAIL & invalid replies, http 5xx
+    RATELIMIT   // http 429
+};
+
+struct Policy {
+    int maxRetries = 2;
+    int backoff = 500;      // milliseconds before the first retry, doubled on each retry
+    int maxBackoff = 10000;
+
+    bool onTimeout = true;
+    bool onRefused = true;
+    bool onServfail = true;
+    bool onRateLimit = true;
+
+    /* if a failure of this class on this retry should be retried */
+    bool retries(retry::ERROR error, int retry) const;
+
+    /* backoff for the retry with jitter, in milliseconds */
+    int delay(int retry) const;
+};
+
+retry::ERROR classify(QDnsLookup::Error error);
+retry::ERROR classify(QNetworkReply *reply);
+retry::ERROR classify(QAbstractSocket::SocketError error);
+
+/* a different nameserver from the list for each retry */
+QString rotate(const QStringList &nameservers, const QString &current, int retry);
+
+///
+/// \brief The Queue class, a thread-safe queue of the targets waiting for their retry
+///
+class Queue {
+    public:
+        void schedule(const QString &target, int retry, int delay);
+
+        /* with the context of the target eg. the domain a brute-forced name was generated from */
+        void schedule(const QString &target, const QString &context, int retry, int delay);
+
+        /* a target whose backoff has elapsed, returns false if there is none */
+        bool take(QString &target, int &retry);
+        bool take(QString &target, QString &context, int &retry);
+
+        /* milliseconds before the next target is ready, -1 if there are no targets */
+        int nextDelay();
+
+        void clear();
+
+    private:
+        struct Target {
+            QString target;
+            QString context;
+            int retry;
+        };
+
+        QMutex m_mutex;
+        QMultiMap<qint64, Target> m_targets; // by the time they are ready
+};
+
+}
+
+#endif // RETRYPOLICY_H
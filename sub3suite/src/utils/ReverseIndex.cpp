@@ -0,0 +1,289 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief :
+*/
+
+#include "ReverseIndex.h"
+#include "Hostname.h"
+#include "Config.h"
+
+#include <QFile>
+#include <QDebug>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QHostAddress>
+#include <QCoreApplication>
+#include <algorithm>
+
+/* the index file's header */
+#define REVERSE_INDEX_MAGIC 0x53334958 // "S3IX"
+#define REVERSE_INDEX_VERSION 1
+
+#define REVERSE_INDEX_FILE "/reverse_index.dat"
+
+#define KINDS 4
+
+
+s3s_ReverseIndex &s3s_ReverseIndex::instance(){
+    static s3s_ReverseIndex index;
+    if(!index.m_loaded){
+        index.m_loaded = true;
+        if(QFile::exists(configuredPath()) && !index.load(configuredPath()))
+            qWarning() << "[Reverse-Index]" << index.error();
+    }
+    return index;
+}
+
+QString s3s_ReverseIndex::configuredPath(){
+    QString path = CONFIG.value(CFG_VAL_REVERSE_INDEX).toString();
+    if(path.isEmpty())
+        path = QCoreApplication::applicationDirPath()+REVERSE_INDEX_FILE;
+    return path;
+}
+
+///
+/// the file...
+///
+
+bool s3s_ReverseIndex::load(const QString &path){
+    QFile file(path);
+    if(!file.open(QIODevice::ReadOnly)){
+        m_error = path+": "+file.errorString();
+        return false;
+    }
+
+    QByteArray data = qUncompress(file.readAll());
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic = 0, version = 0;
+    stream >> magic >> version;
+    if(magic != REVERSE_INDEX_MAGIC || version != REVERSE_INDEX_VERSION){
+        m_error = path+": not a reverse index file";
+        return false;
+    }
+
+    /* the file's names are merged with the index's, their ids are mapped to the index's */
+    quint32 count = 0;
+    stream >> count;
+    QVector<quint32> ids;
+    ids.reserve(static_cast<int>(qMin<quint32>(count, 1 << 24)));
+    for(quint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++){
+        QString name;
+        stream >> name;
+        ids.append(this->intern(name));
+    }
+
+    for(int kind = 0; kind < KINDS && stream.status() == QDataStream::Ok; kind++)
+    {
+        quint32 keys = 0;
+        stream >> keys;
+        for(quint32 i = 0; i < keys && stream.status() == QDataStream::Ok; i++){
+            quint32 key = 0, size = 0;
+            stream >> key >> size;
+            if(key >= static_cast<quint32>(ids.size()))
+                break;
+
+            QSet<quint32> &names = m_index[kind][ids.at(static_cast<int>(key))];
+            for(quint32 j = 0; j < size && stream.status() == QDataStream::Ok; j++){
+                quint32 name = 0;
+                stream >> name;
+                if(name < static_cast<quint32>(ids.size()))
+                    names.insert(ids.at(static_cast<int>(name)));
+            }
+        }
+    }
+
+    if(stream.status() != QDataStream::Ok){
+        m_error = path+": truncated reverse index file";
+        return false;
+    }
+    return true;
+}
+
+bool s3s_ReverseIndex::save(const QString &path){
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    stream << static_cast<quint32>(REVERSE_INDEX_MAGIC) << static_cast<quint32>(REVERSE_INDEX_VERSION);
+    stream << static_cast<quint32>(m_names.size());
+    foreach(const QString &name, m_names)
+        stream << name;
+
+    for(int kind = 0; kind < KINDS; kind++)
+    {
+        stream << static_cast<quint32>(m_index[kind].size());
+        QHash<quint32, QSet<quint32>>::const_iterator i = m_index[kind].constBegin();
+        for(; i != m_index[kind].constEnd(); ++i){
+            stream << i.key() << static_cast<quint32>(i.value().size());
+            foreach(quint32 name, i.value())
+                stream << name;
+        }
+    }
+
+    /* written to a temporary file first, an interrupted save keeps the previous index */
+    QSaveFile file(path);
+    if(!file.open(QIODevice::WriteOnly) || file.write(qCompress(data)) < 0 || !file.commit()){
+        m_error = path+": "+file.errorString();
+        return false;
+    }
+    m_modified = false;
+    return true;
+}
+
+bool s3s_ReverseIndex::saveConfigured(){
+    if(!m_modified)
+        return true;
+    if(this->save(configuredPath()))
+        return true;
+
+    qWarning() << "[Reverse-Index]" << m_error;
+    return false;
+}
+
+///
+/// inserting...
+///
+
+quint32 s3s_ReverseIndex::intern(const QString &name){
+    QHash<QString, quint32>::const_iterator i = m_ids.constFind(name);
+    if(i != m_ids.constEnd())
+        return i.value();
+
+    quint32 id = static_cast<quint32>(m_names.size());
+    m_names.append(name);
+    m_ids.insert(name, id);
+    return id;
+}
+
+QString s3s_ReverseIndex::normalizeKey(reverse::KIND kind, const QString &key){
+    switch(kind){
+    case reverse::KIND::NS:
+    case reverse::KIND::MX:
+        return s3s_Hostname::normalize(key);
+    case reverse::KIND::IP:
+    {
+        QHostAddress address;
+        if(!address.setAddress(key.trimmed()))
+            return QString();
+        return address.toString();
+    }
+    case reverse::KIND::CERT:
+    {
+        /* hex, with or without the colons of the dialogs */
+        QString hash = key.trimmed().toLower().remove(':');
+        if(hash.length() != 40 && hash.length() != 64)
+            return QString();
+        foreach(const QChar &c, hash){
+            if(!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f')))
+                return QString();
+        }
+        return hash;
+    }
+    }
+    return QString();
+}
+
+bool s3s_ReverseIndex::insert(reverse::KIND kind, const QString &key, const QString &name){
+    QString normalizedKey = normalizeKey(kind, key);
+    QString normalizedName = s3s_Hostname::normalize(name);
+    if(normalizedKey.isNull() || normalizedName.isNull())
+        return false;
+
+    QSet<quint32> &names = m_index[static_cast<int>(kind)][this->intern(normalizedKey)];
+    quint32 id = this->intern(normalizedName);
+    if(names.contains(id))
+        return false;
+
+    names.insert(id);
+    m_modified = true;
+    return true;
+}
+
+int s3s_ReverseIndex::insert(const s3s_struct::DNS &dns){
+    int count = 0;
+    foreach(const QString &ns, dns.NS)
+        count += this->insert(reverse::KIND::NS, ns, dns.dns);
+    foreach(const QString &mx, dns.MX)
+        count += this->insert(reverse::KIND::MX, mx, dns.dns);
+    foreach(const QString &ip, dns.A)
+        count += this->insert(reverse::KIND::IP, ip, dns.dns);
+    foreach(const QString &ip, dns.AAAA)
+        count += this->insert(reverse::KIND::IP, ip, dns.dns);
+    return count;
+}
+
+int s3s_ReverseIndex::insert(const s3s_struct::HOST &host){
+    int count = 0;
+    if(!host.ipv4.isEmpty())
+        count += this->insert(reverse::KIND::IP, host.ipv4, host.host);
+    if(!host.ipv6.isEmpty())
+        count += this->insert(reverse::KIND::IP, host.ipv6, host.host);
+    return count;
+}
+
+int s3s_ReverseIndex::insert(const s3s_struct::NS &ns){
+    int count = 0;
+    foreach(const QString &domain, ns.domains)
+        count += this->insert(reverse::KIND::NS, ns.ns, domain);
+    return count;
+}
+
+int s3s_ReverseIndex::insert(const s3s_struct::MX &mx){
+    int count = 0;
+    foreach(const QString &domain, mx.domains)
+        count += this->insert(reverse::KIND::MX, mx.mx, domain);
+    return count;
+}
+
+int s3s_ReverseIndex::insert(const s3s_struct::IP &ip){
+    int count = 0;
+    foreach(const QString &domain, ip.domains)
+        count += this->insert(reverse::KIND::IP, ip.ip, domain);
+    return count;
+}
+
+int s3s_ReverseIndex::insert(const QString &target, const QSslCertificate &cert){
+    if(cert.isNull())
+        return 0;
+
+    /* the target, the common names & the dns alternative names, by both fingerprints */
+    QStringList names(target);
+    names.append(cert.subjectInfo(QSslCertificate::CommonName));
+    names.append(cert.subjectAlternativeNames().values(QSsl::DnsEntry));
+
+    const QString sha1 = cert.digest(QCryptographicHash::Sha1).toHex();
+    const QString sha256 = cert.digest(QCryptographicHash::Sha256).toHex();
+    int count = 0;
+    foreach(const QString &name, names){
+        count += this->insert(reverse::KIND::CERT, sha1, name);
+        count += this->insert(reverse::KIND::CERT, sha256, name);
+    }
+    return count;
+}
+
+///
+/// lookups...
+///
+
+QStringList s3s_ReverseIndex::lookup(reverse::KIND kind, const QString &key) const {
+    QString normalizedKey = normalizeKey(kind, key);
+    if(normalizedKey.isNull())
+        return QStringList();
+
+    quint32 id = m_ids.value(normalizedKey, static_cast<quint32>(m_names.size()));
+    const QHash<quint32, QSet<quint32>> &index = m_index[static_cast<int>(kind)];
+    QHash<quint32, QSet<quint32>>::const_iterator i = index.constFind(id);
+    if(i == index.constEnd())
+        return QStringList();
+
+    QStringList names;
+    names.reserve(i.value().size());
+    foreach(quint32 name, i.value())
+        names.append(m_names.at(static_cast<int>(name)));
+    std::sort(names.begin(), names.end());
+    return names;
+}
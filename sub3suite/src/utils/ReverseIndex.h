@@ -0,0 +1,87 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : a local reverse lookup index, the domains of each nameserver & mail exchanger and the
+          hostnames of each ip & certificate, filled as the dns, host & ssl results of the scans come
+          in. it is kept in a file shared by all the projects, the ns & mx enumerators
+          query it before their apis. the names are interned, a key's names are a set of ids.
+*/
+
+#ifndef REVERSEINDEX_H
+#define REVERSEINDEX_H
+
+#include <QSet>
+#include <QHash>
+#include <QVector>
+#include <QString>
+#include <QSslCertificate>
+
+#include "src/items/DNSItem.h"
+#include "src/items/HostItem.h"
+#include "src/items/NSItem.h"
+#include "src/items/MXItem.h"
+#include "src/items/IPItem.h"
+
+
+namespace reverse {
+
+enum class KIND {
+    NS,   // nameserver -> domains
+    MX,   // mail exchanger -> domains
+    IP,   // address -> hostnames
+    CERT  // sha1 or sha256 fingerprint -> hostnames
+};
+
+}
+
+class s3s_ReverseIndex {
+    public:
+        /* the application's index, loaded from the configured file & used on the gui thread */
+        static s3s_ReverseIndex &instance();
+
+        bool load(const QString &path);
+        bool save(const QString &path);
+
+        /* the file of the [General] section, reverse_index.dat of the application's directory if none */
+        static QString configuredPath();
+
+        /* saves to the configured file if names were added since it was loaded or saved */
+        bool saveConfigured();
+
+        /* the names are normalized, returns false if the key or the name is invalid */
+        bool insert(reverse::KIND kind, const QString &key, const QString &name);
+
+        /* the records of the results, returns the number of new entries */
+        int insert(const s3s_struct::DNS &dns);
+        int insert(const s3s_struct::HOST &host);
+        int insert(const s3s_struct::NS &ns);
+        int insert(const s3s_struct::MX &mx);
+        int insert(const s3s_struct::IP &ip);
+        int insert(const QString &target, const QSslCertificate &cert);
+
+        /* the names of the key, sorted */
+        QStringList lookup(reverse::KIND kind, const QString &key) const;
+
+        int keys(reverse::KIND kind) const { return m_index[static_cast<int>(kind)].size(); }
+        int names() const { return m_names.size(); }
+        bool isModified() const { return m_modified; }
+        QString error() const { return m_error; }
+
+    private:
+        s3s_ReverseIndex() {}
+
+        QVector<QString> m_names;       // the interned keys & names, by id
+        QHash<QString, quint32> m_ids;
+        QHash<quint32, QSet<quint32>> m_index[4];
+        QString m_error;
+        bool m_modified = false;
+        bool m_loaded = false;
+
+        quint32 intern(const QString &name);
+
+        /* the key in its canonical form, a null string if it is not a key of the kind */
+        static QString normalizeKey(reverse::KIND kind, const QString &key);
+};
+
+#endif // REVERSEINDEX_H
@@ -0,0 +1,60 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : a bounded queue streaming targets between the stages of a scan pipeline, the scanners of
+          a stage take targets from it as they arrive & wait while it is empty but still open.
+*/
+
+#include "StreamQueue.h"
+
+
+s3s_StreamQueue::s3s_StreamQueue(int capacity):
+    m_capacity(qMax(1, capacity))
+{
+}
+
+void s3s_StreamQueue::push(const QString &target){
+    QMutexLocker locker(&m_mutex);
+    if(!m_closed)
+        m_targets.enqueue(target);
+}
+
+s3s_StreamQueue::TAKE s3s_StreamQueue::take(QString &target){
+    /* backpressure, no targets are taken while a downstream queue is full */
+    foreach(s3s_StreamQueue *queue, m_downstream){
+        if(queue->isFull())
+            return TAKE::WAIT;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    if(!m_targets.isEmpty()){
+        target = m_targets.dequeue();
+        return TAKE::TARGET;
+    }
+    return m_closed? TAKE::CLOSED : TAKE::WAIT;
+}
+
+void s3s_StreamQueue::addDownstream(s3s_StreamQueue *queue){
+    m_downstream.append(queue);
+}
+
+void s3s_StreamQueue::close(){
+    QMutexLocker locker(&m_mutex);
+    m_closed = true;
+}
+
+bool s3s_StreamQueue::isClosed(){
+    QMutexLocker locker(&m_mutex);
+    return m_closed;
+}
+
+bool s3s_StreamQueue::isFull(){
+    QMutexLocker locker(&m_mutex);
+    return m_targets.size() >= m_capacity;
+}
+
+int s3s_StreamQueue::size(){
+    QMutexLocker locker(&m_mutex);
+    return m_targets.size();
+}
@@ -0,0 +1,63 @@
+/*
+ Copyright 2020-2022 Enock Nicholaus <3nock@protonmail.com>. All rights reserved.
+ Use of this source code is governed by GPL-3.0 LICENSE that can be found in the LICENSE file.
+
+ @brief : a bounded queue streaming targets between the stages of a scan pipeline, the scanners of
+          a stage take targets from it as they arrive & wait while it is empty but still open.
+*/
+
+#ifndef STREAMQUEUE_H
+#define STREAMQUEUE_H
+
+#include <QList>
+#include <QMutex>
+#include <QQueue>
+#include <QString>
+
+/* milliseconds a scanner waits before taking from an empty or throttled queue again */
+#define STREAM_WAIT 50
+
+/* default number of targets a queue holds before its producers are throttled */
+#define STREAM_CAPACITY 1000
+
+
+class s3s_StreamQueue {
+    public:
+        enum class TAKE {
+            TARGET, // a target was taken
+            WAIT,   // no target for now, take again after STREAM_WAIT
+            CLOSED  // no more targets
+        };
+
+        explicit s3s_StreamQueue(int capacity = STREAM_CAPACITY);
+
+        /*
+         * never blocks the caller, the capacity is enforced on the producers. the stages taking from
+         * the queues upstream of this one & the scanners with this queue downstream wait while it is
+         * full, the producers that can not wait, the osint replies & the certificates' names fed back,
+         * may push past the capacity.
+         */
+        void push(const QString &target);
+
+        /* called from the scanner threads */
+        TAKE take(QString &target);
+
+        /* the stages this queue's targets are sent to, a full downstream queue throttles this one */
+        void addDownstream(s3s_StreamQueue *queue);
+
+        void close();
+        bool isClosed();
+        bool isFull();
+        int size();
+
+    private:
+        QMutex m_mutex;
+        QQueue<QString> m_targets;
+        QList<s3s_StreamQueue*> m_downstream;
+        int m_capacity;
+        bool m_closed = false;
+
+        Q_DISABLE_COPY(s3s_StreamQueue)
+};
+
+#endif // STREAMQUEUE_H
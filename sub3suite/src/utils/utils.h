@@ -109,7 +109,6 @@ struct ScanStatus {
     bool isRunning = false;
     bool isStopped = false;
     bool isPaused = false;
-    int activeScanThreads = 0;
 };
 
 enum class RESULT_TYPE {
@@ -43,6 +43,17 @@ include(include/gumbo-parser.pri)
 include(include/breakpad.pri)
 
 SOURCES += \
+    src/cli/Bench.cpp \
+    src/cli/Bench_model.cpp \
+    src/cli/StubServers.cpp \
+    src/cli/ScanRunner.cpp \
+    src/cli/ScanRunner_scan.cpp \
+    src/cli/ScanRunner_modules.cpp \
+    src/cli/Pipeline.cpp \
+    src/cli/Expand.cpp \
+    src/cli/CtTail.cpp \
+    src/cli/EmailVerify.cpp \
+    src/modules/ct/CtTailer.cpp \
     src/dialogs/DocumentationDialog.cpp \
     src/dialogs/ActiveConfigDialog.cpp \
     src/dialogs/FailedScansDialog.cpp \
@@ -180,6 +191,7 @@ SOURCES += \
     src/modules/passive/api/Onyphe.cpp \
     src/modules/passive/api/OtxFree.cpp \
     src/modules/passive/iana/Ripe.cpp \
+    src/modules/passive/iana/Rdap.cpp \
     src/modules/passive/api/RobtexFree.cpp \
     src/modules/passive/api/SpamHaus.cpp \
     src/modules/passive/api/WebResolver.cpp \
@@ -205,7 +217,14 @@ SOURCES += \
     src/enums/ns/NSEnum.cpp \
     src/enums/ssl/SSLEnum.cpp \
     src/modules/active/BruteScanner.cpp \
+    src/modules/active/WildcardCache.cpp \
+    src/modules/active/Permutations.cpp \
     src/modules/active/ActiveScanner.cpp \
+    src/modules/active/PTRScanner.cpp \
+    src/modules/active/ScanExecutor.cpp \
+    src/modules/active/ZoneScanner.cpp \
+    src/modules/active/EmailScanner.cpp \
+    src/modules/active/IPDBScanner.cpp \
     src/modules/passive/api/Bgpview.cpp \
     src/modules/passive/api/BinaryEdge.cpp \
     src/modules/passive/api/C99.cpp \
@@ -249,6 +268,8 @@ SOURCES += \
     src/modules/passive/site/Pkey.cpp \
     src/modules/passive/site/Rapiddns.cpp \
     src/modules/passive/site/SiteDossier.cpp \
+    src/modules/passive/AbstractOsintModule.cpp \
+    src/modules/passive/HtmlScanner.cpp \
     src/engines/raw/Raw.cpp \
     src/engines/active/Active.cpp \
     src/engines/brute/Brute.cpp \
@@ -259,8 +280,20 @@ SOURCES += \
     src/utils/LogsSyntaxHighlighter.cpp \
     src/utils/UpdateChecker.cpp \
     src/utils/CrashHandler.cpp \
+    src/utils/ResultFilter.cpp \
+    src/utils/RetryPolicy.cpp \
+    src/utils/Metrics.cpp \
+    src/utils/Logger.cpp \
+    src/utils/StreamQueue.cpp \
+    src/utils/IpDatabase.cpp \
+    src/utils/RdapRegistry.cpp \
+    src/utils/CidrIterator.cpp \
+    src/utils/Hostname.cpp \
+    src/utils/ReverseIndex.cpp \
     src/widgets/InputWidget.cpp \
     src/dialogs/LogViewerDialog.cpp \
+    src/dialogs/MetricsDialog.cpp \
+    src/dialogs/CtLogDialog.cpp \
     src/dialogs/AboutDialog.cpp \
     src/dialogs/ApiKeysDialog.cpp \
     src/dialogs/WordlistDialog.cpp \
@@ -268,6 +301,14 @@ SOURCES += \
     src/main.cpp
 
 HEADERS += \
+    src/cli/Bench.h \
+    src/cli/StubServers.h \
+    src/cli/ScanRunner.h \
+    src/cli/Pipeline.h \
+    src/cli/Expand.h \
+    src/cli/CtTail.h \
+    src/cli/EmailVerify.h \
+    src/modules/ct/CtTailer.h \
     src/dialogs/DocumentationDialog.h \
     src/dialogs/ActiveConfigDialog.h \
     src/dialogs/FailedScansDialog.h \
@@ -339,6 +380,7 @@ HEADERS += \
     src/modules/passive/api/Onyphe.h \
     src/modules/passive/api/OtxFree.h \
     src/modules/passive/iana/Ripe.h \
+    src/modules/passive/iana/Rdap.h \
     src/modules/passive/api/RobtexFree.h \
     src/modules/passive/api/SpamHaus.h \
     src/modules/passive/api/WebResolver.h \
@@ -370,8 +412,15 @@ HEADERS += \
     src/enums/ns/NSEnum.h \
     src/enums/ssl/SSLEnum.h \
     src/modules/active/BruteScanner.h \
+    src/modules/active/WildcardCache.h \
+    src/modules/active/Permutations.h \
     src/modules/active/ActiveScanner.h \
     src/modules/active/AbstractScanner.h \
+    src/modules/active/PTRScanner.h \
+    src/modules/active/ScanExecutor.h \
+    src/modules/active/ZoneScanner.h \
+    src/modules/active/EmailScanner.h \
+    src/modules/active/IPDBScanner.h \
     src/modules/passive/api/Bgpview.h \
     src/modules/passive/api/BinaryEdge.h \
     src/modules/passive/api/C99.h \
@@ -416,18 +465,31 @@ HEADERS += \
     src/modules/passive/site/Rapiddns.h \
     src/modules/passive/site/SiteDossier.h \
     src/modules/passive/AbstractOsintModule.h \
+    src/modules/passive/HtmlScanner.h \
     src/engines/raw/Raw.h \
     src/engines/active/Active.h \
     src/engines/brute/Brute.h \
     src/engines/osint/Osint.h \
     src/engines/AbstractEngine.h \
     src/utils/CrashHandler.h \
+    src/utils/ResultFilter.h \
+    src/utils/RetryPolicy.h \
+    src/utils/Metrics.h \
+    src/utils/Logger.h \
+    src/utils/StreamQueue.h \
+    src/utils/IpDatabase.h \
+    src/utils/RdapRegistry.h \
+    src/utils/CidrIterator.h \
+    src/utils/Hostname.h \
+    src/utils/ReverseIndex.h \
     src/utils/s3s.h \
     src/utils/JsonSyntaxHighlighter.h \
     src/utils/LogsSyntaxHighlighter.h \
     src/utils/UpdateChecker.h \
     src/widgets/InputWidget.h \
     src/dialogs/LogViewerDialog.h \
+    src/dialogs/MetricsDialog.h \
+    src/dialogs/CtLogDialog.h \
     src/dialogs/AboutDialog.h \
     src/dialogs/ApiKeysDialog.h \
     src/dialogs/WordlistDialog.h \
@@ -461,6 +523,8 @@ FORMS += \
     src/engines/active/Active.ui \
     src/widgets/InputWidget.ui \
     src/dialogs/LogViewerDialog.ui \
+    src/dialogs/MetricsDialog.ui \
+    src/dialogs/CtLogDialog.ui \
     src/dialogs/AboutDialog.ui \
     src/dialogs/WordlistDialog.ui \
     src/dialogs/ApiKeysDialog.ui \